@@ -0,0 +1,185 @@
+#include "bench.hh"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+
+#if defined(CC_OS_WINDOWS)
+#include <Windows.h>
+
+// NOTE: must be _after_ windows.h
+#include <Psapi.h>
+#pragma comment(lib, "psapi.lib")
+#elif defined(CC_OS_APPLE)
+#include <mach/mach.h>
+#elif defined(CC_OS_LINUX)
+#include <unistd.h>
+#endif
+
+namespace
+{
+struct registered_bench
+{
+    char const* name = nullptr;
+    bench::bench_fn fn = nullptr;
+};
+
+cc::vector<registered_bench>& registry()
+{
+    static cc::vector<registered_bench> benches;
+    return benches;
+}
+
+bool header_printed = false;
+
+struct tick_calibration
+{
+    bench::f64 ns_per_tick = 1;
+    bench::f64 overhead_ticks = 0;
+};
+
+// measured once on first use: the timer overhead as the minimum of back-to-back reads
+// and the tick rate against steady_clock over ~10ms
+tick_calibration const& ticks_calibration()
+{
+    static tick_calibration const calibration = []
+    {
+        tick_calibration c;
+
+        auto overhead = ~bench::u64(0);
+        for (auto i = 0; i < 1000; ++i)
+        {
+            auto const t0 = bench::now_ticks();
+            auto const t1 = bench::now_ticks();
+            overhead = cc::min(overhead, t1 - t0);
+        }
+        c.overhead_ticks = bench::f64(overhead);
+
+        auto const ns_start = bench::now_ns();
+        auto const ticks_start = bench::now_ticks();
+        while (bench::now_ns() - ns_start < 10'000'000)
+        {
+        }
+        auto const ns_end = bench::now_ns();
+        auto const ticks_end = bench::now_ticks();
+        c.ns_per_tick = bench::f64(ns_end - ns_start) / bench::f64(ticks_end - ticks_start);
+        return c;
+    }();
+    return calibration;
+}
+} // namespace
+
+bench::i64 bench::now_ns()
+{
+    auto const t = std::chrono::steady_clock::now().time_since_epoch();
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(t).count();
+}
+
+bench::isize bench::current_rss_bytes()
+{
+#if defined(CC_OS_WINDOWS)
+    PROCESS_MEMORY_COUNTERS counters = {};
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+        return 0;
+    return isize(counters.WorkingSetSize);
+#elif defined(CC_OS_APPLE)
+    mach_task_basic_info info = {};
+    mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+    if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO, (task_info_t)&info, &count) != KERN_SUCCESS)
+        return 0;
+    return isize(info.resident_size);
+#elif defined(CC_OS_LINUX)
+    // second field of statm is the resident page count
+    auto const file = std::fopen("/proc/self/statm", "r");
+    if (file == nullptr)
+        return 0;
+    long pages_total = 0;
+    long pages_resident = 0;
+    auto const read = std::fscanf(file, "%ld %ld", &pages_total, &pages_resident);
+    std::fclose(file);
+    if (read != 2)
+        return 0;
+    return isize(pages_resident) * isize(sysconf(_SC_PAGESIZE));
+#else
+    return 0;
+#endif
+}
+
+bench::latency_stats bench::latency_recorder::compute()
+{
+    latency_stats stats;
+    if (_samples.empty())
+        return stats;
+
+    stats.batch_size = _batch_size;
+    std::sort(_samples.begin(), _samples.end());
+
+    // single ops are in ticks and include one timer read
+    auto const& calibration = ticks_calibration();
+    auto const to_ns = [&](f64 sample)
+    {
+        if (_batch_size > 1)
+            return sample;
+        return cc::max(0.0, sample - calibration.overhead_ticks) * calibration.ns_per_tick;
+    };
+
+    auto const percentile = [&](f64 p)
+    {
+        auto const idx = isize(p * f64(_samples.size() - 1) + 0.5);
+        return to_ns(_samples[idx]);
+    };
+
+    stats.p50 = percentile(0.5);
+    stats.p99 = percentile(0.99);
+    stats.p999 = percentile(0.999);
+    stats.max = to_ns(_samples.back());
+    return stats;
+}
+
+void bench::report(result_row const& row)
+{
+    if (!header_printed)
+    {
+        if (row.latency.batch_size > 1)
+            std::printf("(latency percentiles are over per-op means of %lld-op batches)\n",
+                        (long long)row.latency.batch_size);
+        std::printf("%-22s %-18s %8s %4s %10s %9s %9s %9s %9s %10s %10s\n", //
+                    "pattern", "resource", "size", "thr", "ops", "ns/op", "p50", "p99", "p99.9", "max", "rss MiB");
+        header_printed = true;
+    }
+
+    // node size 0 means mixed sizes
+    char size_str[16] = "mixed";
+    if (row.node_size > 0)
+        std::snprintf(size_str, sizeof(size_str), "%lld", (long long)row.node_size);
+
+    auto const ns_per_op = row.ops > 0 ? f64(row.total_ns) / f64(row.ops) : 0.0;
+    std::printf("%-22s %-18s %8s %4lld %10lld %9.2f %9.2f %9.2f %9.2f %10.2f %+10.2f\n", //
+                row.pattern, row.resource, size_str, (long long)row.threads, (long long)row.ops,
+                ns_per_op, row.latency.p50, row.latency.p99, row.latency.p999, row.latency.max,
+                f64(row.rss_growth_bytes) / (1024.0 * 1024.0));
+    std::fflush(stdout);
+}
+
+bench::registrar::registrar(char const* name, bench_fn fn) { registry().push_back({name, fn}); }
+
+int bench::run(int argc, char** argv)
+{
+    char const* filter = argc > 1 ? argv[1] : nullptr;
+
+    isize run_count = 0;
+    for (auto const& b : registry())
+    {
+        if (filter != nullptr && std::strstr(b.name, filter) == nullptr)
+            continue;
+
+        std::printf("\n== %s\n", b.name);
+        header_printed = false;
+        b.fn();
+        ++run_count;
+    }
+
+    std::printf("\n%lld benchmark(s) run\n", (long long)run_count);
+    return 0;
+}
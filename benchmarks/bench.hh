@@ -0,0 +1,172 @@
+#pragma once
+
+#include <clean-core/fwd.hh>
+#include <clean-core/macros.hh>
+#include <clean-core/vector.hh>
+
+#if defined(CC_ARCH_X64)
+#if defined(CC_COMPILER_MSVC)
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#endif
+
+// =========================================================================================================
+// Minimal benchmark harness for clean-core
+// =========================================================================================================
+//
+// Benchmarks are registered via CC_BENCH("name") { ... } and run by benchmarks/main.cc:
+//   clean-core-bench             - runs all benchmarks
+//   clean-core-bench <filter>    - runs benchmarks whose name contains <filter>
+//
+// Each benchmark reports rows via bench::report:
+//   ns/op      - mean wall time per operation
+//   p50..max   - per-op latency percentiles, either of single timed ops (now_ticks, timer overhead subtracted)
+//                or of per-op means of small op batches (the table then notes the batch size)
+//   rss        - growth of the process resident set size during the measured phase
+//
+// This is intentionally dependency-free (no nexus, no external benchmark library),
+// so it can be built in release mode on all platforms without extra setup.
+
+namespace bench
+{
+using namespace cc::primitive_defines;
+
+// =========================================================================================================
+// Measurement
+// =========================================================================================================
+
+/// Monotonic clock in nanoseconds.
+[[nodiscard]] i64 now_ns();
+
+/// Low-overhead timestamp for timing single operations, converted to ns by latency_recorder.
+/// rdtscp on x64 (waits until all previous instructions executed), the virtual counter on arm64, now_ns() otherwise.
+CC_FORCE_INLINE u64 now_ticks()
+{
+#if defined(CC_ARCH_X64)
+    unsigned aux = 0;
+    return __rdtscp(&aux);
+#elif defined(CC_ARCH_ARM64) && !defined(CC_COMPILER_MSVC)
+    u64 ticks = 0;
+    asm volatile("isb; mrs %0, cntvct_el0" : "=r"(ticks));
+    return ticks;
+#else
+    return u64(now_ns());
+#endif
+}
+
+/// Current resident set size of the process in bytes (0 if unsupported on this platform).
+[[nodiscard]] isize current_rss_bytes();
+
+// volatile store target of do_not_optimize
+inline void const* volatile do_not_optimize_sink = nullptr;
+
+/// Keeps the compiler from optimizing away a computed pointer or value.
+CC_FORCE_INLINE void do_not_optimize(void const* p) { do_not_optimize_sink = p; }
+
+/// splitmix64, deterministic across platforms (so all backends see the same key/size sequences).
+struct rng
+{
+    u64 state = 0x9E3779B97F4A7C15ull;
+
+    u64 next()
+    {
+        auto z = (state += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+};
+
+/// Number of operations timed together for batched latency samples (add_batch).
+/// A steady_clock read costs ~20ns, so timing single node allocations with it would mostly measure the clock.
+/// NOTE: batch means hide single-op outliers, prefer add_op with now_ticks() for tail latencies.
+inline constexpr isize latency_batch_size = 16;
+
+struct latency_stats
+{
+    f64 p50 = 0;
+    f64 p99 = 0;
+    f64 p999 = 0;
+    f64 max = 0;
+
+    // 1 if the percentiles are over single ops, otherwise the size of the batches whose per-op means were taken
+    isize batch_size = 1;
+};
+
+/// Collects per-op latencies and computes percentiles.
+/// Samples are either single ops (add_op) or per-op means of op batches (add_batch), but not both.
+struct latency_recorder
+{
+    /// Records a single operation that took op_ticks (difference of two now_ticks() calls).
+    void add_op(u64 op_ticks)
+    {
+        CC_ASSERT(_batch_size <= 1, "cannot mix single ops and batches");
+        _batch_size = 1;
+        _samples.push_back(f64(op_ticks));
+    }
+
+    /// Records a batch of op_count operations that took batch_ns in total.
+    void add_batch(i64 batch_ns, isize op_count)
+    {
+        CC_ASSERT(_batch_size != 1, "cannot mix single ops and batches");
+        _batch_size = op_count;
+        _samples.push_back(f64(batch_ns) / f64(op_count));
+    }
+
+    [[nodiscard]] latency_stats compute();
+
+    void append(latency_recorder const& rhs)
+    {
+        CC_ASSERT(_batch_size == 0 || rhs._batch_size == 0 || _batch_size == rhs._batch_size, "incompatible samples");
+        if (_batch_size == 0)
+            _batch_size = rhs._batch_size;
+        for (auto s : rhs._samples)
+            _samples.push_back(s);
+    }
+
+private:
+    cc::vector<f64> _samples; // ticks for single ops, ns for batches
+    isize _batch_size = 0;    // 0 until the first sample
+};
+
+// =========================================================================================================
+// Reporting
+// =========================================================================================================
+
+struct result_row
+{
+    char const* pattern = "";
+    char const* resource = "";
+    isize node_size = 0; // "size" column (node size, element count, ...), 0 for mixed sizes
+    isize threads = 1;
+    isize ops = 0;
+    i64 total_ns = 0;
+    latency_stats latency = {};
+    isize rss_growth_bytes = 0;
+};
+
+/// Prints one result row (prints the table header before the first row).
+void report(result_row const& row);
+
+// =========================================================================================================
+// Registration
+// =========================================================================================================
+
+using bench_fn = void (*)();
+
+struct registrar
+{
+    registrar(char const* name, bench_fn fn);
+};
+
+/// Runs all registered benchmarks matching the optional filter in argv[1].
+int run(int argc, char** argv);
+} // namespace bench
+
+#define CC_BENCH(name) CC_IMPL_BENCH(name, CC_MACRO_JOIN(cc_bench_fn_, __LINE__))
+#define CC_IMPL_BENCH(name, fn)                                             \
+    static void fn();                                                       \
+    static bench::registrar CC_MACRO_JOIN(fn, _registrar){name, &fn};       \
+    static void fn()
@@ -0,0 +1,144 @@
+#include "bench.hh"
+
+#include <clean-core/bitset.hh>
+
+#include <vector>
+
+// =========================================================================================================
+// Bitset kernels
+// =========================================================================================================
+//
+// Patterns (ns/op is wall time per 64 bits, i.e. per u64 word of the bitset):
+//   and / or / and_not  - a op= b over the whole bitset
+//   count               - popcount of the whole bitset
+//   iterate 1%          - visit every set bit of a bitset with ~1.6% density (per word, not per set bit)
+//
+// The size column is the number of bits: 1M bits (128 KB, cache resident) and 256M bits (32 MB, memory bound).
+// std::vector<bool> is the baseline with hand-written bit loops, as its standard interface offers nothing bulk.
+
+using namespace cc::primitive_defines;
+
+namespace
+{
+constexpr int repetitions = 8;
+
+void report(char const* pattern, char const* resource, isize bits, i64 total_ns)
+{
+    bench::report({.pattern = pattern,
+                   .resource = resource,
+                   .node_size = bits,
+                   .threads = 1,
+                   .ops = bits / 64 * repetitions,
+                   .total_ns = total_ns});
+}
+
+// bit counts are multiples of 64, so filling whole words keeps the bits past size() zero
+cc::bitset random_bitset(isize bits, bench::rng& rng)
+{
+    auto b = cc::bitset::create_with_size(bits);
+    for (auto& w : b.words())
+        w = rng.next();
+    return b;
+}
+
+void run_cc(isize bits)
+{
+    bench::rng rng;
+    auto a = random_bitset(bits, rng);
+    auto const b = random_bitset(bits, rng);
+
+    auto start = bench::now_ns();
+    for (auto r = 0; r < repetitions; ++r)
+        a &= b;
+    report("and", "cc::bitset", bits, bench::now_ns() - start);
+
+    start = bench::now_ns();
+    for (auto r = 0; r < repetitions; ++r)
+        a |= b;
+    report("or", "cc::bitset", bits, bench::now_ns() - start);
+
+    start = bench::now_ns();
+    for (auto r = 0; r < repetitions; ++r)
+        a.and_not(b);
+    report("and_not", "cc::bitset", bits, bench::now_ns() - start);
+
+    isize count = 0;
+    start = bench::now_ns();
+    for (auto r = 0; r < repetitions; ++r)
+        count += b.count();
+    report("count", "cc::bitset", bits, bench::now_ns() - start);
+    bench::do_not_optimize(&count);
+
+    // 1.6% density: and of 6 random words
+    auto sparse = cc::bitset::create_with_size(bits);
+    for (auto& w : sparse.words())
+        w = rng.next() & rng.next() & rng.next() & rng.next() & rng.next() & rng.next();
+    isize sum = 0;
+    start = bench::now_ns();
+    for (auto r = 0; r < repetitions; ++r)
+        for (isize i : sparse.set_bits())
+            sum += i;
+    report("iterate 1%", "cc::bitset", bits, bench::now_ns() - start);
+    bench::do_not_optimize(&sum);
+}
+
+void run_std(isize bits)
+{
+    bench::rng rng;
+    std::vector<bool> a(bits), b(bits), sparse(bits);
+    for (isize i = 0; i < bits; ++i)
+    {
+        a[i] = rng.next() & 1;
+        b[i] = rng.next() & 1;
+        sparse[i] = rng.next() % 64 == 0;
+    }
+
+    auto start = bench::now_ns();
+    for (auto r = 0; r < repetitions; ++r)
+        for (isize i = 0; i < bits; ++i)
+            a[i] = a[i] && b[i];
+    report("and", "std::vector<bool>", bits, bench::now_ns() - start);
+
+    start = bench::now_ns();
+    for (auto r = 0; r < repetitions; ++r)
+        for (isize i = 0; i < bits; ++i)
+            a[i] = a[i] || b[i];
+    report("or", "std::vector<bool>", bits, bench::now_ns() - start);
+
+    start = bench::now_ns();
+    for (auto r = 0; r < repetitions; ++r)
+        for (isize i = 0; i < bits; ++i)
+            a[i] = a[i] && !b[i];
+    report("and_not", "std::vector<bool>", bits, bench::now_ns() - start);
+
+    isize count = 0;
+    start = bench::now_ns();
+    for (auto r = 0; r < repetitions; ++r)
+        for (isize i = 0; i < bits; ++i)
+            count += b[i];
+    report("count", "std::vector<bool>", bits, bench::now_ns() - start);
+    bench::do_not_optimize(&count);
+
+    isize sum = 0;
+    start = bench::now_ns();
+    for (auto r = 0; r < repetitions; ++r)
+        for (isize i = 0; i < bits; ++i)
+            if (sparse[i])
+                sum += i;
+    report("iterate 1%", "std::vector<bool>", bits, bench::now_ns() - start);
+    bench::do_not_optimize(&sum);
+}
+} // namespace
+
+// =========================================================================================================
+// Benchmarks
+// =========================================================================================================
+
+CC_BENCH("bitset - bulk kernels")
+{
+    for (isize bits : {isize(1) << 20, isize(1) << 28})
+    {
+        run_cc(bits);
+        run_std(bits);
+    }
+}
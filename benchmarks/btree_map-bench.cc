@@ -0,0 +1,252 @@
+#include "bench.hh"
+
+#include <clean-core/btree_map.hh>
+#include <clean-core/flat_map.hh>
+
+#include <map>
+
+// =========================================================================================================
+// Ordered map lookup, range scan and insertion
+// =========================================================================================================
+//
+// Patterns:
+//   lookup hit      - random lookups of present keys
+//   range scan      - lower_bound of a random key, then summing the next 64 entries in order
+//   insert random   - inserting keys in random order into an empty map, then destroying it
+//   insert seq      - inserting increasing keys into an empty map, then destroying it
+//   insert/remove   - steady-state churn: remove a random present key, insert a fresh one
+//
+// Backends:
+//   cc::btree_map   - B+tree with 256 byte nodes and linked leaves
+//   std::map        - red-black tree, one allocation per element
+//   cc::flat_map    - sorted keys/values arrays with binary search (lookups and scans only)
+//
+// The size column is the number of keys in the map (1k is L1/L2 resident, 1M is memory-bound).
+
+using namespace cc::primitive_defines;
+
+namespace
+{
+constexpr isize scan_length = 64;
+
+// keys of the map are key_of(0..n-1), scattered over the u64 range
+CC_FORCE_INLINE u64 key_of(u64 i) { return (i * 0x9E3779B97F4A7C15ull) ^ 0x5555'5555'5555'5555ull; }
+
+struct btree_backend
+{
+    static constexpr char const* name = "cc::btree_map";
+
+    using map_t = cc::btree_map<u64, u64>;
+
+    static void insert(map_t& m, u64 key, u64 value) { m.insert_or_assign(key, value); }
+    static void remove(map_t& m, u64 key) { m.remove(key); }
+    static u64 const* find(map_t const& m, u64 key) { return m.get_ptr(key); }
+    static u64 scan(map_t const& m, u64 key)
+    {
+        u64 sum = 0;
+        auto it = m.lower_bound(key);
+        for (isize i = 0; i < scan_length && it != m.end(); ++i, ++it)
+            sum += (*it).value;
+        return sum;
+    }
+};
+
+struct std_map_backend
+{
+    static constexpr char const* name = "std::map";
+
+    using map_t = std::map<u64, u64>;
+
+    static void insert(map_t& m, u64 key, u64 value) { m.insert_or_assign(key, value); }
+    static void remove(map_t& m, u64 key) { m.erase(key); }
+    static u64 const* find(map_t const& m, u64 key)
+    {
+        auto const it = m.find(key);
+        return it != m.end() ? &it->second : nullptr;
+    }
+    static u64 scan(map_t const& m, u64 key)
+    {
+        u64 sum = 0;
+        auto it = m.lower_bound(key);
+        for (isize i = 0; i < scan_length && it != m.end(); ++i, ++it)
+            sum += it->second;
+        return sum;
+    }
+};
+
+struct flat_map_backend
+{
+    static constexpr char const* name = "cc::flat_map";
+
+    using map_t = cc::flat_map<u64, u64>;
+
+    static u64 const* find(map_t const& m, u64 key) { return m.get_ptr(key); }
+    static u64 scan(map_t const& m, u64 key)
+    {
+        u64 sum = 0;
+        auto const end = cc::min(m.lower_bound(key) + scan_length, m.size());
+        for (auto i = m.lower_bound(key); i < end; ++i)
+            sum += m.values()[i];
+        return sum;
+    }
+};
+
+template <class Backend>
+void fill(typename Backend::map_t& m, isize n)
+{
+    if constexpr (std::is_same_v<Backend, flat_map_backend>)
+    {
+        cc::vector<u64> keys;
+        cc::vector<u64> values;
+        for (isize i = 0; i < n; ++i)
+        {
+            keys.push_back(key_of(u64(i)));
+            values.push_back(u64(i));
+        }
+        m = flat_map_backend::map_t::create_from_unsorted(cc::move(keys), cc::move(values));
+    }
+    else
+    {
+        for (isize i = 0; i < n; ++i)
+            Backend::insert(m, key_of(u64(i)), u64(i));
+    }
+}
+
+// scan: range scan instead of a point lookup
+template <class Backend>
+void run_query(char const* pattern, isize n, isize ops, bool scan)
+{
+    typename Backend::map_t m;
+    fill<Backend>(m, n);
+
+    bench::rng r;
+    u64 found = 0;
+    bench::latency_recorder latency;
+    auto const start = bench::now_ns();
+
+    for (isize i = 0; i < ops; i += bench::latency_batch_size)
+    {
+        auto const batch_start = bench::now_ns();
+        for (isize j = 0; j < bench::latency_batch_size; ++j)
+        {
+            auto const key = key_of(r.next() % u64(n));
+            if (scan)
+                found += Backend::scan(m, key);
+            else if (auto const v = Backend::find(m, key))
+                found += *v;
+        }
+        latency.add_batch(bench::now_ns() - batch_start, bench::latency_batch_size);
+    }
+
+    auto const total = bench::now_ns() - start;
+    bench::do_not_optimize(&found);
+
+    bench::report({.pattern = pattern,
+                   .resource = Backend::name,
+                   .node_size = n,
+                   .ops = ops,
+                   .total_ns = total,
+                   .latency = latency.compute()});
+}
+
+template <class Backend>
+void run_insert(char const* pattern, isize n, isize rounds, bool sequential)
+{
+    bench::latency_recorder latency;
+    auto const rss_before = bench::current_rss_bytes();
+    auto const start = bench::now_ns();
+
+    for (isize round = 0; round < rounds; ++round)
+    {
+        typename Backend::map_t m;
+        for (isize i = 0; i < n; i += bench::latency_batch_size)
+        {
+            auto const batch_start = bench::now_ns();
+            for (isize j = 0; j < bench::latency_batch_size; ++j)
+                Backend::insert(m, sequential ? u64(i + j) : key_of(u64(i + j)), u64(j));
+            latency.add_batch(bench::now_ns() - batch_start, bench::latency_batch_size);
+        }
+        bench::do_not_optimize(&m);
+    }
+
+    auto const total = bench::now_ns() - start;
+    auto const rss_after = bench::current_rss_bytes();
+
+    bench::report({.pattern = pattern,
+                   .resource = Backend::name,
+                   .node_size = n,
+                   .ops = n * rounds,
+                   .total_ns = total,
+                   .latency = latency.compute(),
+                   .rss_growth_bytes = rss_after - rss_before});
+}
+
+template <class Backend>
+void run_insert_remove(isize n, isize ops)
+{
+    typename Backend::map_t m;
+    fill<Backend>(m, n);
+
+    // live keys are key_of(next_remove .. next_insert - 1), so removals and insertions hit random positions
+    auto next_remove = u64(0);
+    auto next_insert = u64(n);
+
+    bench::latency_recorder latency;
+    auto const start = bench::now_ns();
+
+    for (isize i = 0; i < ops; i += bench::latency_batch_size)
+    {
+        auto const batch_start = bench::now_ns();
+        for (isize j = 0; j < bench::latency_batch_size; ++j)
+        {
+            Backend::remove(m, key_of(next_remove++));
+            Backend::insert(m, key_of(next_insert), next_insert);
+            ++next_insert;
+        }
+        latency.add_batch(bench::now_ns() - batch_start, bench::latency_batch_size);
+    }
+
+    auto const total = bench::now_ns() - start;
+
+    bench::report({.pattern = "insert/remove",
+                   .resource = Backend::name,
+                   .node_size = n,
+                   .ops = ops,
+                   .total_ns = total,
+                   .latency = latency.compute()});
+}
+} // namespace
+
+// =========================================================================================================
+// Benchmarks
+// =========================================================================================================
+
+CC_BENCH("btree_map - lookup")
+{
+    constexpr isize ops = 4'000'000;
+
+    for (isize n : {1 << 10, 1 << 16, 1 << 20})
+    {
+        run_query<btree_backend>("lookup hit", n, ops, false);
+        run_query<std_map_backend>("lookup hit", n, ops, false);
+        run_query<flat_map_backend>("lookup hit", n, ops, false);
+        run_query<btree_backend>("range scan", n, ops / 8, true);
+        run_query<std_map_backend>("range scan", n, ops / 8, true);
+        run_query<flat_map_backend>("range scan", n, ops / 8, true);
+    }
+}
+
+CC_BENCH("btree_map - insert")
+{
+    run_insert<btree_backend>("insert random", 1 << 10, 1024, false);
+    run_insert<std_map_backend>("insert random", 1 << 10, 1024, false);
+    run_insert<btree_backend>("insert random", 1 << 20, 4, false);
+    run_insert<std_map_backend>("insert random", 1 << 20, 4, false);
+    run_insert<btree_backend>("insert seq", 1 << 20, 4, true);
+    run_insert<std_map_backend>("insert seq", 1 << 20, 4, true);
+
+    run_insert_remove<btree_backend>(1 << 10, 4'000'000);
+    run_insert_remove<std_map_backend>(1 << 10, 4'000'000);
+    run_insert_remove<btree_backend>(1 << 20, 4'000'000);
+    run_insert_remove<std_map_backend>(1 << 20, 4'000'000);
+}
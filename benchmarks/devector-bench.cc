@@ -0,0 +1,115 @@
+#include "bench.hh"
+
+#include <clean-core/devector.hh>
+
+#include <deque>
+
+// =========================================================================================================
+// Double-ended containers
+// =========================================================================================================
+//
+// Patterns (ns/op is wall time per pushed element, scan is per visited element):
+//   push_back       - n push_back into an empty container (repeated to ~10M ops, including the frees)
+//   push_front      - n push_front into an empty container
+//   alternating     - n pushes, alternating front and back
+//   sliding window  - push_back + remove_front once the window holds `size` elements (10M ops)
+//   window + scan   - sliding window that sums the whole window every 64 pushes (per visited element)
+//
+// The size column is n for the push patterns and the window size for the window patterns.
+// cc::devector re-centers into the space freed by remove_front, so the window patterns never reallocate.
+
+using namespace cc::primitive_defines;
+
+namespace
+{
+constexpr isize window_ops = 10'000'000;
+
+void report(char const* pattern, char const* resource, isize size, isize ops, i64 total_ns)
+{
+    bench::report({.pattern = pattern,
+                   .resource = resource,
+                   .node_size = size,
+                   .threads = 1,
+                   .ops = ops,
+                   .total_ns = total_ns});
+}
+
+template <class Container>
+void run(char const* name, isize n, isize window)
+{
+    auto const push_reps = cc::max(isize(1), window_ops / n);
+    auto const push_pattern = [&](char const* pattern, auto&& push)
+    {
+        auto start = bench::now_ns();
+        for (isize r = 0; r < push_reps; ++r)
+        {
+            Container c;
+            for (isize i = 0; i < n; ++i)
+                push(c, u64(i));
+            bench::do_not_optimize(&c.front());
+        }
+        report(pattern, name, n, n * push_reps, bench::now_ns() - start);
+    };
+    push_pattern("push_back", [](Container& c, u64 v) { c.push_back(v); });
+    push_pattern("push_front", [](Container& c, u64 v) { c.push_front(v); });
+    push_pattern("alternating",
+                 [](Container& c, u64 v)
+                 {
+                     if (v & 1)
+                         c.push_front(v);
+                     else
+                         c.push_back(v);
+                 });
+    {
+        auto start = bench::now_ns();
+        Container c;
+        for (isize i = 0; i < window_ops; ++i)
+        {
+            c.push_back(u64(i));
+            if (isize(c.size()) > window)
+                c.pop_front();
+        }
+        report("sliding window", name, window, window_ops, bench::now_ns() - start);
+        bench::do_not_optimize(&c.front());
+    }
+    {
+        u64 sum = 0;
+        isize visited = 0;
+        auto start = bench::now_ns();
+        Container c;
+        for (isize i = 0; i < window_ops / 16; ++i)
+        {
+            c.push_back(u64(i));
+            if (isize(c.size()) > window)
+                c.pop_front();
+            if (i % 64 == 0)
+            {
+                for (auto v : c)
+                    sum += v;
+                visited += isize(c.size());
+            }
+        }
+        report("window + scan", name, window, visited, bench::now_ns() - start);
+        bench::do_not_optimize(&sum);
+    }
+}
+
+// pop_front on both containers without using the value
+struct cc_devector : cc::devector<u64>
+{
+    void pop_front() { remove_front(); }
+};
+} // namespace
+
+// =========================================================================================================
+// Benchmarks
+// =========================================================================================================
+
+CC_BENCH("devector - push and sliding window")
+{
+    for (isize size : {isize(1000), isize(1'000'000)})
+    {
+        run<cc_devector>("cc::devector", size, size);
+        run<std::deque<u64>>("std::deque", size, size);
+    }
+}
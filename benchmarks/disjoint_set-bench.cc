@@ -0,0 +1,105 @@
+#include "bench.hh"
+
+#include <clean-core/disjoint_set.hh>
+#include <clean-core/vector.hh>
+
+#include <thread>
+
+// =========================================================================================================
+// Union-find / connected components
+// =========================================================================================================
+//
+// Patterns (random graph, ns/op is wall time per edge):
+//   unite loop    - one unite() call per edge
+//   unite_all     - bulk unite over the edge span (prefetches parents of upcoming edges)
+//   unite_all xT  - concurrent_disjoint_set, edge list split into T chunks on T threads, then flatten()
+//
+// The size column is the number of vertices (4 random edges per vertex, u32 indices).
+// With 16 MB per parent array, almost every find is a cache miss, which is what the prefetching targets.
+
+using namespace cc::primitive_defines;
+
+namespace
+{
+using edge = cc::pair<u32, u32>;
+
+cc::vector<edge> make_edges(isize vertices, isize count)
+{
+    bench::rng rng;
+    auto edges = cc::vector<edge>::create_uninitialized(count);
+    for (auto& e : edges)
+        e = {u32(rng.next() % u64(vertices)), u32(rng.next() % u64(vertices))};
+    return edges;
+}
+
+void run_sequential(isize vertices, cc::span<edge const> edges, bool bulk)
+{
+    auto ds = cc::disjoint_set<u32>::create_with_size(vertices);
+
+    auto const start = bench::now_ns();
+    if (bulk)
+        ds.unite_all(edges);
+    else
+        for (auto const& e : edges)
+            ds.unite(e.first, e.second);
+    auto const total = bench::now_ns() - start;
+
+    auto sets = ds.set_count();
+    bench::do_not_optimize(&sets);
+
+    bench::report({.pattern = bulk ? "unite_all" : "unite loop",
+                   .resource = "cc::disjoint_set",
+                   .node_size = vertices,
+                   .threads = 1,
+                   .ops = edges.size(),
+                   .total_ns = total});
+}
+
+void run_concurrent(isize vertices, cc::span<edge const> edges, int threads)
+{
+    auto ds = cc::concurrent_disjoint_set<u32>::create_with_size(vertices);
+
+    auto const start = bench::now_ns();
+    cc::vector<std::thread> workers;
+    auto const chunk = edges.size() / threads;
+    for (auto t = 0; t < threads; ++t)
+        workers.push_back(std::thread(
+            [&, t]
+            {
+                auto const begin = t * chunk;
+                auto const end = t + 1 == threads ? edges.size() : begin + chunk;
+                ds.unite_all(cc::span<edge const>(edges.data() + begin, end - begin));
+            }));
+    for (auto& w : workers)
+        w.join();
+    ds.flatten();
+    auto const total = bench::now_ns() - start;
+
+    auto root = ds.find(u32(vertices - 1));
+    bench::do_not_optimize(&root);
+
+    bench::report({.pattern = threads == 1 ? "unite_all x1" : threads == 2 ? "unite_all x2" : "unite_all x4",
+                   .resource = "cc::concurrent_disjoint_set",
+                   .node_size = vertices,
+                   .threads = threads,
+                   .ops = edges.size(),
+                   .total_ns = total});
+}
+} // namespace
+
+// =========================================================================================================
+// Benchmarks
+// =========================================================================================================
+
+CC_BENCH("disjoint_set - random graph")
+{
+    for (isize vertices : {isize(1) << 16, isize(1) << 22})
+    {
+        auto const edges = make_edges(vertices, 4 * vertices);
+
+        run_sequential(vertices, edges, false);
+        run_sequential(vertices, edges, true);
+        for (auto threads : {1, 2, 4})
+            run_concurrent(vertices, edges, threads);
+    }
+}
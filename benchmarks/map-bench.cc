@@ -0,0 +1,307 @@
+#include "bench.hh"
+
+#include <clean-core/flat_map.hh>
+#include <clean-core/map.hh>
+#include <clean-core/string.hh>
+
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+// =========================================================================================================
+// Hash map lookup and insertion
+// =========================================================================================================
+//
+// Patterns:
+//   lookup hit      - random lookups of present keys
+//   lookup miss     - random lookups of absent keys
+//   insert          - inserting fresh keys into an empty map (including all rehashes), then destroying it
+//   insert/remove   - steady-state churn: remove a random present key, insert a fresh one
+//   string hit      - lookup hit with string keys (string_view lookups for cc::map, no temporaries)
+//
+// Backends:
+//   cc::map             - Swiss-table open addressing
+//   std::unordered_map  - node-based chaining
+//   cc::flat_map        - sorted keys/values arrays with binary search (lookups only)
+//
+// The size column is the number of keys in the map (1k is L1/L2 resident, 1M is memory-bound).
+//
+// ns/op comes from an untimed throughput pass.
+// The latency percentiles come from a separate pass (a quarter of the ops) that times every single op via now_ticks.
+// Timed ops cannot overlap with their neighbors, so p50 is usually above the pipelined ns/op.
+
+using namespace cc::primitive_defines;
+
+namespace
+{
+struct cc_map_backend
+{
+    static constexpr char const* name = "cc::map";
+
+    using map_t = cc::map<u64, u64>;
+
+    static void insert(map_t& m, u64 key, u64 value) { m.insert_or_assign(key, value); }
+    static void remove(map_t& m, u64 key) { m.remove(key); }
+    static u64 const* find(map_t const& m, u64 key) { return m.get_ptr(key); }
+};
+
+struct std_map_backend
+{
+    static constexpr char const* name = "std::unordered_map";
+
+    using map_t = std::unordered_map<u64, u64>;
+
+    static void insert(map_t& m, u64 key, u64 value) { m.insert_or_assign(key, value); }
+    static void remove(map_t& m, u64 key) { m.erase(key); }
+    static u64 const* find(map_t const& m, u64 key)
+    {
+        auto const it = m.find(key);
+        return it != m.end() ? &it->second : nullptr;
+    }
+};
+
+// keys of the map are key_of(0..n-1), absent keys are key_of(n..)
+// keys are randomized so that neither backend benefits from sequential integer patterns
+CC_FORCE_INLINE u64 key_of(u64 i) { return (i * 0x9E3779B97F4A7C15ull) ^ 0x5555'5555'5555'5555ull; }
+
+// number of ops in the latency pass, enough samples for a stable p99.9
+constexpr isize latency_ops_for(isize ops) { return cc::max(isize(1), ops / 4); }
+
+// times each call of op_fn separately
+template <class OpF>
+void record_latency(bench::latency_recorder& latency, isize ops, OpF&& op_fn)
+{
+    for (isize i = 0; i < ops; ++i)
+    {
+        auto const op_start = bench::now_ticks();
+        op_fn();
+        latency.add_op(bench::now_ticks() - op_start);
+    }
+}
+
+struct flat_map_backend
+{
+    static constexpr char const* name = "cc::flat_map";
+
+    using map_t = cc::flat_map<u64, u64>;
+
+    static u64 const* find(map_t const& m, u64 key) { return m.get_ptr(key); }
+};
+
+template <class Backend>
+void fill(typename Backend::map_t& m, isize n)
+{
+    if constexpr (std::is_same_v<Backend, flat_map_backend>)
+    {
+        // bulk build, single inserts are O(n)
+        cc::vector<u64> keys;
+        cc::vector<u64> values;
+        for (isize i = 0; i < n; ++i)
+        {
+            keys.push_back(key_of(u64(i)));
+            values.push_back(u64(i));
+        }
+        m = flat_map_backend::map_t::create_from_unsorted(cc::move(keys), cc::move(values));
+    }
+    else
+    {
+        for (isize i = 0; i < n; ++i)
+            Backend::insert(m, key_of(u64(i)), u64(i));
+    }
+}
+
+template <class Backend>
+void run_lookup(char const* pattern, isize n, isize ops, bool hit)
+{
+    typename Backend::map_t m;
+    fill<Backend>(m, n);
+
+    bench::rng r;
+    u64 found = 0;
+    auto const lookup_one = [&]
+    {
+        auto const idx = r.next() % u64(n);
+        auto const key = key_of(hit ? idx : idx + u64(n));
+        if (auto const v = Backend::find(m, key))
+            found += *v;
+    };
+
+    auto const start = bench::now_ns();
+    for (isize i = 0; i < ops; ++i)
+        lookup_one();
+    auto const total = bench::now_ns() - start;
+
+    bench::latency_recorder latency;
+    record_latency(latency, latency_ops_for(ops), lookup_one);
+    bench::do_not_optimize(&found);
+
+    bench::report({.pattern = pattern,
+                   .resource = Backend::name,
+                   .node_size = n,
+                   .ops = ops,
+                   .total_ns = total,
+                   .latency = latency.compute()});
+}
+
+template <class Backend>
+void run_insert(isize n, isize rounds)
+{
+    auto const rss_before = bench::current_rss_bytes();
+    auto const start = bench::now_ns();
+
+    for (isize round = 0; round < rounds; ++round)
+    {
+        typename Backend::map_t m;
+        for (isize i = 0; i < n; ++i)
+            Backend::insert(m, key_of(u64(i)), u64(i));
+        bench::do_not_optimize(&m);
+    }
+
+    auto const total = bench::now_ns() - start;
+    auto const rss_after = bench::current_rss_bytes();
+
+    // the latency pass includes the rehashes, which make up the tail
+    bench::latency_recorder latency;
+    for (isize round = 0; round < latency_ops_for(rounds); ++round)
+    {
+        typename Backend::map_t m;
+        auto i = u64(0);
+        record_latency(latency, n,
+                       [&]
+                       {
+                           Backend::insert(m, key_of(i), i);
+                           ++i;
+                       });
+        bench::do_not_optimize(&m);
+    }
+
+    bench::report({.pattern = "insert",
+                   .resource = Backend::name,
+                   .node_size = n,
+                   .ops = n * rounds,
+                   .total_ns = total,
+                   .latency = latency.compute(),
+                   .rss_growth_bytes = rss_after - rss_before});
+}
+
+template <class Backend>
+void run_insert_remove(isize n, isize ops)
+{
+    typename Backend::map_t m;
+    fill<Backend>(m, n);
+
+    // live keys are key_of(next_remove .. next_insert - 1), the window slides through the key space
+    auto next_remove = u64(0);
+    auto next_insert = u64(n);
+
+    // one op is a remove followed by an insert
+    auto const churn_one = [&]
+    {
+        Backend::remove(m, key_of(next_remove++));
+        Backend::insert(m, key_of(next_insert), next_insert);
+        ++next_insert;
+    };
+
+    auto const rss_before = bench::current_rss_bytes();
+    auto const start = bench::now_ns();
+    for (isize i = 0; i < ops; ++i)
+        churn_one();
+    auto const total = bench::now_ns() - start;
+    auto const rss_after = bench::current_rss_bytes();
+
+    bench::latency_recorder latency;
+    record_latency(latency, latency_ops_for(ops), churn_one);
+
+    bench::report({.pattern = "insert/remove",
+                   .resource = Backend::name,
+                   .node_size = n,
+                   .ops = ops,
+                   .total_ns = total,
+                   .latency = latency.compute(),
+                   .rss_growth_bytes = rss_after - rss_before});
+}
+
+template <class MapT, class LookupFn>
+void run_string_hit(char const* name, isize n, isize ops, LookupFn&& lookup)
+{
+    // keys are stored in the map, lookups go through separately owned buffers (like parsed input)
+    cc::vector<std::string> keys;
+    for (isize i = 0; i < n; ++i)
+        keys.push_back("key/" + std::to_string(key_of(u64(i))));
+
+    MapT m;
+    for (isize i = 0; i < n; ++i)
+    {
+        if constexpr (std::is_same_v<MapT, cc::map<cc::string, u64>>)
+            m.insert_or_assign(cc::string_view(keys[i].data(), isize(keys[i].size())), u64(i));
+        else
+            m.insert_or_assign(keys[i], u64(i));
+    }
+
+    bench::rng r;
+    u64 found = 0;
+    auto const lookup_one = [&] { found += lookup(m, keys[isize(r.next() % u64(n))]); };
+
+    auto const start = bench::now_ns();
+    for (isize i = 0; i < ops; ++i)
+        lookup_one();
+    auto const total = bench::now_ns() - start;
+
+    bench::latency_recorder latency;
+    record_latency(latency, latency_ops_for(ops), lookup_one);
+    bench::do_not_optimize(&found);
+
+    bench::report({.pattern = "string hit",
+                   .resource = name,
+                   .node_size = n,
+                   .ops = ops,
+                   .total_ns = total,
+                   .latency = latency.compute()});
+}
+} // namespace
+
+// =========================================================================================================
+// Benchmarks
+// =========================================================================================================
+
+CC_BENCH("map - lookup")
+{
+    constexpr isize ops = 4'000'000;
+
+    for (isize n : {1 << 10, 1 << 16, 1 << 20})
+    {
+        run_lookup<cc_map_backend>("lookup hit", n, ops, true);
+        run_lookup<std_map_backend>("lookup hit", n, ops, true);
+        run_lookup<flat_map_backend>("lookup hit", n, ops, true);
+        run_lookup<cc_map_backend>("lookup miss", n, ops, false);
+        run_lookup<std_map_backend>("lookup miss", n, ops, false);
+        run_lookup<flat_map_backend>("lookup miss", n, ops, false);
+    }
+}
+
+CC_BENCH("map - insert")
+{
+    run_insert<cc_map_backend>(1 << 10, 1024);
+    run_insert<std_map_backend>(1 << 10, 1024);
+    run_insert<cc_map_backend>(1 << 20, 4);
+    run_insert<std_map_backend>(1 << 20, 4);
+
+    run_insert_remove<cc_map_backend>(1 << 10, 4'000'000);
+    run_insert_remove<std_map_backend>(1 << 10, 4'000'000);
+    run_insert_remove<cc_map_backend>(1 << 20, 4'000'000);
+    run_insert_remove<std_map_backend>(1 << 20, 4'000'000);
+}
+
+CC_BENCH("map - string keys")
+{
+    constexpr isize ops = 4'000'000;
+
+    for (isize n : {1 << 10, 1 << 18})
+    {
+        run_string_hit<cc::map<cc::string, u64>>( //
+            "cc::map", n, ops, [](auto const& m, std::string const& key)
+            { return *m.get_ptr(cc::string_view(key.data(), isize(key.size()))); });
+        run_string_hit<std::unordered_map<std::string, u64>>( //
+            "std::unordered_map", n, ops, [](auto const& m, std::string const& key) { return m.find(key)->second; });
+    }
+}
@@ -0,0 +1,297 @@
+#include "bench.hh"
+
+#include <clean-core/mpmc_queue.hh>
+#include <clean-core/mutex.hh>
+#include <clean-core/optional.hh>
+#include <clean-core/unique_function.hh>
+#include <clean-core/vector.hh>
+
+#include <atomic>
+#include <deque>
+#include <thread>
+
+// =========================================================================================================
+// Multi-producer multi-consumer queues
+// =========================================================================================================
+//
+// Patterns (P producers x C consumers, ns/op is wall time per message):
+//   fan-in 4x1      - four producers, one consumer
+//   fan-out 1x4     - one producer, four consumers
+//   balanced 2x2    - two of each
+//   ... x32         - same, but messages move in batches of up to 32 (one claim per batch)
+//   tasks 1x3       - cc::unique_function<void()> submissions, consumers run them
+//
+// Backends:
+//   cc::mpmc_queue            - lock-free sequence-numbered slots, threads yield when full/empty
+//   cc::blocking_mpmc_queue   - same plus parking (seq_cst fence per operation, futex only with sleepers)
+//   cc::mutex<std::deque>     - std::mutex around a deque, threads yield when empty
+//
+// The size column is the queue capacity. Consumers stop at a sentinel pushed after all producers are done.
+
+using namespace cc::primitive_defines;
+
+namespace
+{
+constexpr isize max_batch = 32;
+constexpr isize capacity = 1024;
+constexpr u64 stop_value = ~u64(0);
+
+struct lock_free_backend
+{
+    static constexpr char const* name = "cc::mpmc_queue";
+
+    template <class T>
+    struct queue_t
+    {
+        cc::mpmc_queue<T> q = cc::mpmc_queue<T>::create_with_capacity(capacity);
+    };
+
+    template <class T>
+    static void push(queue_t<T>& q, T&& v)
+    {
+        while (!q.q.try_push(cc::move(v)))
+            std::this_thread::yield();
+    }
+    template <class T>
+    static void push_batch(queue_t<T>& q, cc::span<T const> v)
+    {
+        while (!v.empty())
+        {
+            auto const n = q.q.try_push_range(v);
+            v = cc::span<T const>(v.data() + n, v.size() - n);
+            if (n == 0)
+                std::this_thread::yield();
+        }
+    }
+    template <class T>
+    static isize pop_batch(queue_t<T>& q, cc::span<T> out)
+    {
+        while (true)
+        {
+            auto const n = q.q.try_pop_to(out);
+            if (n > 0)
+                return n;
+            std::this_thread::yield();
+        }
+    }
+};
+
+struct blocking_backend
+{
+    static constexpr char const* name = "cc::blocking_mpmc_queue";
+
+    template <class T>
+    struct queue_t
+    {
+        cc::blocking_mpmc_queue<T> q = cc::blocking_mpmc_queue<T>::create_with_capacity(capacity);
+    };
+
+    template <class T>
+    static void push(queue_t<T>& q, T&& v)
+    {
+        q.q.push(cc::move(v));
+    }
+    template <class T>
+    static void push_batch(queue_t<T>& q, cc::span<T const> v)
+    {
+        q.q.push_range(v);
+    }
+    template <class T>
+    static isize pop_batch(queue_t<T>& q, cc::span<T> out)
+    {
+        return q.q.pop_to(out);
+    }
+};
+
+struct mutex_deque_backend
+{
+    static constexpr char const* name = "cc::mutex<std::deque>";
+
+    template <class T>
+    struct queue_t
+    {
+        cc::mutex<std::deque<T>> q;
+    };
+
+    template <class T>
+    static void push(queue_t<T>& q, T&& v)
+    {
+        q.q.lock([&](std::deque<T>& d) { d.push_back(cc::move(v)); });
+    }
+    template <class T>
+    static void push_batch(queue_t<T>& q, cc::span<T const> v)
+    {
+        q.q.lock([&](std::deque<T>& d) { d.insert(d.end(), v.data(), v.data() + v.size()); });
+    }
+    template <class T>
+    static isize pop_batch(queue_t<T>& q, cc::span<T> out)
+    {
+        while (true)
+        {
+            auto const n = q.q.lock(
+                [&](std::deque<T>& d)
+                {
+                    auto const count = cc::min(isize(d.size()), out.size());
+                    for (isize i = 0; i < count; ++i)
+                    {
+                        out[i] = cc::move(d.front());
+                        d.pop_front();
+                    }
+                    return count;
+                });
+            if (n > 0)
+                return n;
+            std::this_thread::yield();
+        }
+    }
+};
+
+template <class Backend>
+void run_messages(char const* pattern, int producers, int consumers, isize ops, isize batch)
+{
+    typename Backend::template queue_t<u64> q;
+    std::atomic<u64> total_sum = 0;
+    auto const per_producer = ops / producers;
+
+    auto const start = bench::now_ns();
+    cc::vector<std::thread> threads;
+    for (auto p = 0; p < producers; ++p)
+        threads.push_back(std::thread(
+            [&]
+            {
+                u64 values[max_batch];
+                for (isize i = 0; i < per_producer; i += batch)
+                {
+                    if (batch == 1)
+                        Backend::push(q, u64(i));
+                    else
+                    {
+                        auto const n = cc::min(batch, per_producer - i);
+                        for (isize j = 0; j < n; ++j)
+                            values[j] = u64(i + j);
+                        Backend::push_batch(q, cc::span<u64 const>(values, n));
+                    }
+                }
+            }));
+    for (auto c = 0; c < consumers; ++c)
+        threads.push_back(std::thread(
+            [&]
+            {
+                u64 out[max_batch];
+                u64 sum = 0;
+                while (true)
+                {
+                    auto const n = Backend::pop_batch(q, cc::span<u64>(out, batch));
+                    auto stops = 0;
+                    for (isize j = 0; j < n; ++j)
+                    {
+                        if (out[j] == stop_value)
+                            ++stops;
+                        else
+                            sum += out[j];
+                    }
+                    if (stops > 0)
+                    {
+                        // a batch may grab the sentinels of other consumers
+                        for (auto s = 1; s < stops; ++s)
+                            Backend::push(q, u64(stop_value));
+                        break;
+                    }
+                }
+                total_sum += sum;
+            }));
+
+    for (auto p = 0; p < producers; ++p)
+        threads[p].join();
+    for (auto c = 0; c < consumers; ++c)
+        Backend::push(q, u64(stop_value));
+    for (auto c = 0; c < consumers; ++c)
+        threads[producers + c].join();
+    auto const total = bench::now_ns() - start;
+
+    auto sum = total_sum.load();
+    bench::do_not_optimize(&sum);
+
+    bench::report({.pattern = pattern,
+                   .resource = Backend::name,
+                   .node_size = capacity,
+                   .threads = producers + consumers,
+                   .ops = per_producer * producers,
+                   .total_ns = total});
+}
+
+template <class Backend>
+void run_tasks(isize ops)
+{
+    using task = cc::unique_function<void()>;
+    constexpr int consumers = 3;
+
+    typename Backend::template queue_t<task> q;
+    std::atomic<u64> executed = 0;
+    std::atomic<bool> done = false;
+
+    auto const start = bench::now_ns();
+    cc::vector<std::thread> workers;
+    for (auto c = 0; c < consumers; ++c)
+        workers.push_back(std::thread(
+            [&]
+            {
+                task out[1];
+                while (!done.load(std::memory_order_relaxed))
+                {
+                    Backend::pop_batch(q, cc::span<task>(out, 1));
+                    out[0]();
+                    out[0] = task();
+                }
+            }));
+
+    for (isize i = 0; i < ops; ++i)
+        Backend::push(q, task([&executed] { executed.fetch_add(1, std::memory_order_relaxed); }));
+    // one stop task per worker, each worker runs exactly one
+    for (auto c = 0; c < consumers; ++c)
+        Backend::push(q, task([&done] { done.store(true, std::memory_order_relaxed); }));
+    for (auto& w : workers)
+        w.join();
+    auto const total = bench::now_ns() - start;
+
+    bench::report({.pattern = "tasks 1x3",
+                   .resource = Backend::name,
+                   .node_size = capacity,
+                   .threads = 1 + consumers,
+                   .ops = ops,
+                   .total_ns = total});
+}
+
+template <class Backend>
+void run_all_message_patterns(isize ops)
+{
+    run_messages<Backend>("fan-in 4x1", 4, 1, ops, 1);
+    run_messages<Backend>("fan-out 1x4", 1, 4, ops, 1);
+    run_messages<Backend>("balanced 2x2", 2, 2, ops, 1);
+    run_messages<Backend>("fan-in 4x1 x32", 4, 1, ops, max_batch);
+    run_messages<Backend>("fan-out 1x4 x32", 1, 4, ops, max_batch);
+    run_messages<Backend>("balanced 2x2 x32", 2, 2, ops, max_batch);
+}
+} // namespace
+
+// =========================================================================================================
+// Benchmarks
+// =========================================================================================================
+
+CC_BENCH("mpmc_queue - messages")
+{
+    constexpr isize ops = 4'000'000;
+
+    run_all_message_patterns<lock_free_backend>(ops);
+    run_all_message_patterns<blocking_backend>(ops);
+    run_all_message_patterns<mutex_deque_backend>(ops);
+}
+
+CC_BENCH("mpmc_queue - tasks")
+{
+    constexpr isize ops = 1'000'000;
+
+    run_tasks<lock_free_backend>(ops);
+    run_tasks<blocking_backend>(ops);
+    run_tasks<mutex_deque_backend>(ops);
+}
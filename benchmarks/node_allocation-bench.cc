@@ -0,0 +1,526 @@
+#include "bench.hh"
+
+#include <clean-core/allocation.hh>
+#include <clean-core/array.hh>
+#include <clean-core/node_allocation.hh>
+#include <clean-core/node_arena.hh>
+
+#include <condition_variable>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+
+// =========================================================================================================
+// Node allocation throughput and tail latency
+// =========================================================================================================
+//
+// Patterns:
+//   churn           - alloc/free on one thread with a fixed working set (steady state, slab ring reuse)
+//   alloc burst     - alloc-only bursts (refill path), followed by freeing everything
+//   producer/consumer - one thread allocates, another one frees (remote frees)
+//   fan-in          - many threads allocate, one thread frees everything
+//   mixed sizes     - churn with random node sizes across small classes
+//
+// Backends:
+//   node_allocator  - thread-local allocator of cc::default_node_memory_resource
+//   node_arena      - cc::node_arena (one arena per allocating thread)
+//   memory_resource - cc::default_memory_resource (allocate_bytes/deallocate_bytes)
+//   malloc          - std::malloc/std::free
+
+using namespace cc::primitive_defines;
+
+namespace
+{
+template <isize Size>
+struct alignas(Size >= 8 ? 8 : Size) payload
+{
+    cc::byte data[Size];
+};
+
+// each backend provides a per-thread context with allocate<T>() and free<T>(ptr)
+// frees may happen on any thread, allocations only on the thread owning the context
+
+struct node_backend
+{
+    static constexpr char const* name = "node_allocator";
+
+    struct context
+    {
+        cc::node_allocator* alloc = &cc::default_node_allocator();
+
+        template <class T>
+        CC_FORCE_INLINE cc::byte* allocate()
+        {
+            return alloc->allocate_node_bytes(cc::node_class_index_for<T>(), sizeof(T), alignof(T));
+        }
+
+        template <class T>
+        static CC_FORCE_INLINE void free(cc::byte* p)
+        {
+            cc::node_allocation_free(p, cc::node_class_index_for<T>());
+        }
+
+        // contexts may be created on a different thread than they are used on
+        void bind_to_current_thread() { alloc = &cc::default_node_allocator(); }
+    };
+};
+
+struct arena_backend
+{
+    static constexpr char const* name = "node_arena";
+
+    struct context
+    {
+        cc::node_arena arena;
+
+        template <class T>
+        CC_FORCE_INLINE cc::byte* allocate()
+        {
+            return arena.allocator().allocate_node_bytes(cc::node_class_index_for<T>(), sizeof(T), alignof(T));
+        }
+
+        template <class T>
+        static CC_FORCE_INLINE void free(cc::byte* p)
+        {
+            cc::node_allocation_free(p, cc::node_class_index_for<T>());
+        }
+
+        void bind_to_current_thread() {}
+    };
+};
+
+struct memory_resource_backend
+{
+    static constexpr char const* name = "memory_resource";
+
+    struct context
+    {
+        template <class T>
+        CC_FORCE_INLINE cc::byte* allocate()
+        {
+            auto const res = cc::default_memory_resource;
+            cc::byte* p = nullptr;
+            res->allocate_bytes(&p, sizeof(T), sizeof(T), alignof(T), res->userdata);
+            return p;
+        }
+
+        template <class T>
+        static CC_FORCE_INLINE void free(cc::byte* p)
+        {
+            auto const res = cc::default_memory_resource;
+            res->deallocate_bytes(p, sizeof(T), alignof(T), res->userdata);
+        }
+
+        void bind_to_current_thread() {}
+    };
+};
+
+struct malloc_backend
+{
+    static constexpr char const* name = "malloc";
+
+    struct context
+    {
+        template <class T>
+        CC_FORCE_INLINE cc::byte* allocate()
+        {
+            return static_cast<cc::byte*>(std::malloc(sizeof(T)));
+        }
+
+        template <class T>
+        static CC_FORCE_INLINE void free(cc::byte* p)
+        {
+            std::free(p);
+        }
+
+        void bind_to_current_thread() {}
+    };
+};
+
+// touches the node like a real user would (and keeps the allocation from being optimized away)
+CC_FORCE_INLINE void touch(cc::byte* p)
+{
+    *p = cc::byte(1);
+    bench::do_not_optimize(p);
+}
+
+// bounded multi-producer single-consumer handoff of pointer batches
+struct batch_handoff
+{
+    static constexpr isize batch_size = 256;
+    static constexpr isize max_pending_batches = 64;
+
+    explicit batch_handoff(isize producer_count) : _open_producers(producer_count) {}
+
+    void push(cc::vector<cc::byte*> batch)
+    {
+        std::unique_lock lock(_mutex);
+        _not_full.wait(lock, [&] { return _batches.size() < max_pending_batches; });
+        _batches.push_back(cc::move(batch));
+        _not_empty.notify_one();
+    }
+
+    void close_producer()
+    {
+        std::lock_guard lock(_mutex);
+        --_open_producers;
+        _not_empty.notify_one();
+    }
+
+    /// returns false once all producers are closed and no batches are left
+    bool pop(cc::vector<cc::byte*>& out)
+    {
+        std::unique_lock lock(_mutex);
+        _not_empty.wait(lock, [&] { return !_batches.empty() || _open_producers == 0; });
+        if (_batches.empty())
+            return false;
+
+        out = _batches.pop_at(0);
+        _not_full.notify_all();
+        return true;
+    }
+
+private:
+    std::mutex _mutex;
+    std::condition_variable _not_empty;
+    std::condition_variable _not_full;
+    cc::vector<cc::vector<cc::byte*>> _batches;
+    isize _open_producers = 0;
+};
+
+// =========================================================================================================
+// Patterns
+// =========================================================================================================
+
+template <class Backend, isize Size>
+void run_churn(isize op_count, isize working_set)
+{
+    using node_t = payload<Size>;
+    typename Backend::context ctx;
+
+    cc::vector<cc::byte*> live;
+    for (isize i = 0; i < working_set; ++i)
+        live.push_back(ctx.template allocate<node_t>());
+
+    bench::latency_recorder latency;
+    auto const rss_before = bench::current_rss_bytes();
+    auto const start = bench::now_ns();
+
+    for (isize i = 0; i < op_count; i += bench::latency_batch_size)
+    {
+        auto const batch_start = bench::now_ns();
+        for (isize j = 0; j < bench::latency_batch_size; ++j)
+        {
+            auto& slot = live[(i + j) % working_set];
+            ctx.template free<node_t>(slot);
+            slot = ctx.template allocate<node_t>();
+            touch(slot);
+        }
+        latency.add_batch(bench::now_ns() - batch_start, bench::latency_batch_size);
+    }
+
+    auto const total = bench::now_ns() - start;
+    auto const rss_after = bench::current_rss_bytes();
+
+    for (auto p : live)
+        ctx.template free<node_t>(p);
+
+    bench::report({.pattern = "churn",
+                   .resource = Backend::name,
+                   .node_size = Size,
+                   .ops = op_count,
+                   .total_ns = total,
+                   .latency = latency.compute(),
+                   .rss_growth_bytes = rss_after - rss_before});
+}
+
+template <class Backend, isize Size>
+void run_alloc_burst(isize node_count)
+{
+    using node_t = payload<Size>;
+    typename Backend::context ctx;
+
+    cc::vector<cc::byte*> nodes;
+    nodes.reserve(node_count);
+
+    // alloc phase
+    bench::latency_recorder alloc_latency;
+    auto const rss_before = bench::current_rss_bytes();
+    auto const alloc_start = bench::now_ns();
+    for (isize i = 0; i < node_count; i += bench::latency_batch_size)
+    {
+        auto const batch_start = bench::now_ns();
+        for (isize j = 0; j < bench::latency_batch_size; ++j)
+        {
+            auto const p = ctx.template allocate<node_t>();
+            touch(p);
+            nodes.push_back_stable(p);
+        }
+        alloc_latency.add_batch(bench::now_ns() - batch_start, bench::latency_batch_size);
+    }
+    auto const alloc_total = bench::now_ns() - alloc_start;
+    auto const rss_after = bench::current_rss_bytes();
+
+    // free phase
+    bench::latency_recorder free_latency;
+    auto const free_start = bench::now_ns();
+    for (isize i = 0; i < node_count; i += bench::latency_batch_size)
+    {
+        auto const batch_start = bench::now_ns();
+        for (isize j = 0; j < bench::latency_batch_size; ++j)
+            ctx.template free<node_t>(nodes[i + j]);
+        free_latency.add_batch(bench::now_ns() - batch_start, bench::latency_batch_size);
+    }
+    auto const free_total = bench::now_ns() - free_start;
+
+    bench::report({.pattern = "alloc burst",
+                   .resource = Backend::name,
+                   .node_size = Size,
+                   .ops = node_count,
+                   .total_ns = alloc_total,
+                   .latency = alloc_latency.compute(),
+                   .rss_growth_bytes = rss_after - rss_before});
+    bench::report({.pattern = "free burst",
+                   .resource = Backend::name,
+                   .node_size = Size,
+                   .ops = node_count,
+                   .total_ns = free_total,
+                   .latency = free_latency.compute()});
+}
+
+// producer_count threads allocate, one consumer thread frees everything
+// producer latency is the allocation latency under concurrent remote frees
+template <class Backend, isize Size>
+void run_remote_free(char const* pattern, isize producer_count, isize ops_per_producer)
+{
+    using node_t = payload<Size>;
+
+    batch_handoff handoff(producer_count);
+    // contexts outlive all threads, arenas must only be reset after the consumer freed everything
+    auto contexts = cc::array<typename Backend::context>::create_defaulted(producer_count);
+    cc::vector<bench::latency_recorder> latencies;
+    latencies.resize_to_defaulted(producer_count);
+
+    auto const rss_before = bench::current_rss_bytes();
+    auto const start = bench::now_ns();
+
+    std::thread consumer(
+        [&]
+        {
+            cc::vector<cc::byte*> batch;
+            while (handoff.pop(batch))
+                for (auto p : batch)
+                    Backend::context::template free<node_t>(p);
+        });
+
+    cc::vector<std::thread> producers;
+    for (isize t = 0; t < producer_count; ++t)
+        producers.push_back(std::thread(
+            [&, t]
+            {
+                auto& ctx = contexts[t];
+                auto& latency = latencies[t];
+                ctx.bind_to_current_thread();
+
+                cc::vector<cc::byte*> batch;
+                for (isize i = 0; i < ops_per_producer; i += bench::latency_batch_size)
+                {
+                    auto const batch_start = bench::now_ns();
+                    for (isize j = 0; j < bench::latency_batch_size; ++j)
+                    {
+                        auto const p = ctx.template allocate<node_t>();
+                        touch(p);
+                        batch.push_back(p);
+                    }
+                    latency.add_batch(bench::now_ns() - batch_start, bench::latency_batch_size);
+
+                    if (batch.size() >= batch_handoff::batch_size)
+                        handoff.push(cc::exchange(batch, {}));
+                }
+
+                if (!batch.empty())
+                    handoff.push(cc::move(batch));
+                handoff.close_producer();
+            }));
+
+    for (auto& p : producers)
+        p.join();
+    consumer.join();
+
+    auto const total = bench::now_ns() - start;
+    auto const rss_after = bench::current_rss_bytes();
+
+    bench::latency_recorder latency;
+    for (auto const& l : latencies)
+        latency.append(l);
+
+    bench::report({.pattern = pattern,
+                   .resource = Backend::name,
+                   .node_size = Size,
+                   .threads = producer_count + 1,
+                   .ops = producer_count * ops_per_producer,
+                   .total_ns = total,
+                   .latency = latency.compute(),
+                   .rss_growth_bytes = rss_after - rss_before});
+}
+
+template <class Backend>
+void run_mixed_sizes(isize op_count, isize working_set)
+{
+    typename Backend::context ctx;
+
+    // runtime size class selection, similar to a heterogeneous node-based container workload
+    auto const allocate = [&](u64 kind) -> cc::byte*
+    {
+        switch (kind)
+        {
+        case 0: return ctx.template allocate<payload<8>>();
+        case 1: return ctx.template allocate<payload<16>>();
+        case 2: return ctx.template allocate<payload<24>>();
+        case 3: return ctx.template allocate<payload<48>>();
+        case 4: return ctx.template allocate<payload<64>>();
+        case 5: return ctx.template allocate<payload<136>>();
+        default: return ctx.template allocate<payload<256>>();
+        }
+    };
+    auto const free = [&](cc::byte* p, u64 kind)
+    {
+        switch (kind)
+        {
+        case 0: return Backend::context::template free<payload<8>>(p);
+        case 1: return Backend::context::template free<payload<16>>(p);
+        case 2: return Backend::context::template free<payload<24>>(p);
+        case 3: return Backend::context::template free<payload<48>>(p);
+        case 4: return Backend::context::template free<payload<64>>(p);
+        case 5: return Backend::context::template free<payload<136>>(p);
+        default: return Backend::context::template free<payload<256>>(p);
+        }
+    };
+    constexpr u64 kind_count = 7;
+
+    struct live_node
+    {
+        cc::byte* ptr;
+        u64 kind;
+    };
+
+    bench::rng r;
+    cc::vector<live_node> live;
+    for (isize i = 0; i < working_set; ++i)
+    {
+        auto const kind = r.next() % kind_count;
+        live.push_back({allocate(kind), kind});
+    }
+
+    bench::latency_recorder latency;
+    auto const rss_before = bench::current_rss_bytes();
+    auto const start = bench::now_ns();
+
+    for (isize i = 0; i < op_count; i += bench::latency_batch_size)
+    {
+        auto const batch_start = bench::now_ns();
+        for (isize j = 0; j < bench::latency_batch_size; ++j)
+        {
+            auto const rnd = r.next();
+            auto& n = live[isize(rnd % u64(working_set))];
+            free(n.ptr, n.kind);
+            n.kind = (rnd >> 32) % kind_count;
+            n.ptr = allocate(n.kind);
+            touch(n.ptr);
+        }
+        latency.add_batch(bench::now_ns() - batch_start, bench::latency_batch_size);
+    }
+
+    auto const total = bench::now_ns() - start;
+    auto const rss_after = bench::current_rss_bytes();
+
+    for (auto const& n : live)
+        free(n.ptr, n.kind);
+
+    bench::report({.pattern = "mixed sizes",
+                   .resource = Backend::name,
+                   .node_size = 0,
+                   .ops = op_count,
+                   .total_ns = total,
+                   .latency = latency.compute(),
+                   .rss_growth_bytes = rss_after - rss_before});
+}
+
+isize fan_in_producer_count()
+{
+    auto const hw = isize(std::thread::hardware_concurrency());
+    return cc::clamp(hw - 1, isize(2), isize(8));
+}
+} // namespace
+
+// =========================================================================================================
+// Benchmarks
+// =========================================================================================================
+
+CC_BENCH("node_allocation - churn")
+{
+    constexpr isize ops = 4'000'000;
+    constexpr isize working_set = 1024;
+
+    run_churn<node_backend, 16>(ops, working_set);
+    run_churn<arena_backend, 16>(ops, working_set);
+    run_churn<memory_resource_backend, 16>(ops, working_set);
+    run_churn<malloc_backend, 16>(ops, working_set);
+
+    run_churn<node_backend, 24>(ops, working_set);
+    run_churn<malloc_backend, 24>(ops, working_set);
+
+    run_churn<node_backend, 64>(ops, working_set);
+    run_churn<arena_backend, 64>(ops, working_set);
+    run_churn<memory_resource_backend, 64>(ops, working_set);
+    run_churn<malloc_backend, 64>(ops, working_set);
+
+    run_churn<node_backend, 256>(ops, working_set);
+    run_churn<malloc_backend, 256>(ops, working_set);
+}
+
+CC_BENCH("node_allocation - alloc burst")
+{
+    constexpr isize nodes = 1 << 20;
+
+    run_alloc_burst<node_backend, 16>(nodes);
+    run_alloc_burst<arena_backend, 16>(nodes);
+    run_alloc_burst<memory_resource_backend, 16>(nodes);
+    run_alloc_burst<malloc_backend, 16>(nodes);
+
+    run_alloc_burst<node_backend, 136>(nodes);
+    run_alloc_burst<arena_backend, 136>(nodes);
+    run_alloc_burst<malloc_backend, 136>(nodes);
+}
+
+CC_BENCH("node_allocation - producer/consumer")
+{
+    constexpr isize ops = 2'000'000;
+
+    run_remote_free<node_backend, 32>("producer/consumer", 1, ops);
+    run_remote_free<arena_backend, 32>("producer/consumer", 1, ops);
+    run_remote_free<memory_resource_backend, 32>("producer/consumer", 1, ops);
+    run_remote_free<malloc_backend, 32>("producer/consumer", 1, ops);
+}
+
+CC_BENCH("node_allocation - fan-in")
+{
+    auto const producers = fan_in_producer_count();
+    auto const ops = 4'000'000 / producers;
+
+    run_remote_free<node_backend, 32>("fan-in", producers, ops);
+    run_remote_free<arena_backend, 32>("fan-in", producers, ops);
+    run_remote_free<memory_resource_backend, 32>("fan-in", producers, ops);
+    run_remote_free<malloc_backend, 32>("fan-in", producers, ops);
+}
+
+CC_BENCH("node_allocation - mixed sizes")
+{
+    constexpr isize ops = 4'000'000;
+    constexpr isize working_set = 4096;
+
+    run_mixed_sizes<node_backend>(ops, working_set);
+    run_mixed_sizes<arena_backend>(ops, working_set);
+    run_mixed_sizes<memory_resource_backend>(ops, working_set);
+    run_mixed_sizes<malloc_backend>(ops, working_set);
+}
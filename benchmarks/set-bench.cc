@@ -0,0 +1,101 @@
+#include "bench.hh"
+
+#include <clean-core/set.hh>
+
+#include <unordered_set>
+
+// =========================================================================================================
+// Hash set membership tests
+// =========================================================================================================
+//
+// Patterns:
+//   contains        - one contains() call per key
+//   contains_each   - batched probing with prefetching over the whole key span
+//
+// Backends:
+//   cc::set             - Swiss-table open addressing
+//   std::unordered_set  - node-based chaining (contains only)
+//
+// Keys are half hits, half misses in random order. The size column is the number of elements in the set.
+
+using namespace cc::primitive_defines;
+
+namespace
+{
+constexpr isize key_count = 1 << 16;
+
+CC_FORCE_INLINE u64 element_of(u64 i) { return i * 0x9E3779B97F4A7C15ull; }
+
+cc::vector<u64> make_keys(isize n)
+{
+    bench::rng r;
+    cc::vector<u64> keys;
+    for (isize i = 0; i < key_count; ++i)
+        keys.push_back(element_of(r.next() % u64(2 * n))); // elements are element_of(0..n-1)
+    return keys;
+}
+
+template <class F>
+void run(char const* pattern, char const* resource, isize n, isize rounds, F&& probe_all)
+{
+    bench::latency_recorder latency;
+    auto const start = bench::now_ns();
+
+    for (isize round = 0; round < rounds; ++round)
+    {
+        auto const batch_start = bench::now_ns();
+        probe_all();
+        latency.add_batch(bench::now_ns() - batch_start, key_count);
+    }
+
+    auto const total = bench::now_ns() - start;
+    bench::report({.pattern = pattern,
+                   .resource = resource,
+                   .node_size = n,
+                   .ops = key_count * rounds,
+                   .total_ns = total,
+                   .latency = latency.compute()});
+}
+} // namespace
+
+CC_BENCH("set - membership")
+{
+    constexpr isize rounds = 64;
+
+    for (isize n : {1 << 10, 1 << 16, 1 << 22})
+    {
+        auto const keys = make_keys(n);
+
+        cc::set<u64> s;
+        std::unordered_set<u64> ref;
+        for (isize i = 0; i < n; ++i)
+        {
+            s.insert(element_of(u64(i)));
+            ref.insert(element_of(u64(i)));
+        }
+
+        isize found = 0;
+        auto flags = cc::vector<bool>::create_defaulted(key_count);
+
+        run("contains", "cc::set", n, rounds,
+            [&]
+            {
+                for (auto k : keys)
+                    found += s.contains(k);
+            });
+        run("contains_each", "cc::set", n, rounds,
+            [&]
+            {
+                s.contains_each(keys, flags);
+                bench::do_not_optimize(flags.data());
+            });
+        run("contains", "std::unordered_set", n, rounds,
+            [&]
+            {
+                for (auto k : keys)
+                    found += ref.contains(k);
+            });
+
+        bench::do_not_optimize(&found);
+    }
+}
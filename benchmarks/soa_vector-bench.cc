@@ -0,0 +1,173 @@
+#include "bench.hh"
+
+#include <clean-core/soa_vector.hh>
+#include <clean-core/vector.hh>
+
+// =========================================================================================================
+// Structure of arrays vs array of structs
+// =========================================================================================================
+//
+// Particles with position (3 floats), velocity (3 floats), lifetime (float) and id (u64), 40 bytes per particle.
+//
+// Patterns (ns/op is wall time per particle):
+//   age scan      - lifetime -= dt, touches one field (4 of 40 bytes)
+//   integrate     - position += velocity * dt, touches six floats
+//   remove dead   - remove_all_where on lifetime, then refill to the original count
+//
+// The size column is the particle count.
+// The AoS variant is a cc::vector<particle>, the SoA variant a cc::soa_vector with one column per field.
+
+using namespace cc::primitive_defines;
+
+namespace
+{
+constexpr isize total_ops = 50'000'000;
+
+struct vec3
+{
+    f32 x, y, z;
+};
+
+struct particle
+{
+    vec3 pos;
+    vec3 vel;
+    f32 life;
+    u64 id;
+};
+
+using particle_soa = cc::soa_vector<vec3, vec3, f32, u64>;
+
+void report(char const* pattern, char const* container, isize size, isize ops, i64 total_ns)
+{
+    bench::report({.pattern = pattern,
+                   .resource = container,
+                   .node_size = size,
+                   .threads = 1,
+                   .ops = ops,
+                   .total_ns = total_ns});
+}
+
+particle make_particle(u64 i)
+{
+    auto const f = f32(i % 1000);
+    return {{f, f, f}, {1.f, 2.f, 3.f}, f32(i % 97), i};
+}
+
+void run_aos(isize n)
+{
+    cc::vector<particle> ps;
+    for (isize i = 0; i < n; ++i)
+        ps.push_back(make_particle(u64(i)));
+    auto const reps = cc::max(isize(1), total_ops / n);
+
+    {
+        auto start = bench::now_ns();
+        for (isize r = 0; r < reps; ++r)
+        {
+            for (auto& p : ps)
+                p.life -= 0.01f;
+            bench::do_not_optimize(ps.data());
+        }
+        report("age scan", "AoS cc::vector", n, n * reps, bench::now_ns() - start);
+    }
+    {
+        auto start = bench::now_ns();
+        for (isize r = 0; r < reps; ++r)
+        {
+            for (auto& p : ps)
+            {
+                p.pos.x += p.vel.x * 0.01f;
+                p.pos.y += p.vel.y * 0.01f;
+                p.pos.z += p.vel.z * 0.01f;
+            }
+            bench::do_not_optimize(ps.data());
+        }
+        report("integrate", "AoS cc::vector", n, n * reps, bench::now_ns() - start);
+    }
+    {
+        auto const rm_reps = cc::max(isize(1), reps / 10);
+        u64 next_id = u64(n);
+        auto start = bench::now_ns();
+        for (isize r = 0; r < rm_reps; ++r)
+        {
+            ps.remove_all_where([](particle const& p) { return p.life < 5.f; });
+            while (ps.size() < n)
+                ps.push_back(make_particle(next_id++));
+            for (auto& p : ps)
+                p.life -= 5.f;
+        }
+        report("remove dead", "AoS cc::vector", n, n * rm_reps, bench::now_ns() - start);
+        bench::do_not_optimize(ps.data());
+    }
+}
+
+void run_soa(isize n)
+{
+    particle_soa ps;
+    for (isize i = 0; i < n; ++i)
+    {
+        auto const p = make_particle(u64(i));
+        ps.push_back(p.pos, p.vel, p.life, p.id);
+    }
+    auto const reps = cc::max(isize(1), total_ops / n);
+
+    {
+        auto start = bench::now_ns();
+        for (isize r = 0; r < reps; ++r)
+        {
+            for (auto& life : ps.column<2>())
+                life -= 0.01f;
+            bench::do_not_optimize(ps.column<2>().data());
+        }
+        report("age scan", "SoA cc::soa_vector", n, n * reps, bench::now_ns() - start);
+    }
+    {
+        auto start = bench::now_ns();
+        for (isize r = 0; r < reps; ++r)
+        {
+            auto const pos = ps.column<0>();
+            auto const vel = ps.column<1>();
+            for (isize i = 0; i < n; ++i)
+            {
+                pos[i].x += vel[i].x * 0.01f;
+                pos[i].y += vel[i].y * 0.01f;
+                pos[i].z += vel[i].z * 0.01f;
+            }
+            bench::do_not_optimize(pos.data());
+        }
+        report("integrate", "SoA cc::soa_vector", n, n * reps, bench::now_ns() - start);
+    }
+    {
+        auto const rm_reps = cc::max(isize(1), reps / 10);
+        u64 next_id = u64(n);
+        auto start = bench::now_ns();
+        for (isize r = 0; r < rm_reps; ++r)
+        {
+            ps.remove_all_where([](vec3 const&, vec3 const&, f32 life, u64) { return life < 5.f; });
+            while (ps.size() < n)
+            {
+                auto const p = make_particle(next_id++);
+                ps.push_back(p.pos, p.vel, p.life, p.id);
+            }
+            for (auto& life : ps.column<2>())
+                life -= 5.f;
+        }
+        report("remove dead", "SoA cc::soa_vector", n, n * rm_reps, bench::now_ns() - start);
+        bench::do_not_optimize(ps.column<2>().data());
+    }
+}
+} // namespace
+
+// =========================================================================================================
+// Benchmarks
+// =========================================================================================================
+
+CC_BENCH("soa_vector - particle kernels")
+{
+    for (isize size : {isize(10'000), isize(1'000'000), isize(10'000'000)})
+    {
+        run_aos(size);
+        run_soa(size);
+    }
+}
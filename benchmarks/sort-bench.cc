@@ -0,0 +1,116 @@
+#include "bench.hh"
+
+#include <clean-core/sort.hh>
+#include <clean-core/vector.hh>
+
+#include <algorithm>
+#include <random>
+
+// =========================================================================================================
+// Sorting
+// =========================================================================================================
+//
+// Patterns (ns/op is wall time per sorted element, including copying the input):
+//   u32 random      - uniformly random 32 bit keys
+//   u64 random      - uniformly random 64 bit keys
+//   u64 < 2^16      - 64 bit keys with small values (radix sort skips the upper digits)
+//   f32 random      - random floats in [-1000, 1000)
+//   u32 few unique  - random keys from 16 distinct values
+//   u32 sorted+noise- sorted keys with every 100th element random
+//   16B by key      - 16 byte records sorted by a u32 member (stable sorts keep the record order)
+//
+// The size column is the element count, each sort runs repeatedly on a fresh copy of the same input.
+
+using namespace cc::primitive_defines;
+
+namespace
+{
+constexpr isize total_ops = 20'000'000;
+
+struct record
+{
+    u32 key;
+    u32 payload[3];
+};
+
+void report(char const* pattern, char const* algorithm, isize size, isize ops, i64 total_ns)
+{
+    bench::report({.pattern = pattern,
+                   .resource = algorithm,
+                   .node_size = size,
+                   .threads = 1,
+                   .ops = ops,
+                   .total_ns = total_ns});
+}
+
+template <class T, class SortF>
+void run(char const* pattern, char const* algorithm, cc::vector<T> const& input, SortF&& sort_f)
+{
+    auto const n = input.size();
+    auto const reps = cc::max(isize(1), total_ops / n);
+    auto v = input;
+    auto start = bench::now_ns();
+    for (isize r = 0; r < reps; ++r)
+    {
+        v = input;
+        sort_f(v);
+        bench::do_not_optimize(v.data());
+    }
+    report(pattern, algorithm, n, n * reps, bench::now_ns() - start);
+}
+
+template <class T>
+void run_unstable(char const* pattern, cc::vector<T> const& input)
+{
+    run(pattern, "std::sort", input, [](cc::vector<T>& v) { std::sort(v.begin(), v.end()); });
+    run(pattern, "cc::sort", input, [](cc::vector<T>& v) { cc::sort(v); });
+    run(pattern, "cc::radix_sort", input, [](cc::vector<T>& v) { cc::radix_sort(v); });
+}
+
+template <class Gen>
+cc::vector<decltype(std::declval<Gen&>()(isize()))> make_input(isize n, Gen&& gen)
+{
+    cc::vector<decltype(gen(isize()))> v;
+    for (isize i = 0; i < n; ++i)
+        v.push_back(gen(i));
+    return v;
+}
+} // namespace
+
+// =========================================================================================================
+// Benchmarks
+// =========================================================================================================
+
+CC_BENCH("sort - unstable and radix")
+{
+    std::mt19937_64 rng(42);
+    for (isize n : {isize(16), isize(1000), isize(100'000), isize(10'000'000)})
+    {
+        run_unstable("u32 random", make_input(n, [&](isize) { return u32(rng()); }));
+        run_unstable("u64 random", make_input(n, [&](isize) { return u64(rng()); }));
+        run_unstable("u64 < 2^16", make_input(n, [&](isize) { return u64(rng() % 65536); }));
+        run_unstable("f32 random",
+                     make_input(n, [&](isize) { return f32(i64(rng() % 2'000'000) - 1'000'000) * 0.001f; }));
+        run_unstable("u32 few unique", make_input(n, [&](isize) { return u32(rng() % 16); }));
+        run_unstable("u32 sorted+noise", make_input(n, [&](isize i) { return i % 100 == 0 ? u32(rng()) : u32(i); }));
+    }
+}
+
+CC_BENCH("sort - records by key")
+{
+    std::mt19937_64 rng(43);
+    for (isize n : {isize(1000), isize(100'000), isize(10'000'000)})
+    {
+        auto const input = make_input(n, [&](isize i) { return record{u32(rng()), {u32(i), 0, 0}}; });
+        auto const by_key = [](record const& a, record const& b) { return a.key < b.key; };
+
+        run("16B by key", "std::sort", input, [&](cc::vector<record>& v) { std::sort(v.begin(), v.end(), by_key); });
+        run("16B by key", "cc::sort_by_key", input,
+            [](cc::vector<record>& v) { cc::sort_by_key(v, [](record const& r) { return r.key; }); });
+        run("16B by key", "std::stable_sort", input,
+            [&](cc::vector<record>& v) { std::stable_sort(v.begin(), v.end(), by_key); });
+        run("16B by key", "cc::stable_sort", input, [&](cc::vector<record>& v) { cc::stable_sort(v, by_key); });
+        run("16B by key", "cc::radix_sort_by_key", input,
+            [](cc::vector<record>& v) { cc::radix_sort_by_key(v, [](record const& r) { return r.key; }); });
+    }
+}
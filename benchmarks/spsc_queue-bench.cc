@@ -0,0 +1,212 @@
+#include "bench.hh"
+
+#include <clean-core/mutex.hh>
+#include <clean-core/optional.hh>
+#include <clean-core/spsc_queue.hh>
+
+#include <deque>
+#include <thread>
+
+// =========================================================================================================
+// Single-producer single-consumer queues
+// =========================================================================================================
+//
+// Patterns:
+//   throughput      - one thread pushes ops u64 values, another pops them, ns/op is wall time per message
+//   throughput x64  - same, but messages move in batches of 64 (one index publication per batch)
+//   round-trip      - ping-pong over two queues, latency columns are per round trip (not per op batch)
+//
+// Backends:
+//   cc::spsc_queue            - lock-free ring, spin/yield/futex blocking push/pop
+//   cc::mutex<std::deque>     - the previous approach, std::mutex around a deque (yields on empty)
+//
+// The size column is the queue capacity. Results depend heavily on core placement (same core complex or not).
+
+using namespace cc::primitive_defines;
+
+namespace
+{
+constexpr isize batch = 64;
+
+struct spsc_backend
+{
+    static constexpr char const* name = "cc::spsc_queue";
+
+    struct queue_t
+    {
+        cc::spsc_queue<u64> q = cc::spsc_queue<u64>::create_with_capacity(1024);
+    };
+
+    static void push(queue_t& q, u64 v) { q.q.push(v); }
+    static u64 pop(queue_t& q) { return q.q.pop(); }
+    static void push_batch(queue_t& q, u64 const* v) { q.q.push_range(cc::span<u64 const>(v, batch)); }
+    static isize pop_batch(queue_t& q, u64* out) { return q.q.pop_to(cc::span<u64>(out, batch)); }
+};
+
+struct mutex_deque_backend
+{
+    static constexpr char const* name = "cc::mutex<std::deque>";
+
+    struct queue_t
+    {
+        cc::mutex<std::deque<u64>> q;
+    };
+
+    static void push(queue_t& q, u64 v)
+    {
+        q.q.lock([&](std::deque<u64>& d) { d.push_back(v); });
+    }
+    static u64 pop(queue_t& q)
+    {
+        while (true)
+        {
+            auto const v = q.q.lock(
+                [](std::deque<u64>& d) -> cc::optional<u64>
+                {
+                    if (d.empty())
+                        return cc::nullopt;
+                    auto const r = d.front();
+                    d.pop_front();
+                    return r;
+                });
+            if (v.has_value())
+                return v.value();
+            std::this_thread::yield();
+        }
+    }
+    static void push_batch(queue_t& q, u64 const* v)
+    {
+        q.q.lock([&](std::deque<u64>& d) { d.insert(d.end(), v, v + batch); });
+    }
+    static isize pop_batch(queue_t& q, u64* out)
+    {
+        while (true)
+        {
+            auto const n = q.q.lock(
+                [&](std::deque<u64>& d)
+                {
+                    auto const count = cc::min(isize(d.size()), batch);
+                    for (isize i = 0; i < count; ++i)
+                    {
+                        out[i] = d.front();
+                        d.pop_front();
+                    }
+                    return count;
+                });
+            if (n > 0)
+                return n;
+            std::this_thread::yield();
+        }
+    }
+};
+
+template <class Backend>
+void run_throughput(isize ops, bool batched)
+{
+    typename Backend::queue_t q;
+    u64 sum = 0;
+
+    auto const start = bench::now_ns();
+    std::thread producer(
+        [&]
+        {
+            u64 values[batch];
+            for (isize i = 0; i < ops; i += batched ? batch : 1)
+            {
+                if (batched)
+                {
+                    for (isize j = 0; j < batch; ++j)
+                        values[j] = u64(i + j);
+                    Backend::push_batch(q, values);
+                }
+                else
+                    Backend::push(q, u64(i));
+            }
+        });
+
+    u64 out[batch];
+    for (isize received = 0; received < ops;)
+    {
+        if (batched)
+        {
+            auto const n = Backend::pop_batch(q, out);
+            for (isize j = 0; j < n; ++j)
+                sum += out[j];
+            received += n;
+        }
+        else
+        {
+            sum += Backend::pop(q);
+            ++received;
+        }
+    }
+    producer.join();
+    auto const total = bench::now_ns() - start;
+    bench::do_not_optimize(&sum);
+
+    bench::report({.pattern = batched ? "throughput x64" : "throughput",
+                   .resource = Backend::name,
+                   .node_size = 1024,
+                   .threads = 2,
+                   .ops = ops,
+                   .total_ns = total});
+}
+
+template <class Backend>
+void run_round_trip(isize ops)
+{
+    typename Backend::queue_t ping;
+    typename Backend::queue_t pong;
+
+    std::thread echo(
+        [&]
+        {
+            for (isize i = 0; i < ops; ++i)
+                Backend::push(pong, Backend::pop(ping) + 1);
+        });
+
+    bench::latency_recorder latency;
+    u64 sum = 0;
+    auto const start = bench::now_ns();
+    for (isize i = 0; i < ops; ++i)
+    {
+        auto const t = bench::now_ns();
+        Backend::push(ping, u64(i));
+        sum += Backend::pop(pong);
+        latency.add_batch(bench::now_ns() - t, 1);
+    }
+    auto const total = bench::now_ns() - start;
+    echo.join();
+    bench::do_not_optimize(&sum);
+
+    bench::report({.pattern = "round-trip",
+                   .resource = Backend::name,
+                   .node_size = 1024,
+                   .threads = 2,
+                   .ops = ops,
+                   .total_ns = total,
+                   .latency = latency.compute()});
+}
+} // namespace
+
+// =========================================================================================================
+// Benchmarks
+// =========================================================================================================
+
+CC_BENCH("spsc_queue - throughput")
+{
+    constexpr isize ops = 20'000'000;
+
+    run_throughput<spsc_backend>(ops, false);
+    run_throughput<mutex_deque_backend>(ops / 4, false);
+    run_throughput<spsc_backend>(ops, true);
+    run_throughput<mutex_deque_backend>(ops, true);
+}
+
+CC_BENCH("spsc_queue - round-trip")
+{
+    constexpr isize ops = 200'000;
+
+    run_round_trip<spsc_backend>(ops);
+    run_round_trip<mutex_deque_backend>(ops);
+}
@@ -0,0 +1,76 @@
+#include "atomic_wait.hh"
+
+#if defined(CC_OS_LINUX)
+#include <linux/futex.h>
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <climits>
+#elif defined(CC_OS_WINDOWS)
+#include <Windows.h>
+
+#pragma comment(lib, "Synchronization.lib")
+#else
+#include <thread>
+#endif
+
+static_assert(sizeof(std::atomic<cc::u32>) == sizeof(cc::u32),
+              "atomic words must be plain 32 bit integers for the OS wait primitives");
+
+#if defined(CC_OS_LINUX)
+namespace
+{
+// private futexes skip the cross-process lookup (our words never live in shared memory)
+long futex_call(std::atomic<cc::u32> const* word, int op, cc::u32 value)
+{
+    auto const* addr = reinterpret_cast<cc::u32 const*>(word);
+    return syscall(SYS_futex, addr, op | FUTEX_PRIVATE_FLAG, value, nullptr, nullptr, 0);
+}
+} // namespace
+#endif
+
+void cc::yield_thread()
+{
+#if defined(CC_OS_LINUX)
+    sched_yield();
+#elif defined(CC_OS_WINDOWS)
+    SwitchToThread();
+#else
+    std::this_thread::yield();
+#endif
+}
+
+void cc::atomic_wait(std::atomic<cc::u32> const& word, cc::u32 expected)
+{
+#if defined(CC_OS_LINUX)
+    // EAGAIN (value changed) and EINTR are both fine, callers loop
+    futex_call(&word, FUTEX_WAIT, expected);
+#elif defined(CC_OS_WINDOWS)
+    WaitOnAddress(const_cast<std::atomic<cc::u32>*>(&word), &expected, sizeof(cc::u32), INFINITE);
+#else
+    word.wait(expected, std::memory_order_acquire);
+#endif
+}
+
+void cc::atomic_wake_one(std::atomic<cc::u32>& word)
+{
+#if defined(CC_OS_LINUX)
+    futex_call(&word, FUTEX_WAKE, 1);
+#elif defined(CC_OS_WINDOWS)
+    WakeByAddressSingle(&word);
+#else
+    word.notify_one();
+#endif
+}
+
+void cc::atomic_wake_all(std::atomic<cc::u32>& word)
+{
+#if defined(CC_OS_LINUX)
+    futex_call(&word, FUTEX_WAKE, INT_MAX);
+#elif defined(CC_OS_WINDOWS)
+    WakeByAddressAll(&word);
+#else
+    word.notify_all();
+#endif
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <clean-core/fwd.hh>
+#include <clean-core/macros.hh>
+
+#include <atomic>
+
+#if defined(CC_HAS_SSE2)
+#include <emmintrin.h>
+#endif
+
+// =========================================================================================================
+// Blocking on atomics
+// =========================================================================================================
+//
+// Minimal building blocks for blocking concurrent containers (see spsc_queue.hh):
+//   cpu_relax()                   - spin-wait hint for the current core (pause/yield instruction)
+//   yield_thread()                - gives up the rest of the time slice to another ready thread
+//   atomic_wait(word, expected)   - sleeps while word == expected (futex on Linux, WaitOnAddress on Windows)
+//   atomic_wake_one(word)         - wakes one thread sleeping in atomic_wait on word
+//   atomic_wake_all(word)         - wakes all threads sleeping in atomic_wait on word
+//
+// Compared to std::atomic::wait/notify, these always go straight to the OS primitive
+// (no internal spinning or waiter tables), so callers control the spin-then-sleep policy themselves.
+
+namespace cc
+{
+/// Hint that the current thread is spin-waiting, reduces power use and pipeline flushes in spin loops.
+CC_FORCE_INLINE void cpu_relax()
+{
+#if defined(CC_HAS_SSE2)
+    _mm_pause();
+#elif defined(CC_ARCH_ARM64) && defined(CC_COMPILER_POSIX)
+    __asm__ __volatile__("yield");
+#endif
+}
+
+/// Lets the OS schedule another ready thread on this core (sched_yield / SwitchToThread).
+/// Cheaper than a sleep/wake round trip when the waited-for thread shares the core (oversubscription).
+void yield_thread();
+
+/// Blocks the calling thread while word == expected.
+/// May return spuriously, callers must re-check their condition in a loop.
+/// Returns immediately if word != expected at the time of the call.
+///
+/// Usage (waiter):
+///   while (!ready())
+///   {
+///       flag.store(1);
+///       if (!ready())
+///           cc::atomic_wait(flag, 1);
+///   }
+void atomic_wait(std::atomic<u32> const& word, u32 expected);
+
+/// Wakes one thread blocked in atomic_wait on word (no-op if there is none).
+void atomic_wake_one(std::atomic<u32>& word);
+
+/// Wakes all threads blocked in atomic_wait on word.
+void atomic_wake_all(std::atomic<u32>& word);
+} // namespace cc
@@ -32,6 +32,7 @@
 //   popcount(value)                         - count number of 1 bits in unsigned integer
 //
 // Atomic operations:
+//   atomic_load(value, order)               - atomically load value (seq_cst by default)
 //   atomic_add(value, rhs)                  - atomically add rhs to value, return old value
 //   atomic_sub(value, rhs)                  - atomically subtract rhs from value, return old value
 //   atomic_and(value, rhs)                  - atomically AND rhs with value, return old value
@@ -195,6 +196,19 @@ using std::popcount;
 // Atomic operations
 // =========================================================================================================
 
+/// Atomically loads a value that other threads may concurrently modify via atomic operations
+/// Creates a temporary atomic_ref and performs load with the given memory order
+/// Usage:
+///   int counter = 0;
+///   int val = cc::atomic_load(counter);                                // seq_cst
+///   int approx = cc::atomic_load(counter, std::memory_order_relaxed);  // e.g. for statistics
+template <class T>
+T atomic_load(T const& v, std::memory_order order = std::memory_order_seq_cst) noexcept
+{
+    // atomic_ref<T const> is C++26, loading through a non-const ref does not write
+    return std::atomic_ref<T>(const_cast<T&>(v)).load(order);
+}
+
 /// Atomically adds a value and returns the old value
 /// Creates a temporary atomic_ref and performs fetch_add
 /// Usage:
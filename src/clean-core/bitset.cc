@@ -0,0 +1,375 @@
+#include "bitset.hh"
+
+#if defined(CC_HAS_SSE2)
+#include <emmintrin.h>
+#endif
+
+// Word kernels for cc::bitset
+// All loops are memory-bound for large bitsets: the SSE2 paths process one cache line (8 words) per iteration,
+// the scalar tails handle the remaining words. Our allocations are 64 byte aligned, so vector loads are aligned.
+
+namespace
+{
+using cc::isize;
+using cc::u64;
+
+struct and_op
+{
+    static u64 scalar(u64 a, u64 b) { return a & b; }
+#if defined(CC_HAS_SSE2)
+    static __m128i vec(__m128i a, __m128i b) { return _mm_and_si128(a, b); }
+#endif
+};
+
+struct or_op
+{
+    static u64 scalar(u64 a, u64 b) { return a | b; }
+#if defined(CC_HAS_SSE2)
+    static __m128i vec(__m128i a, __m128i b) { return _mm_or_si128(a, b); }
+#endif
+};
+
+struct xor_op
+{
+    static u64 scalar(u64 a, u64 b) { return a ^ b; }
+#if defined(CC_HAS_SSE2)
+    static __m128i vec(__m128i a, __m128i b) { return _mm_xor_si128(a, b); }
+#endif
+};
+
+struct and_not_op
+{
+    static u64 scalar(u64 a, u64 b) { return a & ~b; }
+#if defined(CC_HAS_SSE2)
+    static __m128i vec(__m128i a, __m128i b) { return _mm_andnot_si128(b, a); }
+#endif
+};
+
+// plain loop instead of memset, compilers lower it to the same code
+void fill_words(u64* dst, isize n, u64 value)
+{
+    for (isize i = 0; i < n; ++i)
+        dst[i] = value;
+}
+
+// dst[i] = Op(dst[i], src[i]) for n words
+template <class Op>
+void combine_words(u64* dst, u64 const* src, isize n)
+{
+    isize i = 0;
+#if defined(CC_HAS_SSE2)
+    for (; i + 8 <= n; i += 8)
+    {
+        auto* d = reinterpret_cast<__m128i*>(dst + i);
+        auto const* s = reinterpret_cast<__m128i const*>(src + i);
+        auto const r0 = Op::vec(_mm_load_si128(d + 0), _mm_load_si128(s + 0));
+        auto const r1 = Op::vec(_mm_load_si128(d + 1), _mm_load_si128(s + 1));
+        auto const r2 = Op::vec(_mm_load_si128(d + 2), _mm_load_si128(s + 2));
+        auto const r3 = Op::vec(_mm_load_si128(d + 3), _mm_load_si128(s + 3));
+        _mm_store_si128(d + 0, r0);
+        _mm_store_si128(d + 1, r1);
+        _mm_store_si128(d + 2, r2);
+        _mm_store_si128(d + 3, r3);
+    }
+#endif
+    for (; i < n; ++i)
+        dst[i] = Op::scalar(dst[i], src[i]);
+}
+
+#if defined(CC_HAS_SSE2) && !defined(__POPCNT__)
+// per-byte popcount (0..8 per byte) via the classic SWAR reduction on 128 bit lanes
+__m128i popcount_bytes(__m128i v)
+{
+    auto const m1 = _mm_set1_epi8(0x55);
+    auto const m2 = _mm_set1_epi8(0x33);
+    auto const m4 = _mm_set1_epi8(0x0F);
+    v = _mm_sub_epi8(v, _mm_and_si128(_mm_srli_epi64(v, 1), m1));
+    v = _mm_add_epi8(_mm_and_si128(v, m2), _mm_and_si128(_mm_srli_epi64(v, 2), m2));
+    return _mm_and_si128(_mm_add_epi8(v, _mm_srli_epi64(v, 4)), m4);
+}
+#endif
+
+isize popcount_words(u64 const* w, isize n)
+{
+    isize i = 0;
+    isize total = 0;
+#if defined(__POPCNT__)
+    // hardware popcnt: independent accumulators hide its latency
+    isize c0 = 0, c1 = 0, c2 = 0, c3 = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        c0 += cc::popcount(w[i + 0]);
+        c1 += cc::popcount(w[i + 1]);
+        c2 += cc::popcount(w[i + 2]);
+        c3 += cc::popcount(w[i + 3]);
+    }
+    total = c0 + c1 + c2 + c3;
+#elif defined(CC_HAS_SSE2)
+    // without popcnt (baseline x64), std::popcount is a per-word bit trick or a library call,
+    // counting bytes of a whole cache line in SIMD and summing them with one psadbw is much faster
+    auto acc = _mm_setzero_si128();
+    for (; i + 8 <= n; i += 8)
+    {
+        auto const* v = reinterpret_cast<__m128i const*>(w + i);
+        // 4 x (0..8) per byte fits in a byte
+        auto bytes = popcount_bytes(_mm_load_si128(v + 0));
+        bytes = _mm_add_epi8(bytes, popcount_bytes(_mm_load_si128(v + 1)));
+        bytes = _mm_add_epi8(bytes, popcount_bytes(_mm_load_si128(v + 2)));
+        bytes = _mm_add_epi8(bytes, popcount_bytes(_mm_load_si128(v + 3)));
+        acc = _mm_add_epi64(acc, _mm_sad_epu8(bytes, _mm_setzero_si128()));
+    }
+    total = isize(_mm_cvtsi128_si64(acc)) + isize(_mm_cvtsi128_si64(_mm_unpackhi_epi64(acc, acc)));
+#endif
+    for (; i < n; ++i)
+        total += cc::popcount(w[i]);
+    return total;
+}
+} // namespace
+
+isize cc::bitset::count() const { return popcount_words(_data.obj_start, word_count()); }
+
+bool cc::bitset::all() const
+{
+    auto const* w = _data.obj_start;
+    auto const full_words = _size >> 6;
+    for (isize i = 0; i < full_words; ++i)
+        if (w[i] != ~u64(0))
+            return false;
+    auto const tail_bits = _size & 63;
+    return tail_bits == 0 || w[full_words] == (~u64(0) >> (64 - tail_bits));
+}
+
+isize cc::bitset::find_from(isize start) const
+{
+    auto const* w = _data.obj_start;
+    auto const n = word_count();
+    auto wi = start >> 6;
+    auto bits = w[wi] & (~u64(0) << (start & 63));
+    while (bits == 0)
+    {
+        ++wi;
+        // skip empty stretches a cache line at a time
+        while (wi + 8 <= n
+               && (w[wi] | w[wi + 1] | w[wi + 2] | w[wi + 3] | w[wi + 4] | w[wi + 5] | w[wi + 6] | w[wi + 7]) == 0)
+            wi += 8;
+        if (wi >= n)
+            return -1;
+        bits = w[wi];
+    }
+    return wi * 64 + cc::count_trailing_zeroes(bits);
+}
+
+bool cc::bitset::operator==(bitset const& rhs) const
+{
+    if (_size != rhs._size)
+        return false;
+    // bits past size are zero in both
+    auto const* a = _data.obj_start;
+    auto const* b = rhs._data.obj_start;
+    for (isize i = 0, n = word_count(); i < n; ++i)
+        if (a[i] != b[i])
+            return false;
+    return true;
+}
+
+void cc::bitset::set_range(isize start, isize count)
+{
+    CC_ASSERT(0 <= start && 0 <= count && start + count <= _size, "bit range out of bounds");
+    if (count == 0)
+        return;
+    auto* w = _data.obj_start;
+    auto const first = start >> 6;
+    auto const last = (start + count - 1) >> 6;
+    auto const first_mask = ~u64(0) << (start & 63);
+    auto const last_mask = ~u64(0) >> (63 - ((start + count - 1) & 63));
+    if (first == last)
+    {
+        w[first] |= first_mask & last_mask;
+        return;
+    }
+    w[first] |= first_mask;
+    fill_words(w + first + 1, last - first - 1, ~u64(0));
+    w[last] |= last_mask;
+}
+
+void cc::bitset::clear_range(isize start, isize count)
+{
+    CC_ASSERT(0 <= start && 0 <= count && start + count <= _size, "bit range out of bounds");
+    if (count == 0)
+        return;
+    auto* w = _data.obj_start;
+    auto const first = start >> 6;
+    auto const last = (start + count - 1) >> 6;
+    auto const first_mask = ~u64(0) << (start & 63);
+    auto const last_mask = ~u64(0) >> (63 - ((start + count - 1) & 63));
+    if (first == last)
+    {
+        w[first] &= ~(first_mask & last_mask);
+        return;
+    }
+    w[first] &= ~first_mask;
+    fill_words(w + first + 1, last - first - 1, 0);
+    w[last] &= ~last_mask;
+}
+
+void cc::bitset::flip_all()
+{
+    auto* w = _data.obj_start;
+    auto const n = word_count();
+    isize i = 0;
+#if defined(CC_HAS_SSE2)
+    auto const ones = _mm_set1_epi32(-1);
+    for (; i + 8 <= n; i += 8)
+    {
+        auto* v = reinterpret_cast<__m128i*>(w + i);
+        auto const r0 = _mm_xor_si128(_mm_load_si128(v + 0), ones);
+        auto const r1 = _mm_xor_si128(_mm_load_si128(v + 1), ones);
+        auto const r2 = _mm_xor_si128(_mm_load_si128(v + 2), ones);
+        auto const r3 = _mm_xor_si128(_mm_load_si128(v + 3), ones);
+        _mm_store_si128(v + 0, r0);
+        _mm_store_si128(v + 1, r1);
+        _mm_store_si128(v + 2, r2);
+        _mm_store_si128(v + 3, r3);
+    }
+#endif
+    for (; i < n; ++i)
+        w[i] = ~w[i];
+    clear_tail();
+}
+
+cc::bitset& cc::bitset::operator&=(bitset const& rhs)
+{
+    CC_ASSERT(_size == rhs._size, "bitsets must have the same size");
+    combine_words<and_op>(_data.obj_start, rhs._data.obj_start, word_count());
+    return *this;
+}
+
+cc::bitset& cc::bitset::operator|=(bitset const& rhs)
+{
+    CC_ASSERT(_size == rhs._size, "bitsets must have the same size");
+    combine_words<or_op>(_data.obj_start, rhs._data.obj_start, word_count());
+    return *this;
+}
+
+cc::bitset& cc::bitset::operator^=(bitset const& rhs)
+{
+    CC_ASSERT(_size == rhs._size, "bitsets must have the same size");
+    combine_words<xor_op>(_data.obj_start, rhs._data.obj_start, word_count());
+    return *this;
+}
+
+cc::bitset& cc::bitset::and_not(bitset const& rhs)
+{
+    CC_ASSERT(_size == rhs._size, "bitsets must have the same size");
+    combine_words<and_not_op>(_data.obj_start, rhs._data.obj_start, word_count());
+    return *this;
+}
+
+void cc::bitset::resize(isize new_size, bool value)
+{
+    CC_ASSERT(new_size >= 0, "size must be non-negative");
+    auto const old_size = _size;
+    if (new_size <= old_size)
+    {
+        _size = new_size;
+        _data.obj_end = _data.obj_start + words_for(new_size);
+        clear_tail();
+        return;
+    }
+
+    grow_words(new_size);
+    _size = new_size;
+    if (value)
+        set_range(old_size, new_size - old_size);
+}
+
+cc::bitset cc::bitset::create_with_size(isize size, cc::memory_resource const* resource)
+{
+    CC_ASSERT(size >= 0, "size must be non-negative");
+    bitset b;
+    b._data = allocate_words(words_for(size), resource);
+    b._size = size;
+    if (size > 0)
+        fill_words(b._data.obj_start, b.word_count(), 0);
+    return b;
+}
+
+cc::bitset cc::bitset::create_filled(isize size, bool value, cc::memory_resource const* resource)
+{
+    auto b = create_with_size(size, resource);
+    if (value)
+        b.set_all();
+    return b;
+}
+
+cc::bitset cc::bitset::create_from_words(cc::span<u64 const> words, isize size, cc::memory_resource const* resource)
+{
+    CC_ASSERT(size >= 0 && words.size() >= words_for(size), "not enough words for the requested size");
+    bitset b;
+    b._data = allocate_words(words_for(size), resource);
+    b._size = size;
+    if (size > 0)
+    {
+        cc::memcpy(b._data.obj_start, words.data(), b.word_count() * sizeof(u64));
+        b.clear_tail();
+    }
+    return b;
+}
+
+cc::bitset::bitset(bitset const& rhs)
+  : _data(allocate_words(rhs.word_count(), rhs._data.custom_resource)), _size(rhs._size)
+{
+    if (_size > 0)
+        cc::memcpy(_data.obj_start, rhs._data.obj_start, word_count() * sizeof(u64));
+}
+
+cc::bitset& cc::bitset::operator=(bitset const& rhs)
+{
+    if (this != &rhs)
+    {
+        // reuse our words if they fit
+        if (isize(_data.alloc_end - _data.alloc_start) >= rhs.word_count() * isize(sizeof(u64)))
+        {
+            _data.obj_end = _data.obj_start + rhs.word_count();
+            _size = rhs._size;
+            if (_size > 0)
+                cc::memcpy(_data.obj_start, rhs._data.obj_start, word_count() * sizeof(u64));
+        }
+        else
+            *this = bitset(rhs);
+    }
+    return *this;
+}
+
+cc::allocation<u64> cc::bitset::allocate_words(isize word_count, cc::memory_resource const* resource)
+{
+    auto const bytes = word_count * isize(sizeof(u64));
+    auto data = cc::allocation<u64>::create_empty_bytes(bytes, bytes, alloc_alignment, resource);
+    data.obj_end = data.obj_start + word_count;
+    return data;
+}
+
+void cc::bitset::grow_words(isize bits)
+{
+    auto const old_words = word_count();
+    auto const new_words = words_for(bits);
+    if (new_words <= old_words)
+        return;
+
+    auto const capacity_words = isize(_data.alloc_end - _data.alloc_start) / isize(sizeof(u64));
+    if (new_words > capacity_words)
+    {
+        auto data = allocate_words(cc::max(new_words, 2 * capacity_words), _data.custom_resource);
+        if (old_words > 0)
+            cc::memcpy(data.obj_start, _data.obj_start, old_words * sizeof(u64));
+        _data = cc::move(data);
+    }
+    _data.obj_end = _data.obj_start + new_words;
+    fill_words(_data.obj_start + old_words, new_words - old_words, 0);
+}
+
+void cc::bitset::clear_tail()
+{
+    if ((_size & 63) != 0)
+        _data.obj_start[_size >> 6] &= ~u64(0) >> (64 - (_size & 63));
+}
@@ -1,10 +1,256 @@
 #pragma once
 
+#include <clean-core/allocation.hh>
+#include <clean-core/bit.hh>
 #include <clean-core/fwd.hh>
+#include <clean-core/span.hh>
+#include <clean-core/utility.hh>
 
-/// Dynamic bitset with runtime-determined size
-/// Provides efficient storage and manipulation of boolean flags
+namespace cc::impl
+{
+/// Iterates the indices of set bits, one word at a time (clear lowest bit + count trailing zeroes).
+struct set_bit_iterator
+{
+    u64 const* words;
+    isize word_idx;
+    isize word_count;
+    u64 bits; // remaining set bits of words[word_idx]
+
+    [[nodiscard]] isize operator*() const { return word_idx * 64 + cc::count_trailing_zeroes(bits); }
+
+    set_bit_iterator& operator++()
+    {
+        bits &= bits - 1;
+        while (bits == 0 && ++word_idx < word_count)
+            bits = words[word_idx];
+        return *this;
+    }
+
+    [[nodiscard]] friend bool operator==(set_bit_iterator const& it, cc::sentinel) { return it.bits == 0; }
+};
+
+struct set_bit_range
+{
+    u64 const* words;
+    isize word_count;
+
+    [[nodiscard]] set_bit_iterator begin() const
+    {
+        set_bit_iterator it = {words, 0, word_count, 0};
+        while (it.word_idx < word_count && (it.bits = words[it.word_idx]) == 0)
+            ++it.word_idx;
+        return it;
+    }
+    [[nodiscard]] cc::sentinel end() const { return {}; }
+};
+} // namespace cc::impl
+
+/// Dynamic bitset with runtime-determined size, stored as a cache-line aligned array of u64 words.
+///
+/// Bit i lives in word i / 64 at position i % 64 (least significant first).
+/// Bits past size() in the last word are always zero, so word-level kernels never need to mask.
+///
+/// Performance design:
+///   - bulk operations (&=, |=, ^=, and_not, count, find_next, range set/clear) are word-parallel kernels
+///     in bitset.cc, SSE2 where available, meant to run at memory bandwidth on large bitsets
+///   - iterating set bits visits whole words: clear the lowest bit and count trailing zeroes,
+///     so sparse bitsets cost one load per 64 bits
+///   - words() exposes the raw words for custom kernels (e.g. selection vectors in filter pipelines)
+///
+/// Usage:
+///   auto selected = cc::bitset::create_with_size(row_count);
+///   for (isize i = 0; i < row_count; ++i)
+///       selected.set(i, price[i] > 100);
+///   selected &= in_stock;
+///   for (auto row : selected.set_bits())
+///       emit(row);
 struct cc::bitset
 {
-    // TODO: implement bitset
+    // queries
+public:
+    /// Number of bits.
+    [[nodiscard]] isize size() const { return _size; }
+    [[nodiscard]] bool empty() const { return _size == 0; }
+
+    /// Number of u64 words holding the bits (size() rounded up to 64, divided by 64).
+    [[nodiscard]] isize word_count() const { return _data.obj_end - _data.obj_start; }
+
+    /// The underlying words. Writers must keep the bits past size() in the last word zero.
+    [[nodiscard]] cc::span<u64 const> words() const { return cc::span<u64 const>(_data.obj_start, word_count()); }
+    [[nodiscard]] cc::span<u64> words() { return cc::span<u64>(_data.obj_start, word_count()); }
+
+    /// Value of bit i.
+    [[nodiscard]] bool test(isize i) const
+    {
+        CC_ASSERT(0 <= i && i < _size, "bit index out of bounds");
+        return (_data.obj_start[i >> 6] >> (i & 63)) & 1;
+    }
+    [[nodiscard]] bool operator[](isize i) const { return test(i); }
+
+    /// Number of set bits.
+    [[nodiscard]] isize count() const;
+
+    /// True if any / no / every bit is set (all() and none() are true for an empty bitset).
+    [[nodiscard]] bool any() const { return find_first() >= 0; }
+    [[nodiscard]] bool none() const { return !any(); }
+    [[nodiscard]] bool all() const;
+
+    /// Index of the first set bit, or -1 if there is none.
+    [[nodiscard]] isize find_first() const { return _size == 0 ? -1 : find_from(0); }
+
+    /// Index of the first set bit after pos (pos itself excluded, pos may be -1), or -1 if there is none.
+    [[nodiscard]] isize find_next(isize pos) const
+    {
+        CC_ASSERT(-1 <= pos && pos < _size, "bit index out of bounds");
+        return pos + 1 >= _size ? -1 : find_from(pos + 1);
+    }
+
+    [[nodiscard]] bool operator==(bitset const& rhs) const;
+
+    // iteration
+public:
+    /// Range over the indices of all set bits in ascending order.
+    /// Usage:
+    ///   for (isize i : bits.set_bits())
+    ///       ...
+    /// Only on lvalues, the range would dangle for a temporary bitset.
+    [[nodiscard]] impl::set_bit_range set_bits() const& { return {_data.obj_start, word_count()}; }
+    impl::set_bit_range set_bits() const&& = delete;
+
+    /// Calls f(isize index) for every set bit in ascending order.
+    template <class F>
+    void for_each_set_bit(F&& f) const
+    {
+        auto const* words = _data.obj_start;
+        auto const count = word_count();
+        for (isize w = 0; w < count; ++w)
+        {
+            auto bits = words[w];
+            while (bits != 0)
+            {
+                f(w * 64 + cc::count_trailing_zeroes(bits));
+                bits &= bits - 1;
+            }
+        }
+    }
+
+    // single bits
+public:
+    void set(isize i)
+    {
+        CC_ASSERT(0 <= i && i < _size, "bit index out of bounds");
+        _data.obj_start[i >> 6] |= u64(1) << (i & 63);
+    }
+
+    /// Sets bit i to value (branchless).
+    void set(isize i, bool value)
+    {
+        CC_ASSERT(0 <= i && i < _size, "bit index out of bounds");
+        auto& word = _data.obj_start[i >> 6];
+        auto const mask = u64(1) << (i & 63);
+        word = (word & ~mask) | (-u64(value) & mask);
+    }
+
+    void clear(isize i)
+    {
+        CC_ASSERT(0 <= i && i < _size, "bit index out of bounds");
+        _data.obj_start[i >> 6] &= ~(u64(1) << (i & 63));
+    }
+
+    void flip(isize i)
+    {
+        CC_ASSERT(0 <= i && i < _size, "bit index out of bounds");
+        _data.obj_start[i >> 6] ^= u64(1) << (i & 63);
+    }
+
+    // ranges
+public:
+    /// Sets / clears the bits [start, start + count).
+    void set_range(isize start, isize count);
+    void clear_range(isize start, isize count);
+
+    void set_all() { set_range(0, _size); }
+    void clear_all() { clear_range(0, _size); }
+    void flip_all();
+
+    // bitwise operations (both bitsets must have the same size)
+public:
+    bitset& operator&=(bitset const& rhs);
+    bitset& operator|=(bitset const& rhs);
+    bitset& operator^=(bitset const& rhs);
+
+    /// Clears every bit that is set in rhs (this &= ~rhs, without materializing ~rhs).
+    bitset& and_not(bitset const& rhs);
+
+    [[nodiscard]] friend bitset operator&(bitset lhs, bitset const& rhs) { return cc::move(lhs &= rhs); }
+    [[nodiscard]] friend bitset operator|(bitset lhs, bitset const& rhs) { return cc::move(lhs |= rhs); }
+    [[nodiscard]] friend bitset operator^(bitset lhs, bitset const& rhs) { return cc::move(lhs ^= rhs); }
+    [[nodiscard]] friend bitset operator~(bitset b)
+    {
+        b.flip_all();
+        return b;
+    }
+
+    // size changes
+public:
+    /// Changes the number of bits, new bits are set to value.
+    void resize(isize new_size, bool value = false);
+
+    /// Appends one bit (amortized O(1)).
+    void push_back(bool value)
+    {
+        if ((_size >> 6) == word_count())
+            grow_words(_size + 1);
+        _size += 1;
+        set(_size - 1, value);
+    }
+
+    // factories
+public:
+    /// Creates a bitset of size bits, all clear.
+    [[nodiscard]] static bitset create_with_size(isize size, cc::memory_resource const* resource = nullptr);
+
+    /// Creates a bitset of size bits, all set to value.
+    [[nodiscard]] static bitset create_filled(isize size, bool value, cc::memory_resource const* resource = nullptr);
+
+    /// Creates a bitset of size bits from existing words (bit i is words[i / 64] >> (i % 64)).
+    /// words must hold at least size bits, bits past size are ignored.
+    [[nodiscard]] static bitset create_from_words(cc::span<u64 const> words,
+                                                  isize size,
+                                                  cc::memory_resource const* resource = nullptr);
+
+    // ctors
+public:
+    bitset() = default;
+    bitset(bitset const& rhs);
+    bitset(bitset&& rhs) noexcept : _data(cc::move(rhs._data)), _size(cc::exchange(rhs._size, 0)) {}
+    bitset& operator=(bitset const& rhs);
+    bitset& operator=(bitset&& rhs) noexcept
+    {
+        _data = cc::move(rhs._data);
+        _size = cc::exchange(rhs._size, 0);
+        return *this;
+    }
+    ~bitset() = default;
+
+private:
+    // whole cache lines for the word kernels
+    static constexpr isize alloc_alignment = 64;
+
+    [[nodiscard]] static isize words_for(isize bits) { return (bits + 63) >> 6; }
+
+    // first set bit at or after start (start < size), -1 if none
+    [[nodiscard]] isize find_from(isize start) const;
+
+    // allocates word_count words (uninitialized) with the given resource
+    [[nodiscard]] static cc::allocation<u64> allocate_words(isize word_count, cc::memory_resource const* resource);
+
+    // makes room for at least bits (new words are zero), at least doubling the capacity
+    void grow_words(isize bits);
+
+    // clears the bits past size() in the last word
+    void clear_tail();
+
+    cc::allocation<u64> _data; // live window = the word_count() used words, capacity may be larger
+    isize _size = 0;
 };
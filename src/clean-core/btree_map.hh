@@ -0,0 +1,1022 @@
+#pragma once
+
+#include <clean-core/bit.hh>
+#include <clean-core/fwd.hh>
+#include <clean-core/impl/flat_util.hh>
+#include <clean-core/macros.hh>
+#include <clean-core/map.hh> // cc::map_entry
+#include <clean-core/node_allocation.hh>
+#include <clean-core/node_list.hh> // impl::list_allocator_for
+#include <clean-core/optional.hh>
+#include <clean-core/pair.hh>
+#include <clean-core/utility.hh>
+#include <clean-core/vector.hh>
+
+#include <cstring>
+#include <initializer_list>
+
+#if defined(CC_HAS_SSE2)
+#include <emmintrin.h>
+#endif
+
+namespace cc::impl
+{
+/// Size budget of one B+tree node: 4 cache lines, the largest class served by the node allocator slab path.
+inline constexpr isize btree_node_bytes = 256;
+
+/// Upper bound on the tree height (inner nodes have a fanout of at least 3).
+inline constexpr isize btree_max_depth = 40;
+
+/// Common header of leaves and inner nodes.
+struct btree_node
+{
+    u16 count = 0; // number of keys
+    bool is_leaf = false;
+};
+
+/// Leaf: sorted keys and their values in two arrays, linked to its neighbors for ordered iteration.
+/// The slots are unions, the map constructs/destroys exactly the first count entries.
+template <class K, class V>
+struct btree_leaf : btree_node
+{
+    static constexpr isize capacity
+        = cc::max(isize(4), isize((btree_node_bytes - 3 * sizeof(void*)) / (sizeof(K) + sizeof(V))));
+
+    btree_leaf* prev = nullptr;
+    btree_leaf* next = nullptr;
+    union
+    {
+        K keys[capacity];
+    };
+    union
+    {
+        V values[capacity];
+    };
+
+    btree_leaf() { is_leaf = true; }
+    ~btree_leaf() {}
+};
+
+/// Inner node: count separator keys and count + 1 children.
+/// children[i] holds the keys in [keys[i - 1], keys[i]).
+template <class K, class V>
+struct btree_inner : btree_node
+{
+    static constexpr isize capacity
+        = cc::max(isize(4), isize((btree_node_bytes - 2 * sizeof(void*)) / (sizeof(K) + sizeof(void*))));
+
+    union
+    {
+        K keys[capacity];
+    };
+    btree_node* children[capacity + 1];
+
+    btree_inner() {}
+    ~btree_inner() {}
+};
+
+#if defined(CC_HAS_SSE2)
+template <bool UpperBound, class K>
+[[nodiscard]] CC_FORCE_INLINE isize btree_search_sse2(K const* keys, isize count, K key)
+{
+    isize n = 0;
+    isize i = 0;
+    if constexpr (std::is_same_v<K, f32>)
+    {
+        auto const k = _mm_set1_ps(key);
+        for (; i + 4 <= count; i += 4)
+        {
+            auto const v = _mm_loadu_ps(keys + i);
+            n += cc::popcount(u32(_mm_movemask_ps(UpperBound ? _mm_cmple_ps(v, k) : _mm_cmplt_ps(v, k))));
+        }
+    }
+    else if constexpr (std::is_same_v<K, f64>)
+    {
+        auto const k = _mm_set1_pd(key);
+        for (; i + 2 <= count; i += 2)
+        {
+            auto const v = _mm_loadu_pd(keys + i);
+            n += cc::popcount(u32(_mm_movemask_pd(UpperBound ? _mm_cmple_pd(v, k) : _mm_cmplt_pd(v, k))));
+        }
+    }
+    else // 32 bit integers, unsigned ones are flipped into the signed range for the signed compare
+    {
+        constexpr u32 bias = std::is_signed_v<K> ? 0u : 0x8000'0000u;
+        auto const b = _mm_set1_epi32(int(bias));
+        auto const k = _mm_set1_epi32(int(u32(key) ^ bias));
+        for (; i + 4 <= count; i += 4)
+        {
+            auto const v = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<__m128i const*>(keys + i)), b);
+            // UpperBound counts !(key < v), i.e. the lanes that are not greater than key
+            auto const m = UpperBound ? _mm_cmpgt_epi32(v, k) : _mm_cmplt_epi32(v, k);
+            auto const bits = isize(cc::popcount(u32(_mm_movemask_ps(_mm_castsi128_ps(m)))));
+            n += UpperBound ? 4 - bits : bits;
+        }
+    }
+    for (; i < count; ++i)
+        n += UpperBound ? isize(!(key < keys[i])) : isize(keys[i] < key);
+    return n;
+}
+#endif
+
+/// Number of keys in a sorted node that are less than key (UpperBound: not greater than key).
+/// Nodes hold only a handful of keys, so arithmetic keys are counted with a linear (SIMD) scan
+/// instead of a binary search: no unpredictable branches, and the whole node is streamed once.
+template <bool UpperBound, class K, class KeyT>
+[[nodiscard]] CC_FORCE_INLINE isize btree_search(K const* keys, isize count, KeyT const& key)
+{
+    if constexpr (std::is_arithmetic_v<K> && std::is_same_v<K, KeyT>)
+    {
+#if defined(CC_HAS_SSE2)
+        if constexpr (sizeof(K) == 4 || std::is_same_v<K, f64>)
+            return impl::btree_search_sse2<UpperBound>(keys, count, key);
+#endif
+        // counting loop, compilers vectorize this where the target has a matching compare
+        isize n = 0;
+        for (isize i = 0; i < count; ++i)
+            n += UpperBound ? isize(!(key < keys[i])) : isize(keys[i] < key);
+        return n;
+    }
+    else if constexpr (UpperBound)
+        return impl::flat_upper_bound(keys, count, key);
+    else
+        return impl::flat_lower_bound(keys, count, key);
+}
+
+/// Moves count elements into uninitialized dst and destroys the sources (ranges must not overlap).
+template <class T>
+CC_FORCE_INLINE void btree_relocate(T* dst, T* src, isize count)
+{
+    if constexpr (std::is_trivially_copyable_v<T>)
+    {
+        if (count > 0)
+            std::memcpy(static_cast<void*>(dst), static_cast<void const*>(src), count * sizeof(T));
+    }
+    else
+    {
+        for (isize i = 0; i < count; ++i)
+        {
+            new (cc::placement_new, dst + i) T(cc::move(src[i]));
+            src[i].~T();
+        }
+    }
+}
+
+/// Moves the live elements [pos, count) up by one, leaving slot pos uninitialized.
+template <class T>
+CC_FORCE_INLINE void btree_open_gap(T* data, isize count, isize pos)
+{
+    if constexpr (std::is_trivially_copyable_v<T>)
+    {
+        if (count > pos)
+            std::memmove(static_cast<void*>(data + pos + 1), static_cast<void const*>(data + pos),
+                         (count - pos) * sizeof(T));
+    }
+    else
+    {
+        for (isize i = count; i > pos; --i)
+        {
+            new (cc::placement_new, data + i) T(cc::move(data[i - 1]));
+            data[i - 1].~T();
+        }
+    }
+}
+
+/// Moves the live elements (pos, count) down by one into the uninitialized slot pos.
+template <class T>
+CC_FORCE_INLINE void btree_close_gap(T* data, isize count, isize pos)
+{
+    if constexpr (std::is_trivially_copyable_v<T>)
+    {
+        if (count > pos + 1)
+            std::memmove(static_cast<void*>(data + pos), static_cast<void const*>(data + pos + 1),
+                         (count - pos - 1) * sizeof(T));
+    }
+    else
+    {
+        for (isize i = pos; i + 1 < count; ++i)
+        {
+            new (cc::placement_new, data + i) T(cc::move(data[i + 1]));
+            data[i + 1].~T();
+        }
+    }
+}
+
+/// Forward iterator over the linked leaves, end() is {nullptr, 0}.
+template <class K, class V, bool IsConst>
+struct btree_iterator
+{
+    using leaf_t = btree_leaf<K, V>;
+    using entry_t = std::conditional_t<IsConst, map_entry<K, V const>, map_entry<K, V>>;
+
+    [[nodiscard]] CC_FORCE_INLINE entry_t operator*() const
+    {
+        CC_ASSERT(_leaf != nullptr, "dereferencing end iterator");
+        return {_leaf->keys[_idx], _leaf->values[_idx]};
+    }
+
+    CC_FORCE_INLINE btree_iterator& operator++()
+    {
+        CC_ASSERT(_leaf != nullptr, "incrementing end iterator");
+        if (++_idx == _leaf->count)
+        {
+            _leaf = _leaf->next;
+            _idx = 0;
+        }
+        return *this;
+    }
+
+    [[nodiscard]] bool operator==(btree_iterator const& rhs) const { return _leaf == rhs._leaf && _idx == rhs._idx; }
+
+    leaf_t* _leaf = nullptr;
+    isize _idx = 0;
+};
+} // namespace cc::impl
+
+/// Ordered map from K to V stored in a B+tree of cache-line-sized nodes.
+///
+/// Fills the gap between cc::map (unordered) and cc::flat_map (ordered, but O(n) insertion):
+///   - O(log n) insertion and removal that only moves elements within one 256 byte node
+///   - all elements live in the leaves, which are linked for fast ordered iteration and range scans
+///   - high fanout keeps the tree shallow: a lookup touches a few nodes instead of ~log2(n) like a red-black tree
+///   - in-node search is a linear scan, SIMD for 32 bit and floating point keys (see impl::btree_search)
+///   - nodes come from the node allocator (see node_allocation.hh), optionally from a custom node_memory_resource
+///   - appending in increasing key order fills nodes completely, create_from_sorted bulk-loads in O(n)
+///
+/// Keys are compared via <, equality is !(a < b) && !(b < a) (floating point keys must not be NaN).
+/// K must be copyable: inner nodes store copies of leaf keys as separators.
+/// Lookups are templated on the key type, so a btree_map<cc::string, V> can be queried with string_view.
+/// Insertion and removal invalidate all iterators and references.
+///
+/// Usage:
+///   cc::btree_map<u64, cc::string> m;
+///   m.insert_or_assign(42, "answer");
+///   if (auto* v = m.get_ptr(42))
+///       use(*v);
+///   for (auto it = m.lower_bound(10); it != m.end() && (*it).key <= 20; ++it) // all keys in [10, 20]
+///       use((*it).key, (*it).value);
+template <class K, class V>
+struct cc::btree_map
+{
+    static_assert(std::is_object_v<K> && !std::is_const_v<K>, "map keys must be non-const objects");
+    static_assert(std::is_object_v<V> && !std::is_const_v<V>, "map values must be non-const objects");
+    static_assert(std::is_copy_constructible_v<K>, "btree keys are copied into inner nodes as separators");
+
+    using key_t = K;
+    using value_t = V;
+    using entry_t = map_entry<K, V>;
+    using iterator = impl::btree_iterator<K, V, false>;
+    using const_iterator = impl::btree_iterator<K, V, true>;
+
+    // element access
+public:
+    /// Returns a pointer to the value of key, or nullptr if key is not present.
+    template <class KeyT>
+    [[nodiscard]] CC_FORCE_INLINE V* get_ptr(KeyT const& key)
+    {
+        auto const leaf = find_leaf(key);
+        if (leaf == nullptr)
+            return nullptr;
+        auto const pos = impl::btree_search<false>(leaf->keys, leaf->count, key);
+        return pos < leaf->count && !(key < leaf->keys[pos]) ? &leaf->values[pos] : nullptr;
+    }
+    template <class KeyT>
+    [[nodiscard]] CC_FORCE_INLINE V const* get_ptr(KeyT const& key) const
+    {
+        return const_cast<btree_map*>(this)->get_ptr(key);
+    }
+
+    /// Returns the value of key, which must be present.
+    template <class KeyT>
+    [[nodiscard]] V& get(KeyT const& key)
+    {
+        auto const v = get_ptr(key);
+        CC_ASSERT(v != nullptr, "key not found in map");
+        return *v;
+    }
+    template <class KeyT>
+    [[nodiscard]] V const& get(KeyT const& key) const
+    {
+        auto const v = get_ptr(key);
+        CC_ASSERT(v != nullptr, "key not found in map");
+        return *v;
+    }
+
+    /// Returns the value of key, default-constructing it first if key is not present.
+    template <class KeyT>
+    V& operator[](KeyT&& key)
+    {
+        return get_or_emplace(cc::forward<KeyT>(key));
+    }
+
+    // queries
+public:
+    template <class KeyT>
+    [[nodiscard]] bool contains(KeyT const& key) const
+    {
+        return get_ptr(key) != nullptr;
+    }
+
+    [[nodiscard]] isize size() const { return _size; }
+    [[nodiscard]] bool empty() const { return _size == 0; }
+
+    // iteration (in increasing key order)
+public:
+    [[nodiscard]] iterator begin() { return {_size > 0 ? _first : nullptr, 0}; }
+    [[nodiscard]] iterator end() { return {}; }
+    [[nodiscard]] const_iterator begin() const { return {_size > 0 ? _first : nullptr, 0}; }
+    [[nodiscard]] const_iterator end() const { return {}; }
+
+    /// Iterator to the first element whose key is not less than key (end() if there is none).
+    template <class KeyT>
+    [[nodiscard]] iterator lower_bound(KeyT const& key)
+    {
+        auto const leaf = find_leaf(key);
+        return leaf == nullptr ? end() : normalized({leaf, impl::btree_search<false>(leaf->keys, leaf->count, key)});
+    }
+    template <class KeyT>
+    [[nodiscard]] const_iterator lower_bound(KeyT const& key) const
+    {
+        auto const it = const_cast<btree_map*>(this)->lower_bound(key);
+        return {it._leaf, it._idx};
+    }
+
+    /// Iterator to the first element whose key is greater than key (end() if there is none).
+    template <class KeyT>
+    [[nodiscard]] iterator upper_bound(KeyT const& key)
+    {
+        auto const leaf = find_leaf(key);
+        return leaf == nullptr ? end() : normalized({leaf, impl::btree_search<true>(leaf->keys, leaf->count, key)});
+    }
+    template <class KeyT>
+    [[nodiscard]] const_iterator upper_bound(KeyT const& key) const
+    {
+        auto const it = const_cast<btree_map*>(this)->upper_bound(key);
+        return {it._leaf, it._idx};
+    }
+
+    // insertion
+public:
+    /// Inserts or overwrites the value of key. Returns a reference to the stored value.
+    template <class KeyT, class ValueT>
+    V& insert_or_assign(KeyT&& key, ValueT&& value)
+    {
+        bool inserted;
+        auto const [leaf, pos] = find_or_insert(inserted, cc::forward<KeyT>(key), cc::forward<ValueT>(value));
+        if (!inserted)
+            leaf->values[pos] = cc::forward<ValueT>(value);
+        return leaf->values[pos];
+    }
+
+    /// Inserts key with a value constructed from args, unless key is already present (then nothing is constructed).
+    /// Returns true if the element was inserted.
+    template <class KeyT, class... Args>
+    bool try_insert(KeyT&& key, Args&&... args)
+    {
+        bool inserted;
+        (void)find_or_insert(inserted, cc::forward<KeyT>(key), cc::forward<Args>(args)...);
+        return inserted;
+    }
+
+    /// Returns the value of key, constructing it from args first if key is not present.
+    template <class KeyT, class... Args>
+    V& get_or_emplace(KeyT&& key, Args&&... args)
+    {
+        bool inserted;
+        auto const [leaf, pos] = find_or_insert(inserted, cc::forward<KeyT>(key), cc::forward<Args>(args)...);
+        return leaf->values[pos];
+    }
+
+    // removal
+public:
+    /// Removes key if present. Returns true if an element was removed.
+    template <class KeyT>
+    bool remove(KeyT const& key)
+    {
+        path_entry path[impl::btree_max_depth];
+        isize depth = 0;
+        auto const [leaf, pos] = locate(key, path, depth);
+        if (leaf == nullptr)
+            return false;
+        erase_at(path, depth, leaf, pos);
+        return true;
+    }
+
+    /// Removes key and returns its value (or nullopt if key is not present).
+    template <class KeyT>
+    [[nodiscard("use remove() if you don't need the return value")]] cc::optional<V> pop(KeyT const& key)
+    {
+        path_entry path[impl::btree_max_depth];
+        isize depth = 0;
+        auto const [leaf, pos] = locate(key, path, depth);
+        if (leaf == nullptr)
+            return cc::nullopt;
+        auto result = cc::optional<V>(cc::move(leaf->values[pos]));
+        erase_at(path, depth, leaf, pos);
+        return result;
+    }
+
+    /// Removes all elements and frees all nodes.
+    void clear()
+    {
+        if (_root != nullptr)
+            destroy_subtree(_root);
+        _root = nullptr;
+        _first = nullptr;
+        _last = nullptr;
+        _size = 0;
+    }
+
+    // factories
+public:
+    /// Creates an empty map allocating nodes from the given resource (nullptr means default).
+    [[nodiscard]] static btree_map create_with_resource(node_memory_resource* resource)
+    {
+        btree_map m;
+        m._resource = resource;
+        return m;
+    }
+
+    /// Bulk-loads strictly increasing keys (and their values) in O(n).
+    /// Builds the leaves left to right, then each inner level on top of the one below (no descent from the root).
+    /// Nodes are filled completely, which is ideal for read-mostly maps.
+    [[nodiscard]] static btree_map create_from_sorted(cc::vector<K> keys,
+                                                      cc::vector<V> values,
+                                                      node_memory_resource* resource = nullptr)
+    {
+        CC_ASSERT(keys.size() == values.size(), "keys and values must have the same size");
+        CC_ASSERT(impl::flat_is_strictly_sorted(keys.data(), keys.size()), "keys must be strictly increasing");
+
+        auto m = btree_map::create_with_resource(resource);
+        isize i = 0;
+        m.bulk_load(keys.size(),
+                    [&](K* key, V* value)
+                    {
+                        new (cc::placement_new, key) K(cc::move(keys[i]));
+                        new (cc::placement_new, value) V(cc::move(values[i]));
+                        ++i;
+                    });
+        return m;
+    }
+
+    // ctors/dtor
+public:
+    btree_map() = default;
+
+    btree_map(std::initializer_list<cc::pair<K, V>> entries)
+    {
+        for (auto const& e : entries)
+            insert_or_assign(e.first, e.second);
+    }
+
+    btree_map(btree_map&& rhs) noexcept
+      : _root(cc::exchange(rhs._root, nullptr)),
+        _first(cc::exchange(rhs._first, nullptr)),
+        _last(cc::exchange(rhs._last, nullptr)),
+        _size(cc::exchange(rhs._size, 0)),
+        _resource(rhs._resource)
+    {
+    }
+    btree_map& operator=(btree_map&& rhs) noexcept
+    {
+        // take ownership from rhs first, rhs might be owned by one of our values
+        auto const new_root = cc::exchange(rhs._root, nullptr);
+        auto const new_first = cc::exchange(rhs._first, nullptr);
+        auto const new_last = cc::exchange(rhs._last, nullptr);
+        auto const new_size = cc::exchange(rhs._size, 0);
+        auto const new_resource = rhs._resource;
+
+        clear();
+
+        _root = new_root;
+        _first = new_first;
+        _last = new_last;
+        _size = new_size;
+        _resource = new_resource;
+        return *this;
+    }
+
+    /// Deep copy with completely filled nodes (bulk-loaded in O(n)), the copy uses the same resource.
+    btree_map(btree_map const& rhs) : _resource(rhs._resource) { bulk_load_copy_of(rhs); }
+    /// Deep copy into this map, the nodes are allocated from our own resource.
+    btree_map& operator=(btree_map const& rhs)
+    {
+        if (this != &rhs)
+        {
+            auto copy = btree_map::create_with_resource(_resource);
+            copy.bulk_load_copy_of(rhs);
+            *this = cc::move(copy);
+        }
+        return *this;
+    }
+
+    ~btree_map() { clear(); }
+
+private:
+    using node_t = impl::btree_node;
+    using leaf_t = impl::btree_leaf<K, V>;
+    using inner_t = impl::btree_inner<K, V>;
+
+    static constexpr isize leaf_min = leaf_t::capacity / 2;
+    static constexpr isize inner_min = inner_t::capacity / 2;
+
+    // an inner node on the way down and the index of the child that was taken
+    struct path_entry
+    {
+        inner_t* node;
+        isize child;
+    };
+
+    [[nodiscard]] static leaf_t* as_leaf(node_t* n) { return static_cast<leaf_t*>(n); }
+    [[nodiscard]] static inner_t* as_inner(node_t* n) { return static_cast<inner_t*>(n); }
+
+    [[nodiscard]] node_allocator& allocator() const { return impl::list_allocator_for(_resource); }
+
+    template <class NodeT>
+    [[nodiscard]] NodeT* allocate_node()
+    {
+        auto const ptr
+            = allocator().allocate_node_bytes(cc::node_class_index_for<NodeT>(), sizeof(NodeT), alignof(NodeT));
+        return new (cc::placement_new, ptr) NodeT();
+    }
+
+    template <class NodeT>
+    static void free_node(NodeT* node)
+    {
+        node->~NodeT();
+        cc::node_allocation_free(reinterpret_cast<cc::byte*>(node), cc::node_class_index_for<NodeT>()); // NOLINT
+    }
+
+    void destroy_subtree(node_t* node)
+    {
+        if (node->is_leaf)
+        {
+            auto const leaf = as_leaf(node);
+            for (isize i = 0; i < leaf->count; ++i)
+            {
+                leaf->keys[i].~K();
+                leaf->values[i].~V();
+            }
+            free_node(leaf);
+        }
+        else
+        {
+            auto const inner = as_inner(node);
+            for (isize i = 0; i <= inner->count; ++i)
+                destroy_subtree(inner->children[i]);
+            for (isize i = 0; i < inner->count; ++i)
+                inner->keys[i].~K();
+            free_node(inner);
+        }
+    }
+
+    // moves an iterator that points past the end of its leaf to the start of the next one
+    [[nodiscard]] static iterator normalized(iterator it)
+    {
+        if (it._idx == it._leaf->count)
+            return {it._leaf->next, 0};
+        return it;
+    }
+
+    // the leaf that contains key if it is present (nullptr if the map has no nodes)
+    template <class KeyT>
+    [[nodiscard]] CC_FORCE_INLINE leaf_t* find_leaf(KeyT const& key) const
+    {
+        auto node = _root;
+        if (node == nullptr)
+            return nullptr;
+        while (!node->is_leaf)
+        {
+            auto const inner = as_inner(node);
+            node = inner->children[impl::btree_search<true>(inner->keys, inner->count, key)];
+        }
+        return as_leaf(node);
+    }
+
+    // like find_leaf but records the path, returns {nullptr, 0} if key is not present
+    template <class KeyT>
+    cc::pair<leaf_t*, isize> locate(KeyT const& key, path_entry* path, isize& depth) const
+    {
+        auto node = _root;
+        if (node == nullptr)
+            return {nullptr, 0};
+        while (!node->is_leaf)
+        {
+            auto const inner = as_inner(node);
+            auto const idx = impl::btree_search<true>(inner->keys, inner->count, key);
+            path[depth++] = {inner, idx};
+            node = inner->children[idx];
+        }
+        auto const leaf = as_leaf(node);
+        auto const pos = impl::btree_search<false>(leaf->keys, leaf->count, key);
+        if (pos < leaf->count && !(key < leaf->keys[pos]))
+            return {leaf, pos};
+        return {nullptr, 0};
+    }
+
+    // returns the slot of key, inserting it with a value constructed from args if it is not present
+    template <class KeyT, class... Args>
+    cc::pair<leaf_t*, isize> find_or_insert(bool& inserted, KeyT&& key, Args&&... args)
+    {
+        if (_root == nullptr)
+        {
+            auto const leaf = allocate_node<leaf_t>();
+            _root = leaf;
+            _first = leaf;
+            _last = leaf;
+        }
+
+        path_entry path[impl::btree_max_depth];
+        isize depth = 0;
+        auto node = _root;
+        while (!node->is_leaf)
+        {
+            auto const inner = as_inner(node);
+            auto const idx = impl::btree_search<true>(inner->keys, inner->count, key);
+            path[depth++] = {inner, idx};
+            node = inner->children[idx];
+        }
+
+        auto const leaf = as_leaf(node);
+        auto const pos = impl::btree_search<false>(leaf->keys, leaf->count, key);
+        if (pos < leaf->count && !(key < leaf->keys[pos]))
+        {
+            inserted = false;
+            return {leaf, pos};
+        }
+
+        // construct before touching the tree, so a throwing constructor leaves it unchanged
+        K k(cc::forward<KeyT>(key));
+        V v(cc::forward<Args>(args)...);
+        inserted = true;
+        return insert_into_leaf(path, depth, leaf, pos, cc::move(k), cc::move(v));
+    }
+
+    // a node of the level that is being built on and the smallest key in its subtree (its separator in the parent)
+    struct bulk_entry
+    {
+        node_t* node;
+        K const* min_key;
+    };
+
+    // calls f(begin, count) for consecutive groups of [0, total) with at most capacity items
+    // groups are full, except that the last two groups share their items if the last one would have less than min_count
+    template <class F>
+    static void for_each_bulk_group(isize total, isize capacity, isize min_count, F&& f)
+    {
+        isize begin = 0;
+        while (begin < total)
+        {
+            auto const remaining = total - begin;
+            auto count = cc::min(capacity, remaining);
+            if (remaining > count && remaining - count < min_count)
+                count = remaining - remaining / 2; // capacity >= 2 * min_count - 1, so both halves are large enough
+            f(begin, count);
+            begin += count;
+        }
+    }
+
+    // builds the tree of an empty map bottom-up from n entries in increasing key order, O(n)
+    // construct_next(key_slot, value_slot) constructs the next entry in place
+    template <class ConstructNextF>
+    void bulk_load(isize n, ConstructNextF&& construct_next)
+    {
+        CC_ASSERT(_root == nullptr, "bulk loading needs an empty map");
+        if (n == 0)
+            return;
+
+        auto level = cc::vector<bulk_entry>::create_with_capacity(cc::int_div_round_up(n, leaf_t::capacity));
+        for_each_bulk_group(n, leaf_t::capacity, leaf_min,
+                            [&](isize, isize count)
+                            {
+                                auto const leaf = allocate_node<leaf_t>();
+                                leaf->prev = _last;
+                                (_last != nullptr ? _last->next : _first) = leaf;
+                                _last = leaf;
+                                for (isize i = 0; i < count; ++i)
+                                {
+                                    construct_next(&leaf->keys[i], &leaf->values[i]);
+                                    ++leaf->count;
+                                    ++_size;
+                                }
+                                level.push_back({leaf, &leaf->keys[0]});
+                            });
+
+        // each inner level is written over the front of the level below, which is consumed left to right
+        while (level.size() > 1)
+        {
+            isize parent_count = 0;
+            for_each_bulk_group(level.size(), inner_t::capacity + 1, inner_min + 1,
+                                [&](isize begin, isize count)
+                                {
+                                    auto const inner = allocate_node<inner_t>();
+                                    inner->children[0] = level[begin].node;
+                                    for (isize i = 1; i < count; ++i)
+                                    {
+                                        new (cc::placement_new, &inner->keys[i - 1]) K(*level[begin + i].min_key);
+                                        inner->children[i] = level[begin + i].node;
+                                        ++inner->count;
+                                    }
+                                    level[parent_count++] = {inner, level[begin].min_key};
+                                });
+            level.resize_down_to(parent_count);
+        }
+        _root = level[0].node;
+    }
+
+    void bulk_load_copy_of(btree_map const& rhs)
+    {
+        auto it = rhs.begin();
+        bulk_load(rhs.size(),
+                  [&](K* key, V* value)
+                  {
+                      auto const [k, v] = *it;
+                      new (cc::placement_new, key) K(k);
+                      new (cc::placement_new, value) V(v);
+                      ++it;
+                  });
+    }
+
+    cc::pair<leaf_t*, isize> insert_into_leaf(path_entry* path,
+                                              isize depth,
+                                              leaf_t* leaf,
+                                              isize pos,
+                                              K&& key,
+                                              V&& value)
+    {
+        ++_size;
+
+        if (leaf->count < leaf_t::capacity)
+        {
+            place_in_leaf(leaf, pos, cc::move(key), cc::move(value));
+            return {leaf, pos};
+        }
+
+        // split the full leaf
+        // appending at the end of the map starts a new leaf instead, so increasing insertions fill nodes completely
+        auto const is_append = leaf == _last && pos == leaf->count;
+        auto const right = allocate_node<leaf_t>();
+        right->prev = leaf;
+        right->next = leaf->next;
+        (leaf->next != nullptr ? leaf->next->prev : _last) = right;
+        leaf->next = right;
+
+        auto target = right;
+        if (is_append)
+            pos = 0;
+        else
+        {
+            auto const half = leaf_t::capacity / 2;
+            impl::btree_relocate(right->keys, leaf->keys + half, leaf->count - half);
+            impl::btree_relocate(right->values, leaf->values + half, leaf->count - half);
+            right->count = u16(leaf->count - half);
+            leaf->count = u16(half);
+            if (pos <= half)
+                target = leaf;
+            else
+                pos -= half;
+        }
+        place_in_leaf(target, pos, cc::move(key), cc::move(value));
+
+        insert_into_parent(path, depth, K(right->keys[0]), right, is_append);
+        return {target, pos};
+    }
+
+    static void place_in_leaf(leaf_t* leaf, isize pos, K&& key, V&& value)
+    {
+        impl::btree_open_gap(leaf->keys, leaf->count, pos);
+        impl::btree_open_gap(leaf->values, leaf->count, pos);
+        new (cc::placement_new, &leaf->keys[pos]) K(cc::move(key));
+        new (cc::placement_new, &leaf->values[pos]) V(cc::move(value));
+        ++leaf->count;
+    }
+
+    // inserts separator key and the new node right of the child taken at path[depth - 1], splitting upwards as needed
+    void insert_into_parent(path_entry* path, isize depth, K key, node_t* right, bool is_append)
+    {
+        while (true)
+        {
+            if (depth == 0)
+            {
+                auto const root = allocate_node<inner_t>();
+                new (cc::placement_new, &root->keys[0]) K(cc::move(key));
+                root->children[0] = _root;
+                root->children[1] = right;
+                root->count = 1;
+                _root = root;
+                return;
+            }
+
+            auto const [inner, idx] = path[--depth];
+            if (inner->count < inner_t::capacity)
+            {
+                place_in_inner(inner, idx, cc::move(key), right);
+                return;
+            }
+
+            // split the full inner node, the middle key moves up
+            // (appends only move the last child over, so the left node stays full)
+            auto const sibling = allocate_node<inner_t>();
+            if (is_append)
+            {
+                CC_ASSERT(idx == inner->count, "appends always take the last child");
+                new (cc::placement_new, &sibling->keys[0]) K(cc::move(key));
+                sibling->children[0] = inner->children[inner->count];
+                sibling->children[1] = right;
+                sibling->count = 1;
+                key = cc::move(inner->keys[inner->count - 1]);
+                inner->keys[inner->count - 1].~K();
+                --inner->count;
+            }
+            else
+            {
+                auto const mid = inner_t::capacity / 2;
+                auto const moved = inner->count - mid - 1;
+                K up(cc::move(inner->keys[mid]));
+                inner->keys[mid].~K();
+                impl::btree_relocate(sibling->keys, inner->keys + mid + 1, moved);
+                for (isize i = 0; i <= moved; ++i)
+                    sibling->children[i] = inner->children[mid + 1 + i];
+                sibling->count = u16(moved);
+                inner->count = u16(mid);
+
+                if (idx <= mid)
+                    place_in_inner(inner, idx, cc::move(key), right);
+                else
+                    place_in_inner(sibling, idx - mid - 1, cc::move(key), right);
+                key = cc::move(up);
+            }
+            right = sibling;
+        }
+    }
+
+    // inserts key at idx and child right of it
+    static void place_in_inner(inner_t* inner, isize idx, K&& key, node_t* child)
+    {
+        impl::btree_open_gap(inner->keys, inner->count, idx);
+        new (cc::placement_new, &inner->keys[idx]) K(cc::move(key));
+        for (isize i = inner->count + 1; i > idx + 1; --i)
+            inner->children[i] = inner->children[i - 1];
+        inner->children[idx + 1] = child;
+        ++inner->count;
+    }
+
+    // removes keys[idx] and children[idx + 1]
+    static void remove_from_inner(inner_t* inner, isize idx)
+    {
+        inner->keys[idx].~K();
+        impl::btree_close_gap(inner->keys, inner->count, idx);
+        for (isize i = idx + 1; i < inner->count; ++i)
+            inner->children[i] = inner->children[i + 1];
+        --inner->count;
+    }
+
+    void erase_at(path_entry* path, isize depth, leaf_t* leaf, isize pos)
+    {
+        leaf->keys[pos].~K();
+        leaf->values[pos].~V();
+        impl::btree_close_gap(leaf->keys, leaf->count, pos);
+        impl::btree_close_gap(leaf->values, leaf->count, pos);
+        --leaf->count;
+        --_size;
+
+        // separators equal to the removed key may stay, they only route lookups
+        node_t* node = leaf;
+        while (depth > 0)
+        {
+            if (node->count >= (node->is_leaf ? leaf_min : inner_min))
+                return;
+
+            // underflow: borrow from a sibling with spare keys, otherwise merge with one
+            // (every parent has at least two children)
+            auto const [parent, ci] = path[--depth];
+            auto const left = ci > 0 ? parent->children[ci - 1] : nullptr;
+            auto const right = ci < parent->count ? parent->children[ci + 1] : nullptr;
+            if (node->is_leaf)
+            {
+                if (left != nullptr && left->count > leaf_min)
+                    return borrow_from_left(parent, ci, as_leaf(left), as_leaf(node));
+                if (right != nullptr && right->count > leaf_min)
+                    return borrow_from_right(parent, ci, as_leaf(node), as_leaf(right));
+                if (left != nullptr)
+                    merge_leaves(parent, ci - 1, as_leaf(left), as_leaf(node));
+                else
+                    merge_leaves(parent, ci, as_leaf(node), as_leaf(right));
+            }
+            else
+            {
+                if (left != nullptr && left->count > inner_min)
+                    return borrow_from_left(parent, ci, as_inner(left), as_inner(node));
+                if (right != nullptr && right->count > inner_min)
+                    return borrow_from_right(parent, ci, as_inner(node), as_inner(right));
+                if (left != nullptr)
+                    merge_inners(parent, ci - 1, as_inner(left), as_inner(node));
+                else
+                    merge_inners(parent, ci, as_inner(node), as_inner(right));
+            }
+            node = parent;
+        }
+
+        // shrink the root
+        if (!_root->is_leaf && _root->count == 0)
+        {
+            auto const old = as_inner(_root);
+            _root = old->children[0];
+            free_node(old);
+        }
+        else if (_root->is_leaf && _root->count == 0)
+        {
+            free_node(as_leaf(_root));
+            _root = nullptr;
+            _first = nullptr;
+            _last = nullptr;
+        }
+    }
+
+    static void borrow_from_left(inner_t* parent, isize ci, leaf_t* left, leaf_t* node)
+    {
+        auto const last = left->count - 1;
+        impl::btree_open_gap(node->keys, node->count, 0);
+        impl::btree_open_gap(node->values, node->count, 0);
+        impl::btree_relocate(node->keys, left->keys + last, 1);
+        impl::btree_relocate(node->values, left->values + last, 1);
+        --left->count;
+        ++node->count;
+        parent->keys[ci - 1] = node->keys[0];
+    }
+
+    static void borrow_from_right(inner_t* parent, isize ci, leaf_t* node, leaf_t* right)
+    {
+        impl::btree_relocate(node->keys + node->count, right->keys, 1);
+        impl::btree_relocate(node->values + node->count, right->values, 1);
+        impl::btree_close_gap(right->keys, right->count, 0);
+        impl::btree_close_gap(right->values, right->count, 0);
+        --right->count;
+        ++node->count;
+        parent->keys[ci] = right->keys[0];
+    }
+
+    // moves all entries of right into left and frees right
+    void merge_leaves(inner_t* parent, isize sep, leaf_t* left, leaf_t* right)
+    {
+        impl::btree_relocate(left->keys + left->count, right->keys, right->count);
+        impl::btree_relocate(left->values + left->count, right->values, right->count);
+        left->count = u16(left->count + right->count);
+        right->count = 0;
+
+        left->next = right->next;
+        (right->next != nullptr ? right->next->prev : _last) = left;
+        free_node(right);
+        remove_from_inner(parent, sep);
+    }
+
+    // the separator rotates through the parent
+    static void borrow_from_left(inner_t* parent, isize ci, inner_t* left, inner_t* node)
+    {
+        impl::btree_open_gap(node->keys, node->count, 0);
+        new (cc::placement_new, &node->keys[0]) K(cc::move(parent->keys[ci - 1]));
+        for (isize i = node->count + 1; i > 0; --i)
+            node->children[i] = node->children[i - 1];
+        node->children[0] = left->children[left->count];
+        ++node->count;
+
+        parent->keys[ci - 1] = cc::move(left->keys[left->count - 1]);
+        left->keys[left->count - 1].~K();
+        --left->count;
+    }
+
+    static void borrow_from_right(inner_t* parent, isize ci, inner_t* node, inner_t* right)
+    {
+        new (cc::placement_new, &node->keys[node->count]) K(cc::move(parent->keys[ci]));
+        node->children[node->count + 1] = right->children[0];
+        ++node->count;
+
+        parent->keys[ci] = cc::move(right->keys[0]);
+        right->keys[0].~K();
+        impl::btree_close_gap(right->keys, right->count, 0);
+        for (isize i = 0; i < right->count; ++i)
+            right->children[i] = right->children[i + 1];
+        --right->count;
+    }
+
+    // pulls the separator down and moves all keys and children of right into left
+    void merge_inners(inner_t* parent, isize sep, inner_t* left, inner_t* right)
+    {
+        new (cc::placement_new, &left->keys[left->count]) K(cc::move(parent->keys[sep]));
+        impl::btree_relocate(left->keys + left->count + 1, right->keys, right->count);
+        for (isize i = 0; i <= right->count; ++i)
+            left->children[left->count + 1 + i] = right->children[i];
+        left->count = u16(left->count + right->count + 1);
+        right->count = 0;
+
+        free_node(right);
+        remove_from_inner(parent, sep);
+    }
+
+private:
+    node_t* _root = nullptr;
+    leaf_t* _first = nullptr;
+    leaf_t* _last = nullptr;
+    isize _size = 0;
+    node_memory_resource* _resource = nullptr;
+};
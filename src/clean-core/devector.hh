@@ -0,0 +1,329 @@
+#pragma once
+
+#include <clean-core/impl/allocating_container.hh>
+
+
+// TODO:
+// - insert/emplace at arbitrary positions (shifting the shorter side)
+// - push_front_range / push_back_range
+// - equality, order, hashing
+
+
+/// Dynamically allocated double-ended vector of T elements with value semantics.
+/// Like cc::vector, but keeps capacity on both sides of the live range, so pushing and popping
+/// at the front is amortized O(1) as well. Elements stay contiguous (data() / size() is a plain span),
+/// which makes it a cache-friendly replacement for deques in sliding windows and work queues.
+///
+/// Growth re-centers the live range: when one side runs out of capacity, the spare capacity is split between
+/// front and back according to the recently observed push direction (a moving average over growth events).
+/// Pure back pushes converge to a vector-like layout, while a queue (push_back + remove_front) keeps recycling
+/// the capacity freed at the front instead of reallocating.
+/// Making room for `count` elements tries, in order:
+///   1. shifting the elements within the allocation, if at most half of it would be in use
+///   2. growing the allocation in place (cc::allocation::try_resize_alloc_inplace)
+///   3. moving the elements to a new allocation with exponential growth
+/// The side that ran out always receives at least a quarter of the spare capacity, so all of these amortize.
+///
+/// Any growth (including the in-place shift) invalidates pointers, references, and iterators.
+/// Constructing from existing elements (e.g. `push_front(d.back())`) is safe during growth.
+///
+/// Usage:
+///   cc::devector<int> window;
+///   for (auto x : samples)
+///   {
+///       window.push_back(x);
+///       if (window.size() > 16)
+///           window.remove_front();
+///   }
+///
+///   cc::devector<task> queue;
+///   queue.push_back(normal_task);
+///   queue.push_front(urgent_task);
+///   auto t = queue.pop_front();
+template <class T>
+struct cc::devector : private cc::allocating_container<T, devector<T>>
+{
+    static_assert(std::is_object_v<T> && !std::is_const_v<T>,
+                  "allocations need to refer to non-const objects, not references/functions/void");
+
+    using base = cc::allocating_container<T, devector<T>>;
+
+    // element access
+public:
+    using base::operator[]; // access element by index
+    using base::back;       // access last element
+    using base::data;       // get pointer to underlying storage
+    using base::front;      // access first element
+
+    // iterators
+public:
+    using base::begin; // get pointer to first element
+    using base::end;   // get pointer to one past last element
+
+    // queries
+public:
+    using base::empty;      // check if devector is empty
+    using base::size;       // get number of elements
+    using base::size_bytes; // get total size in bytes
+
+    // capacity queries
+public:
+    using base::capacity_back;          // get available capacity at back
+    using base::capacity_front;         // get available capacity at front
+    using base::has_capacity_back_for;  // check if capacity exists for N elements at back
+    using base::has_capacity_front_for; // check if capacity exists for N elements at front
+
+    /// Returns the total capacity (elements that fit into the current allocation).
+    /// Note that pushes on one side can only use that side's capacity without re-centering.
+    [[nodiscard]] constexpr isize capacity() const { return capacity_front() + size() + capacity_back(); }
+
+    // factories
+public:
+    using base::create_copy_of;         // create deep copy from span
+    using base::create_defaulted;       // create with default-constructed elements
+    using base::create_filled;          // create with copies of a value
+    using base::create_from_allocation; // create from existing allocation
+    using base::create_uninitialized;   // create with uninitialized memory
+    using base::create_with_capacity;   // create with reserved capacity
+    using base::create_with_resource;   // create empty with specified memory resource
+
+    // appending operations
+public:
+    /// Constructs a new element at the back, re-centering or reallocating if necessary.
+    /// If has_capacity_back_for(1) is true, no invalidation of any kind occurs.
+    /// Amortized O(1) complexity.
+    template <class... Args>
+    constexpr T& emplace_back(Args&&... args)
+    {
+        static_assert(
+            requires { T(cc::forward<Args>(args)...); }, "emplace_back: T is not constructible from "
+                                                         "the provided argument types");
+
+        if (this->has_capacity_back_for(1)) [[likely]]
+            return this->emplace_back_stable(cc::forward<Args>(args)...);
+
+        // construct first: args may refer to elements that are about to move
+        return this->emplace_back_grow(T(cc::forward<Args>(args)...));
+    }
+
+    /// Constructs a new element at the front, re-centering or reallocating if necessary.
+    /// If has_capacity_front_for(1) is true, no invalidation of any kind occurs.
+    /// Amortized O(1) complexity.
+    template <class... Args>
+    constexpr T& emplace_front(Args&&... args)
+    {
+        static_assert(
+            requires { T(cc::forward<Args>(args)...); }, "emplace_front: T is not constructible from "
+                                                         "the provided argument types");
+
+        if (this->has_capacity_front_for(1)) [[likely]]
+            return this->emplace_front_stable(cc::forward<Args>(args)...);
+
+        // construct first: args may refer to elements that are about to move
+        return this->emplace_front_grow(T(cc::forward<Args>(args)...));
+    }
+
+    /// Appends a copy of the element to the back.
+    /// See emplace_back for guarantees and complexity.
+    constexpr T& push_back(T const& value) { return this->emplace_back(value); }
+
+    /// Appends an element to the back via move.
+    /// See emplace_back for guarantees and complexity.
+    constexpr T& push_back(T&& value) { return this->emplace_back(cc::move(value)); }
+
+    /// Prepends a copy of the element to the front.
+    /// See emplace_front for guarantees and complexity.
+    constexpr T& push_front(T const& value) { return this->emplace_front(value); }
+
+    /// Prepends an element to the front via move.
+    /// See emplace_front for guarantees and complexity.
+    constexpr T& push_front(T&& value) { return this->emplace_front(cc::move(value)); }
+
+    using base::emplace_back_stable;  // construct element at back (requires capacity)
+    using base::emplace_front_stable; // construct element at front (requires capacity)
+    using base::push_back_stable;     // add element at back (requires capacity)
+    using base::push_front_stable;    // add element at front (requires capacity)
+
+    // single element removal
+public:
+    using base::pop_back;     // remove and return last element
+    using base::pop_front;    // remove and return first element
+    using base::remove_back;  // remove last element (fast path, no return value)
+    using base::remove_front; // remove first element (fast path, no return value)
+
+    /// Removes and returns the element at the given index.
+    /// Precondition: 0 <= idx < size().
+    /// O(min(idx, size() - idx)) complexity: only the shorter side is shifted.
+    /// NOTE: Prefer remove_at() if you don't need the return value (avoids an extra move).
+    [[nodiscard("use remove_at() if you don't need the return value")]] constexpr T pop_at(isize idx)
+    {
+        CC_ASSERT(0 <= idx && idx < size(), "index out of bounds");
+        auto value = cc::move(data()[idx]);
+        this->remove_at(idx);
+        return value;
+    }
+
+    /// Removes the element at the given index.
+    /// Precondition: 0 <= idx < size().
+    /// O(min(idx, size() - idx)) complexity: only the shorter side is shifted.
+    constexpr void remove_at(isize idx)
+    {
+        CC_ASSERT(0 <= idx && idx < size(), "index out of bounds");
+
+        if (idx >= size() / 2)
+        {
+            base::remove_at(idx);
+            return;
+        }
+
+        // close the gap from the front: [0, idx) moves one slot towards the back
+        auto const obj_start = this->_data.obj_start;
+        impl::compact_move_objects_forward(obj_start + idx + 1, obj_start, obj_start + idx);
+        this->remove_front();
+    }
+
+    using base::pop_at_unordered;    // remove and return element at index (O(1), does not preserve order)
+    using base::remove_at_unordered; // remove element at index (O(1), does not preserve order)
+
+    // range removal
+public:
+    using base::remove_at_range;           // remove range [start, start+count) (preserves order)
+    using base::remove_at_range_unordered; // remove range [start, start+count) (O(count), does not preserve order)
+    using base::remove_from_to;            // remove range [start, end) (preserves order)
+    using base::remove_from_to_unordered;  // remove range [start, end) (O(end-start), does not preserve order)
+
+    // predicate-based removal
+public:
+    using base::remove_all_where;   // remove all elements matching predicate
+    using base::remove_first_where; // remove first element matching predicate
+    using base::remove_last_where;  // remove last element matching predicate
+
+    using base::remove_all_value;   // remove all elements equal to value
+    using base::remove_first_value; // remove first element equal to value
+    using base::remove_last_value;  // remove last element equal to value
+
+    using base::retain_all_where; // retain only elements matching predicate (remove others)
+
+    // resizing operations
+public:
+    using base::resize_down_to;          // shrink to new_size by destroying trailing elements
+    using base::resize_to_constructed;   // resize with custom construction args
+    using base::resize_to_defaulted;     // resize to new_size, default-construct new elements
+    using base::resize_to_filled;        // resize to new_size, fill new elements with value
+    using base::resize_to_uninitialized; // resize to new_size, new elements uninitialized (trivial types only)
+
+    using base::clear_resize_to_constructed;   // clear and resize with custom construction args
+    using base::clear_resize_to_defaulted;     // clear and resize to new_size, default-construct all elements
+    using base::clear_resize_to_filled;        // clear and resize to new_size, fill all elements with value
+    using base::clear_resize_to_uninitialized; // clear and resize, all elements uninitialized (trivial types only)
+
+    // capacity management
+public:
+    using base::reserve_back;        // ensure capacity for N more elements at back (exponential growth)
+    using base::reserve_back_exact;  // ensure capacity for N more elements at back (exact allocation)
+    using base::reserve_front;       // ensure capacity for N more elements at front (exponential growth)
+    using base::reserve_front_exact; // ensure capacity for N more elements at front (exact allocation)
+    using base::shrink_to_fit;       // reduce capacity to match size (drops front capacity)
+
+    // other mutations
+public:
+    using base::clear; // destroy all elements, size becomes 0
+    using base::fill;  // fill all elements with value
+
+    // ctors / allocation management
+public:
+    // devector has deep-copy value semantics
+    using base::base; // inherit constructors (including initializer_list)
+    devector() = default;
+    ~devector() = default;
+    devector(devector&&) = default;
+    devector& operator=(devector&&) = default;
+    devector(devector const&) = default;
+    devector& operator=(devector const&) = default;
+
+    using base::extract_allocation; // extract underlying allocation
+
+    friend base;
+
+private:
+    CC_COLD_FUNC T& emplace_back_grow(T&& value)
+    {
+        this->make_room_for(1, false);
+        return this->emplace_back_stable(cc::move(value));
+    }
+
+    CC_COLD_FUNC T& emplace_front_grow(T&& value)
+    {
+        this->make_room_for(1, true);
+        return this->emplace_front_stable(cc::move(value));
+    }
+
+    /// Makes room for `count` more elements at the front or back (see growth order in the type docs).
+    /// Only called when that side is out of capacity.
+    CC_COLD_FUNC void make_room_for(isize count, bool at_front)
+    {
+        auto& data = this->_data;
+
+        // moving average of the growth direction, updated before splitting so the
+        // requesting side always ends up with at least a quarter of the spare capacity
+        _front_bias = u16((3 * _front_bias + (at_front ? bias_one : 0)) / 4);
+
+        auto const obj_size = this->size();
+        auto const alloc_count = data.alloc_size_bytes() / isize(sizeof(T));
+
+        // 1. plenty of capacity, just on the wrong side:
+        //    shifting obj_size elements buys at least obj_size / 4 pushes on this side
+        if (alloc_count - obj_size - count >= obj_size)
+        {
+            this->recenter_in_place(alloc_count, count, at_front);
+            return;
+        }
+
+        auto const new_size_min = base::alloc_grow_size_for(data.alloc_size_bytes(), (alloc_count + count) * sizeof(T));
+        auto const new_size_max = new_size_min + cc::min(new_size_min, base::alloc_max_slack);
+
+        // 2. in-place growth only adds capacity at the back, front pushes re-center into it
+        if (data.try_resize_alloc_inplace(new_size_min, new_size_max))
+        {
+            if (at_front)
+                this->recenter_in_place(data.alloc_size_bytes() / isize(sizeof(T)), count, at_front);
+            return;
+        }
+
+        // 3. new allocation, split by the actually allocated size
+        auto new_allocation = cc::allocation<T>::create_empty_bytes(new_size_min, new_size_max, base::alloc_alignment,
+                                                                    data.custom_resource);
+        auto const new_count = new_allocation.alloc_size_bytes() / isize(sizeof(T));
+        new_allocation.obj_start += this->front_offset_for(new_count, count, at_front);
+        new_allocation.obj_end = new_allocation.obj_start;
+        impl::move_create_objects_to(new_allocation.obj_end, data.obj_start, data.obj_end);
+        data = cc::move(new_allocation);
+    }
+
+    /// Shifts the live range within the current allocation of alloc_count elements.
+    void recenter_in_place(isize alloc_count, isize count, bool at_front)
+    {
+        auto& data = this->_data;
+        auto const obj_size = this->size();
+        auto const new_start = (T*)data.alloc_start + this->front_offset_for(alloc_count, count, at_front);
+
+        impl::relocate_objects_within(new_start, data.obj_start, data.obj_end);
+        data.obj_start = new_start;
+        data.obj_end = new_start + obj_size;
+    }
+
+    /// Offset of the first element when placing the current elements into alloc_count slots,
+    /// reserving `count` slots on the requested side and splitting the rest by _front_bias.
+    [[nodiscard]] isize front_offset_for(isize alloc_count, isize count, bool at_front) const
+    {
+        auto const spare = alloc_count - this->size() - count;
+        CC_ASSERT(spare >= 0, "allocation too small");
+        return spare * _front_bias / bias_one + (at_front ? count : 0);
+    }
+
+    /// Fixed-point fraction of spare capacity placed at the front (bias_one == 100%).
+    static constexpr isize bias_one = 256;
+
+    /// Starts balanced, then follows the direction of growth events.
+    u16 _front_bias = bias_one / 2;
+};
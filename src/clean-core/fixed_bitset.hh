@@ -1,11 +1,370 @@
 #pragma once
 
+#include <clean-core/bit.hh>
 #include <clean-core/fwd.hh>
+#include <clean-core/macros.hh>
+#include <clean-core/utility.hh>
 
-/// Fixed-size bitset with compile-time size N
-/// Provides efficient storage and manipulation of N boolean flags
+#include <type_traits>
+#include <utility>
+
+namespace cc::impl
+{
+// smallest unsigned word holding N bits, u64 words beyond that
+template <isize N>
+using fixed_bitset_word = std::conditional_t<
+    N <= 8,
+    u8,
+    std::conditional_t<N <= 16, u16, std::conditional_t<N <= 32, u32, u64>>>;
+
+// up to this many words, word loops are fully unrolled (larger loops are left to the vectorizer)
+inline constexpr isize fixed_bitset_unroll_words = 8;
+
+// calls f(w) for every word index w in [0, WordCount)
+template <isize WordCount, class F>
+CC_FORCE_INLINE constexpr void fixed_bitset_for_each_word(F&& f)
+{
+    if constexpr (WordCount <= fixed_bitset_unroll_words)
+        [&]<isize... W>(std::integer_sequence<isize, W...>)
+        {
+            (f(W), ...);
+        }(std::make_integer_sequence<isize, WordCount>());
+    else
+        for (isize w = 0; w < WordCount; ++w)
+            f(w);
+}
+
+/// Iterates the indices of set bits of a fixed word array (clear lowest bit + count trailing zeroes).
+template <class WordT, isize WordCount>
+struct fixed_set_bit_iterator
+{
+    WordT const* words;
+    isize word_idx;
+    WordT bits; // remaining set bits of words[word_idx]
+
+    [[nodiscard]] constexpr isize operator*() const
+    {
+        return word_idx * isize(8 * sizeof(WordT)) + cc::count_trailing_zeroes(bits);
+    }
+
+    constexpr fixed_set_bit_iterator& operator++()
+    {
+        bits = WordT(bits & (bits - 1));
+        while (bits == 0 && ++word_idx < WordCount)
+            bits = words[word_idx];
+        return *this;
+    }
+
+    [[nodiscard]] friend constexpr bool operator==(fixed_set_bit_iterator const& it, cc::sentinel)
+    {
+        return it.bits == 0;
+    }
+
+    [[nodiscard]] static constexpr fixed_set_bit_iterator create_begin(WordT const* words)
+    {
+        fixed_set_bit_iterator it = {words, 0, words[0]};
+        while (it.bits == 0 && ++it.word_idx < WordCount)
+            it.bits = words[it.word_idx];
+        return it;
+    }
+};
+
+/// Owns a copy of the words, so iterating the set bits of a temporary bitset is safe.
+template <class WordT, isize WordCount>
+struct fixed_set_bit_range
+{
+    WordT words[WordCount];
+
+    [[nodiscard]] constexpr fixed_set_bit_iterator<WordT, WordCount> begin() const
+    {
+        return fixed_set_bit_iterator<WordT, WordCount>::create_begin(words);
+    }
+    [[nodiscard]] constexpr cc::sentinel end() const { return {}; }
+};
+} // namespace cc::impl
+
+/// Fixed-size bitset with compile-time size N, stored inline.
+///
+/// Bit i lives in word i / bits_per_word at position i % bits_per_word (least significant first).
+/// Bits past N in the last word are always zero.
+///
+/// Performance design:
+///   - the word type is the smallest unsigned integer holding N bits (u8 .. u64), u64 words above that,
+///     so for N <= 64 every operation is a single integer op on one register
+///   - word loops are fully unrolled up to 8 words (512 bits)
+///   - everything is constexpr and branch-free where possible (e.g. set(i, value))
+///
+/// Usage:
+///   cc::fixed_bitset<100> visible;
+///   visible.set(3);
+///   visible |= other;
+///   for (isize i : visible.set_bits())
+///       draw(i);
 template <cc::isize N>
 struct cc::fixed_bitset
 {
-    // TODO: implement fixed_bitset
+    static_assert(N >= 0, "fixed_bitset size must be non-negative");
+
+    using word_t = impl::fixed_bitset_word<N>;
+
+    static constexpr isize bits_per_word = 8 * sizeof(word_t);
+    static constexpr isize word_count = N == 0 ? 1 : (N + bits_per_word - 1) / bits_per_word;
+
+    // queries
+public:
+    /// Number of bits (compile-time constant N).
+    [[nodiscard]] static constexpr isize size() { return N; }
+
+    /// Value of bit i.
+    [[nodiscard]] constexpr bool test(isize i) const
+    {
+        CC_ASSERT(0 <= i && i < N, "bit index out of bounds");
+        return (_words[i / bits_per_word] >> (i % bits_per_word)) & 1;
+    }
+    [[nodiscard]] constexpr bool operator[](isize i) const { return test(i); }
+
+    /// Number of set bits.
+    [[nodiscard]] constexpr isize count() const
+    {
+        isize c = 0;
+        impl::fixed_bitset_for_each_word<word_count>([&](isize w) { c += cc::popcount(_words[w]); });
+        return c;
+    }
+
+    /// True if any / no / every bit is set (all() and none() are true for N == 0).
+    [[nodiscard]] constexpr bool any() const
+    {
+        word_t acc = 0;
+        impl::fixed_bitset_for_each_word<word_count>([&](isize w) { acc |= _words[w]; });
+        return acc != 0;
+    }
+    [[nodiscard]] constexpr bool none() const { return !any(); }
+    [[nodiscard]] constexpr bool all() const
+    {
+        auto r = true;
+        impl::fixed_bitset_for_each_word<word_count>([&](isize w) { r &= _words[w] == word_mask(w); });
+        return r;
+    }
+
+    /// Index of the first set bit, or -1 if there is none.
+    [[nodiscard]] constexpr isize find_first() const
+    {
+        if constexpr (word_count == 1)
+            return _words[0] == 0 ? -1 : cc::count_trailing_zeroes(_words[0]);
+        else
+            return find_from(0);
+    }
+
+    /// Index of the first set bit after pos (pos itself excluded, pos may be -1), or -1 if there is none.
+    [[nodiscard]] constexpr isize find_next(isize pos) const
+    {
+        CC_ASSERT(-1 <= pos && pos < N, "bit index out of bounds");
+        return pos + 1 >= N ? -1 : find_from(pos + 1);
+    }
+
+    /// Word wi of the underlying storage.
+    [[nodiscard]] constexpr word_t word(isize wi) const
+    {
+        CC_ASSERT(0 <= wi && wi < word_count, "word index out of bounds");
+        return _words[wi];
+    }
+
+    /// Pointer to the word_count words of the underlying storage.
+    [[nodiscard]] constexpr word_t const* word_data() const { return _words; }
+
+    [[nodiscard]] constexpr bool operator==(fixed_bitset const& rhs) const = default;
+
+    // iteration
+public:
+    /// Range over the indices of all set bits in ascending order (holds a copy of the bits).
+    /// Usage:
+    ///   for (isize i : bits.set_bits())
+    ///       ...
+    [[nodiscard]] constexpr impl::fixed_set_bit_range<word_t, word_count> set_bits() const
+    {
+        impl::fixed_set_bit_range<word_t, word_count> r = {};
+        impl::fixed_bitset_for_each_word<word_count>([&](isize w) { r.words[w] = _words[w]; });
+        return r;
+    }
+
+    /// Calls f(isize index) for every set bit in ascending order.
+    template <class F>
+    constexpr void for_each_set_bit(F&& f) const
+    {
+        for (isize w = 0; w < word_count; ++w)
+        {
+            auto bits = _words[w];
+            while (bits != 0)
+            {
+                f(w * bits_per_word + cc::count_trailing_zeroes(bits));
+                bits = word_t(bits & (bits - 1));
+            }
+        }
+    }
+
+    // single bits
+public:
+    constexpr void set(isize i)
+    {
+        CC_ASSERT(0 <= i && i < N, "bit index out of bounds");
+        _words[i / bits_per_word] |= bit_of(i);
+    }
+
+    /// Sets bit i to value (branchless).
+    constexpr void set(isize i, bool value)
+    {
+        CC_ASSERT(0 <= i && i < N, "bit index out of bounds");
+        auto& word = _words[i / bits_per_word];
+        auto const mask = bit_of(i);
+        word = word_t((word & ~mask) | (word_t(-word_t(value)) & mask));
+    }
+
+    constexpr void clear(isize i)
+    {
+        CC_ASSERT(0 <= i && i < N, "bit index out of bounds");
+        _words[i / bits_per_word] &= word_t(~bit_of(i));
+    }
+
+    constexpr void flip(isize i)
+    {
+        CC_ASSERT(0 <= i && i < N, "bit index out of bounds");
+        _words[i / bits_per_word] ^= bit_of(i);
+    }
+
+    /// Sets word wi of the underlying storage, bits past N are dropped.
+    constexpr void set_word(isize wi, word_t bits)
+    {
+        CC_ASSERT(0 <= wi && wi < word_count, "word index out of bounds");
+        _words[wi] = bits & word_mask(wi);
+    }
+
+    // all bits
+public:
+    constexpr void set_all()
+    {
+        impl::fixed_bitset_for_each_word<word_count>([&](isize w) { _words[w] = word_mask(w); });
+    }
+    constexpr void clear_all()
+    {
+        impl::fixed_bitset_for_each_word<word_count>([&](isize w) { _words[w] = 0; });
+    }
+    constexpr void flip_all()
+    {
+        impl::fixed_bitset_for_each_word<word_count>([&](isize w) { _words[w] = word_t(~_words[w]) & word_mask(w); });
+    }
+
+    // bitwise operations
+public:
+    constexpr fixed_bitset& operator&=(fixed_bitset const& rhs)
+    {
+        impl::fixed_bitset_for_each_word<word_count>([&](isize w) { _words[w] &= rhs._words[w]; });
+        return *this;
+    }
+    constexpr fixed_bitset& operator|=(fixed_bitset const& rhs)
+    {
+        impl::fixed_bitset_for_each_word<word_count>([&](isize w) { _words[w] |= rhs._words[w]; });
+        return *this;
+    }
+    constexpr fixed_bitset& operator^=(fixed_bitset const& rhs)
+    {
+        impl::fixed_bitset_for_each_word<word_count>([&](isize w) { _words[w] ^= rhs._words[w]; });
+        return *this;
+    }
+
+    /// Clears every bit that is set in rhs (this &= ~rhs).
+    constexpr fixed_bitset& and_not(fixed_bitset const& rhs)
+    {
+        impl::fixed_bitset_for_each_word<word_count>([&](isize w) { _words[w] &= word_t(~rhs._words[w]); });
+        return *this;
+    }
+
+    /// True if any bit is set in both (without materializing the intersection).
+    [[nodiscard]] constexpr bool intersects(fixed_bitset const& rhs) const
+    {
+        word_t acc = 0;
+        impl::fixed_bitset_for_each_word<word_count>([&](isize w) { acc |= _words[w] & rhs._words[w]; });
+        return acc != 0;
+    }
+
+    /// True if every bit set in rhs is also set here.
+    [[nodiscard]] constexpr bool contains(fixed_bitset const& rhs) const
+    {
+        word_t acc = 0;
+        impl::fixed_bitset_for_each_word<word_count>([&](isize w) { acc |= rhs._words[w] & word_t(~_words[w]); });
+        return acc == 0;
+    }
+
+    [[nodiscard]] friend constexpr fixed_bitset operator&(fixed_bitset lhs, fixed_bitset const& rhs)
+    {
+        return lhs &= rhs;
+    }
+    [[nodiscard]] friend constexpr fixed_bitset operator|(fixed_bitset lhs, fixed_bitset const& rhs)
+    {
+        return lhs |= rhs;
+    }
+    [[nodiscard]] friend constexpr fixed_bitset operator^(fixed_bitset lhs, fixed_bitset const& rhs)
+    {
+        return lhs ^= rhs;
+    }
+    [[nodiscard]] friend constexpr fixed_bitset operator~(fixed_bitset b)
+    {
+        b.flip_all();
+        return b;
+    }
+
+    // factories
+public:
+    /// Creates a bitset with all N bits set to value.
+    [[nodiscard]] static constexpr fixed_bitset create_filled(bool value)
+    {
+        fixed_bitset b;
+        if (value)
+            b.set_all();
+        return b;
+    }
+
+    /// Creates a bitset from the low N bits of an integer (bit i is (bits >> i) & 1).
+    [[nodiscard]] static constexpr fixed_bitset create_from_bits(u64 bits)
+        requires(N <= 64)
+    {
+        fixed_bitset b;
+        b._words[0] = word_t(bits) & word_mask(0);
+        return b;
+    }
+
+    /// The bits as one integer (requires N <= 64).
+    [[nodiscard]] constexpr word_t to_bits() const
+        requires(N <= 64)
+    {
+        return _words[0];
+    }
+
+private:
+    // valid bits of word w: all but the last word are full
+    static constexpr word_t last_word_mask
+        = N == 0 ? word_t(0)
+                 : N % bits_per_word == 0 ? word_t(~word_t(0)) : word_t((word_t(1) << (N % bits_per_word)) - 1);
+
+    [[nodiscard]] static constexpr word_t word_mask(isize w)
+    {
+        return w == word_count - 1 ? last_word_mask : word_t(~word_t(0));
+    }
+
+    [[nodiscard]] static constexpr word_t bit_of(isize i) { return word_t(word_t(1) << (i % bits_per_word)); }
+
+    // first set bit at or after start (start < N), -1 if none
+    [[nodiscard]] constexpr isize find_from(isize start) const
+    {
+        auto wi = start / bits_per_word;
+        auto bits = word_t(_words[wi] & word_t(~word_t(0) << (start % bits_per_word)));
+        while (bits == 0)
+        {
+            if (++wi == word_count)
+                return -1;
+            bits = _words[wi];
+        }
+        return wi * bits_per_word + cc::count_trailing_zeroes(bits);
+    }
+
+    word_t _words[word_count] = {};
 };
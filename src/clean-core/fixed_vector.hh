@@ -1,27 +1,549 @@
 #pragma once
 
 #include <clean-core/fwd.hh>
+#include <clean-core/impl/object_lifetime_util.hh>
+#include <clean-core/optional.hh>
+#include <clean-core/span.hh>
+#include <clean-core/utility.hh>
+
+#include <initializer_list>
+#include <type_traits>
 
 // TODO:
-// - implement fixed_vector body
 // - equality, order, hashing
 
+namespace cc::impl
+{
+// smallest unsigned integer holding [0, N]
+template <isize N>
+using fixed_vector_size_t = std::conditional_t<
+    N <= 0xFF,
+    u8,
+    std::conditional_t<N <= 0xFFFF, u16, std::conditional_t<N <= 0xFFFF'FFFF, u32, u64>>>;
+} // namespace cc::impl
 
 /// Fixed-capacity vector of up to N elements of type T.
 /// Similar to a vector but with compile-time maximum capacity.
 /// Does not perform dynamic allocation - all storage is inline.
 /// Supports runtime variable size up to the fixed capacity N.
+///
+/// Performance design:
+///   - storage is N * sizeof(T) uninitialized bytes followed by the size, stored in the smallest
+///     unsigned integer that can hold N (e.g. a u8 for N <= 255), so there is no pointer and no capacity field
+///   - if T is trivially copyable, so is fixed_vector<T, N>: it can be memcpy'd, stored in shared memory,
+///     or bulk-copied as part of a larger trivially copyable struct (copies always copy all N slots)
+///   - elements never move on their own, so pointers stay valid until the element itself is removed or shifted
+///
+/// Exceeding the capacity is a precondition violation (asserted), try_emplace_back / try_push_back
+/// report a full vector instead.
+///
+/// Usage:
+///   struct particle { cc::fixed_vector<u32, 6> neighbors; ... };
+///   p.neighbors.push_back(idx);
+///   p.neighbors.remove_all_value(removed_idx);
 template <class T, cc::isize N>
 struct cc::fixed_vector
 {
-    // TODO: implement fixed_vector
-    // Should have:
-    // - inline storage for N elements
-    // - runtime size tracking
-    // - push_back/pop_back operations (without allocation)
-    // - element access (operator[], front, back, data)
-    // - iterators (begin, end)
-    // - queries (size, empty, capacity)
-    // - modifiers (clear, emplace_back, etc.)
-    // - similar interface to cc::vector but with fixed capacity
+    static_assert(std::is_object_v<T> && !std::is_const_v<T>,
+                  "fixed_vector elements need to be non-const objects, not references/functions/void");
+    static_assert(N > 0, "fixed_vector capacity must be positive");
+
+    // element access
+public:
+    /// Returns a reference to the element at index i.
+    /// Precondition: 0 <= i < size().
+    [[nodiscard]] T& operator[](isize i)
+    {
+        CC_ASSERT(0 <= i && i < isize(_size), "index out of bounds");
+        return data()[i];
+    }
+    [[nodiscard]] T const& operator[](isize i) const
+    {
+        CC_ASSERT(0 <= i && i < isize(_size), "index out of bounds");
+        return data()[i];
+    }
+
+    /// Returns a reference to the first element.
+    /// Precondition: !empty().
+    [[nodiscard]] T& front()
+    {
+        CC_ASSERT(_size > 0, "cannot access front of empty fixed_vector");
+        return data()[0];
+    }
+    [[nodiscard]] T const& front() const
+    {
+        CC_ASSERT(_size > 0, "cannot access front of empty fixed_vector");
+        return data()[0];
+    }
+
+    /// Returns a reference to the last element.
+    /// Precondition: !empty().
+    [[nodiscard]] T& back()
+    {
+        CC_ASSERT(_size > 0, "cannot access back of empty fixed_vector");
+        return data()[_size - 1];
+    }
+    [[nodiscard]] T const& back() const
+    {
+        CC_ASSERT(_size > 0, "cannot access back of empty fixed_vector");
+        return data()[_size - 1];
+    }
+
+    /// Returns a pointer to the inline storage.
+    [[nodiscard]] T* data() { return reinterpret_cast<T*>(_storage); }
+    [[nodiscard]] T const* data() const { return reinterpret_cast<T const*>(_storage); }
+
+    // iterators
+public:
+    [[nodiscard]] T* begin() { return data(); }
+    [[nodiscard]] T* end() { return data() + _size; }
+    [[nodiscard]] T const* begin() const { return data(); }
+    [[nodiscard]] T const* end() const { return data() + _size; }
+
+    // queries
+public:
+    /// Returns the number of elements.
+    [[nodiscard]] constexpr isize size() const { return isize(_size); }
+    /// Returns the size in bytes of the live elements.
+    [[nodiscard]] constexpr isize size_bytes() const { return isize(_size) * isize(sizeof(T)); }
+    [[nodiscard]] constexpr bool empty() const { return _size == 0; }
+    /// True if no more elements fit.
+    [[nodiscard]] constexpr bool full() const { return isize(_size) == N; }
+
+    /// Returns the compile-time capacity N.
+    [[nodiscard]] static constexpr isize capacity() { return N; }
+    /// Returns how many more elements fit.
+    [[nodiscard]] constexpr isize capacity_back() const { return N - isize(_size); }
+    [[nodiscard]] constexpr bool has_capacity_back_for(isize count) const { return count <= N - isize(_size); }
+
+    // factories
+public:
+    /// Creates a fixed_vector with "size" many default-constructed elements.
+    [[nodiscard]] static fixed_vector create_defaulted(isize size)
+    {
+        fixed_vector v;
+        v.resize_to_defaulted(size);
+        return v;
+    }
+
+    /// Creates a fixed_vector with "size" many copies of value.
+    [[nodiscard]] static fixed_vector create_filled(isize size, T const& value)
+    {
+        fixed_vector v;
+        v.resize_to_filled(size, value);
+        return v;
+    }
+
+    /// Creates a fixed_vector with "size" many uninitialized elements (only for trivial types).
+    [[nodiscard]] static fixed_vector create_uninitialized(isize size)
+    {
+        fixed_vector v;
+        v.resize_to_uninitialized(size);
+        return v;
+    }
+
+    /// Creates a fixed_vector holding copies of the elements of source.
+    [[nodiscard]] static fixed_vector create_copy_of(cc::span<T const> source)
+    {
+        CC_ASSERT(source.size() <= N, "source does not fit into fixed_vector");
+        fixed_vector v;
+        auto end = v.data();
+        impl::copy_create_objects_to(end, source.data(), source.data() + source.size());
+        v._size = size_type(source.size());
+        return v;
+    }
+
+    // appending operations
+public:
+    /// Constructs an element in place at the back.
+    /// Precondition: !full().
+    /// O(1), never moves other elements.
+    template <class... Args>
+    T& emplace_back(Args&&... args)
+    {
+        static_assert(
+            requires { T(cc::forward<Args>(args)...); }, "emplace_back: T is not constructible from "
+                                                         "the provided argument types");
+        CC_ASSERT(isize(_size) < N, "fixed_vector is full");
+        auto const p = new (cc::placement_new, data() + _size) T(cc::forward<Args>(args)...);
+        ++_size; // _after_ so exceptions in T(...) leave state valid
+        return *p;
+    }
+
+    T& push_back(T const& value) { return this->emplace_back(value); }
+    T& push_back(T&& value) { return this->emplace_back(cc::move(value)); }
+
+    /// Constructs an element at the back if there is room.
+    /// Returns a pointer to the new element, or nullptr if the vector was full (args are then unused).
+    template <class... Args>
+    T* try_emplace_back(Args&&... args)
+    {
+        if (isize(_size) == N)
+            return nullptr;
+        return &this->emplace_back(cc::forward<Args>(args)...);
+    }
+
+    T* try_push_back(T const& value) { return this->try_emplace_back(value); }
+    T* try_push_back(T&& value) { return this->try_emplace_back(cc::move(value)); }
+
+    // single element removal
+public:
+    /// Removes and returns the last element by move.
+    /// Precondition: !empty().
+    [[nodiscard("use remove_back() if you don't need the return value")]] T pop_back()
+    {
+        CC_ASSERT(_size > 0, "cannot pop from empty container");
+        auto value = cc::move(back());
+        remove_back();
+        return value;
+    }
+
+    /// Removes the last element.
+    /// Precondition: !empty().
+    void remove_back()
+    {
+        CC_ASSERT(_size > 0, "cannot remove from empty container");
+        --_size;
+        data()[_size].~T();
+    }
+
+    /// Removes and returns the element at the given index, preserving order.
+    /// O(n) complexity due to element compaction.
+    [[nodiscard("use remove_at() if you don't need the return value")]] T pop_at(isize idx)
+    {
+        CC_ASSERT(0 <= idx && idx < isize(_size), "index out of bounds");
+        auto value = cc::move(data()[idx]);
+        remove_at(idx);
+        return value;
+    }
+
+    /// Removes the element at the given index, preserving order.
+    /// O(n) complexity due to element compaction (a memmove for trivially copyable T).
+    void remove_at(isize idx)
+    {
+        CC_ASSERT(0 <= idx && idx < isize(_size), "index out of bounds");
+        impl::compact_move_objects_backward(data() + idx, data() + idx + 1, end());
+        remove_back();
+    }
+
+    /// Removes and returns the element at the given index by moving the last element into its place.
+    /// Does not preserve relative order of elements. O(1).
+    [[nodiscard("use remove_at_unordered() if you don't need the return value")]] T pop_at_unordered(isize idx)
+    {
+        CC_ASSERT(0 <= idx && idx < isize(_size), "index out of bounds");
+        auto value = cc::move(data()[idx]);
+        remove_at_unordered(idx);
+        return value;
+    }
+
+    /// Removes the element at the given index by moving the last element into its place.
+    /// Does not preserve relative order of elements. O(1).
+    void remove_at_unordered(isize idx)
+    {
+        CC_ASSERT(0 <= idx && idx < isize(_size), "index out of bounds");
+        --_size;
+        auto const last = data() + _size;
+        if (data() + idx != last)
+            data()[idx] = cc::move(*last);
+        last->~T();
+    }
+
+    // range removal
+public:
+    /// Removes [start, start + count) by moving the last count elements into the gap. O(count).
+    void remove_at_range_unordered(isize start, isize count)
+    {
+        CC_ASSERT(0 <= start && 0 <= count && start + count <= isize(_size), "range out of bounds");
+        if (count == 0)
+            return;
+        // the tail may overlap the gap, so only move the part of it that lies behind the gap
+        auto const tail_start = cc::max(start + count, isize(_size) - count);
+        impl::compact_move_objects_backward(data() + start, data() + tail_start, end());
+        resize_down_to(isize(_size) - count);
+    }
+
+    /// Removes [start, end) by moving the last elements into the gap. O(end - start).
+    void remove_from_to_unordered(isize start, isize end)
+    {
+        CC_ASSERT(0 <= start && start <= end && end <= isize(_size), "range out of bounds");
+        this->remove_at_range_unordered(start, end - start);
+    }
+
+    /// Removes [start, start + count) while preserving relative order.
+    void remove_at_range(isize start, isize count)
+    {
+        CC_ASSERT(0 <= start && 0 <= count && start + count <= isize(_size), "range out of bounds");
+        if (count == 0)
+            return;
+        impl::compact_move_objects_backward(data() + start, data() + start + count, this->end());
+        resize_down_to(isize(_size) - count);
+    }
+
+    /// Removes [start, end) while preserving relative order.
+    void remove_from_to(isize start, isize end)
+    {
+        CC_ASSERT(0 <= start && start <= end && end <= isize(_size), "range out of bounds");
+        this->remove_at_range(start, end - start);
+    }
+
+    // predicate-based removal
+public:
+    /// Removes all elements for which the predicate returns true, preserving the order of the others.
+    /// Predicate is invoked as pred(element) or pred(idx, element).
+    /// Returns the number of removed elements.
+    template <class Pred>
+    isize remove_all_where(Pred&& pred)
+    {
+        static_assert(cc::is_invocable_r<bool, Pred, T&> || cc::is_invocable_r<bool, Pred, isize, T&>,
+                      "remove_all_where: predicate must be invocable with T& or (isize, T&) and return bool");
+        return compact_where([&](isize idx, T& e) { return !cc::invoke_with_optional_idx(idx, pred, e); });
+    }
+
+    /// Removes the first element for which the predicate returns true.
+    /// Returns the index of the removed element, or cc::nullopt if no element matched.
+    template <class Pred>
+    cc::optional<isize> remove_first_where(Pred&& pred)
+    {
+        static_assert(cc::is_invocable_r<bool, Pred, T&> || cc::is_invocable_r<bool, Pred, isize, T&>,
+                      "remove_first_where: predicate must be invocable with T& or (isize, T&) and return bool");
+        for (isize i = 0; i < isize(_size); ++i)
+            if (cc::invoke_with_optional_idx(i, pred, data()[i]))
+            {
+                remove_at(i);
+                return i;
+            }
+        return cc::nullopt;
+    }
+
+    /// Removes the last element for which the predicate returns true.
+    /// Returns the index of the removed element, or cc::nullopt if no element matched.
+    template <class Pred>
+    cc::optional<isize> remove_last_where(Pred&& pred)
+    {
+        static_assert(cc::is_invocable_r<bool, Pred, T&> || cc::is_invocable_r<bool, Pred, isize, T&>,
+                      "remove_last_where: predicate must be invocable with T& or (isize, T&) and return bool");
+        for (isize i = isize(_size) - 1; i >= 0; --i)
+            if (cc::invoke_with_optional_idx(i, pred, data()[i]))
+            {
+                remove_at(i);
+                return i;
+            }
+        return cc::nullopt;
+    }
+
+    /// Removes all elements equal to value, returns how many were removed.
+    isize remove_all_value(T const& value)
+    {
+        static_assert(requires { bool(value == value); }, "remove_all_value: T must support operator==");
+        return this->remove_all_where([&value](T const& elem) { return elem == value; });
+    }
+
+    /// Removes the first element equal to value, returns its index or cc::nullopt.
+    cc::optional<isize> remove_first_value(T const& value)
+    {
+        static_assert(requires { bool(value == value); }, "remove_first_value: T must support operator==");
+        return this->remove_first_where([&value](T const& elem) { return elem == value; });
+    }
+
+    /// Removes the last element equal to value, returns its index or cc::nullopt.
+    cc::optional<isize> remove_last_value(T const& value)
+    {
+        static_assert(requires { bool(value == value); }, "remove_last_value: T must support operator==");
+        return this->remove_last_where([&value](T const& elem) { return elem == value; });
+    }
+
+    /// Keeps only the elements for which the predicate returns true, preserving their order.
+    /// Returns the number of removed elements.
+    template <class Pred>
+    isize retain_all_where(Pred&& pred)
+    {
+        static_assert(cc::is_invocable_r<bool, Pred, T&> || cc::is_invocable_r<bool, Pred, isize, T&>,
+                      "retain_all_where: predicate must be invocable with T& or (isize, T&) and return bool");
+        return compact_where([&](isize idx, T& e) { return bool(cc::invoke_with_optional_idx(idx, pred, e)); });
+    }
+
+    // resizing operations
+public:
+    /// Shrinks to new_size by destroying trailing elements.
+    /// Precondition: new_size <= size().
+    void resize_down_to(isize new_size)
+    {
+        CC_ASSERT(0 <= new_size && new_size <= isize(_size), "resize_down_to: new_size must be <= size()");
+        impl::destroy_objects_in_reverse(data() + new_size, end());
+        _size = size_type(new_size);
+    }
+
+    /// Resizes to new_size, new elements are constructed as T(args...) (args are not forwarded).
+    /// Precondition: new_size <= N.
+    template <class... Args>
+    void resize_to_constructed(isize new_size, Args&&... args)
+    {
+        static_assert(
+            requires { T(args...); }, "resize_to_constructed: T is not constructible from the provided "
+                                      "argument types");
+        CC_ASSERT(0 <= new_size && new_size <= N, "new size exceeds fixed_vector capacity");
+        if (new_size <= isize(_size))
+        {
+            resize_down_to(new_size);
+            return;
+        }
+        while (isize(_size) < new_size)
+        {
+            new (cc::placement_new, data() + _size) T(args...);
+            ++_size;
+        }
+    }
+
+    void resize_to_defaulted(isize new_size)
+    {
+        static_assert(std::is_default_constructible_v<T>, "resize_to_defaulted requires T to be default constructible");
+        this->resize_to_constructed(new_size);
+    }
+
+    void resize_to_filled(isize new_size, T const& value)
+    {
+        static_assert(std::is_copy_constructible_v<T>, "resize_to_filled requires T to be copy constructible");
+        this->resize_to_constructed(new_size, value);
+    }
+
+    /// Resizes to new_size, new elements are left uninitialized (trivial types only).
+    void resize_to_uninitialized(isize new_size)
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "resize_to_uninitialized requires T to be trivially copyable");
+        static_assert(std::is_trivially_destructible_v<T>, "resize_to_uninitialized requires T to be trivially "
+                                                           "destructible");
+        CC_ASSERT(0 <= new_size && new_size <= N, "new size exceeds fixed_vector capacity");
+        _size = size_type(new_size);
+    }
+
+    template <class... Args>
+    void clear_resize_to_constructed(isize new_size, Args&&... args)
+    {
+        this->clear();
+        this->resize_to_constructed(new_size, args...);
+    }
+    void clear_resize_to_defaulted(isize new_size)
+    {
+        this->clear();
+        this->resize_to_defaulted(new_size);
+    }
+    void clear_resize_to_filled(isize new_size, T const& value)
+    {
+        this->clear();
+        this->resize_to_filled(new_size, value);
+    }
+    void clear_resize_to_uninitialized(isize new_size)
+    {
+        this->clear();
+        this->resize_to_uninitialized(new_size);
+    }
+
+    // other mutations
+public:
+    /// Destroys all elements, size becomes 0.
+    void clear()
+    {
+        impl::destroy_objects_in_reverse(data(), end());
+        _size = 0;
+    }
+
+    /// Copies value into every element.
+    void fill(T const& value)
+    {
+        for (auto& e : *this)
+            e = value;
+    }
+
+    // ctors
+public:
+    fixed_vector() = default;
+
+    fixed_vector(std::initializer_list<T> init)
+    {
+        CC_ASSERT(isize(init.size()) <= N, "initializer list does not fit into fixed_vector");
+        auto end = data();
+        impl::copy_create_objects_to(end, init.begin(), init.end());
+        _size = size_type(init.size());
+    }
+
+    // trivially copyable T: all special members are trivial, copies are a plain copy of the whole object
+    fixed_vector(fixed_vector const&)
+        requires std::is_trivially_copyable_v<T>
+    = default;
+    fixed_vector(fixed_vector&&)
+        requires std::is_trivially_copyable_v<T>
+    = default;
+    fixed_vector& operator=(fixed_vector const&)
+        requires std::is_trivially_copyable_v<T>
+    = default;
+    fixed_vector& operator=(fixed_vector&&)
+        requires std::is_trivially_copyable_v<T>
+    = default;
+    ~fixed_vector()
+        requires std::is_trivially_destructible_v<T>
+    = default;
+
+    // otherwise: element-wise, moved-from vectors are empty
+    fixed_vector(fixed_vector const& rhs)
+    {
+        auto end = data();
+        impl::copy_create_objects_to(end, rhs.data(), rhs.data() + rhs._size);
+        _size = rhs._size;
+    }
+    fixed_vector(fixed_vector&& rhs) noexcept(std::is_nothrow_move_constructible_v<T>)
+    {
+        auto end = data();
+        impl::move_create_objects_to(end, rhs.data(), rhs.data() + rhs._size);
+        _size = rhs._size;
+        rhs.clear();
+    }
+    fixed_vector& operator=(fixed_vector const& rhs)
+    {
+        if (this != &rhs)
+        {
+            clear();
+            auto end = data();
+            impl::copy_create_objects_to(end, rhs.data(), rhs.data() + rhs._size);
+            _size = rhs._size;
+        }
+        return *this;
+    }
+    fixed_vector& operator=(fixed_vector&& rhs) noexcept(std::is_nothrow_move_constructible_v<T>)
+    {
+        if (this != &rhs)
+        {
+            clear();
+            auto end = data();
+            impl::move_create_objects_to(end, rhs.data(), rhs.data() + rhs._size);
+            _size = rhs._size;
+            rhs.clear();
+        }
+        return *this;
+    }
+    ~fixed_vector() { clear(); }
+
+private:
+    using size_type = impl::fixed_vector_size_t<N>;
+
+    // single pass compaction: keeps elements where keep(idx, elem) is true, returns the number removed
+    template <class KeepF>
+    isize compact_where(KeepF&& keep)
+    {
+        auto const p = data();
+        auto const count = isize(_size);
+        isize write = 0;
+        for (isize read = 0; read < count; ++read)
+        {
+            if (!keep(read, p[read]))
+                continue;
+            if (write != read)
+                p[write] = cc::move(p[read]);
+            ++write;
+        }
+        resize_down_to(write);
+        return count - write;
+    }
+
+    alignas(T) cc::byte _storage[N * sizeof(T)];
+    size_type _size = 0;
 };
@@ -1,11 +1,160 @@
 #pragma once
 
+#include <clean-core/fixed_bitset.hh>
 #include <clean-core/fwd.hh>
 
-/// Type-safe bitset for enum flags with configurable storage size
-/// Provides bitwise operations on enum values with compile-time safety
+#include <type_traits>
+
+namespace cc::impl
+{
+/// Iterates the set flags of a cc::flags as enum values.
+template <class EnumT, class WordT, isize WordCount>
+struct flags_iterator
+{
+    fixed_set_bit_iterator<WordT, WordCount> it;
+
+    [[nodiscard]] constexpr EnumT operator*() const { return EnumT(*it); }
+    constexpr flags_iterator& operator++()
+    {
+        ++it;
+        return *this;
+    }
+    [[nodiscard]] friend constexpr bool operator==(flags_iterator const& it, cc::sentinel s) { return it.it == s; }
+};
+} // namespace cc::impl
+
+/// Type-safe set of enum flags, stored as a cc::fixed_bitset<Bits>.
+///
+/// The enum values are bit indices in [0, Bits), not masks:
+///   enum class state : u8 { visible, selected, dirty };
+///   cc::flags<state> s = {state::visible, state::dirty};
+///
+/// Bits defaults to the bit width of the enum (8 for a u8 enum, i.e. values 0..7),
+/// and the storage is the smallest unsigned integer holding Bits bits,
+/// so all operations compile down to plain integer ops (e.g. has() is a shift + and).
+///
+/// Usage:
+///   auto s = cc::flags<state>(state::visible) | state::dirty;
+///   if (s.has(state::dirty))
+///       s.clear(state::dirty);
+///   if (s.has_any({state::selected, state::dirty}))
+///       ...
+///   for (state f : s)
+///       ...
 template <class EnumT, cc::isize Bits>
 struct cc::flags
 {
-    // TODO: implement flags
+    static_assert(std::is_enum_v<EnumT>, "flags requires an enum type");
+    static_assert(Bits > 0, "flags requires at least one bit");
+
+    using bitset_t = cc::fixed_bitset<Bits>;
+
+    // queries
+public:
+    /// True if flag f is set.
+    [[nodiscard]] constexpr bool has(EnumT f) const { return _bits.test(index_of(f)); }
+
+    /// True if any / all of the flags in f are set.
+    [[nodiscard]] constexpr bool has_any(flags const& f) const { return _bits.intersects(f._bits); }
+    [[nodiscard]] constexpr bool has_all(flags const& f) const { return _bits.contains(f._bits); }
+
+    /// Number of set flags.
+    [[nodiscard]] constexpr isize count() const { return _bits.count(); }
+
+    [[nodiscard]] constexpr bool any() const { return _bits.any(); }
+    [[nodiscard]] constexpr bool none() const { return _bits.none(); }
+    [[nodiscard]] constexpr bool empty() const { return _bits.none(); }
+
+    /// The underlying bits (bit i is the flag EnumT(i)).
+    [[nodiscard]] constexpr bitset_t const& bits() const { return _bits; }
+
+    [[nodiscard]] constexpr bool operator==(flags const& rhs) const = default;
+
+    // iteration
+public:
+    /// Iterates the set flags in ascending order of their values.
+    /// Usage:
+    ///   for (EnumT f : flags)
+    ///       ...
+    [[nodiscard]] constexpr auto begin() const
+    {
+        using word_iterator = impl::fixed_set_bit_iterator<typename bitset_t::word_t, bitset_t::word_count>;
+        return impl::flags_iterator<EnumT, typename bitset_t::word_t, bitset_t::word_count>{
+            word_iterator::create_begin(_bits.word_data())};
+    }
+    [[nodiscard]] constexpr cc::sentinel end() const { return {}; }
+
+    // modification
+public:
+    constexpr void set(EnumT f) { _bits.set(index_of(f)); }
+    constexpr void set(EnumT f, bool value) { _bits.set(index_of(f), value); }
+    constexpr void clear(EnumT f) { _bits.clear(index_of(f)); }
+    constexpr void flip(EnumT f) { _bits.flip(index_of(f)); }
+    constexpr void clear_all() { _bits.clear_all(); }
+
+    constexpr flags& operator|=(flags const& rhs)
+    {
+        _bits |= rhs._bits;
+        return *this;
+    }
+    constexpr flags& operator&=(flags const& rhs)
+    {
+        _bits &= rhs._bits;
+        return *this;
+    }
+    constexpr flags& operator^=(flags const& rhs)
+    {
+        _bits ^= rhs._bits;
+        return *this;
+    }
+
+    /// Clears every flag set in rhs.
+    constexpr flags& clear(flags const& rhs)
+    {
+        _bits.and_not(rhs._bits);
+        return *this;
+    }
+
+    // single enum values convert implicitly, so a | EnumT works as well
+    [[nodiscard]] friend constexpr flags operator|(flags lhs, flags const& rhs) { return lhs |= rhs; }
+    [[nodiscard]] friend constexpr flags operator&(flags lhs, flags const& rhs) { return lhs &= rhs; }
+    [[nodiscard]] friend constexpr flags operator^(flags lhs, flags const& rhs) { return lhs ^= rhs; }
+
+    /// All Bits bits flipped (including values that are not enumerators).
+    [[nodiscard]] friend constexpr flags operator~(flags f)
+    {
+        f._bits.flip_all();
+        return f;
+    }
+
+    // ctors
+public:
+    /// No flags set.
+    constexpr flags() = default;
+
+    /// The given flags set (implicit, so a single enum value converts to flags).
+    template <class... Fs>
+        requires(sizeof...(Fs) > 0 && (std::is_same_v<Fs, EnumT> && ...))
+    constexpr flags(Fs... fs)
+    {
+        (_bits.set(index_of(fs)), ...);
+    }
+
+    /// From the underlying bits (bit i is the flag EnumT(i)).
+    [[nodiscard]] static constexpr flags create_from_bitset(bitset_t const& bits)
+    {
+        flags f;
+        f._bits = bits;
+        return f;
+    }
+
+private:
+    [[nodiscard]] static constexpr isize index_of(EnumT f)
+    {
+        auto const i = isize(f);
+        CC_ASSERT(0 <= i && i < Bits, "flag value out of range");
+        return i;
+    }
+
+    bitset_t _bits;
 };
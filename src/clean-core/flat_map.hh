@@ -0,0 +1,447 @@
+#pragma once
+
+#include <clean-core/fwd.hh>
+#include <clean-core/impl/flat_util.hh>
+#include <clean-core/map.hh> // cc::map_entry
+#include <clean-core/optional.hh>
+#include <clean-core/pair.hh>
+#include <clean-core/sort.hh>
+#include <clean-core/span.hh>
+#include <clean-core/vector.hh>
+
+#include <initializer_list>
+
+namespace cc::impl
+{
+template <class K, class V, bool IsConst>
+struct flat_map_iterator
+{
+    using value_ptr_t = std::conditional_t<IsConst, V const*, V*>;
+    using entry_t = std::conditional_t<IsConst, map_entry<K, V const>, map_entry<K, V>>;
+
+    [[nodiscard]] CC_FORCE_INLINE entry_t operator*() const { return {*_key, *_value}; }
+
+    CC_FORCE_INLINE flat_map_iterator& operator++()
+    {
+        ++_key;
+        ++_value;
+        return *this;
+    }
+
+    [[nodiscard]] bool operator==(flat_map_iterator const& rhs) const { return _key == rhs._key; }
+
+    K const* _key;
+    value_ptr_t _value;
+};
+} // namespace cc::impl
+
+/// Sorted map from K to V stored in two parallel cc::vectors (keys and values, "structure of arrays").
+///
+/// Compared to cc::map, flat_map trades O(n) single-element insertion/removal for:
+///   - ordered iteration and range queries (lower_bound/upper_bound return indices)
+///   - compact memory: no control bytes, no empty slots
+///   - lookups that only touch the key array (a branchless binary search, see impl/flat_util.hh),
+///     so for small to medium read-mostly maps it is usually faster than hashing
+///
+/// Keys are compared via <, equality is !(a < b) && !(b < a).
+/// Lookups are templated on the key type, so a flat_map<cc::string, V> can be queried with string_view.
+///
+/// Bulk operations avoid the O(n) per-element insert:
+///   - create_from_unsorted adopts key/value vectors, sorts them in place and removes duplicates (later wins)
+///   - merge_sorted merges a sorted batch in one pass
+///
+/// Usage:
+///   auto m = cc::flat_map<int, cc::string>::create_from_unsorted(cc::move(keys), cc::move(values));
+///   if (auto* v = m.get_ptr(42))
+///       use(*v);
+///   for (auto i = m.lower_bound(10); i < m.upper_bound(20); ++i) // all keys in [10, 20]
+///       use(m.keys()[i], m.values()[i]);
+template <class K, class V>
+struct cc::flat_map
+{
+    static_assert(std::is_object_v<K> && !std::is_const_v<K>, "map keys must be non-const objects");
+    static_assert(std::is_object_v<V> && !std::is_const_v<V>, "map values must be non-const objects");
+
+    using key_t = K;
+    using value_t = V;
+    using entry_t = map_entry<K, V>;
+    using iterator = impl::flat_map_iterator<K, V, false>;
+    using const_iterator = impl::flat_map_iterator<K, V, true>;
+
+    // element access
+public:
+    /// Returns a pointer to the value of key, or nullptr if key is not present.
+    template <class KeyT>
+    [[nodiscard]] CC_FORCE_INLINE V* get_ptr(KeyT const& key)
+    {
+        auto const idx = index_of(key);
+        return idx >= 0 ? &_values[idx] : nullptr;
+    }
+    template <class KeyT>
+    [[nodiscard]] CC_FORCE_INLINE V const* get_ptr(KeyT const& key) const
+    {
+        auto const idx = index_of(key);
+        return idx >= 0 ? &_values[idx] : nullptr;
+    }
+
+    /// Returns the value of key, which must be present.
+    template <class KeyT>
+    [[nodiscard]] V& get(KeyT const& key)
+    {
+        auto const v = get_ptr(key);
+        CC_ASSERT(v != nullptr, "key not found in map");
+        return *v;
+    }
+    template <class KeyT>
+    [[nodiscard]] V const& get(KeyT const& key) const
+    {
+        auto const v = get_ptr(key);
+        CC_ASSERT(v != nullptr, "key not found in map");
+        return *v;
+    }
+
+    /// Returns the value of key, default-constructing it first if key is not present.
+    template <class KeyT>
+    V& operator[](KeyT&& key)
+    {
+        return get_or_emplace(cc::forward<KeyT>(key));
+    }
+
+    /// Sorted keys, values()[i] belongs to keys()[i].
+    [[nodiscard]] cc::span<K const> keys() const { return cc::span<K const>(_keys.data(), _keys.size()); }
+    [[nodiscard]] cc::span<V> values() { return cc::span<V>(_values.data(), _values.size()); }
+    [[nodiscard]] cc::span<V const> values() const { return cc::span<V const>(_values.data(), _values.size()); }
+
+    // queries
+public:
+    template <class KeyT>
+    [[nodiscard]] bool contains(KeyT const& key) const
+    {
+        return index_of(key) >= 0;
+    }
+
+    /// Returns the index of key in keys()/values(), or -1 if key is not present.
+    template <class KeyT>
+    [[nodiscard]] CC_FORCE_INLINE isize index_of(KeyT const& key) const
+    {
+        auto const idx = lower_bound(key);
+        return idx < _keys.size() && !(key < _keys[idx]) ? idx : -1;
+    }
+
+    /// Index of the first key that is not less than key (size() if there is none).
+    template <class KeyT>
+    [[nodiscard]] CC_FORCE_INLINE isize lower_bound(KeyT const& key) const
+    {
+        return impl::flat_lower_bound(_keys.data(), _keys.size(), key);
+    }
+
+    /// Index of the first key that is greater than key (size() if there is none).
+    template <class KeyT>
+    [[nodiscard]] CC_FORCE_INLINE isize upper_bound(KeyT const& key) const
+    {
+        return impl::flat_upper_bound(_keys.data(), _keys.size(), key);
+    }
+
+    [[nodiscard]] isize size() const { return _keys.size(); }
+    [[nodiscard]] bool empty() const { return _keys.empty(); }
+
+    // iteration (in key order)
+public:
+    [[nodiscard]] iterator begin() { return {_keys.data(), _values.data()}; }
+    [[nodiscard]] iterator end() { return {_keys.data() + _keys.size(), _values.data() + _values.size()}; }
+    [[nodiscard]] const_iterator begin() const { return {_keys.data(), _values.data()}; }
+    [[nodiscard]] const_iterator end() const { return {_keys.data() + _keys.size(), _values.data() + _values.size()}; }
+
+    // insertion
+public:
+    /// Inserts or overwrites the value of key. Returns a reference to the stored value.
+    /// O(n) if the key is new (later elements are moved up), prefer the bulk operations for many keys.
+    template <class KeyT, class ValueT>
+    V& insert_or_assign(KeyT&& key, ValueT&& value)
+    {
+        auto const idx = lower_bound(key);
+        if (idx < _keys.size() && !(key < _keys[idx]))
+            return _values[idx] = cc::forward<ValueT>(value);
+        return insert_new_at(idx, cc::forward<KeyT>(key), cc::forward<ValueT>(value));
+    }
+
+    /// Inserts key with a value constructed from args, unless key is already present (then nothing is constructed).
+    /// Returns true if the element was inserted.
+    template <class KeyT, class... Args>
+    bool try_insert(KeyT&& key, Args&&... args)
+    {
+        auto const idx = lower_bound(key);
+        if (idx < _keys.size() && !(key < _keys[idx]))
+            return false;
+        insert_new_at(idx, cc::forward<KeyT>(key), cc::forward<Args>(args)...);
+        return true;
+    }
+
+    /// Returns the value of key, constructing it from args first if key is not present.
+    template <class KeyT, class... Args>
+    V& get_or_emplace(KeyT&& key, Args&&... args)
+    {
+        auto const idx = lower_bound(key);
+        if (idx < _keys.size() && !(key < _keys[idx]))
+            return _values[idx];
+        return insert_new_at(idx, cc::forward<KeyT>(key), cc::forward<Args>(args)...);
+    }
+
+    /// Merges a batch of strictly increasing keys (and their values) in one O(size() + batch) pass.
+    /// Values of keys that are already present are overwritten. Returns the number of new keys.
+    /// If copying a batch element throws, the map only keeps the elements merged so far.
+    isize merge_sorted(cc::span<K const> keys, cc::span<V const> values)
+    {
+        CC_ASSERT(keys.size() == values.size(), "merge_sorted needs one value per key");
+        CC_ASSERT(impl::flat_is_strictly_sorted(keys.data(), keys.size()),
+                  "merge_sorted needs strictly increasing keys");
+
+        if (keys.empty())
+            return 0;
+
+        // moved-from vectors keep their memory resource
+        auto old_keys = cc::move(_keys);
+        auto old_values = cc::move(_values);
+        _keys.reserve_back(old_keys.size() + keys.size());
+        _values.reserve_back(old_values.size() + keys.size());
+
+        auto const push_batch = [&](isize j)
+        {
+            // copy both first so that keys and values stay in sync if a copy throws
+            K k = keys[j];
+            V v = values[j];
+            _keys.push_back_stable(cc::move(k));
+            _values.push_back_stable(cc::move(v));
+        };
+
+        isize i = 0;
+        isize j = 0;
+        isize added = 0;
+        while (i < old_keys.size() && j < keys.size())
+        {
+            if (old_keys[i] < keys[j])
+            {
+                _keys.push_back_stable(cc::move(old_keys[i]));
+                _values.push_back_stable(cc::move(old_values[i]));
+                ++i;
+            }
+            else if (keys[j] < old_keys[i])
+            {
+                push_batch(j);
+                ++j;
+                ++added;
+            }
+            else
+            {
+                V v = values[j];
+                _keys.push_back_stable(cc::move(old_keys[i]));
+                _values.push_back_stable(cc::move(v));
+                ++i;
+                ++j;
+            }
+        }
+        for (; i < old_keys.size(); ++i)
+        {
+            _keys.push_back_stable(cc::move(old_keys[i]));
+            _values.push_back_stable(cc::move(old_values[i]));
+        }
+        for (; j < keys.size(); ++j, ++added)
+            push_batch(j);
+
+        return added;
+    }
+
+    // removal
+public:
+    /// Removes key if present (O(n), later elements are moved down). Returns true if an element was removed.
+    template <class KeyT>
+    bool remove(KeyT const& key)
+    {
+        auto const idx = index_of(key);
+        if (idx < 0)
+            return false;
+        remove_at(idx);
+        return true;
+    }
+
+    /// Removes key and returns its value (or nullopt if key is not present).
+    template <class KeyT>
+    [[nodiscard("use remove() if you don't need the return value")]] cc::optional<V> pop(KeyT const& key)
+    {
+        auto const idx = index_of(key);
+        if (idx < 0)
+            return cc::nullopt;
+        auto result = cc::optional<V>(cc::move(_values[idx]));
+        remove_at(idx);
+        return result;
+    }
+
+    /// Removes the element at index idx in keys()/values().
+    void remove_at(isize idx)
+    {
+        CC_ASSERT(0 <= idx && idx < size(), "index out of bounds");
+        _keys.remove_at(idx);
+        _values.remove_at(idx);
+    }
+
+    /// Removes all elements for which pred(key, value) returns true in one pass.
+    /// Returns the number of removed elements.
+    template <class Pred>
+    isize remove_all_where(Pred&& pred)
+    {
+        auto const n = size();
+        isize write = 0;
+        for (isize read = 0; read < n; ++read)
+        {
+            if (pred(static_cast<K const&>(_keys[read]), _values[read]))
+                continue;
+            if (write != read)
+            {
+                _keys[write] = cc::move(_keys[read]);
+                _values[write] = cc::move(_values[read]);
+            }
+            ++write;
+        }
+        _keys.resize_down_to(write);
+        _values.resize_down_to(write);
+        return n - write;
+    }
+
+    /// Removes all elements but keeps the capacity.
+    void clear()
+    {
+        _keys.clear();
+        _values.clear();
+    }
+
+    // capacity
+public:
+    /// Makes sure that count elements fit without reallocation.
+    void reserve(isize count)
+    {
+        CC_ASSERT(count >= 0, "count must be non-negative");
+        _keys.reserve_back(cc::max(isize(0), count - size()));
+        _values.reserve_back(cc::max(isize(0), count - size()));
+    }
+
+    // factories
+public:
+    /// Creates an empty map that allocates from the given resource (nullptr means default).
+    [[nodiscard]] static flat_map create_with_resource(cc::memory_resource const* resource)
+    {
+        flat_map m;
+        m._keys = cc::vector<K>::create_with_resource(resource);
+        m._values = cc::vector<V>::create_with_resource(resource);
+        return m;
+    }
+
+    /// Creates an empty map with room for count elements.
+    [[nodiscard]] static flat_map create_with_capacity(isize count, cc::memory_resource const* resource = nullptr)
+    {
+        auto m = flat_map::create_with_resource(resource);
+        m.reserve(count);
+        return m;
+    }
+
+    /// Adopts the storage of two parallel vectors in any order, sorts them in place and removes duplicate keys
+    /// (the one that came last in the input wins). O(n log n), no element is copied.
+    [[nodiscard]] static flat_map create_from_unsorted(cc::vector<K> keys, cc::vector<V> values)
+    {
+        CC_ASSERT(keys.size() == values.size(), "create_from_unsorted needs one value per key");
+
+        flat_map m;
+        m._keys = cc::move(keys);
+        m._values = cc::move(values);
+
+        auto const n = m._keys.size();
+        if (!impl::flat_is_strictly_sorted(m._keys.data(), n))
+        {
+            // sort a permutation (ties broken by input position, so duplicates keep their input order),
+            // then move keys and values into place along its cycles
+            auto perm = cc::vector<isize>::create_uninitialized(n);
+            for (isize i = 0; i < n; ++i)
+                perm[i] = i;
+
+            auto const* k = m._keys.data();
+            cc::sort(perm, [k](isize a, isize b) { return k[a] < k[b] || (!(k[b] < k[a]) && a < b); });
+            impl::flat_apply_permutation(cc::span<isize>(perm.data(), n), m._keys.data(), m._values.data());
+
+            m.remove_duplicates_keep_last();
+        }
+        return m;
+    }
+
+    /// Adopts the storage of two parallel vectors whose keys are already strictly increasing.
+    /// O(1) (O(n) check in debug).
+    [[nodiscard]] static flat_map create_from_sorted(cc::vector<K> keys, cc::vector<V> values)
+    {
+        CC_ASSERT(keys.size() == values.size(), "create_from_sorted needs one value per key");
+        CC_ASSERT(impl::flat_is_strictly_sorted(keys.data(), keys.size()), "keys must be strictly increasing");
+
+        flat_map m;
+        m._keys = cc::move(keys);
+        m._values = cc::move(values);
+        return m;
+    }
+
+    // ctors/dtor
+public:
+    flat_map() = default;
+
+    /// Later duplicates overwrite earlier ones.
+    flat_map(std::initializer_list<cc::pair<K, V>> entries)
+    {
+        auto keys = cc::vector<K>::create_with_capacity(isize(entries.size()));
+        auto values = cc::vector<V>::create_with_capacity(isize(entries.size()));
+        for (auto const& e : entries)
+        {
+            keys.push_back_stable(e.first);
+            values.push_back_stable(e.second);
+        }
+        *this = flat_map::create_from_unsorted(cc::move(keys), cc::move(values));
+    }
+
+    flat_map(flat_map const&) = default;
+    flat_map(flat_map&&) = default;
+    flat_map& operator=(flat_map const&) = default;
+    flat_map& operator=(flat_map&&) = default;
+
+private:
+    template <class KeyT, class... Args>
+    V& insert_new_at(isize idx, KeyT&& key, Args&&... args)
+    {
+        // materialize key and value before growing, the args may reference elements of this map
+        // with room in both vectors, only moves happen once the first vector is modified
+        K k(cc::forward<KeyT>(key));
+        V v(cc::forward<Args>(args)...);
+        _keys.reserve_back(1);
+        _values.reserve_back(1);
+
+        auto& value = _values.emplace_at(idx, cc::move(v));
+        _keys.emplace_at(idx, cc::move(k));
+        return value;
+    }
+
+    // keys are sorted, keeps the last element of each run of equal keys
+    void remove_duplicates_keep_last()
+    {
+        auto const n = _keys.size();
+        isize write = 0;
+        for (isize read = 0; read < n; ++read)
+        {
+            if (read + 1 < n && !(_keys[read] < _keys[read + 1]))
+                continue;
+            if (write != read)
+            {
+                _keys[write] = cc::move(_keys[read]);
+                _values[write] = cc::move(_values[read]);
+            }
+            ++write;
+        }
+        _keys.resize_down_to(write);
+        _values.resize_down_to(write);
+    }
+
+    cc::vector<K> _keys;
+    cc::vector<V> _values;
+};
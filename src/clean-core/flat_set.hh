@@ -0,0 +1,240 @@
+#pragma once
+
+#include <clean-core/fwd.hh>
+#include <clean-core/impl/flat_util.hh>
+#include <clean-core/sort.hh>
+#include <clean-core/span.hh>
+#include <clean-core/vector.hh>
+
+#include <initializer_list>
+
+/// Sorted set of unique T elements stored in one cc::vector.
+///
+/// The sorted-contiguous counterpart of cc::set (see flat_map.hh for the trade-offs):
+/// ordered iteration, compact memory and branchless binary search lookups,
+/// but O(n) single-element insertion/removal. Build it in bulk via create_from_unsorted or merge_sorted.
+///
+/// Elements are compared via <, equality is !(a < b) && !(b < a).
+///
+/// Usage:
+///   auto ids = cc::flat_set<int>::create_from_unsorted(cc::move(raw_ids)); // sorts and dedupes in place
+///   if (ids.contains(42))
+///       ...
+///   ids.merge_sorted(more_sorted_ids);
+template <class T>
+struct cc::flat_set
+{
+    static_assert(std::is_object_v<T> && !std::is_const_v<T>, "set elements must be non-const objects");
+
+    using element_t = T;
+
+    // element access
+public:
+    /// All elements in increasing order.
+    [[nodiscard]] cc::span<T const> elements() const { return cc::span<T const>(_elements.data(), _elements.size()); }
+
+    [[nodiscard]] T const& operator[](isize idx) const { return _elements[idx]; }
+
+    // queries
+public:
+    template <class KeyT>
+    [[nodiscard]] CC_FORCE_INLINE bool contains(KeyT const& key) const
+    {
+        return index_of(key) >= 0;
+    }
+
+    /// Returns the index of key in elements(), or -1 if key is not present.
+    template <class KeyT>
+    [[nodiscard]] CC_FORCE_INLINE isize index_of(KeyT const& key) const
+    {
+        auto const idx = lower_bound(key);
+        return idx < _elements.size() && !(key < _elements[idx]) ? idx : -1;
+    }
+
+    /// Index of the first element that is not less than key (size() if there is none).
+    template <class KeyT>
+    [[nodiscard]] CC_FORCE_INLINE isize lower_bound(KeyT const& key) const
+    {
+        return impl::flat_lower_bound(_elements.data(), _elements.size(), key);
+    }
+
+    /// Index of the first element that is greater than key (size() if there is none).
+    template <class KeyT>
+    [[nodiscard]] CC_FORCE_INLINE isize upper_bound(KeyT const& key) const
+    {
+        return impl::flat_upper_bound(_elements.data(), _elements.size(), key);
+    }
+
+    [[nodiscard]] isize size() const { return _elements.size(); }
+    [[nodiscard]] bool empty() const { return _elements.empty(); }
+
+    // iteration (in increasing order)
+public:
+    [[nodiscard]] T const* begin() const { return _elements.data(); }
+    [[nodiscard]] T const* end() const { return _elements.data() + _elements.size(); }
+
+    // insertion
+public:
+    /// Inserts key (converted to T) unless an equal element is present. Returns true if the element was inserted.
+    /// O(n) if the element is new (later elements are moved up), prefer the bulk operations for many elements.
+    template <class KeyT>
+    bool insert(KeyT&& key)
+    {
+        auto const idx = lower_bound(key);
+        if (idx < _elements.size() && !(key < _elements[idx]))
+            return false;
+        _elements.emplace_at(idx, cc::forward<KeyT>(key)); // safe if key references an element
+        return true;
+    }
+
+    /// Merges a batch of strictly increasing elements in one O(size() + batch) pass.
+    /// Returns the number of inserted elements.
+    isize merge_sorted(cc::span<T const> elements)
+    {
+        CC_ASSERT(impl::flat_is_strictly_sorted(elements.data(), elements.size()),
+                  "merge_sorted needs strictly increasing elements");
+
+        if (elements.empty())
+            return 0;
+
+        // moved-from vectors keep their memory resource
+        auto old = cc::move(_elements);
+        _elements.reserve_back(old.size() + elements.size());
+
+        isize i = 0;
+        isize j = 0;
+        while (i < old.size() && j < elements.size())
+        {
+            if (old[i] < elements[j])
+                _elements.push_back_stable(cc::move(old[i++]));
+            else if (elements[j] < old[i])
+                _elements.push_back_stable(elements[j++]);
+            else
+            {
+                _elements.push_back_stable(cc::move(old[i++]));
+                ++j;
+            }
+        }
+        for (; i < old.size(); ++i)
+            _elements.push_back_stable(cc::move(old[i]));
+        for (; j < elements.size(); ++j)
+            _elements.push_back_stable(elements[j]);
+
+        return _elements.size() - old.size();
+    }
+
+    // removal
+public:
+    /// Removes key if present (O(n), later elements are moved down). Returns true if an element was removed.
+    template <class KeyT>
+    bool remove(KeyT const& key)
+    {
+        auto const idx = index_of(key);
+        if (idx < 0)
+            return false;
+        _elements.remove_at(idx);
+        return true;
+    }
+
+    /// Removes the element at index idx in elements().
+    void remove_at(isize idx) { _elements.remove_at(idx); }
+
+    /// Removes all elements for which pred(element) returns true in one pass.
+    /// Returns the number of removed elements.
+    template <class Pred>
+    isize remove_all_where(Pred&& pred)
+    {
+        return _elements.remove_all_where([&](T const& e) { return bool(pred(e)); });
+    }
+
+    /// Removes all elements but keeps the capacity.
+    void clear() { _elements.clear(); }
+
+    /// Moves all elements (in increasing order) into a new vector, leaving the set empty. O(1).
+    [[nodiscard]] cc::vector<T> extract_to_vector() { return cc::move(_elements); }
+
+    // capacity
+public:
+    /// Makes sure that count elements fit without reallocation.
+    void reserve(isize count)
+    {
+        CC_ASSERT(count >= 0, "count must be non-negative");
+        _elements.reserve_back(cc::max(isize(0), count - size()));
+    }
+
+    // factories
+public:
+    /// Creates an empty set that allocates from the given resource (nullptr means default).
+    [[nodiscard]] static flat_set create_with_resource(cc::memory_resource const* resource)
+    {
+        flat_set s;
+        s._elements = cc::vector<T>::create_with_resource(resource);
+        return s;
+    }
+
+    /// Creates an empty set with room for count elements.
+    [[nodiscard]] static flat_set create_with_capacity(isize count, cc::memory_resource const* resource = nullptr)
+    {
+        auto s = flat_set::create_with_resource(resource);
+        s.reserve(count);
+        return s;
+    }
+
+    /// Adopts the storage of a vector in any order, sorts it in place and removes duplicates.
+    /// O(n log n), no element is copied.
+    [[nodiscard]] static flat_set create_from_unsorted(cc::vector<T> elements)
+    {
+        flat_set s;
+        s._elements = cc::move(elements);
+
+        auto const n = s._elements.size();
+        if (!impl::flat_is_strictly_sorted(s._elements.data(), n))
+        {
+            cc::sort(s._elements);
+
+            // keep the first element of each run of equal elements
+            isize write = n > 0 ? 1 : 0;
+            for (isize read = 1; read < n; ++read)
+            {
+                if (!(s._elements[write - 1] < s._elements[read]))
+                    continue;
+                if (write != read)
+                    s._elements[write] = cc::move(s._elements[read]);
+                ++write;
+            }
+            s._elements.resize_down_to(write);
+        }
+        return s;
+    }
+
+    /// Adopts the storage of a vector that is already strictly increasing. O(1) (O(n) check in debug).
+    [[nodiscard]] static flat_set create_from_sorted(cc::vector<T> elements)
+    {
+        CC_ASSERT(impl::flat_is_strictly_sorted(elements.data(), elements.size()),
+                  "elements must be strictly increasing");
+
+        flat_set s;
+        s._elements = cc::move(elements);
+        return s;
+    }
+
+    // ctors/dtor
+public:
+    flat_set() = default;
+
+    flat_set(std::initializer_list<T> elements)
+    {
+        auto v = cc::vector<T>::create_with_capacity(isize(elements.size()));
+        for (auto const& e : elements)
+            v.push_back_stable(e);
+        *this = flat_set::create_from_unsorted(cc::move(v));
+    }
+
+    flat_set(flat_set const&) = default;
+    flat_set(flat_set&&) = default;
+    flat_set& operator=(flat_set const&) = default;
+    flat_set& operator=(flat_set&&) = default;
+
+private:
+    cc::vector<T> _elements;
+};
@@ -72,12 +72,21 @@ struct allocation;
 enum class node_class_index : u8;
 enum class node_class_size : u64;
 struct node_memory_resource;
+struct node_memory_resource_stats;
 struct node_allocator;
+struct node_allocator_stats;
+struct node_arena;
 struct any_node_allocation;
 template <class T>
 struct node_allocation;
 template <class T, class NodeTraits>
 struct poly_node_allocation;
+template <class T, bool IsAtomic>
+struct basic_shared_node_allocation;
+template <class T>
+using shared_node_allocation = basic_shared_node_allocation<T, true>;
+template <class T>
+using local_shared_node_allocation = basic_shared_node_allocation<T, false>;
 
 
 //
@@ -122,19 +131,48 @@ template <class T>
 struct unique_vector;
 template <class T, isize N>
 struct fixed_vector;
+template <class T, isize N>
+struct small_vector;
+template <class... Ts>
+struct soa_vector;
 
-// template <class T>
-// struct devector;
+template <class T>
+struct devector;
 // template <class T, isize N>
 // struct fixed_devector;
 
 template <class K, class V>
 struct map;
+template <class K, class V>
+struct map_entry;
 template <class T>
 struct set;
+template <class K, class V>
+struct flat_map;
+template <class T>
+struct flat_set;
+template <class K, class V>
+struct btree_map;
 
 template <class T>
 struct ringbuffer;
+template <class T>
+struct ring_regions;
+template <class T>
+struct spsc_queue;
+template <class T>
+struct mpmc_queue;
+template <class T>
+struct blocking_mpmc_queue;
+
+template <class T>
+struct list_node_handle;
+template <class T>
+struct node_list;
+template <class T>
+struct node_stack;
+template <class T>
+struct node_queue;
 
 template <class... Ts>
 struct tuple;
@@ -147,6 +185,8 @@ struct pair;
 
 template <class IdxT>
 struct disjoint_set;
+template <class IdxT>
+struct concurrent_disjoint_set;
 
 struct bitset;
 template <isize N>
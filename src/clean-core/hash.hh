@@ -0,0 +1,231 @@
+#pragma once
+
+#include <clean-core/bit.hh>
+#include <clean-core/fwd.hh>
+#include <clean-core/macros.hh>
+#include <clean-core/string_view.hh>
+
+#include <cstring>
+#include <type_traits>
+#include <utility> // index_sequence
+
+#if defined(CC_COMPILER_MSVC)
+#include <intrin.h>
+#endif
+
+// =========================================================================================================
+// Hashing
+// =========================================================================================================
+//
+// Hash values are u64 and meant for in-process hash tables (not stable across versions or platforms).
+// All hashes are fully mixed, so hash tables can use any subset of bits (e.g. low bits for the slot, high bits as tag).
+//
+// Functions:
+//   make_hash(values...)           - hash one or more values (combined in order)
+//   hash_mix(a, b)                 - strong 64 bit mixer (folded 128 bit multiply)
+//   hash_combine(seed, h)          - order-dependent combination of two hashes
+//   hash_bytes(data, size)         - hash a byte range
+//
+// Supported types:
+//   - integers, enums, bool, char types (equal numeric values of different integer types hash equally)
+//   - floating point (0.0 and -0.0 hash equally)
+//   - pointers and nullptr
+//   - everything convertible to cc::string_view (string, string_view, char const*, literals hash equally)
+//   - cc::pair<A, B> of hashable types
+//   - cc::tuple<Ts...> of hashable types (hashes the raw bytes if cc::tuple::is_bytewise_comparable)
+//   - types with a `u64 hash() const` member function
+//
+// The string rule enables heterogeneous lookup, e.g. map<cc::string, V>::get_ptr("literal") without a temporary string.
+//
+// Usage:
+//   struct point { int x, y; u64 hash() const { return cc::make_hash(x, y); } };
+//   auto const h = cc::make_hash(cc::string_view("abc"), 42);
+
+namespace cc
+{
+/// Strong 64 bit mixer: folds the full 128 bit product of a and b.
+/// Used as the core primitive of all hashes here.
+[[nodiscard]] CC_FORCE_INLINE u64 hash_mix(u64 a, u64 b)
+{
+#if defined(CC_COMPILER_MSVC)
+    return (a * b) ^ __umulh(a, b);
+#else
+    auto const r = __uint128_t(a) * b;
+    return u64(r) ^ u64(r >> 64);
+#endif
+}
+
+/// Combines a seed with another hash value.
+/// Order-dependent: hash_combine(a, b) != hash_combine(b, a) in general.
+[[nodiscard]] CC_FORCE_INLINE u64 hash_combine(u64 seed, u64 h)
+{
+    return cc::hash_mix(seed ^ 0x9e3779b97f4a7c15ull, h ^ 0xbf58476d1ce4e5b9ull);
+}
+
+/// Hashes size bytes starting at data.
+/// Processes 16 bytes per step, short inputs (the common case for keys) need at most two mixes.
+[[nodiscard]] inline u64 hash_bytes(void const* data, isize size, u64 seed = 0)
+{
+    CC_ASSERT(size >= 0, "size must be non-negative");
+    CC_ASSERT(data != nullptr || size == 0, "null data only allowed for empty range");
+
+    constexpr u64 k0 = 0xa0761d6478bd642full;
+    constexpr u64 k1 = 0xe7037ed1a0b428dbull;
+
+    auto const load64 = [](cc::byte const* p)
+    {
+        u64 v;
+        std::memcpy(&v, p, 8);
+        return v;
+    };
+    auto const load32 = [](cc::byte const* p)
+    {
+        u32 v;
+        std::memcpy(&v, p, 4);
+        return u64(v);
+    };
+
+    auto p = static_cast<cc::byte const*>(data);
+    auto h = seed ^ cc::hash_mix(seed ^ k0, u64(size) ^ k1);
+
+    u64 a = 0;
+    u64 b = 0;
+    if (size <= 16)
+    {
+        // overlapping loads cover all sizes without a byte loop
+        if (size >= 8)
+        {
+            a = load64(p);
+            b = load64(p + size - 8);
+        }
+        else if (size >= 4)
+        {
+            a = load32(p);
+            b = load32(p + size - 4);
+        }
+        else if (size > 0)
+        {
+            a = (u64(p[0]) << 16) | (u64(p[size >> 1]) << 8) | u64(p[size - 1]);
+        }
+    }
+    else
+    {
+        auto rest = size;
+        while (rest > 16)
+        {
+            h = cc::hash_mix(load64(p) ^ k1, load64(p + 8) ^ h);
+            p += 16;
+            rest -= 16;
+        }
+
+        // last 16 bytes (overlapping with the previous block)
+        a = load64(p + rest - 16);
+        b = load64(p + rest - 8);
+    }
+
+    return cc::hash_mix(k1 ^ u64(size), cc::hash_mix(a ^ k1, b ^ h));
+}
+} // namespace cc
+
+namespace cc::impl
+{
+template <class T>
+concept has_hash_member = requires(T const& v) {
+    { v.hash() } -> std::convertible_to<u64>;
+};
+
+template <class T>
+concept is_pair_like_hashable = requires(T const& v) {
+    typename T::first_t;
+    typename T::second_t;
+    v.first;
+    v.second;
+};
+
+template <class T>
+concept is_tuple_like_hashable = requires(T const& v) {
+    { T::is_bytewise_comparable } -> std::convertible_to<bool>;
+    { T::size() } -> std::convertible_to<isize>;
+};
+
+template <class T>
+[[nodiscard]] CC_FORCE_INLINE u64 hash_one(T const& v)
+{
+    // NOTE: string_view conversion comes first so that char const* hashes its content, like string and string_view
+    if constexpr (std::is_convertible_v<T const&, cc::string_view> && !std::is_same_v<T, std::nullptr_t>)
+    {
+        auto const s = cc::string_view(v);
+        return cc::hash_bytes(s.data(), s.size());
+    }
+    else if constexpr (std::is_integral_v<T> || std::is_enum_v<T>)
+    {
+        // sign-extend to 64 bit so that equal values of different integer types hash equally
+        if constexpr (std::is_enum_v<T>)
+            return cc::hash_mix(u64(std::underlying_type_t<T>(v)) ^ 0x9e3779b97f4a7c15ull, 0xd6e8feb86659fd93ull);
+        else
+            return cc::hash_mix(u64(v) ^ 0x9e3779b97f4a7c15ull, 0xd6e8feb86659fd93ull);
+    }
+    else if constexpr (std::is_floating_point_v<T>)
+    {
+        // 0.0 == -0.0 must hash equally
+        auto const d = v == T(0) ? 0.0 : double(v);
+        return cc::hash_mix(cc::bit_cast<u64>(d) ^ 0x9e3779b97f4a7c15ull, 0xd6e8feb86659fd93ull);
+    }
+    else if constexpr (std::is_pointer_v<T> || std::is_same_v<T, std::nullptr_t>)
+    {
+        return cc::hash_mix(u64(reinterpret_cast<std::uintptr_t>(v)) ^ 0x9e3779b97f4a7c15ull, 0xd6e8feb86659fd93ull);
+    }
+    else if constexpr (has_hash_member<T>)
+    {
+        return u64(v.hash());
+    }
+    else if constexpr (is_pair_like_hashable<T>)
+    {
+        // same as make_hash(v.first, v.second)
+        return cc::hash_combine(cc::hash_combine(0, impl::hash_one(v.first)), impl::hash_one(v.second));
+    }
+    else if constexpr (is_tuple_like_hashable<T>)
+    {
+        // equal bytes <=> equal tuple, so composite keys of integers hash in one pass
+        if constexpr (T::is_bytewise_comparable)
+            return cc::hash_bytes(&v, sizeof(T));
+        else
+            return [&]<std::size_t... Is>(std::index_sequence<Is...>)
+            {
+                u64 h = 0;
+                ((h = cc::hash_combine(h, impl::hash_one(v.template get<Is>()))), ...);
+                return h;
+            }(std::make_index_sequence<T::size()>{});
+    }
+    else
+    {
+        static_assert(sizeof(T) == 0, "type is not hashable, add a 'u64 hash() const' member function");
+        return 0;
+    }
+}
+} // namespace cc::impl
+
+namespace cc
+{
+/// Hashes one or more values.
+/// A single value hashes the same as its own hash, multiple values are combined in order.
+/// Usage:
+///   auto h0 = cc::make_hash(42);
+///   auto h1 = cc::make_hash(name, id);  // e.g. in a `u64 hash() const` member
+template <class... Args>
+[[nodiscard]] CC_FORCE_INLINE u64 make_hash(Args const&... args)
+{
+    static_assert(sizeof...(Args) > 0, "make_hash needs at least one value");
+
+    if constexpr (sizeof...(Args) == 1)
+    {
+        return impl::hash_one(args...);
+    }
+    else
+    {
+        u64 h = 0;
+        ((h = cc::hash_combine(h, impl::hash_one(args))), ...);
+        return h;
+    }
+}
+} // namespace cc
@@ -269,23 +269,6 @@ private:
     {
         CC_ASSERT(!has_capacity_back_for(count), "only call this if we don't have enough capacity");
 
-        auto const new_capacity_front = container_t::uses_capacity_front ? capacity_front() : 0;
-        auto const obj_size = size();
-
-        // exponential growth strategy, at least sizeof(T) more
-        auto const new_size_request_min = allocating_container::alloc_grow_size_for(
-            (new_capacity_front + obj_size) * sizeof(T), (new_capacity_front + obj_size + count) * sizeof(T));
-        auto const new_size_request_max = new_size_request_min + cc::min(new_size_request_min, alloc_max_slack);
-
-        // try realloc first
-        if (_data.try_resize_alloc_inplace(new_size_request_min, new_size_request_max))
-            return &_data.obj_end;
-
-        // otherwise we need a full new allocation
-        // TODO: think about re-center logic for cc::devector
-        new_allocation = cc::allocation<T>::create_empty_bytes(new_size_request_min, new_size_request_max,
-                                                               alloc_alignment, _data.custom_resource);
-
         // Construct new elements where they would be in the new allocation (after old elements)
         // The old allocation remains valid during construction phase
         // The new allocation's live range tracks only newly-constructed elements for exception safety:
@@ -293,9 +276,10 @@ private:
         // new elements (e.g. first k of push_back_range when at k+1) need cleanup via new_allocation's dtor
         // Thus the live range semantically starts behind the old allocation's live range
         // In finalize, when we move over old elements, we extend it to the full allocation
-        new_allocation.obj_start += new_capacity_front + size();
-        new_allocation.obj_end = new_allocation.obj_start;
-        return &new_allocation.obj_end;
+        if (this->ensure_capacity_gap_begin(new_allocation, size(), count))
+            return &new_allocation.obj_end;
+
+        return &_data.obj_end;
     }
 
     /// Finalizes the back capacity operation after elements have been constructed.
@@ -320,6 +304,62 @@ private:
         _data = cc::move(new_allocation);
     }
 
+    /// Generalization of ensure_capacity_back_begin for inserting count elements at index idx.
+    /// Grows the allocation so that count more elements fit.
+    /// Returns false if the allocation could be resized in place (the caller then shifts within _data).
+    /// Otherwise, new_allocation is a fresh allocation whose (empty) live range starts where the element at idx
+    /// will be. The caller constructs the new elements there while the old allocation is still valid,
+    /// then calls ensure_capacity_gap_finalize, which moves the old elements in front of and behind them.
+    CC_COLD_FUNC [[nodiscard]] constexpr bool ensure_capacity_gap_begin(allocation<T>& new_allocation,
+                                                                        isize idx,
+                                                                        isize count)
+    {
+        CC_ASSERT(!has_capacity_back_for(count), "only call this if we don't have enough capacity");
+
+        auto const new_capacity_front = container_t::uses_capacity_front ? capacity_front() : 0;
+        auto const obj_size = size();
+
+        // exponential growth strategy, at least sizeof(T) more
+        auto const new_size_request_min = allocating_container::alloc_grow_size_for(
+            (new_capacity_front + obj_size) * sizeof(T), (new_capacity_front + obj_size + count) * sizeof(T));
+        auto const new_size_request_max = new_size_request_min + cc::min(new_size_request_min, alloc_max_slack);
+
+        // try realloc first
+        if (_data.try_resize_alloc_inplace(new_size_request_min, new_size_request_max))
+            return false;
+
+        // otherwise we need a full new allocation
+        // NOTE: keeps the front capacity as is, cc::devector re-centers in its own push growth path
+        new_allocation = cc::allocation<T>::create_empty_bytes(new_size_request_min, new_size_request_max,
+                                                               alloc_alignment, _data.custom_resource);
+        new_allocation.obj_start += new_capacity_front + idx;
+        new_allocation.obj_end = new_allocation.obj_start;
+        return true;
+    }
+
+    /// Finalizes ensure_capacity_gap_begin after the new elements have been constructed in new_allocation.
+    /// Moves [idx, size()) behind and [0, idx) in front of them, then replaces _data.
+    CC_COLD_FUNC constexpr void ensure_capacity_gap_finalize(allocation<T>& new_allocation, isize idx)
+    {
+        CC_ASSERT(new_allocation.is_valid(), "only call this when we have a temporary alloc");
+
+        impl::move_create_objects_to(new_allocation.obj_end, _data.obj_start + idx, _data.obj_end);
+        impl::move_create_objects_to_reverse(new_allocation.obj_start, _data.obj_start, _data.obj_start + idx);
+        _data = cc::move(new_allocation);
+    }
+
+    /// Shifts [idx, size()) back by count within the current allocation, which must have the capacity.
+    /// Returns a pointer to the resulting gap of count uninitialized (but already counted) objects,
+    /// which the caller must construct before anything else can observe the container.
+    constexpr T* open_gap_within(isize idx, isize count)
+    {
+        CC_ASSERT(has_capacity_back_for(count), "not enough capacity to open a gap");
+        auto const pos = _data.obj_start + idx;
+        impl::relocate_objects_within(pos + count, pos, _data.obj_end);
+        _data.obj_end += count;
+        return pos;
+    }
+
 public:
     // destroys the live object range, so that obj_start == obj_end afterwards
     // calls all destructors, does not move obj_start
@@ -715,12 +755,137 @@ public:
     /// See emplace_back for guarantees and complexity.
     constexpr T& push_back(T&& value) { return this->emplace_back(cc::move(value)); }
 
+    /// Appends copies of all values to the back, growing at most once.
+    /// Trivially copyable T is copied with a single memcpy.
+    /// values may point into this container (the old allocation stays valid while copying).
+    /// If a copy throws, the already copied elements stay appended.
+    /// O(values.size()) complexity.
+    void push_back_range(cc::span<T const> values)
+    {
+        static_assert(std::is_copy_constructible_v<T>, "push_back_range requires T to be copy constructible");
+
+        auto const count = values.size();
+        allocation<T> new_allocation;
+        auto p_obj_end = &_data.obj_end;
+
+        if (!this->has_capacity_back_for(count)) [[unlikely]]
+            p_obj_end = this->ensure_capacity_back_begin(new_allocation, count);
+
+        impl::copy_create_objects_to(*p_obj_end, values.data(), values.data() + count);
+
+        if (new_allocation.is_valid()) [[unlikely]]
+            this->ensure_capacity_back_finalize(new_allocation);
+    }
+
+    /// Appends count uninitialized elements and returns them as a span to be filled in place.
+    /// Only valid for trivially copyable and trivially destructible types.
+    /// Grows at most once (exponentially, like push_back). Invalidates previous pointers on growth.
+    /// Usage:
+    ///   auto dst = bytes.append_uninitialized(header_size);
+    ///   write_header(dst);
+    [[nodiscard]] cc::span<T> append_uninitialized(isize count)
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "append_uninitialized requires T to be trivially copyable");
+        static_assert(std::is_trivially_destructible_v<T>, "append_uninitialized requires T to be trivially "
+                                                           "destructible");
+        CC_ASSERT(count >= 0, "count must be non-negative");
+
+        this->reserve_back(count);
+        auto const p = _data.obj_end;
+        _data.obj_end += count;
+        return cc::span<T>(p, count);
+    }
+
     // TODO:
     // - emplace_front
     // - push_front
-    // - push_back_range
     // - push_front_range
 
+    // insertion
+public:
+    /// Constructs a new element at index idx, shifting [idx, size()) back by one.
+    /// Precondition: 0 <= idx <= size() (idx == size() appends).
+    /// Grows at most once; args may reference elements of this container.
+    /// Trivially copyable T is shifted with a single memmove.
+    /// O(size() - idx) complexity.
+    template <class... Args>
+    T& emplace_at(isize idx, Args&&... args)
+    {
+        static_assert(
+            requires { T(cc::forward<Args>(args)...); }, "emplace_at: T is not constructible from "
+                                                         "the provided argument types");
+        CC_ASSERT(0 <= idx && idx <= size(), "insertion index out of bounds");
+
+        if (!this->has_capacity_back_for(1)) [[unlikely]]
+        {
+            // construct in the new allocation while args are still valid, then move the old elements around it
+            allocation<T> new_allocation;
+            if (this->ensure_capacity_gap_begin(new_allocation, idx, 1))
+            {
+                auto const p = new (cc::placement_new, new_allocation.obj_end) T(cc::forward<Args>(args)...);
+                new_allocation.obj_end++;
+                this->ensure_capacity_gap_finalize(new_allocation, idx);
+                return *p;
+            }
+        }
+
+        // construct before shifting, so that args referencing shifted elements stay valid
+        // and a throwing T(...) leaves the container untouched
+        T value(cc::forward<Args>(args)...);
+        return *new (cc::placement_new, this->open_gap_within(idx, 1)) T(cc::move(value));
+    }
+
+    /// Inserts a copy of value at index idx, shifting [idx, size()) back by one.
+    /// See emplace_at for guarantees and complexity.
+    T& insert_at(isize idx, T const& value) { return this->emplace_at(idx, value); }
+
+    /// Inserts value at index idx via move, shifting [idx, size()) back by one.
+    /// See emplace_at for guarantees and complexity.
+    T& insert_at(isize idx, T&& value) { return this->emplace_at(idx, cc::move(value)); }
+
+    /// Inserts copies of all values at index idx, shifting [idx, size()) back by values.size().
+    /// Precondition: 0 <= idx <= size().
+    /// Grows at most once, shifts the tail once and copies the values with memcpy for trivially copyable T.
+    /// values may point into this container.
+    /// O(size() - idx + values.size()) complexity.
+    void insert_range_at(isize idx, cc::span<T const> values)
+    {
+        static_assert(std::is_copy_constructible_v<T>, "insert_range_at requires T to be copy constructible");
+        CC_ASSERT(0 <= idx && idx <= size(), "insertion index out of bounds");
+
+        auto const count = values.size();
+        auto const src = values.data();
+        if (count == 0)
+            return;
+
+        if (!this->has_capacity_back_for(count)) [[unlikely]]
+        {
+            allocation<T> new_allocation;
+            if (this->ensure_capacity_gap_begin(new_allocation, idx, count))
+            {
+                impl::copy_create_objects_to(new_allocation.obj_end, src, src + count);
+                this->ensure_capacity_gap_finalize(new_allocation, idx);
+                return;
+            }
+        }
+
+        // the values are copied into the gap after shifting
+        // copies that might throw or that read from the shifted range need a detour through temporary storage
+        auto const aliases = src < _data.obj_end && _data.obj_start < src + count;
+        if (!std::is_nothrow_copy_constructible_v<T> || aliases) [[unlikely]]
+        {
+            auto copies = cc::allocation<T>::create_empty_bytes(count * sizeof(T), count * sizeof(T), alignof(T),
+                                                                _data.custom_resource);
+            impl::copy_create_objects_to(copies.obj_end, src, src + count);
+            auto gap_end = this->open_gap_within(idx, count);
+            impl::move_create_objects_to(gap_end, copies.obj_start, copies.obj_end);
+            return;
+        }
+
+        auto gap_end = this->open_gap_within(idx, count);
+        impl::copy_create_objects_to(gap_end, src, src + count);
+    }
+
     // removals
 public:
     /// Removes and returns the last element by move.
@@ -1085,9 +1250,8 @@ public:
         return removed_count;
     }
 
-    // TODO:
-    // special for SoA use cases
-    // - remove_all_where_zipped(pred, containers&...) -> isize count
+    // NOTE: structure-of-arrays use cases (removing from several parallel containers in one pass)
+    //       are covered by cc::soa_vector, which compacts all of its columns in remove_all_where
 
     // other mutations
 public:
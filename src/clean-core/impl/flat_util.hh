@@ -0,0 +1,101 @@
+#pragma once
+
+#include <clean-core/fwd.hh>
+#include <clean-core/macros.hh>
+#include <clean-core/span.hh>
+#include <clean-core/utility.hh>
+
+// =========================================================================================================
+// Helpers for the sorted contiguous containers (cc::flat_map, cc::flat_set)
+// =========================================================================================================
+//
+//   flat_lower_bound(data, n, key)      - branchless binary search, first index with !(data[i] < key)
+//   flat_is_strictly_sorted(data, n)   - checks that data is sorted without duplicates
+//   flat_apply_permutation(perm, fs...) - reorders parallel arrays in place so that new[i] = old[perm[i]]
+
+namespace cc::impl
+{
+/// Returns the first index i in [0, n] with !(data[i] < key), data must be sorted.
+/// The loop has a fixed trip count of ceil(log2(n)) and compiles to conditional moves,
+/// so it has no unpredictable branches (unlike a classic binary search that exits early).
+template <class T, class KeyT>
+[[nodiscard]] CC_FORCE_INLINE isize flat_lower_bound(T const* data, isize n, KeyT const& key)
+{
+    if (n == 0)
+        return 0;
+
+    auto base = data;
+    while (n > 1)
+    {
+        auto const half = n / 2;
+        base = base[half] < key ? base + half : base;
+        n -= half;
+    }
+    return (base - data) + isize(*base < key);
+}
+
+/// Returns the first index i in [0, n] with key < data[i], data must be sorted.
+template <class T, class KeyT>
+[[nodiscard]] CC_FORCE_INLINE isize flat_upper_bound(T const* data, isize n, KeyT const& key)
+{
+    if (n == 0)
+        return 0;
+
+    auto base = data;
+    while (n > 1)
+    {
+        auto const half = n / 2;
+        base = key < base[half] ? base : base + half;
+        n -= half;
+    }
+    return (base - data) + isize(!(key < *base));
+}
+
+/// Returns true if data[i] < data[i + 1] for all i.
+template <class T>
+[[nodiscard]] bool flat_is_strictly_sorted(T const* data, isize n)
+{
+    for (isize i = 1; i < n; ++i)
+        if (!(data[i - 1] < data[i]))
+            return false;
+    return true;
+}
+
+/// Reorders every array in arrays... in place so that new[i] = old[perm[i]].
+/// perm must be a permutation of [0, n) and is used as scratch (left in an unspecified state).
+/// Follows the cycles of the permutation, so every element is moved about once.
+template <class... Ts>
+void flat_apply_permutation(cc::span<isize> perm, Ts*... arrays)
+{
+    auto const n = perm.size();
+    for (isize start = 0; start < n; ++start)
+    {
+        if (perm[start] == start || perm[start] < 0)
+            continue;
+
+        // rotate the cycle start <- perm[start] <- perm[perm[start]] <- ...
+        (
+            [&](auto* data)
+            {
+                auto tmp = cc::move(data[start]);
+                auto i = start;
+                while (perm[i] != start)
+                {
+                    data[i] = cc::move(data[perm[i]]);
+                    i = perm[i];
+                }
+                data[i] = cc::move(tmp);
+            }(arrays),
+            ...);
+
+        // mark the cycle as done (negative values, as indices are never negative)
+        auto i = start;
+        while (perm[i] >= 0)
+        {
+            auto const next = perm[i];
+            perm[i] = -1;
+            i = next;
+        }
+    }
+}
+} // namespace cc::impl
@@ -0,0 +1,577 @@
+#pragma once
+
+#include <clean-core/allocation.hh>
+#include <clean-core/bit.hh>
+#include <clean-core/fwd.hh>
+#include <clean-core/hash.hh>
+#include <clean-core/macros.hh>
+#include <clean-core/utility.hh>
+
+#include <cstring>
+
+#if defined(CC_HAS_SSE2)
+#include <emmintrin.h>
+#endif
+
+// =========================================================================================================
+// Open-addressing hash table engine shared by cc::map and cc::set
+// =========================================================================================================
+//
+// Swiss-table design:
+//   - one control byte per slot: empty (0x80), deleted (0xFE), or full (0x00..0x7F = low 7 bits of the hash, "h2")
+//   - the remaining hash bits ("h1") select the start position, probing visits whole groups of 16 control bytes
+//   - a group is compared against h2 in one step (SSE2 on x64, SWAR on other targets)
+//     so most lookups touch one control cache line and compare a key only for (likely) hits
+//   - quadratic probing over groups (pos += 16, 32, 48, ...) visits every group since capacity is a power of two
+//   - max load factor is 7/8, deletions leave tombstones only if a probe might have passed over the slot
+//
+// Memory layout (single cc::allocation<cc::byte>, so custom memory resources work):
+//   [ctrl bytes: capacity + 15] [padding] [slots: capacity]
+//   The 15 control bytes after the end mirror the first 15 so that group loads never need to wrap.
+//
+// Default-constructed tables point to a static all-empty group and allocate nothing.
+// Lookups therefore never need to special-case the empty table.
+//
+// Slots are relocated by move + destroy on rehash. Pointers to elements are invalidated by any insertion that grows.
+
+namespace cc::impl
+{
+using hash_ctrl = i8;
+
+inline constexpr hash_ctrl hash_ctrl_empty = -128;  // 0b1000'0000
+inline constexpr hash_ctrl hash_ctrl_deleted = -2;  // 0b1111'1110
+inline constexpr isize hash_group_width = 16;
+inline constexpr isize hash_min_capacity = hash_group_width;
+
+/// Control bytes of empty tables, never written to.
+alignas(16) inline constexpr hash_ctrl hash_empty_group[hash_group_width] = {
+    hash_ctrl_empty, hash_ctrl_empty, hash_ctrl_empty, hash_ctrl_empty, //
+    hash_ctrl_empty, hash_ctrl_empty, hash_ctrl_empty, hash_ctrl_empty, //
+    hash_ctrl_empty, hash_ctrl_empty, hash_ctrl_empty, hash_ctrl_empty, //
+    hash_ctrl_empty, hash_ctrl_empty, hash_ctrl_empty, hash_ctrl_empty, //
+};
+
+/// Start position bits of a hash.
+[[nodiscard]] CC_FORCE_INLINE u64 hash_h1(u64 hash) { return hash >> 7; }
+/// Control byte of a hash (7 bits, always a "full" control byte).
+[[nodiscard]] CC_FORCE_INLINE hash_ctrl hash_h2(u64 hash) { return hash_ctrl(hash & 0x7F); }
+
+/// 16 control bytes loaded at an arbitrary position.
+/// All match functions return a bitmask with bit i set if control byte i matches.
+struct hash_group
+{
+#if defined(CC_HAS_SSE2)
+    explicit hash_group(hash_ctrl const* ctrl) : _ctrl(_mm_loadu_si128(reinterpret_cast<__m128i const*>(ctrl))) {}
+
+    [[nodiscard]] CC_FORCE_INLINE u32 match(hash_ctrl h2) const
+    {
+        return u32(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), _ctrl)));
+    }
+    [[nodiscard]] CC_FORCE_INLINE u32 match_empty() const { return match(hash_ctrl_empty); }
+    [[nodiscard]] CC_FORCE_INLINE u32 match_empty_or_deleted() const
+    {
+        // empty and deleted are the only control bytes < -1
+        return u32(_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(-1), _ctrl)));
+    }
+    [[nodiscard]] CC_FORCE_INLINE u32 match_full() const { return u32(_mm_movemask_epi8(_ctrl)) ^ 0xFFFFu; }
+
+private:
+    __m128i _ctrl;
+#else
+    // SWAR fallback: two little-endian 64 bit words, results are compressed to one bit per byte
+    explicit hash_group(hash_ctrl const* ctrl)
+    {
+        std::memcpy(&_lo, ctrl, 8);
+        std::memcpy(&_hi, ctrl + 8, 8);
+    }
+
+    /// NOTE: may report false positives (for bytes directly after a match), which key comparison filters out
+    [[nodiscard]] CC_FORCE_INLINE u32 match(hash_ctrl h2) const
+    {
+        auto const pattern = lsbs * u8(h2);
+        return compress(zero_bytes(_lo ^ pattern)) | (compress(zero_bytes(_hi ^ pattern)) << 8);
+    }
+    [[nodiscard]] CC_FORCE_INLINE u32 match_empty() const
+    {
+        // empty is the only control byte with msb set and bit 1 cleared
+        return compress(_lo & ~(_lo << 6) & msbs) | (compress(_hi & ~(_hi << 6) & msbs) << 8);
+    }
+    [[nodiscard]] CC_FORCE_INLINE u32 match_empty_or_deleted() const
+    {
+        // empty and deleted are the only control bytes with msb set and bit 0 cleared
+        return compress(_lo & ~(_lo << 7) & msbs) | (compress(_hi & ~(_hi << 7) & msbs) << 8);
+    }
+    [[nodiscard]] CC_FORCE_INLINE u32 match_full() const
+    {
+        return compress(~_lo & msbs) | (compress(~_hi & msbs) << 8);
+    }
+
+private:
+    static constexpr u64 lsbs = 0x0101010101010101ull;
+    static constexpr u64 msbs = 0x8080808080808080ull;
+
+    [[nodiscard]] CC_FORCE_INLINE static u64 zero_bytes(u64 x) { return (x - lsbs) & ~x & msbs; }
+
+    // gathers the msb of each byte into the low 8 bits
+    [[nodiscard]] CC_FORCE_INLINE static u32 compress(u64 byte_msbs)
+    {
+        return u32(((byte_msbs >> 7) * 0x0102040810204080ull) >> 56);
+    }
+
+    u64 _lo;
+    u64 _hi;
+#endif
+};
+
+/// Number of slots needed so that count elements fit without growing.
+[[nodiscard]] inline isize hash_capacity_for(isize count)
+{
+    if (count <= 0)
+        return 0;
+
+    // max load factor 7/8
+    auto const min_cap = count + (count + 6) / 7;
+    return cc::max(hash_min_capacity, isize(cc::bit_ceil(u64(min_cap))));
+}
+
+/// Number of elements that fit into a table with the given capacity before it grows.
+[[nodiscard]] CC_FORCE_INLINE isize hash_growth_limit(isize capacity) { return capacity - capacity / 8; }
+
+/// Forward cursor over the full slots of a table.
+/// Counts down the remaining elements, so iteration stops right after the last element without scanning the tail.
+template <class Slot>
+struct hash_table_cursor
+{
+    hash_ctrl const* ctrl = nullptr;
+    Slot* slots = nullptr;
+    isize idx = 0;
+    isize remaining = 0;
+
+    /// Moves idx to the first full slot at or after idx, requires remaining > 0.
+    CC_FORCE_INLINE void seek()
+    {
+        // the remaining full slot bounds the scan, so mirrored control bytes are never reported
+        while (true)
+        {
+            auto const m = hash_group(ctrl + idx).match_full();
+            if (m != 0)
+            {
+                idx += cc::count_trailing_zeroes(m);
+                return;
+            }
+            idx += hash_group_width;
+        }
+    }
+
+    CC_FORCE_INLINE void advance()
+    {
+        CC_ASSERT(remaining > 0, "advancing past the end");
+        if (--remaining > 0)
+        {
+            ++idx;
+            seek();
+        }
+    }
+};
+
+/// The table engine. Traits provide `static auto const& key_of(Slot const&)`.
+/// Keys are hashed with cc::make_hash and compared with ==, which enables heterogeneous lookup.
+template <class Slot, class Traits>
+struct hash_table
+{
+    // queries
+public:
+    [[nodiscard]] isize size() const { return _size; }
+    [[nodiscard]] isize capacity() const { return _slots == nullptr ? 0 : isize(_mask) + 1; }
+    [[nodiscard]] cc::memory_resource const* custom_resource() const { return _storage.custom_resource; }
+    [[nodiscard]] Slot* slots() const { return _slots; }
+
+    [[nodiscard]] hash_table_cursor<Slot> cursor() const
+    {
+        auto c = hash_table_cursor<Slot>{_ctrl, _slots, 0, _size};
+        if (_size > 0)
+            c.seek();
+        return c;
+    }
+
+    // lookup
+public:
+    template <class KeyT>
+    [[nodiscard]] CC_FORCE_INLINE Slot* find(KeyT const& key, u64 hash) const
+    {
+        auto const tag = hash_h2(hash);
+        auto pos = hash_h1(hash) & _mask;
+        auto step = u64(0);
+        while (true)
+        {
+            auto const g = hash_group(_ctrl + pos);
+            for (auto m = g.match(tag); m != 0; m &= m - 1)
+            {
+                auto const idx = (pos + cc::count_trailing_zeroes(m)) & _mask;
+                if (Traits::key_of(_slots[idx]) == key) [[likely]]
+                    return &_slots[idx];
+            }
+
+            if (g.match_empty() != 0) [[likely]]
+                return nullptr;
+
+            step += hash_group_width;
+            pos = (pos + step) & _mask;
+        }
+    }
+
+    /// Issues a prefetch for the first control group and slot of a hash, e.g. for batched lookups.
+    CC_FORCE_INLINE void prefetch(u64 hash) const
+    {
+        auto const pos = hash_h1(hash) & _mask;
+        cc::prefetch(_ctrl + pos);
+        if (_slots != nullptr)
+            cc::prefetch(_slots + pos);
+    }
+
+    /// Looks up key_at(0..count-1) and calls on_result(i, slot_or_nullptr, hash) for each, in order.
+    /// Hashes are computed and prefetched a fixed distance ahead of the probes,
+    /// so the cache misses of independent lookups overlap instead of being paid one after another.
+    template <class KeyAtF, class OnResultF>
+    void find_batched(isize count, KeyAtF&& key_at, OnResultF&& on_result) const
+    {
+        constexpr isize distance = 16; // power of two, hashes[] is a ring buffer
+        u64 hashes[distance];
+
+        auto const ahead = cc::min(distance, count);
+        for (isize i = 0; i < ahead; ++i)
+        {
+            hashes[i] = cc::make_hash(key_at(i));
+            prefetch(hashes[i]);
+        }
+
+        for (isize i = 0; i < count; ++i)
+        {
+            auto const hash = hashes[i & (distance - 1)];
+            if (i + distance < count)
+            {
+                auto const next = cc::make_hash(key_at(i + distance));
+                hashes[i & (distance - 1)] = next;
+                prefetch(next);
+            }
+            on_result(i, find(key_at(i), hash), hash);
+        }
+    }
+
+    // insertion
+public:
+    /// Constructs a new slot from args (growing if needed). The caller must ensure that no equal key is present.
+    /// args may reference elements of this table: when growing, the slot is built before the old slots are relocated.
+    template <class... Args>
+    CC_FORCE_INLINE Slot& insert_new(u64 hash, Args&&... args)
+    {
+        if (_growth_left == 0) [[unlikely]]
+            return insert_new_growing(hash, cc::forward<Args>(args)...);
+
+        return construct_at(find_insert_index(hash), hash, cc::forward<Args>(args)...);
+    }
+
+    /// Returns an index where an element with the given hash can be inserted via construct_at (growing if needed).
+    /// The caller must ensure that no equal key is present.
+    /// NOTE: growing relocates all slots, so the construction args must not reference elements of this table
+    ///       (use insert_new for those)
+    [[nodiscard]] CC_FORCE_INLINE isize prepare_insert(u64 hash)
+    {
+        if (_growth_left == 0) [[unlikely]]
+            grow_for_insert();
+
+        return find_insert_index(hash);
+    }
+
+    /// Constructs a slot at a prepared index and marks it as full.
+    /// Construction happens first, so a throwing constructor leaves the table unchanged.
+    template <class... Args>
+    CC_FORCE_INLINE Slot& construct_at(isize idx, u64 hash, Args&&... args)
+    {
+        auto& slot = *new (cc::placement_new, &_slots[idx]) Slot(cc::forward<Args>(args)...);
+        if (_ctrl[idx] == hash_ctrl_empty)
+            --_growth_left;
+        set_ctrl(idx, hash_h2(hash));
+        ++_size;
+        return slot;
+    }
+
+    // removal
+public:
+    /// Destroys the slot at idx (which must be full).
+    void erase_at(isize idx)
+    {
+        CC_ASSERT(0 <= idx && idx < capacity() && _ctrl[idx] >= 0, "erase_at: slot is not full");
+
+        _slots[idx].~Slot();
+        --_size;
+
+        // a slot can become empty again if no probe could have passed over it,
+        // i.e. every group window containing idx still has an empty slot.
+        // in a single-group table every probe sees all slots at once, so that is always the case.
+        auto can_be_empty = true;
+        if (isize(_mask) + 1 > hash_group_width)
+        {
+            auto const empty_before = hash_group(_ctrl + ((u64(idx) - hash_group_width) & _mask)).match_empty();
+            auto const empty_after = hash_group(_ctrl + idx).match_empty();
+            can_be_empty = empty_before != 0 && empty_after != 0
+                        && cc::count_leading_zeroes(u16(empty_before)) + cc::count_trailing_zeroes(empty_after)
+                               < hash_group_width;
+        }
+
+        set_ctrl(idx, can_be_empty ? hash_ctrl_empty : hash_ctrl_deleted);
+        if (can_be_empty)
+            ++_growth_left;
+    }
+
+    /// Removes all slots matching pred(slot). Returns the number of removed slots.
+    template <class Pred>
+    isize erase_all_where(Pred&& pred)
+    {
+        isize removed = 0;
+        auto const cap = capacity();
+        for (isize i = 0; i < cap; ++i)
+        {
+            if (_ctrl[i] >= 0 && pred(_slots[i]))
+            {
+                erase_at(i);
+                ++removed;
+            }
+        }
+        return removed;
+    }
+
+    /// Destroys all slots but keeps the capacity.
+    void clear()
+    {
+        if (_slots == nullptr)
+            return;
+
+        destroy_all_slots();
+        std::memset(_ctrl, u8(hash_ctrl_empty), size_t(ctrl_bytes(capacity())));
+        _size = 0;
+        _growth_left = hash_growth_limit(capacity());
+    }
+
+    // capacity
+public:
+    /// Makes sure that count elements fit without growing.
+    void reserve(isize count)
+    {
+        CC_ASSERT(count >= 0, "count must be non-negative");
+        if (count <= _size + _growth_left)
+            return;
+        resize_to(hash_capacity_for(count));
+    }
+
+    /// Rebuilds the table with the smallest capacity that fits max(size, count) elements.
+    /// Also removes all tombstones. rehash(0) shrinks to fit (and frees the storage of empty tables).
+    void rehash(isize count)
+    {
+        CC_ASSERT(count >= 0, "count must be non-negative");
+        resize_to(hash_capacity_for(cc::max(count, _size)));
+    }
+
+    // factories
+public:
+    [[nodiscard]] static hash_table create_with_resource(cc::memory_resource const* resource)
+    {
+        hash_table t;
+        t._storage.custom_resource = resource;
+        return t;
+    }
+
+    // ctors/dtor
+public:
+    hash_table() = default;
+
+    /// Copies the exact layout (no rehashing), so copies are as fast as copying the slots.
+    hash_table(hash_table const& rhs)
+    {
+        _storage.custom_resource = rhs._storage.custom_resource;
+        if (rhs._size == 0)
+            return;
+
+        // build into a local table: if a copy throws, its dtor destroys exactly the slots copied so far
+        auto t = hash_table::create_with_resource(rhs._storage.custom_resource);
+        t.allocate_storage(rhs.capacity());
+        for (auto cur = rhs.cursor(); cur.remaining > 0; cur.advance())
+        {
+            new (cc::placement_new, &t._slots[cur.idx]) Slot(rhs._slots[cur.idx]);
+            t.set_ctrl(cur.idx, rhs._ctrl[cur.idx]);
+            ++t._size;
+        }
+
+        // also take over tombstones, so the probe sequences stay identical
+        std::memcpy(t._ctrl, rhs._ctrl, size_t(ctrl_bytes(rhs.capacity())));
+        t._growth_left = rhs._growth_left;
+
+        *this = cc::move(t);
+    }
+
+    hash_table(hash_table&& rhs) noexcept
+      : _ctrl(cc::exchange(rhs._ctrl, empty_ctrl())),
+        _slots(cc::exchange(rhs._slots, nullptr)),
+        _mask(cc::exchange(rhs._mask, 0)),
+        _size(cc::exchange(rhs._size, 0)),
+        _growth_left(cc::exchange(rhs._growth_left, 0)),
+        _storage(cc::move(rhs._storage))
+    {
+    }
+
+    hash_table& operator=(hash_table const& rhs)
+    {
+        if (this != &rhs)
+            *this = hash_table(rhs);
+        return *this;
+    }
+
+    hash_table& operator=(hash_table&& rhs) noexcept
+    {
+        if (this != &rhs)
+        {
+            // take everything from rhs first, rhs might live inside one of our slots
+            auto tmp = hash_table(cc::move(rhs));
+
+            destroy_all_slots();
+            _size = 0;
+
+            _ctrl = cc::exchange(tmp._ctrl, empty_ctrl());
+            _slots = cc::exchange(tmp._slots, nullptr);
+            _mask = cc::exchange(tmp._mask, 0);
+            _size = cc::exchange(tmp._size, 0);
+            _growth_left = cc::exchange(tmp._growth_left, 0);
+            _storage = cc::move(tmp._storage);
+        }
+        return *this;
+    }
+
+    ~hash_table() { destroy_all_slots(); }
+
+    // helper
+private:
+    [[nodiscard]] static hash_ctrl* empty_ctrl()
+    {
+        // never written to: all writes require capacity > 0
+        return const_cast<hash_ctrl*>(hash_empty_group);
+    }
+
+    [[nodiscard]] static isize ctrl_bytes(isize capacity) { return capacity + hash_group_width - 1; }
+    [[nodiscard]] static isize slots_offset(isize capacity)
+    {
+        return cc::align_up(ctrl_bytes(capacity), alignof(Slot));
+    }
+
+    void set_ctrl(isize idx, hash_ctrl c)
+    {
+        _ctrl[idx] = c;
+
+        // mirror the first group_width - 1 bytes behind the end so that group loads never wrap
+        if (idx < hash_group_width - 1)
+            _ctrl[isize(_mask) + 1 + idx] = c;
+    }
+
+    [[nodiscard]] CC_FORCE_INLINE isize find_insert_index(u64 hash) const
+    {
+        auto pos = hash_h1(hash) & _mask;
+        auto step = u64(0);
+        while (true)
+        {
+            auto const m = hash_group(_ctrl + pos).match_empty_or_deleted();
+            if (m != 0) [[likely]]
+                return isize((pos + cc::count_trailing_zeroes(m)) & _mask);
+
+            step += hash_group_width;
+            pos = (pos + step) & _mask;
+        }
+    }
+
+    // replaces the (empty) storage with a fresh all-empty table of the given capacity
+    void allocate_storage(isize capacity)
+    {
+        CC_ASSERT(_slots == nullptr && _size == 0, "storage must be empty");
+        CC_ASSERT(capacity >= hash_min_capacity && cc::is_power_of_two(capacity), "invalid capacity");
+
+        auto const bytes = slots_offset(capacity) + capacity * isize(sizeof(Slot));
+        auto const alignment = cc::max(isize(alignof(Slot)), hash_group_width);
+        _storage = cc::allocation<cc::byte>::create_empty_bytes(bytes, bytes, alignment, _storage.custom_resource);
+
+        _ctrl = reinterpret_cast<hash_ctrl*>(_storage.alloc_start);
+        _slots = reinterpret_cast<Slot*>(_storage.alloc_start + slots_offset(capacity));
+        _mask = u64(capacity - 1);
+        _growth_left = hash_growth_limit(capacity);
+        std::memset(_ctrl, u8(hash_ctrl_empty), size_t(ctrl_bytes(capacity)));
+    }
+
+    void destroy_all_slots()
+    {
+        if constexpr (!std::is_trivially_destructible_v<Slot>)
+        {
+            if (_size == 0)
+                return;
+
+            for (auto cur = cursor(); cur.remaining > 0; cur.advance())
+                _slots[cur.idx].~Slot();
+        }
+    }
+
+    // called when no growth is left: either clean up tombstones or double the capacity
+    // args might reference elements of this table, which the growth relocates and frees
+    // so the new slot is built first and moved into place afterwards
+    template <class... Args>
+    CC_COLD_FUNC CC_DONT_INLINE Slot& insert_new_growing(u64 hash, Args&&... args)
+    {
+        Slot slot(cc::forward<Args>(args)...);
+        grow_for_insert();
+        return construct_at(find_insert_index(hash), hash, cc::move(slot));
+    }
+
+    CC_COLD_FUNC CC_DONT_INLINE void grow_for_insert()
+    {
+        auto const cap = capacity();
+        if (cap > 0 && _size <= cap * 7 / 16)
+            resize_to(cap); // mostly tombstones, rehash in place
+        else
+            resize_to(cap == 0 ? hash_min_capacity : cap * 2);
+    }
+
+    // rebuilds the table with the given capacity (0 frees the storage), relocating all slots
+    CC_DONT_INLINE void resize_to(isize new_capacity)
+    {
+        CC_ASSERT(hash_growth_limit(new_capacity) >= _size, "new capacity is too small");
+
+        auto new_table = hash_table::create_with_resource(_storage.custom_resource);
+        if (new_capacity > 0)
+            new_table.allocate_storage(new_capacity);
+
+        if (_size > 0)
+        {
+            for (auto cur = cursor(); cur.remaining > 0; cur.advance())
+            {
+                auto& slot = _slots[cur.idx];
+                auto const hash = cc::make_hash(Traits::key_of(slot));
+                auto const idx = new_table.find_insert_index(hash);
+                new (cc::placement_new, &new_table._slots[idx]) Slot(cc::move(slot));
+                slot.~Slot();
+                new_table.set_ctrl(idx, hash_h2(hash));
+            }
+
+            new_table._size = _size;
+            new_table._growth_left -= _size;
+
+            // all old slots are relocated, only the storage is left
+            _size = 0;
+        }
+
+        *this = cc::move(new_table);
+    }
+
+private:
+    hash_ctrl* _ctrl = empty_ctrl();
+    Slot* _slots = nullptr;
+    u64 _mask = 0; // capacity - 1, or 0 for empty storage (then _ctrl points to the static empty group)
+    isize _size = 0;
+    isize _growth_left = 0;
+    cc::allocation<cc::byte> _storage;
+};
+} // namespace cc::impl
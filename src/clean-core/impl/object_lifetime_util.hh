@@ -244,6 +244,112 @@ constexpr void compact_move_objects_backward(T* dest_start, T* src_start, T* src
     }
 }
 
+/// Compacts objects by moving [src_start, src_end) to [..., dest_end) within the same allocation.
+/// Mirror of compact_move_objects_backward for closing a gap towards the back (dest_end > src_end),
+/// e.g. when removing an element from the front half of a cc::devector.
+/// PRECONDITIONS:
+///   - src_end <= dest_end (target is behind source)
+///   - Both ranges are within the same allocation
+///   - All objects in [dest_end - (src_end - src_start), dest_end) are alive (will be overwritten)
+///   - All objects in [src_start, src_end) are alive (will be moved-from)
+/// POSTCONDITIONS:
+///   - Objects in [dest_end - (src_end - src_start), dest_end) contain moved values
+///   - Objects in [src_start, src_end) not covered by the target are in moved-from state (must be destroyed separately)
+/// Uses backward iteration which is safe since dest_end > src_end.
+/// Trivially copyable types are optimized to use memmove.
+/// Empty ranges (src_start == src_end) are valid and result in a no-op.
+///
+/// Usage pattern (closing a gap after removal):
+///   // Remove element at idx from [obj_start, obj_end)
+///   compact_move_objects_forward(obj_start + idx + 1, obj_start, obj_start + idx);
+///   // obj_start[0] is now in moved-from state, destroy it
+///   obj_start->~T();
+///   ++obj_start;
+template <class T>
+constexpr void compact_move_objects_forward(T* dest_end, T* src_start, T* src_end)
+{
+    static_assert(sizeof(T) > 0, "T must be a complete type (did you forget to include a header?)");
+    static_assert(std::is_move_assignable_v<T>, "T must be move assignable");
+
+    CC_ASSERT(src_end <= dest_end, "compact_move_objects_forward requires dest_end > src_end");
+
+    if constexpr (std::is_trivially_copyable_v<T>)
+    {
+        auto const size = src_end - src_start;
+        if (size > 0)
+        {
+            std::memmove(dest_end - size, src_start, size * sizeof(T));
+        }
+    }
+    else
+    {
+        // Backward iteration is safe: we're moving forward (dest > src)
+        while (src_start != src_end)
+        {
+            --dest_end;
+            --src_end;
+            *dest_end = cc::move(*src_end);
+        }
+    }
+}
+
+/// Relocates the live range [src_start, src_end) to start at dest_start within the same allocation.
+/// Source and target may overlap in either direction.
+/// PRECONDITIONS:
+///   - All objects in [src_start, src_end) are alive
+///   - All other objects in the target range are NOT yet constructed (uninitialized memory)
+/// POSTCONDITIONS:
+///   - [dest_start, dest_start + (src_end - src_start)) is the new live range
+///   - All objects in [src_start, src_end) outside of the new live range are destroyed
+/// Target slots outside the source range are move-constructed, overlapping ones are move-assigned.
+/// Trivially copyable types are optimized to a single memmove.
+///
+/// Usage pattern (re-centering a cc::devector without reallocating):
+///   relocate_objects_within(new_obj_start, obj_start, obj_end);
+///   obj_end = new_obj_start + (obj_end - obj_start);
+///   obj_start = new_obj_start;
+template <class T>
+constexpr void relocate_objects_within(T* dest_start, T* src_start, T* src_end)
+{
+    static_assert(sizeof(T) > 0, "T must be a complete type (did you forget to include a header?)");
+    static_assert(std::is_move_constructible_v<T>, "T must be move constructible");
+
+    auto const size = src_end - src_start;
+
+    if constexpr (std::is_trivially_copyable_v<T>)
+    {
+        if (size > 0 && dest_start != src_start)
+        {
+            std::memmove(dest_start, src_start, size * sizeof(T));
+        }
+    }
+    else if (dest_start < src_start)
+    {
+        // front to back: every target slot in front of src_start is uninitialized,
+        // every later one holds an object that was already moved from
+        for (isize i = 0; i < size; ++i)
+        {
+            if (dest_start + i < src_start)
+                new (cc::placement_new, dest_start + i) T(cc::move(src_start[i]));
+            else
+                dest_start[i] = cc::move(src_start[i]);
+        }
+        destroy_objects_in_reverse(cc::max(dest_start + size, src_start), src_end);
+    }
+    else if (dest_start > src_start)
+    {
+        // back to front: mirror of the above
+        for (isize i = size - 1; i >= 0; --i)
+        {
+            if (dest_start + i >= src_end)
+                new (cc::placement_new, dest_start + i) T(cc::move(src_start[i]));
+            else
+                dest_start[i] = cc::move(src_start[i]);
+        }
+        destroy_objects_in_reverse(src_start, cc::min(dest_start, src_end));
+    }
+}
+
 /// Copy-assigns objects from [src_start, src_end) using copy assignment operator.
 /// dest_end is incremented for each successfully assigned object.
 /// IMPORTANT: Assumes the objects at [*dest_end, *dest_end + (src_end - src_start)) are already constructed (alive).
@@ -123,6 +123,19 @@
 #define CC_TARGET_CONSOLE
 #endif
 
+// =========================================================================================================
+// Architecture detection
+// =========================================================================================================
+// Conditionally defined: CC_ARCH_X64, CC_ARCH_ARM64, CC_HAS_SSE2
+// SSE2 is part of the x64 baseline, so it is always available there
+
+#if defined(_M_X64) || defined(__x86_64__)
+#define CC_ARCH_X64
+#define CC_HAS_SSE2
+#elif defined(_M_ARM64) || defined(__aarch64__)
+#define CC_ARCH_ARM64
+#endif
+
 // =========================================================================================================
 // Public macros
 // =========================================================================================================
@@ -159,6 +172,10 @@
 // Usage: CC_ASSUME(ptr != nullptr);
 #define CC_ASSUME(x) CC_IMPL_ASSUME(x)
 
+// CC_NO_UNIQUE_ADDRESS - Allow a member of empty type to take no storage (portable [[no_unique_address]])
+// Usage: CC_NO_UNIQUE_ADDRESS Allocator _alloc;
+#define CC_NO_UNIQUE_ADDRESS CC_IMPL_NO_UNIQUE_ADDRESS
+
 // CC_MACRO_JOIN(a, b) - Concatenate two tokens at preprocessing time
 // Usage: CC_MACRO_JOIN(foo_, bar) -> foo_bar
 // Note: Indirection ensures arguments are expanded before concatenation
@@ -205,6 +222,9 @@
 #define CC_IMPL_ARRAY_COUNT_OF(arr) __crt_countof(arr)
 #define CC_IMPL_ASSUME(x) __assume(x)
 
+// MSVC ignores the standard attribute for ABI compatibility
+#define CC_IMPL_NO_UNIQUE_ADDRESS [[msvc::no_unique_address]]
+
 #elif defined(CC_COMPILER_POSIX)
 
 #define CC_IMPL_PRETTY_FUNC __PRETTY_FUNCTION__
@@ -224,6 +244,8 @@
 #define CC_IMPL_ASSUME(x) ((!x) ? __builtin_unreachable() : void(0))
 #endif
 
+#define CC_IMPL_NO_UNIQUE_ADDRESS [[no_unique_address]]
+
 #else
 #error "Unknown compiler"
 #endif
@@ -1,11 +1,294 @@
 #pragma once
 
 #include <clean-core/fwd.hh>
+#include <clean-core/impl/hash_table.hh>
+#include <clean-core/optional.hh>
+#include <clean-core/pair.hh>
 
-/// Associative container mapping keys of type K to values of type V
-/// Provides efficient key-based lookup and insertion
+#include <initializer_list>
+
+namespace cc::impl
+{
+template <class K, class V>
+struct map_slot
+{
+    K key;
+    V value;
+
+    template <class KeyT, class... Args>
+    explicit map_slot(KeyT&& k, Args&&... args)
+        requires(!std::is_same_v<std::remove_cvref_t<KeyT>, map_slot>)
+      : key(cc::forward<KeyT>(k)), value(cc::forward<Args>(args)...)
+    {
+    }
+
+    map_slot(map_slot const&) = default;
+    map_slot(map_slot&&) = default;
+    map_slot& operator=(map_slot const&) = default;
+    map_slot& operator=(map_slot&&) = default;
+};
+
+template <class K, class V>
+struct map_traits
+{
+    [[nodiscard]] CC_FORCE_INLINE static K const& key_of(map_slot<K, V> const& s) { return s.key; }
+};
+} // namespace cc::impl
+
+/// Element reference yielded by map iteration.
+/// The key is immutable (changing it would corrupt the table), the value can be modified in place.
+/// Supports structured bindings: `for (auto [k, v] : m)` binds k as K const& and v as V&.
+template <class K, class V>
+struct cc::map_entry
+{
+    K const& key;
+    V& value;
+};
+
+namespace cc::impl
+{
+template <class K, class V, bool IsConst>
+struct map_iterator
+{
+    using slot_t = map_slot<K, V>;
+    using entry_t = std::conditional_t<IsConst, map_entry<K, V const>, map_entry<K, V>>;
+
+    [[nodiscard]] CC_FORCE_INLINE entry_t operator*() const
+    {
+        auto& s = _cursor.slots[_cursor.idx];
+        return {s.key, s.value};
+    }
+
+    CC_FORCE_INLINE map_iterator& operator++()
+    {
+        _cursor.advance();
+        return *this;
+    }
+
+    [[nodiscard]] friend bool operator==(map_iterator const& it, cc::sentinel) { return it._cursor.remaining == 0; }
+
+    hash_table_cursor<slot_t> _cursor;
+};
+} // namespace cc::impl
+
+/// Hash map from K to V with Swiss-table style open addressing (see impl/hash_table.hh for the design).
+///
+/// Keys and values are stored inline in one flat slot array (no per-element allocation),
+/// next to one control byte per slot that is probed 16 slots at a time (SSE2 on x64, SWAR elsewhere).
+/// Storage is a single cc::allocation, so maps work with custom memory resources (see create_with_resource).
+///
+/// Keys are hashed via cc::make_hash (see hash.hh) and compared via ==.
+/// All lookup functions are templated on the key type, which enables heterogeneous lookup:
+/// a map<cc::string, V> can be queried with string_view or string literals without creating a cc::string.
+///
+/// Guarantees and caveats:
+///   - get_ptr/get/contains/remove are O(1) on average, insertion is amortized O(1)
+///   - insertions may rehash: pointers and references to elements are invalidated when the map grows
+///     (reserve upfront to avoid that), removal never moves other elements
+///   - iteration order is unspecified and changes on rehash
+///   - like all cc containers, maps are not thread-safe
+///
+/// Usage:
+///   cc::map<cc::string, int> counts;
+///   counts["apple"] += 1;                      // default-inserts 0 first
+///   counts.insert_or_assign("pear", 5);
+///   if (auto* v = counts.get_ptr("apple"))      // no temporary cc::string
+///       use(*v);
+///   for (auto [key, value] : counts)
+///       print(key, value);
 template <class K, class V>
 struct cc::map
 {
-    // TODO: implement map
+    static_assert(std::is_object_v<K> && !std::is_const_v<K>, "map keys must be non-const objects");
+    static_assert(std::is_object_v<V> && !std::is_const_v<V>, "map values must be non-const objects");
+
+    using key_t = K;
+    using value_t = V;
+    using entry_t = map_entry<K, V>;
+    using iterator = impl::map_iterator<K, V, false>;
+    using const_iterator = impl::map_iterator<K, V, true>;
+
+    // element access
+public:
+    /// Returns a pointer to the value of key, or nullptr if key is not present.
+    template <class KeyT>
+    [[nodiscard]] CC_FORCE_INLINE V* get_ptr(KeyT const& key)
+    {
+        auto const s = _table.find(key, cc::make_hash(key));
+        return s != nullptr ? &s->value : nullptr;
+    }
+    template <class KeyT>
+    [[nodiscard]] CC_FORCE_INLINE V const* get_ptr(KeyT const& key) const
+    {
+        auto const s = _table.find(key, cc::make_hash(key));
+        return s != nullptr ? &s->value : nullptr;
+    }
+
+    /// Returns the value of key, which must be present.
+    template <class KeyT>
+    [[nodiscard]] V& get(KeyT const& key)
+    {
+        auto const v = get_ptr(key);
+        CC_ASSERT(v != nullptr, "key not found in map");
+        return *v;
+    }
+    template <class KeyT>
+    [[nodiscard]] V const& get(KeyT const& key) const
+    {
+        auto const v = get_ptr(key);
+        CC_ASSERT(v != nullptr, "key not found in map");
+        return *v;
+    }
+
+    /// Returns the value of key, default-constructing it first if key is not present.
+    /// Heterogeneous keys are converted to K only on insertion.
+    template <class KeyT>
+    V& operator[](KeyT&& key)
+    {
+        return get_or_emplace(cc::forward<KeyT>(key));
+    }
+
+    // queries
+public:
+    template <class KeyT>
+    [[nodiscard]] bool contains(KeyT const& key) const
+    {
+        return _table.find(key, cc::make_hash(key)) != nullptr;
+    }
+
+    [[nodiscard]] isize size() const { return _table.size(); }
+    [[nodiscard]] bool empty() const { return _table.size() == 0; }
+
+    /// Number of slots. Up to 7/8 of them can be filled before the map grows.
+    [[nodiscard]] isize capacity() const { return _table.capacity(); }
+
+    // iteration
+public:
+    [[nodiscard]] iterator begin() { return {_table.cursor()}; }
+    [[nodiscard]] const_iterator begin() const { return {_table.cursor()}; }
+    [[nodiscard]] cc::sentinel end() const { return {}; }
+
+    // insertion
+public:
+    /// Inserts or overwrites the value of key. Returns a reference to the stored value.
+    template <class KeyT, class ValueT>
+    V& insert_or_assign(KeyT&& key, ValueT&& value)
+    {
+        auto const hash = cc::make_hash(key);
+        if (auto const s = _table.find(key, hash))
+        {
+            s->value = cc::forward<ValueT>(value);
+            return s->value;
+        }
+        return _table.insert_new(hash, cc::forward<KeyT>(key), cc::forward<ValueT>(value)).value;
+    }
+
+    /// Inserts key with a value constructed from args, unless key is already present (then nothing is constructed).
+    /// Returns true if the element was inserted.
+    template <class KeyT, class... Args>
+    bool try_insert(KeyT&& key, Args&&... args)
+    {
+        auto const hash = cc::make_hash(key);
+        if (_table.find(key, hash) != nullptr)
+            return false;
+        _table.insert_new(hash, cc::forward<KeyT>(key), cc::forward<Args>(args)...);
+        return true;
+    }
+
+    /// Returns the value of key, constructing it from args first if key is not present.
+    template <class KeyT, class... Args>
+    V& get_or_emplace(KeyT&& key, Args&&... args)
+    {
+        auto const hash = cc::make_hash(key);
+        if (auto const s = _table.find(key, hash))
+            return s->value;
+        return _table.insert_new(hash, cc::forward<KeyT>(key), cc::forward<Args>(args)...).value;
+    }
+
+    // removal
+public:
+    /// Removes key if present. Returns true if an element was removed.
+    template <class KeyT>
+    bool remove(KeyT const& key)
+    {
+        auto const s = _table.find(key, cc::make_hash(key));
+        if (s == nullptr)
+            return false;
+        _table.erase_at(s - &slot_at(0));
+        return true;
+    }
+
+    /// Removes key and returns its value (or nullopt if key is not present).
+    template <class KeyT>
+    [[nodiscard("use remove() if you don't need the return value")]] cc::optional<V> pop(KeyT const& key)
+    {
+        auto const s = _table.find(key, cc::make_hash(key));
+        if (s == nullptr)
+            return cc::nullopt;
+        auto result = cc::optional<V>(cc::move(s->value));
+        _table.erase_at(s - &slot_at(0));
+        return result;
+    }
+
+    /// Removes all elements for which pred(key, value) returns true. Returns the number of removed elements.
+    template <class Pred>
+    isize remove_all_where(Pred&& pred)
+    {
+        return _table.erase_all_where([&](impl::map_slot<K, V>& s)
+                                      { return bool(pred(static_cast<K const&>(s.key), s.value)); });
+    }
+
+    /// Removes all elements but keeps the capacity.
+    void clear() { _table.clear(); }
+
+    // capacity
+public:
+    /// Makes sure that count elements fit without rehashing.
+    void reserve(isize count) { _table.reserve(count); }
+
+    /// Rebuilds the table for max(size(), count) elements, removing all tombstones.
+    /// rehash(0) shrinks the map to fit (and frees all memory of an empty map).
+    void rehash(isize count = 0) { _table.rehash(count); }
+
+    // factories
+public:
+    /// Creates an empty map that allocates from the given resource (nullptr means default).
+    [[nodiscard]] static map create_with_resource(cc::memory_resource const* resource)
+    {
+        map m;
+        m._table = table_t::create_with_resource(resource);
+        return m;
+    }
+
+    /// Creates an empty map with room for count elements.
+    [[nodiscard]] static map create_with_capacity(isize count, cc::memory_resource const* resource = nullptr)
+    {
+        auto m = map::create_with_resource(resource);
+        m.reserve(count);
+        return m;
+    }
+
+    // ctors/dtor
+public:
+    map() = default;
+
+    /// Later duplicates overwrite earlier ones.
+    map(std::initializer_list<cc::pair<K, V>> entries)
+    {
+        reserve(isize(entries.size()));
+        for (auto const& e : entries)
+            insert_or_assign(e.first, e.second);
+    }
+
+    map(map const&) = default;
+    map(map&&) = default;
+    map& operator=(map const&) = default;
+    map& operator=(map&&) = default;
+
+private:
+    using table_t = impl::hash_table<impl::map_slot<K, V>, impl::map_traits<K, V>>;
+
+    [[nodiscard]] impl::map_slot<K, V>& slot_at(isize idx) const { return _table.slots()[idx]; }
+
+    table_t _table;
 };
@@ -0,0 +1,443 @@
+#pragma once
+
+#include <clean-core/allocation.hh>
+#include <clean-core/atomic_wait.hh>
+#include <clean-core/bit.hh>
+#include <clean-core/fwd.hh>
+#include <clean-core/optional.hh>
+#include <clean-core/span.hh>
+#include <clean-core/utility.hh>
+
+#include <atomic>
+#include <new>
+
+namespace cc::impl
+{
+/// One slot of an mpmc_queue, padded to a full cache line so neighbouring slots never false-share.
+/// sequence encodes the slot state relative to the queue counters (see mpmc_queue).
+template <class T>
+struct alignas(std::hardware_destructive_interference_size) mpmc_slot
+{
+    std::atomic<isize> sequence;
+    cc::storage_for<T> storage = {};
+};
+} // namespace cc::impl
+
+/// Bounded lock-free queue for any number of producer and consumer threads (Vyukov-style).
+///
+/// Every slot carries a sequence number next to its payload. For the position pos (a free-running counter,
+/// slot = pos & mask):
+///   - sequence == pos                 -> the slot is free for the producer that claims pos
+///   - sequence == pos + 1             -> the slot holds the element for the consumer that claims pos
+///   - sequence == pos + capacity      -> the consumer released it, free for the producer of the next lap
+/// Producers and consumers claim positions by CAS on their shared counter and then hand the slot over
+/// with a single release store of its sequence, so there is no lock and no shared "size" word.
+///
+/// Performance design:
+///   - the enqueue and dequeue counters live on separate cache lines, slots are cache-line padded
+///   - batch operations (try_push_range, try_pop_to) claim a run of ready slots with a single CAS
+///   - no blocking here: see cc::blocking_mpmc_queue for a wrapper that parks waiting threads
+///
+/// Payloads may be move-only (e.g. cc::unique_function), which makes this usable as a task submission queue.
+/// Constructors and move assignment of T must not throw (a claimed slot must always be handed over).
+///
+/// The queue is neither copyable nor movable (the threads hold references to it).
+///
+/// Usage:
+///   auto q = cc::mpmc_queue<cc::unique_function<void()>>::create_with_capacity(1024);
+///   // any producer thread
+///   if (!q.try_push([&] { work(); })) ...   // full
+///   // any consumer thread
+///   if (auto task = q.try_pop(); task.has_value())
+///       task.value()();
+template <class T>
+struct cc::mpmc_queue
+{
+    static_assert(std::is_object_v<T> && !std::is_const_v<T>, "queue elements must be non-const objects");
+
+    // queries
+public:
+    /// Maximum number of elements in the queue (a power of two).
+    [[nodiscard]] isize capacity() const { return _mask + 1; }
+
+    /// Number of elements at the time of the call (only a snapshot while other threads are active).
+    [[nodiscard]] isize size() const
+    {
+        auto const head = _dequeue.pos.load(std::memory_order_acquire);
+        auto const tail = _enqueue.pos.load(std::memory_order_acquire);
+        return cc::min(cc::max(tail - head, isize(0)), capacity());
+    }
+    [[nodiscard]] bool empty() const { return size() == 0; }
+
+    // producers
+public:
+    /// Constructs an element at the back unless the queue is full. Returns true if the element was pushed.
+    /// args are only consumed on success, so a failed try_push(cc::move(x)) leaves x intact.
+    template <class... Args>
+    bool try_emplace(Args&&... args)
+    {
+        auto const [pos, count] = claim(_enqueue.pos, 1, 0);
+        if (count == 0)
+            return false;
+        auto& s = slot(pos);
+        new (cc::placement_new, &s.storage.value) T(cc::forward<Args>(args)...);
+        s.sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+    bool try_push(T const& value) { return try_emplace(value); }
+    bool try_push(T&& value) { return try_emplace(cc::move(value)); }
+
+    /// Copies as many values as fit (from the front of values), claiming all slots with a single CAS.
+    /// Returns the number of pushed values.
+    isize try_push_range(cc::span<T const> values)
+    {
+        return push_claimed(values.size(), [&](isize i) -> T const& { return values[i]; });
+    }
+
+    /// Like try_push_range, but moves from the pushed values (the first n returned ones), e.g. for move-only T.
+    isize try_push_moved_range(cc::span<T> values)
+    {
+        return push_claimed(values.size(), [&](isize i) -> T&& { return cc::move(values[i]); });
+    }
+
+    // consumers
+public:
+    /// Removes and returns the front element, or nullopt if the queue is empty.
+    [[nodiscard]] cc::optional<T> try_pop()
+    {
+        auto const [pos, count] = claim(_dequeue.pos, 1, 1);
+        if (count == 0)
+            return cc::nullopt;
+        auto& s = slot(pos);
+        cc::optional<T> result = cc::move(s.storage.value);
+        release(s, pos);
+        return result;
+    }
+
+    /// Moves up to dest.size() elements into dest (assigning to the existing objects there),
+    /// claiming all slots with a single CAS. Returns the number of moved elements.
+    isize try_pop_to(cc::span<T> dest)
+    {
+        if (dest.empty())
+            return 0;
+        auto const [pos, count] = claim(_dequeue.pos, dest.size(), 1);
+        for (isize i = 0; i < count; ++i)
+        {
+            auto& s = slot(pos + i);
+            dest[i] = cc::move(s.storage.value);
+            release(s, pos + i);
+        }
+        return count;
+    }
+
+    // factories
+public:
+    /// Creates a queue with room for at least count elements (rounded up to a power of two, at least 2).
+    [[nodiscard]] static mpmc_queue create_with_capacity(isize count, cc::memory_resource const* resource = nullptr)
+    {
+        CC_ASSERT(count > 0, "queue capacity must be positive");
+        return mpmc_queue(isize(cc::bit_ceil(u64(cc::max(count, isize(2))))), resource);
+    }
+
+    // ctors/dtor
+public:
+    mpmc_queue(mpmc_queue const&) = delete;
+    mpmc_queue(mpmc_queue&&) = delete;
+    mpmc_queue& operator=(mpmc_queue const&) = delete;
+    mpmc_queue& operator=(mpmc_queue&&) = delete;
+
+    ~mpmc_queue()
+    {
+        if constexpr (!std::is_trivially_destructible_v<T>)
+        {
+            auto const head = _dequeue.pos.load(std::memory_order_relaxed);
+            auto const tail = _enqueue.pos.load(std::memory_order_relaxed);
+            for (auto pos = head; pos != tail; ++pos)
+                slot(pos).storage.value.~T();
+        }
+    }
+
+private:
+    using slot_t = impl::mpmc_slot<T>;
+
+    static constexpr isize cache_line = std::hardware_destructive_interference_size;
+
+    struct claimed
+    {
+        isize pos;
+        isize count;
+    };
+
+    // slot destructors do nothing, so the allocation keeps an empty live window and we only manage payloads
+    mpmc_queue(isize capacity, cc::memory_resource const* resource)
+      : _storage(cc::allocation<slot_t>::create_empty(capacity, alignof(slot_t), resource)),
+        _slots(_storage.obj_start),
+        _mask(capacity - 1)
+    {
+        for (isize i = 0; i < capacity; ++i)
+            new (cc::placement_new, _slots + i) slot_t{.sequence = i};
+    }
+
+    [[nodiscard]] CC_FORCE_INLINE slot_t& slot(isize pos) const { return _slots[pos & _mask]; }
+
+    // claims up to max_count consecutive slots at the shared counter whose sequence is (their position + lag),
+    // i.e. free slots for producers (lag 0) or full slots for consumers (lag 1)
+    // count == 0 means the first slot is not ready (queue full/empty)
+    // checking the run before the CAS is enough: a ready slot can only change state
+    // after someone claims its position, which moves the counter past it and fails our CAS
+    [[nodiscard]] claimed claim(std::atomic<isize>& counter, isize max_count, isize lag)
+    {
+        auto pos = counter.load(std::memory_order_relaxed);
+        while (true)
+        {
+            isize count = 0;
+            while (count < max_count && slot(pos + count).sequence.load(std::memory_order_acquire) == pos + count + lag)
+                ++count;
+
+            if (count == 0)
+            {
+                // behind the counter: not ready for this lap yet, ahead: someone else claimed pos, retry
+                if (slot(pos).sequence.load(std::memory_order_acquire) - (pos + lag) < 0)
+                    return {pos, 0};
+                pos = counter.load(std::memory_order_relaxed);
+                continue;
+            }
+
+            if (counter.compare_exchange_weak(pos, pos + count, std::memory_order_relaxed))
+                return {pos, count};
+        }
+    }
+
+    template <class GetValue>
+    isize push_claimed(isize max_count, GetValue&& get_value)
+    {
+        if (max_count == 0)
+            return 0;
+        auto const [pos, count] = claim(_enqueue.pos, max_count, 0);
+        for (isize i = 0; i < count; ++i)
+        {
+            auto& s = slot(pos + i);
+            new (cc::placement_new, &s.storage.value) T(get_value(i));
+            s.sequence.store(pos + i + 1, std::memory_order_release);
+        }
+        return count;
+    }
+
+    // destroys the (moved-from) payload and hands the slot to the producer of the next lap
+    CC_FORCE_INLINE void release(slot_t& s, isize pos)
+    {
+        s.storage.value.~T();
+        s.sequence.store(pos + capacity(), std::memory_order_release);
+    }
+
+private:
+    struct alignas(cache_line) counter_line
+    {
+        std::atomic<isize> pos = 0;
+    };
+
+    counter_line _enqueue;
+    counter_line _dequeue;
+
+    // read-only after construction
+    cc::allocation<slot_t> _storage;
+    slot_t* _slots = nullptr;
+    isize _mask = 0;
+};
+
+/// cc::mpmc_queue plus blocking push/pop that park waiting threads via cc::atomic_wait.
+///
+/// Waiters spin briefly, yield, then sleep on an epoch counter. Every successful operation pays
+/// one seq_cst fence to check for sleepers on the other side, and a wakeup syscall only if there are any.
+/// Use the plain cc::mpmc_queue if all users poll anyway.
+///
+/// Usage:
+///   auto q = cc::blocking_mpmc_queue<job>::create_with_capacity(256);
+///   q.push(job{...});        // producer, blocks while full
+///   auto j = q.pop();        // consumer, blocks while empty
+template <class T>
+struct cc::blocking_mpmc_queue
+{
+    // queries
+public:
+    [[nodiscard]] isize capacity() const { return _queue.capacity(); }
+    [[nodiscard]] isize size() const { return _queue.size(); }
+    [[nodiscard]] bool empty() const { return _queue.empty(); }
+
+    // producers
+public:
+    /// Constructs an element at the back unless the queue is full. Returns true if the element was pushed.
+    template <class... Args>
+    bool try_emplace(Args&&... args)
+    {
+        if (!_queue.try_emplace(cc::forward<Args>(args)...))
+            return false;
+        notify(_not_empty, 1);
+        return true;
+    }
+    bool try_push(T const& value) { return try_emplace(value); }
+    bool try_push(T&& value) { return try_emplace(cc::move(value)); }
+
+    /// Pushes an element, waiting while the queue is full.
+    template <class... Args>
+    void emplace(Args&&... args)
+    {
+        wait_until(_not_full, [&] { return _queue.try_emplace(cc::forward<Args>(args)...); });
+        notify(_not_empty, 1);
+    }
+    void push(T const& value) { emplace(value); }
+    void push(T&& value) { emplace(cc::move(value)); }
+
+    /// Copies as many values as fit, returns the number of pushed values.
+    isize try_push_range(cc::span<T const> values)
+    {
+        auto const count = _queue.try_push_range(values);
+        notify(_not_empty, count);
+        return count;
+    }
+
+    /// Copies all values, waiting for free slots as needed.
+    void push_range(cc::span<T const> values)
+    {
+        while (!values.empty())
+        {
+            isize count = 0;
+            wait_until(_not_full, [&] { return (count = _queue.try_push_range(values)) > 0; });
+            notify(_not_empty, count);
+            values = cc::span<T const>(values.data() + count, values.size() - count);
+        }
+    }
+
+    /// Like try_push_range, but moves from the pushed values.
+    isize try_push_moved_range(cc::span<T> values)
+    {
+        auto const count = _queue.try_push_moved_range(values);
+        notify(_not_empty, count);
+        return count;
+    }
+
+    // consumers
+public:
+    /// Removes and returns the front element, or nullopt if the queue is empty.
+    [[nodiscard]] cc::optional<T> try_pop()
+    {
+        auto result = _queue.try_pop();
+        if (result.has_value())
+            notify(_not_full, 1);
+        return result;
+    }
+
+    /// Removes and returns the front element, waiting while the queue is empty.
+    [[nodiscard]] T pop()
+    {
+        cc::optional<T> result;
+        wait_until(_not_empty, [&] { return (result = _queue.try_pop()).has_value(); });
+        notify(_not_full, 1);
+        return cc::move(result).value();
+    }
+
+    /// Moves up to dest.size() elements into dest, returns the number of moved elements.
+    isize try_pop_to(cc::span<T> dest)
+    {
+        auto const count = _queue.try_pop_to(dest);
+        notify(_not_full, count);
+        return count;
+    }
+
+    /// Like try_pop_to, but waits until at least one element is available (if dest is not empty).
+    isize pop_to(cc::span<T> dest)
+    {
+        if (dest.empty())
+            return 0;
+        isize count = 0;
+        wait_until(_not_empty, [&] { return (count = _queue.try_pop_to(dest)) > 0; });
+        notify(_not_full, count);
+        return count;
+    }
+
+    // factories
+public:
+    /// Creates a queue with room for at least count elements (rounded up to a power of two, at least 2).
+    [[nodiscard]] static blocking_mpmc_queue create_with_capacity(isize count,
+                                                                  cc::memory_resource const* resource = nullptr)
+    {
+        return blocking_mpmc_queue(count, resource);
+    }
+
+    // ctors/dtor
+public:
+    blocking_mpmc_queue(blocking_mpmc_queue const&) = delete;
+    blocking_mpmc_queue(blocking_mpmc_queue&&) = delete;
+    blocking_mpmc_queue& operator=(blocking_mpmc_queue const&) = delete;
+    blocking_mpmc_queue& operator=(blocking_mpmc_queue&&) = delete;
+    ~blocking_mpmc_queue() = default;
+
+private:
+    static constexpr isize cache_line = std::hardware_destructive_interference_size;
+
+    // a waiting call first spins, then yields its time slice, then sleeps
+    static constexpr int spin_count = 64;
+    static constexpr int yield_count = 16;
+
+    // sleepers wait for epoch to change, waiters tells the other side whether anyone might be sleeping
+    struct alignas(cache_line) parking_line
+    {
+        std::atomic<u32> epoch = 0;
+        std::atomic<u32> waiters = 0;
+    };
+
+    blocking_mpmc_queue(isize count, cc::memory_resource const* resource)
+      : _queue(mpmc_queue<T>::create_with_capacity(count, resource))
+    {
+    }
+
+    // retries attempt() until it returns true
+    // the waiter fence (after announcing) and the notifier fence (after the queue operation) are both seq_cst:
+    // either the notifier sees the waiter count or the waiter's final attempt sees the queue operation
+    template <class Attempt>
+    void wait_until(parking_line& p, Attempt&& attempt)
+    {
+        for (auto i = 0; i < spin_count + yield_count; ++i)
+        {
+            if (attempt())
+                return;
+            if (i < spin_count)
+                cc::cpu_relax();
+            else
+                cc::yield_thread();
+        }
+
+        while (true)
+        {
+            auto const epoch = p.epoch.load(std::memory_order_acquire);
+            p.waiters.fetch_add(1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (attempt())
+            {
+                p.waiters.fetch_sub(1, std::memory_order_relaxed);
+                return;
+            }
+            cc::atomic_wait(p.epoch, epoch);
+            p.waiters.fetch_sub(1, std::memory_order_relaxed);
+        }
+    }
+
+    CC_FORCE_INLINE void notify(parking_line& p, isize count)
+    {
+        if (count == 0)
+            return;
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (p.waiters.load(std::memory_order_relaxed) == 0) [[likely]]
+            return;
+        p.epoch.fetch_add(1, std::memory_order_release);
+        if (count == 1)
+            cc::atomic_wake_one(p.epoch);
+        else
+            cc::atomic_wake_all(p.epoch);
+    }
+
+private:
+    mpmc_queue<T> _queue;
+    parking_line _not_empty;
+    parking_line _not_full;
+};
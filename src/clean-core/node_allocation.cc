@@ -2,8 +2,10 @@
 
 #include <clean-core/allocation.hh>
 #include <clean-core/bit.hh>
+#include <clean-core/string.hh>
 
 #include <atomic>
+#include <format>
 
 namespace
 {
@@ -17,10 +19,20 @@ void system_deallocate_node_bytes_large(cc::byte* ptr, cc::node_class_index idx,
 cc::byte* system_refill_slabs_and_allocate_node_bytes(cc::node_allocator::slab_info& slabs,
                                                       cc::node_class_index idx,
                                                       void* userdata);
+void system_collect_stats(cc::node_memory_resource_stats& stats, void* userdata);
 
 // forward declaration of the system node memory resource (defined below)
 extern cc::node_memory_resource system_node_memory_resource;
 
+// statistics of the system node memory resource, shared by all threads
+// only touched in cold paths (refill, large alloc/free) and always via atomic ops
+cc::isize system_stats_slab_count[cc::isize(cc::node_class_index::small_count)] = {};
+cc::isize system_stats_large_alloc_count = 0;
+cc::isize system_stats_large_free_count = 0;
+cc::isize system_stats_large_live_bytes = 0;
+cc::isize system_stats_backing_count = 0;
+cc::isize system_stats_backing_bytes = 0;
+
 /// Returns a thread-local node_allocator for the system node memory resource.
 /// The allocator is lazy-initialized with all slabs nullptr.
 cc::node_allocator& system_get_allocator(void* userdata)
@@ -58,6 +70,9 @@ cc::byte* system_allocate_node_bytes_large(cc::node_class_index idx, cc::isize s
     *reinterpret_cast<cc::isize*>(alloc_ptr + 8) = alignment;                                     // NOLINT
     *reinterpret_cast<cc::node_memory_resource**>(alloc_ptr + 16) = &system_node_memory_resource; // NOLINT
 
+    cc::atomic_add(system_stats_large_alloc_count, cc::isize(1));
+    cc::atomic_add(system_stats_large_live_bytes, total_size);
+
     // return pointer past the header
     return alloc_ptr + header_size;
 }
@@ -83,62 +98,77 @@ void system_deallocate_node_bytes_large(cc::byte* ptr, cc::node_class_index idx,
     cc::isize const total_size = header_size + size_bytes;
     cc::default_memory_resource->deallocate_bytes(alloc_ptr, total_size, alignment,
                                                   cc::default_memory_resource->userdata);
+
+    cc::atomic_add(system_stats_large_free_count, cc::isize(1));
+    cc::atomic_sub(system_stats_large_live_bytes, total_size);
 }
 
-/// Refills slabs for a given size class by allocating a new slab from the system memory resource.
-/// Sets up the freemap with appropriate slots forced to zero (for the header metadata).
-/// Wires the new slab into the cyclic slab list (making it the new head).
+/// Size of the superblocks that slabs are carved from.
+/// 2 MiB matches the common huge page size, superblocks are also aligned to it so they can be backed by huge pages.
+constexpr cc::isize system_superblock_size_bytes = cc::isize(2) << 20;
+static_assert(system_superblock_size_bytes % cc::impl::node_slab_carver::chunk_size_bytes == 0);
+
+/// Refills slabs for a given size class by carving a new slab out of the thread's current superblock.
+/// Only when the superblock is exhausted, a new one is allocated from the system memory resource.
+/// Superblocks are never released (slabs are kept alive as other threads might still free into them).
 cc::byte* system_refill_slabs_and_allocate_node_bytes(cc::node_allocator::slab_info& slabs,
                                                       cc::node_class_index idx,
                                                       void* userdata)
 {
     CC_UNUSED(userdata);
-    // allocate a new slab from the system memory resource
-    cc::isize const slab_size = cc::node_slab_size_bytes_for_class(idx);
-    cc::isize const slab_alignment = slab_size; // slabs are aligned to their own size
 
-    cc::byte* new_slab = nullptr;
-    cc::isize const actual_size = cc::default_memory_resource->allocate_bytes(
-        &new_slab, slab_size, slab_size, slab_alignment, cc::default_memory_resource->userdata);
-    CC_ASSERT(actual_size >= slab_size, "system allocator must allocate at least the requested slab size");
-    CC_ASSERT(new_slab != nullptr, "system allocator must return non-null for slab allocation");
-    CC_ASSERT(cc::is_aligned(new_slab, slab_alignment), "slab must be aligned to its own size");
+    // refills are always called on the thread owning the allocator, so thread-local carving needs no locking
+    // this also keeps the slabs of one thread close together
+    thread_local cc::impl::node_slab_carver tls_carver;
 
-    // compute how many slots are blocked by the 16-byte header (freemap + next pointer)
-    // header is 16 bytes: [freemap (8B)][next slab pointer (8B)]
-    constexpr cc::isize header_bytes = 16;
-    cc::isize const class_size = cc::isize(1) << cc::isize(idx);                  // 2^idx
-    cc::isize const blocked_slots = (header_bytes + class_size - 1) / class_size; // round up division
+    cc::byte* new_slab = tls_carver.try_carve_slab(idx);
+    if (new_slab == nullptr)
+    {
+        cc::byte* superblock = nullptr;
+        cc::isize const actual_size = cc::default_memory_resource->allocate_bytes(
+            &superblock, system_superblock_size_bytes, system_superblock_size_bytes, system_superblock_size_bytes,
+            cc::default_memory_resource->userdata);
+        CC_ASSERT(actual_size >= system_superblock_size_bytes, "system allocator must allocate at least the requested "
+                                                               "superblock size");
+        CC_ASSERT(superblock != nullptr, "system allocator must return non-null for superblock allocation");
+
+        cc::atomic_add(system_stats_backing_count, cc::isize(1));
+        cc::atomic_add(system_stats_backing_bytes, system_superblock_size_bytes);
+
+        tls_carver.set_block(superblock, superblock + system_superblock_size_bytes);
+        new_slab = tls_carver.try_carve_slab(idx);
+        CC_ASSERT(new_slab != nullptr, "a fresh superblock must fit any slab");
+    }
 
-    // initialize freemap: all bits set to 1 (free), except for blocked slots
-    cc::u64 initial_freemap = ~cc::u64(0);                          // all 1s
-    cc::u64 const blocked_mask = (cc::u64(1) << blocked_slots) - 1; // mask for blocked slots
-    initial_freemap &= ~blocked_mask;                               // clear bits for blocked slots
+    CC_ASSERT(cc::is_aligned(new_slab, cc::node_slab_size_bytes_for_class(idx)),
+              "slab must be aligned to its own size");
 
-    // write freemap
-    *reinterpret_cast<cc::u64*>(new_slab) = initial_freemap; // NOLINT
+    cc::atomic_add(system_stats_slab_count[cc::isize(idx)], cc::isize(1));
 
-    // get reference to the slab base for this class
-    cc::byte*& slab_base_ref = slabs.slab_base[cc::isize(idx)];
+    return cc::impl::node_link_slab_and_allocate(slabs, idx, new_slab);
+}
 
-    // DEBUG: for now we simply pass out new self-cycles
-    // TODO: keep non-empty previous slabs in here as well
-    // FIXME: this is currently basically a memory leak here, but it's fine for correctness for now
-    *reinterpret_cast<cc::byte**>(new_slab + 8) = new_slab; // NOLINT
+/// Fills the statistics of the system resource from the global counters.
+/// Counters are read individually, so the snapshot is not atomic as a whole while other threads allocate.
+void system_collect_stats(cc::node_memory_resource_stats& stats, void* userdata)
+{
+    CC_UNUSED(userdata);
 
-    // update slab base reference to point to the new slab (making it the new head)
-    slab_base_ref = new_slab;
+    auto const load = [](cc::isize& v) { return std::atomic_ref<cc::isize>(v).load(std::memory_order_relaxed); };
 
-    // allocate the first free slot from the new slab
-    auto const a_freemap = std::atomic_ref<cc::u64>(*cc::node_slab_freemap_for_base(new_slab));
-    auto const freemap = a_freemap.load();
-    CC_ASSERT(freemap != 0, "newly allocated slab must have at least one free slot");
+    for (cc::isize i = 0; i < cc::isize(cc::node_class_index::small_count); ++i)
+    {
+        stats.slab_count[i] = load(system_stats_slab_count[i]);
+        stats.slab_bytes += stats.slab_count[i] * cc::node_slab_size_bytes_for_class(cc::node_class_index(i));
+    }
 
-    auto const slot_idx = cc::count_trailing_zeroes(freemap);
-    auto const slot_bit = cc::u64(1) << slot_idx;
-    a_freemap.fetch_and(~slot_bit);
+    stats.backing_count = load(system_stats_backing_count);
+    stats.backing_bytes = load(system_stats_backing_bytes);
 
-    return cc::node_slot_ptr_for(new_slab, idx, slot_idx);
+    stats.large_alloc_count = load(system_stats_large_alloc_count);
+    stats.large_free_count = load(system_stats_large_free_count);
+    stats.large_live_count = stats.large_alloc_count - stats.large_free_count;
+    stats.large_live_bytes = load(system_stats_large_live_bytes);
 }
 
 constinit cc::node_memory_resource system_node_memory_resource = {
@@ -146,6 +176,7 @@ constinit cc::node_memory_resource system_node_memory_resource = {
     .allocate_node_bytes_large = system_allocate_node_bytes_large,
     .refill_slabs_and_allocate_node_bytes = system_refill_slabs_and_allocate_node_bytes,
     .deallocate_node_bytes_large = system_deallocate_node_bytes_large,
+    .collect_stats = system_collect_stats,
     .userdata = nullptr,
 };
 
@@ -153,6 +184,44 @@ constinit cc::node_memory_resource system_node_memory_resource = {
 
 constinit cc::node_memory_resource* const cc::default_node_memory_resource = &system_node_memory_resource;
 
+cc::byte* cc::impl::node_link_slab_and_allocate(node_allocator::slab_info& slabs, node_class_index idx, cc::byte* slab)
+{
+    CC_ASSERT(slab != nullptr, "slab must not be null");
+    CC_ASSERT(cc::is_aligned(slab, cc::node_slab_size_bytes_for_class(idx)), "slab must be aligned to its own size");
+
+    // initialize freemap: all bits set to 1 (free), except for the slots blocked by the 16-byte header
+    // header is 16 bytes: [freemap (8B)][next slab pointer (8B)]
+    *cc::node_slab_freemap_for_base(slab) = cc::node_slab_initial_freemap_for_class(idx);
+
+    // link into the ring directly after the current head (or form a new self-cycle)
+    // the slab ring is only modified by the owning thread, remote frees only touch freemaps
+    cc::byte*& head = slabs.slab_base[isize(idx)];
+    auto& next = *reinterpret_cast<cc::byte**>(slab + 8); // NOLINT
+    if (head == nullptr)
+    {
+        next = slab;
+    }
+    else
+    {
+        next = cc::node_slab_next_for_base(head);
+        *reinterpret_cast<cc::byte**>(head + 8) = slab; // NOLINT
+    }
+
+    // the new slab becomes the new head
+    head = slab;
+
+    // allocate the first free slot from the new slab
+    auto const a_freemap = std::atomic_ref<u64>(*cc::node_slab_freemap_for_base(slab));
+    auto const freemap = a_freemap.load();
+    CC_ASSERT(freemap != 0, "newly allocated slab must have at least one free slot");
+
+    auto const slot_idx = cc::count_trailing_zeroes(freemap);
+    auto const slot_bit = u64(1) << slot_idx;
+    a_freemap.fetch_and(~slot_bit);
+
+    return cc::node_slot_ptr_for(slab, idx, u64(slot_idx));
+}
+
 void cc::node_allocation_free_large(cc::byte* ptr, node_class_index idx)
 {
     CC_ASSERT(cc::is_aligned(ptr, 8), "large node allocations must be at least 8-byte aligned");
@@ -169,6 +238,10 @@ cc::byte* cc::node_allocator::allocate_node_bytes_large(node_class_index idx, is
 {
     CC_ASSERT(_resource != nullptr, "node_allocator must have a valid resource");
     CC_ASSERT(_resource->allocate_node_bytes_large != nullptr, "resource must implement allocate_node_bytes_large");
+
+    _stats.large_alloc_count += 1;
+    _stats.large_alloc_bytes += size_bytes;
+
     return _resource->allocate_node_bytes_large(idx, size_bytes, alignment, _resource->userdata);
 }
 
@@ -177,6 +250,9 @@ cc::byte* cc::node_allocator::refill_slabs_and_allocate_node_bytes(node_class_in
     CC_ASSERT(_resource != nullptr, "node_allocator must have a valid resource");
     CC_ASSERT(_resource->refill_slabs_and_allocate_node_bytes != nullptr, "resource must implement "
                                                                           "refill_slabs_and_allocate_node_bytes");
+
+    _stats.classes[isize(idx)].refill_count += 1;
+
     return _resource->refill_slabs_and_allocate_node_bytes(_slabs, idx, _resource->userdata);
 }
 
@@ -188,15 +264,19 @@ cc::byte* cc::node_allocator::allocate_node_bytes_non_fast(node_class_index idx)
     auto const start_base = _slabs.slab_base[isize(idx)];
     CC_ASSERT(start_base != nullptr, "node class should be initialized");
 
+    auto& stats = _stats.classes[isize(idx)];
+    stats.ring_scan_count += 1;
+
     // slab is initialized but full
-    // we now iterate the slab ring to find a new free slab
+    // we now scan the slab ring for slabs with slots that were freed in the meantime
     // this is still reasonably hot (it's the full node capacity for this thread without refill)
-    // TODO: this is currently non-ideal for alloc-only workflows
-    //       because we go through the list for each exhaustion
-    //       with some minimal bookkeeping, we can keep this cheaper
-    //       maybe slabs need to know the owning allocators after all
+    // the scan is bounded so alloc-only workloads don't walk the whole (full) ring on every exhaustion
+    // a subsequent refill links the new slab after the last scanned one, so the next scan continues from there
+    constexpr int max_scanned_slabs = 8;
+
+    auto prev = start_base;
     auto base = cc::node_slab_next_for_base(start_base);
-    while (base != start_base)
+    for (int i = 0; i < max_scanned_slabs && base != start_base; ++i)
     {
         CC_ASSERT(base != nullptr, "the slab ring must be a cycling single-linked-list. indicates a "
                                    "node_memory_resource bug.");
@@ -209,6 +289,9 @@ cc::byte* cc::node_allocator::allocate_node_bytes_non_fast(node_class_index idx)
             // record next free slab
             _slabs.slab_base[isize(idx)] = base;
 
+            // everything free in here was freed after the slab ran full
+            stats.scan_reclaimed_count += cc::popcount(freemap);
+
             // allocate & return
             auto const slot_idx = cc::count_trailing_zeroes(freemap);
             auto const slot_bit = u64(1) << slot_idx;
@@ -218,15 +301,17 @@ cc::byte* cc::node_allocator::allocate_node_bytes_non_fast(node_class_index idx)
             auto const old_freemap = a_freemap.fetch_and(~slot_bit);
             CC_ASSERT((old_freemap & slot_bit) != 0, "double-allocation detected. this indicates multiple threads "
                                                      "allocating from the same slab");
-            return cc::node_slot_ptr_for(base, idx, slot_idx);
+            return cc::node_slot_ptr_for(base, idx, u64(slot_idx));
         }
 
         // advance
+        prev = base;
         base = cc::node_slab_next_for_base(base);
     }
 
-    // all slabs in the ring are full
-    // => we request more from the allocator
+    // all scanned slabs are full
+    // => we request more from the allocator, the new slab is linked in after the last scanned slab
+    _slabs.slab_base[isize(idx)] = prev;
     return this->refill_slabs_and_allocate_node_bytes(idx);
 }
 
@@ -234,3 +319,122 @@ cc::node_allocator& cc::default_node_allocator()
 {
     return cc::default_node_memory_resource->get_allocator(cc::default_node_memory_resource->userdata);
 }
+
+cc::node_allocator_stats cc::node_allocator::collect_stats() const
+{
+    // event counters are tracked continuously, slab state is computed here
+    node_allocator_stats stats = _stats;
+
+    for (isize i = 0; i < isize(node_class_index::small_count); ++i)
+    {
+        auto const start_base = _slabs.slab_base[i];
+        if (start_base == nullptr)
+            continue;
+
+        auto& class_stats = stats.classes[i];
+        auto const usable_slots = isize(cc::popcount(cc::node_slab_initial_freemap_for_class(node_class_index(i))));
+
+        auto base = start_base;
+        do
+        {
+            CC_ASSERT(base != nullptr, "the slab ring must be a cycling single-linked-list. indicates a "
+                                       "node_memory_resource bug.");
+
+            // other threads may free concurrently, so this is only a snapshot
+            auto const freemap = cc::atomic_load(*cc::node_slab_freemap_for_base(base), std::memory_order_relaxed);
+
+            class_stats.slab_count += 1;
+            class_stats.slot_capacity += usable_slots;
+            class_stats.live_slots += usable_slots - isize(cc::popcount(freemap));
+
+            base = cc::node_slab_next_for_base(base);
+        } while (base != start_base);
+    }
+
+    return stats;
+}
+
+cc::node_memory_resource_stats cc::collect_stats(node_memory_resource const& resource)
+{
+    node_memory_resource_stats stats;
+    if (resource.collect_stats != nullptr)
+        resource.collect_stats(stats, resource.userdata);
+    return stats;
+}
+
+cc::isize cc::node_allocator_stats::total_slab_count() const
+{
+    isize sum = 0;
+    for (auto const& c : classes)
+        sum += c.slab_count;
+    return sum;
+}
+
+cc::isize cc::node_allocator_stats::total_slab_bytes() const
+{
+    isize sum = 0;
+    for (isize i = 0; i < isize(node_class_index::small_count); ++i)
+        sum += classes[i].slab_count * cc::node_slab_size_bytes_for_class(node_class_index(i));
+    return sum;
+}
+
+cc::isize cc::node_allocator_stats::total_live_slots() const
+{
+    isize sum = 0;
+    for (auto const& c : classes)
+        sum += c.live_slots;
+    return sum;
+}
+
+cc::isize cc::node_allocator_stats::total_live_bytes() const
+{
+    isize sum = 0;
+    for (isize i = 0; i < isize(node_class_index::small_count); ++i)
+        sum += classes[i].live_slots * cc::node_slot_size_bytes_for_class(node_class_index(i));
+    return sum;
+}
+
+cc::string cc::node_allocator_stats::to_string() const
+{
+    cc::string s = "node_allocator stats\n";
+    s += std::format("  {:>5} {:>6} {:>7} {:>9} {:>9} {:>8} {:>8} {:>9}\n", //
+                     "class", "size", "slabs", "capacity", "live", "refills", "scans", "reclaimed");
+
+    for (isize i = 0; i < isize(node_class_index::small_count); ++i)
+    {
+        auto const& c = classes[i];
+        if (c.slab_count == 0 && c.refill_count == 0 && c.ring_scan_count == 0)
+            continue;
+
+        s += std::format("  {:>5} {:>5}B {:>7} {:>9} {:>9} {:>8} {:>8} {:>9}\n", //
+                         i, cc::node_slot_size_bytes_for_class(node_class_index(i)), c.slab_count, c.slot_capacity,
+                         c.live_slots, c.refill_count, c.ring_scan_count, c.scan_reclaimed_count);
+    }
+
+    s += std::format("  total: {} slabs ({} bytes), {} live slots ({} bytes)\n", //
+                     total_slab_count(), total_slab_bytes(), total_live_slots(), total_live_bytes());
+    s += std::format("  large: {} allocations ({} bytes requested)\n", large_alloc_count, large_alloc_bytes);
+    return s;
+}
+
+cc::string cc::node_memory_resource_stats::to_string() const
+{
+    cc::string s = "node_memory_resource stats\n";
+
+    for (isize i = 0; i < isize(node_class_index::small_count); ++i)
+    {
+        if (slab_count[i] == 0)
+            continue;
+
+        auto const idx = node_class_index(i);
+        s += std::format("  class {} ({}B): {} slabs ({} bytes)\n", //
+                         i, cc::node_slot_size_bytes_for_class(idx), slab_count[i],
+                         slab_count[i] * cc::node_slab_size_bytes_for_class(idx));
+    }
+
+    s += std::format("  slabs total: {} bytes\n", slab_bytes);
+    s += std::format("  backing: {} allocations ({} bytes)\n", backing_count, backing_bytes);
+    s += std::format("  large: {} live ({} bytes), {} allocations, {} frees\n", //
+                     large_live_count, large_live_bytes, large_alloc_count, large_free_count);
+    return s;
+}
@@ -7,58 +7,149 @@
 #include <atomic>
 
 /// Newtype for size class index (0, 1, 2, ...) to prevent API confusion.
-/// The index i maps to actual size 2^i bytes.
+/// Small classes are 1, 2, 4, 8, 16 bytes, followed by alternating intermediate and power-of-two classes:
+///   index:  0  1  2  3   4   5   6   7   8   9   10   11   12
+///   size:   1  2  4  8  16  24  32  48  64  96  128  192  256
+/// The intermediate classes 3 * 2^k cut the worst-case internal fragmentation from 50% to 33%.
 /// Kept as u8 to be as tight as possible
 enum class cc::node_class_index : cc::u8
 {
-    // max small class is 2^8 = 256 bytes
+    // max small class is 256 bytes
     // after that we do normal allocations and store a header
-    small_max = 8,
+    small_max = 12,
 
     // number of small size classes
     small_count = small_max + 1,
 };
 
-/// Newtype for actual size class in bytes (1, 2, 4, 8, 16, ...) to prevent API confusion.
-/// This is the actual allocation size & alignment, computed as 2^index.
+/// Newtype for actual size class in bytes (1, 2, 4, 8, 16, 24, 32, ...) to prevent API confusion.
+/// This is the actual allocation size of a slot (see node_slot_size_bytes_for_class).
 enum class cc::node_class_size : cc::u64
 {
 };
 
+namespace cc::impl
+{
+/// Slab layout of a single small size class.
+/// Slot sizes are either 2^k (power-of-two classes) or 3 * 2^k (intermediate classes).
+/// All slabs have power-of-two sizes and are aligned to their own size, so slab base recovery stays a single AND.
+///
+/// Power-of-two classes use 64 slots per slab, the 16-byte slab header blocks the first slot(s).
+/// Intermediate classes use slabs of 128 * 2^k bytes holding 42 slots of 3 * 2^k bytes.
+/// The 2 * 2^k leftover bytes host the header, slots start at max(16, 2^k) (keeping 2^k alignment).
+///
+/// Slot indices are computed as ((offset >> slot_shift) * slot_index_mul) >> 9,
+/// i.e. a shift by the power-of-two factor followed by a precomputed reciprocal multiplication:
+///   - power-of-two classes: slot_index_mul = 512 (identity)
+///   - intermediate classes: slot_index_mul = 171 ~ 512 / 3, exact for all offsets < 512 * 2^k
+struct node_class_geometry
+{
+    isize slot_size = 0;
+    isize slab_size = 0;
+    isize first_slot_offset = 0;
+    u64 initial_freemap = 0;
+    u64 slot_shift = 0;
+    u64 slot_index_mul = 0;
+};
+
+[[nodiscard]] constexpr node_class_geometry make_node_class_geometry(isize idx)
+{
+    constexpr isize header_bytes = 16;
+
+    node_class_geometry g;
+
+    // power-of-two classes: 1, 2, 4, 8, 16 and then every second index
+    if (idx <= 4 || idx % 2 == 0)
+    {
+        auto const shift = idx <= 4 ? idx : (idx + 4) / 2;
+        g.slot_size = isize(1) << shift;
+        g.slab_size = g.slot_size * 64;
+        g.first_slot_offset = 0;
+        auto const blocked_slots = (header_bytes + g.slot_size - 1) / g.slot_size; // round up division
+        g.initial_freemap = ~u64(0) << u64(blocked_slots);
+        g.slot_shift = u64(shift);
+        g.slot_index_mul = 512;
+    }
+    // intermediate classes: 24, 48, 96, 192
+    else
+    {
+        auto const shift = (idx + 1) / 2;
+        auto const unit = isize(1) << shift;
+        g.slot_size = 3 * unit;
+        g.slab_size = 128 * unit;
+        g.first_slot_offset = cc::max(header_bytes, unit);
+        g.initial_freemap = (u64(1) << 42) - 1;
+        g.slot_shift = u64(shift);
+        g.slot_index_mul = 171;
+    }
+
+    return g;
+}
+
+/// Precomputed geometry of all small size classes, indexed by node_class_index.
+inline constexpr node_class_geometry node_class_geometries[] = {
+    make_node_class_geometry(0),  make_node_class_geometry(1),  make_node_class_geometry(2),
+    make_node_class_geometry(3),  make_node_class_geometry(4),  make_node_class_geometry(5),
+    make_node_class_geometry(6),  make_node_class_geometry(7),  make_node_class_geometry(8),
+    make_node_class_geometry(9),  make_node_class_geometry(10), make_node_class_geometry(11),
+    make_node_class_geometry(12),
+};
+static_assert(sizeof(node_class_geometries) / sizeof(node_class_geometry) == isize(node_class_index::small_count));
+} // namespace cc::impl
+
 namespace cc
 {
 /// Compute the class index from size and alignment requirements.
-/// Class index i maps to actual size 2^i bytes (power of two).
-/// Input is max(size, alignment) rounded up to next power of 2 via bit_width.
+/// Picks the smallest class whose slot size is at least max(size, alignment) and whose slots satisfy the alignment.
+/// Intermediate classes 3 * 2^k only guarantee 2^k alignment, so over-aligned types skip them.
+/// Large nodes (> 256 bytes) continue with index 2 * bit_width - 4, which only distinguishes them from small nodes.
 /// This helper is called by the templated node_class_index_for<T>() to minimize template logic.
-/// Examples: size=1,align=1 → max=1 → bit_width=1 → index=0 (class size 1)
-///           size=5,align=4 → max=5 → bit_width(4)=3 → index=3 (class size 8)
-///           size=16,align=8 → max=16 → bit_width(15)=4 → index=4 (class size 16)
+/// Examples: size=1,align=1   → index 0 (class size 1)
+///           size=5,align=4   → index 3 (class size 8)
+///           size=24,align=8  → index 5 (class size 24)
+///           size=24,align=16 → index 6 (class size 32)
+///           size=136,align=8 → index 11 (class size 192)
 [[nodiscard]] constexpr node_class_index node_class_index_from_size_and_align(isize size, isize alignment)
 {
     auto const required = cc::max(size, alignment);
-    return node_class_index(cc::bit_width(u64(required - 1)));
+    auto const p = isize(cc::bit_width(u64(required - 1))); // required <= 2^p
+
+    if (p <= 4)
+        return node_class_index(p);
+
+    // intermediate class 3 * 2^(p-2) between 2^(p-1) and 2^p
+    if (p <= 8 && required <= (isize(3) << (p - 2)) && alignment <= (isize(1) << (p - 2)))
+        return node_class_index(2 * p - 5);
+
+    return node_class_index(2 * p - 4);
 }
 
 /// Compute the class index for T.
-/// Class index i means actual allocation size is 2^i bytes.
 /// All nodes with the same class index share slab infrastructure.
 /// Uses bit operations for ultra-cheap computation and masking logic.
-/// Examples: sizeof=1,alignof=1 → index 0 (size 1)
+/// Examples: sizeof=1,alignof=1  → index 0 (size 1)
 ///           sizeof=12,alignof=4 → index 4 (size 16)
-///           sizeof=24,alignof=8 → index 5 (size 32)
+///           sizeof=24,alignof=8 → index 5 (size 24)
 template <class T>
 [[nodiscard]] constexpr node_class_index node_class_index_for()
 {
     return node_class_index_from_size_and_align(sizeof(T), alignof(T));
 }
 
-/// Compute slab size in bytes for a given class index.
-/// Slab size = (2^index) * 64 bytes, yielding exactly 64 slots per slab.
-/// Examples: index 0 (size 1) → 64 bytes, index 2 (size 4) → 256 bytes, index 4 (size 16) → 1024 bytes.
+/// Compute the slot size in bytes for a given small class index.
+/// Examples: index 0 → 1, index 4 → 16, index 5 → 24, index 12 → 256.
+[[nodiscard]] constexpr isize node_slot_size_bytes_for_class(node_class_index idx)
+{
+    return impl::node_class_geometries[isize(idx)].slot_size;
+}
+
+/// Compute slab size in bytes for a given small class index.
+/// Power-of-two classes use 64 * class_size, intermediate classes 128 * 2^k (42 slots of 3 * 2^k).
+/// Slab sizes are always powers of two, slabs are aligned to their size.
+/// Examples: index 0 (size 1) → 64 bytes, index 4 (size 16) → 1024 bytes, index 5 (size 24) → 1024 bytes.
 [[nodiscard]] constexpr isize node_slab_size_bytes_for_class(node_class_index idx)
 {
-    return (isize(1) << isize(idx)) * 64;
+    return impl::node_class_geometries[isize(idx)].slab_size;
 }
 
 /// Compute the alignment mask for a slab of the given class index.
@@ -77,6 +168,16 @@ template <class T>
     return reinterpret_cast<cc::byte*>(reinterpret_cast<u64>(ptr) & ~u64(mask)); // NOLINT
 }
 
+/// Compute the freemap of a freshly initialized slab for a given class index.
+/// All existing slots are free (bit set) except those overlapping the 16-byte slab header (freemap + next pointer).
+/// The popcount of this value is the number of usable slots per slab.
+/// Examples: index 0 (size 1) → 48 slots, index 3 (size 8) → 62 slots, index 4 (size 16) → 63 slots,
+///           intermediate classes (24, 48, 96, 192) → 42 slots.
+[[nodiscard]] constexpr u64 node_slab_initial_freemap_for_class(node_class_index idx)
+{
+    return impl::node_class_geometries[isize(idx)].initial_freemap;
+}
+
 /// Retrieve the free bitmap for a slab.
 /// The u64 free bitmap is stored at the slab base; one bit per slot.
 /// Bits corresponding to slots overlapping the bitmap itself remain permanently zero.
@@ -94,19 +195,21 @@ template <class T>
 }
 
 /// Compute the slot index within a slab for a given pointer.
-/// Index = (ptr - slab_base) / class_size where class_size = 2^class_index.
-/// Optimized to (ptr - slab_base) >> class_index for power-of-two division.
+/// Index = (ptr - slab_base - first_slot_offset) / slot_size without a division:
+/// a shift by the power-of-two factor of the slot size and a multiplication by the precomputed reciprocal
+/// of the remaining factor (see impl::node_class_geometry). Folds to a single shift for constant power-of-two classes.
 [[nodiscard]] CC_FORCE_INLINE u64 node_slot_index_for_ptr(cc::byte* ptr, cc::byte* base, node_class_index idx)
 {
-    return u64(ptr - base) >> u64(idx);
+    auto const& g = impl::node_class_geometries[isize(idx)];
+    return ((u64(ptr - base - g.first_slot_offset) >> g.slot_shift) * g.slot_index_mul) >> 9;
 }
 
 /// Compute the slot pointer for a given base address, class index, and slot index.
-/// Inverse of node_slot_index_for_ptr: ptr = base + slot_index * class_size.
-/// Optimized to base + (slot_index << class_index) for power-of-two multiplication.
+/// Inverse of node_slot_index_for_ptr: ptr = base + first_slot_offset + slot_index * slot_size.
 [[nodiscard]] CC_FORCE_INLINE cc::byte* node_slot_ptr_for(cc::byte* base, node_class_index idx, u64 slot_index)
 {
-    return base + (slot_index << u64(idx));
+    auto const& g = impl::node_class_geometries[isize(idx)];
+    return base + g.first_slot_offset + isize(slot_index) * g.slot_size;
 }
 
 /// Cold path for freeing large nodes (> small_max).
@@ -148,6 +251,86 @@ CC_FORCE_INLINE void node_allocation_free(cc::byte* ptr, node_class_index idx)
 extern cc::node_memory_resource* const default_node_memory_resource;
 } // namespace cc
 
+/// Point-in-time statistics of a single node_allocator, obtained via node_allocator::collect_stats().
+/// Slab and slot numbers are computed on demand by walking the slab rings and popcounting their freemaps.
+/// They are exact for the owning thread, but other threads may free concurrently while the snapshot is taken.
+/// Event counters (refills, ring scans, slots reclaimed by scans, large allocations) are only maintained in cold paths,
+/// the allocate_node_bytes fast path and node_allocation_free are never instrumented.
+///
+/// Usage:
+///   auto const stats = cc::default_node_allocator().collect_stats();
+///   log(stats.to_string()); // multi-line table, one row per used size class
+struct cc::node_allocator_stats
+{
+    struct class_stats
+    {
+        // slab state, computed by walking the slab ring:
+        // - number of slabs currently in the slab ring of this class
+        // - usable slots across those slabs (header slots excluded)
+        // - slots currently allocated (capacity minus freemap popcount)
+        isize slab_count = 0;
+        isize slot_capacity = 0;
+        isize live_slots = 0;
+
+        // number of times the resource was asked for a new slab
+        isize refill_count = 0;
+
+        // number of times the current slab ran full and the slab ring was scanned
+        isize ring_scan_count = 0;
+
+        // number of free slots found in previously full slabs during ring scans
+        // these slots were freed (locally or by other threads) after their slab ran full
+        // NOTE: this is not a remote-free count, the free path itself is not instrumented
+        isize scan_reclaimed_count = 0;
+    };
+
+    // per-class statistics, indexed by node_class_index
+    class_stats classes[isize(node_class_index::small_count)] = {};
+
+    // large nodes (> small_max) allocated through this allocator
+    // bytes are the sum of requested sizes, including nodes that were freed already
+    isize large_alloc_count = 0;
+    isize large_alloc_bytes = 0;
+
+    // summaries
+public:
+    [[nodiscard]] isize total_slab_count() const;
+    [[nodiscard]] isize total_slab_bytes() const;
+    [[nodiscard]] isize total_live_slots() const;
+
+    /// Bytes occupied by live slots, i.e. live_slots * class size summed over all classes.
+    [[nodiscard]] isize total_live_bytes() const;
+
+    /// Human-readable multi-line dump intended for logs and dashboards.
+    /// Lists one row per size class that has slabs or events, followed by the large-node summary.
+    [[nodiscard]] cc::string to_string() const;
+};
+
+/// Point-in-time statistics of a node_memory_resource, obtained via cc::collect_stats(resource).
+/// Unlike node_allocator_stats, these are aggregated over all allocators of the resource (e.g. all threads).
+/// Resources that do not implement node_memory_resource::collect_stats report all zeros.
+struct cc::node_memory_resource_stats
+{
+    // slabs handed out by the resource, indexed by node_class_index
+    // slab_bytes is the total over all classes (excluding any backing overhead)
+    isize slab_count[isize(node_class_index::small_count)] = {};
+    isize slab_bytes = 0;
+
+    // backing allocations that slabs are carved from (e.g. superblocks)
+    isize backing_count = 0;
+    isize backing_bytes = 0;
+
+    // large-node path (> small_max)
+    // live bytes are the backing bytes of currently alive large nodes, including their headers
+    isize large_alloc_count = 0;
+    isize large_free_count = 0;
+    isize large_live_count = 0;
+    isize large_live_bytes = 0;
+
+    /// Human-readable multi-line dump intended for logs and dashboards.
+    [[nodiscard]] cc::string to_string() const;
+};
+
 // this is a concrete non-customizable allocator interface for all node classes
 // if a node memory resource segregates by threads, it must be by giving out different allocators (e.g. via TLS)
 // this is designed in a way that the fast path allocation is _extremely_ fast
@@ -174,6 +357,11 @@ public:
     [[nodiscard]] slab_info& slabs() { return _slabs; }
     [[nodiscard]] slab_info const& slabs() const { return _slabs; }
 
+    /// Takes a statistics snapshot of this allocator (see node_allocator_stats).
+    /// Walks all slab rings, so this is O(#slabs) and meant for diagnostics, not hot loops.
+    /// Must be called from the thread owning this allocator.
+    [[nodiscard]] node_allocator_stats collect_stats() const;
+
 public:
     // allocates a new node from the given size class
     // must be freed via node_allocation_free and the same class index!
@@ -225,7 +413,6 @@ private:
     // should do bookkeeping and ensure the slab ring has free capacity
     // and also allocate a node for the given size class (guaranteed to be a small class)
     // also works when the class is not initialized yet
-    // TODO: implement me
     [[nodiscard]] CC_COLD_FUNC cc::byte* refill_slabs_and_allocate_node_bytes(node_class_index idx);
 
 private:
@@ -235,21 +422,105 @@ private:
     // the backup resource for this allocation
     // NOTE: must be non-nullptr for a valid allocator!
     cc::node_memory_resource* _resource = nullptr;
+
+    // event counters, only updated in the cold paths
+    // the slab state fields are not stored but computed in collect_stats
+    node_allocator_stats _stats;
 };
 
+namespace cc::impl
+{
+/// Carves slabs of all size classes out of larger blocks (e.g. 2 MiB superblocks).
+/// Blocks are split into chunks of the largest slab size, and each class carves its slabs from its own chunk.
+/// Because all slab sizes are powers of two not larger than a chunk, every slab stays aligned to its own size
+/// (so node_slab_base_for_ptr keeps working) without any alignment padding between slabs.
+/// Unused tails of chunks and blocks stay with the carver, they are simply used by later refills.
+/// Not thread-safe: node memory resources keep one carver per allocator or per thread.
+struct node_slab_carver
+{
+    // size and alignment of the chunks that slabs are carved from
+    // blocks passed to set_block must be aligned to this and be a multiple of it in size
+    static constexpr isize chunk_size_bytes = node_slab_size_bytes_for_class(node_class_index::small_max);
+
+    /// Returns a new slab for the given class or nullptr if the current block is exhausted.
+    /// In the latter case, provide a new block via set_block and try again.
+    [[nodiscard]] cc::byte* try_carve_slab(node_class_index idx)
+    {
+        auto const i = isize(idx);
+        auto const slab_size = node_slab_size_bytes_for_class(idx);
+
+        if (chunk_end[i] - chunk_cursor[i] < slab_size)
+        {
+            if (block_end - block_cursor < chunk_size_bytes)
+                return nullptr;
+
+            chunk_cursor[i] = block_cursor;
+            chunk_end[i] = block_cursor + chunk_size_bytes;
+            block_cursor += chunk_size_bytes;
+        }
+
+        auto const slab = chunk_cursor[i];
+        chunk_cursor[i] += slab_size;
+        return slab;
+    }
+
+    /// Returns count contiguous chunks from the current block or nullptr if not enough are left.
+    /// Allows resources to bump-allocate other data (e.g. large nodes) from the same blocks.
+    [[nodiscard]] cc::byte* try_carve_chunks(isize count)
+    {
+        CC_ASSERT(count > 0, "must carve at least one chunk");
+        if (block_end - block_cursor < count * chunk_size_bytes)
+            return nullptr;
+
+        auto const chunks = block_cursor;
+        block_cursor += count * chunk_size_bytes;
+        return chunks;
+    }
+
+    /// Sets the block that new chunks are carved from (previous block tails are discarded).
+    /// Chunks that are already assigned to a class keep being used until they are exhausted.
+    void set_block(cc::byte* begin, cc::byte* end)
+    {
+        CC_ASSERT(cc::is_aligned(begin, chunk_size_bytes), "blocks must be aligned to the chunk size");
+        CC_ASSERT((end - begin) % chunk_size_bytes == 0, "block size must be a multiple of the chunk size");
+        block_cursor = begin;
+        block_end = end;
+    }
+
+    /// Forgets all chunks and the current block (e.g. when the backing memory is released).
+    void clear() { *this = {}; }
+
+    // current chunk per class
+    cc::byte* chunk_cursor[isize(node_class_index::small_count)] = {};
+    cc::byte* chunk_end[isize(node_class_index::small_count)] = {};
+
+    // current block, chunks are carved front to back
+    cc::byte* block_cursor = nullptr;
+    cc::byte* block_end = nullptr;
+};
+
+/// Initializes a fresh slab, links it into the slab ring of its class and allocates its first slot.
+/// The slab is inserted directly after slabs.slab_base[idx] (or forms a new ring) and becomes the new head.
+/// This is the common tail of refill_slabs_and_allocate_node_bytes for all slab-carving resources.
+[[nodiscard]] cc::byte* node_link_slab_and_allocate(node_allocator::slab_info& slabs,
+                                                    node_class_index idx,
+                                                    cc::byte* slab);
+} // namespace cc::impl
+
 /// Small-node allocation system optimized for cheap thread-local allocation and wait-free deallocation.
-/// Nodes are grouped by power-of-two size classes: class index i corresponds to size 2^i bytes.
-/// Size class index = bit_width(max(sizeof(T), alignof(T)) - 1), ensuring both size and alignment are satisfied.
+/// Nodes are grouped by size classes 1, 2, 4, 8, 16, 24, 32, 48, 64, 96, 128, 192, 256 (see node_class_index).
+/// The class is the smallest one fitting max(sizeof(T), alignof(T)) whose slots satisfy alignof(T).
 ///
-/// Each slab is a 64 * class_size block; slabs are aligned to their own size.
-/// The slab prefix contains metadata that blocks some initial slots:
+/// Slabs have power-of-two sizes and are aligned to their own size.
+/// The slab prefix contains metadata:
 ///   - First u64 (offset 0): Free bitmap tracking slot availability (one bit per slot)
 ///   - Second u64 (offset 8): Pointer to the next slab in the slab ring (byte*)
 ///
-/// The number of blocked slots depends on class size:
+/// Power-of-two classes use 64 * class_size slabs, the prefix blocks some initial slots:
 ///   - 1B nodes (e.g., char): 16 bytes prefix blocks 16 slots → 48 usable slots per slab
 ///   - 8B nodes (e.g., i64, ptr): 16 bytes prefix blocks 2 slots → 62 usable slots per slab
 ///   - 16B+ nodes: 16 bytes prefix blocks 1 slot → 63 usable slots per slab
+/// Intermediate classes (3 * 2^k) use 128 * 2^k slabs with 42 slots behind the prefix (see impl::node_class_geometry).
 ///
 /// Allocation is thread-owned and may update allocator state for bookkeeping and slab lifecycle management.
 /// Deallocation requires only the pointer and class index; no allocator state or resource reference needed.
@@ -257,11 +528,19 @@ private:
 /// The allocating thread discovers remotely freed slots during cold allocation paths (slab reuse, new slab allocation).
 ///
 /// Slab base recovery from any interior pointer: ptr & ~(slab_size - 1), exploiting alignment.
+/// The default resource carves slabs out of 2 MiB superblocks (see impl::node_slab_carver),
+/// so refills almost never call into the backing allocator and related nodes share pages.
+///
+/// Each class keeps its slabs in a cyclic slab ring. When the current slab runs full, the allocator scans
+/// a bounded number of ring slabs for slots freed in the meantime before requesting a new slab.
+/// New slabs are linked in after the last scanned slab, so consecutive scans visit the ring round-robin.
 ///
 /// Target use case: node-based containers (list, map, set) and small heap objects (unique_ptr payloads, unique_function).
 /// Out of scope: large allocations, contiguous buffers, bulk operations; use cc::allocation<T> or cc::memory_resource.
 ///
-/// Future: could support shared_ptr-like semantics as well by co-locating refcounts
+/// Shared ownership with co-located refcounts is provided by cc::shared_node_allocation
+/// (see shared_node_allocation.hh).
+/// Linked sequences (node_list, node_stack, node_queue) are provided in node_list.hh, node_stack.hh and node_queue.hh.
 struct cc::node_memory_resource
 {
     // returns a node allocator that is usable on this thread
@@ -282,6 +561,9 @@ struct cc::node_memory_resource
     // refills slabs for the given size class and allocates a node from the new slab
     // called by node_allocator::refill_slabs_and_allocate_node_bytes
     // takes a reference to the allocator's slab_info and the class index
+    // the new slab must be linked into the ring directly after slab_base[idx] (if any) and become the new head
+    // (the allocator positions slab_base[idx] so that the next ring scan continues with unscanned slabs)
+    // impl::node_link_slab_and_allocate implements this for freshly carved slabs
     cc::function_ptr<cc::byte*(node_allocator::slab_info&, node_class_index, void*)> refill_slabs_and_allocate_node_bytes
         = nullptr;
 
@@ -289,6 +571,11 @@ struct cc::node_memory_resource
     // called by node_allocation_free_large
     cc::function_ptr<void(cc::byte*, node_class_index, void*)> deallocate_node_bytes_large = nullptr;
 
+    // OPTIONAL: fills a statistics snapshot aggregated over all allocators of this resource
+    // called by cc::collect_stats(resource), may be nullptr for resources that do not track statistics
+    // implementations should only count in their cold paths (refill, large allocations)
+    cc::function_ptr<void(node_memory_resource_stats&, void*)> collect_stats = nullptr;
+
     /// User-defined data for custom allocators. Can be nullptr for stateless allocators.
     void* userdata = nullptr;
 };
@@ -300,6 +587,11 @@ namespace cc
 /// The returned allocator is thread-local and must not be used across threads.
 /// For most use cases, this is the recommended way to obtain a node allocator (or take an explicit node_allocator&).
 node_allocator& default_node_allocator();
+
+/// Returns a statistics snapshot of the given node memory resource.
+/// Resources without a collect_stats function report all zeros.
+/// Per-thread details (live slots, ring scans) are only available via node_allocator::collect_stats.
+[[nodiscard]] node_memory_resource_stats collect_stats(node_memory_resource const& resource);
 } // namespace cc
 
 /// Move-only owning handle for a single live T stored in node memory.
@@ -0,0 +1,229 @@
+#include "node_arena.hh"
+
+#include <clean-core/allocation.hh>
+
+namespace
+{
+// every block ends with a footer that links it to the previously allocated block
+// footers live behind the usable block range, so the block start stays chunk-aligned for slab carving
+struct block_footer
+{
+    cc::byte* prev_footer = nullptr;
+    cc::byte* begin = nullptr;
+    cc::isize total_size = 0;
+};
+
+// large node header directly before the user pointer: [size (8B)][resource* (8B)]
+constexpr cc::isize large_header_size = 16;
+
+// large nodes that would take more than this fraction of a block get a dedicated block
+constexpr cc::isize large_dedicated_block_divisor = 4;
+} // namespace
+
+cc::node_arena::node_arena(memory_resource const* backing, isize block_size_bytes)
+  : _resource{
+        .get_allocator = resource_get_allocator,
+        .allocate_node_bytes_large = resource_allocate_node_bytes_large,
+        .refill_slabs_and_allocate_node_bytes = resource_refill_slabs_and_allocate_node_bytes,
+        .deallocate_node_bytes_large = resource_deallocate_node_bytes_large,
+        .collect_stats = resource_collect_stats,
+        .userdata = this,
+    },
+    _allocator(&_resource),
+    _backing(backing != nullptr ? backing : cc::default_memory_resource)
+{
+    CC_ASSERT(block_size_bytes > 0, "block size must be positive");
+    _block_size_bytes = cc::int_round_up_to_multiple(block_size_bytes, impl::node_slab_carver::chunk_size_bytes);
+}
+
+cc::node_arena::~node_arena() { reset(); }
+
+void cc::node_arena::reset()
+{
+    // destroy arena-owned objects in reverse creation order
+    // this comes first, as these objects may own regular nodes of this arena (e.g. a node_list)
+    // the records themselves are nodes of this arena and are released with the blocks
+    for (auto record = _last_dtor; record != nullptr; record = record->prev)
+        record->dtor(record->ptr);
+    _last_dtor = nullptr;
+
+    // arena-owned objects keep their slots until the blocks are released, everything else must be freed by now
+    CC_ASSERT(count_live_slots() == _owned_slot_count, "node_allocations from this arena are still alive during "
+                                                       "reset. they must be freed before (or created via emplace)");
+    CC_ASSERT(_large_alloc_count - cc::atomic_load(_large_free_count) == _owned_large_count,
+              "large node_allocations from this arena are still alive during reset");
+
+    // release all blocks, O(#blocks)
+    auto footer_ptr = _last_block_footer;
+    while (footer_ptr != nullptr)
+    {
+        auto const footer = *reinterpret_cast<block_footer*>(footer_ptr); // NOLINT
+        _backing->deallocate_bytes(footer.begin, footer.total_size, impl::node_slab_carver::chunk_size_bytes,
+                                   _backing->userdata);
+        footer_ptr = footer.prev_footer;
+    }
+
+    // the allocator keeps pointing to this arena, but forgets all slabs (and its statistics)
+    _allocator = node_allocator(&_resource);
+    _carver.clear();
+
+    _last_block_footer = nullptr;
+    _block_count = 0;
+    _allocated_bytes = 0;
+
+    for (auto& c : _slab_count)
+        c = 0;
+
+    _large_cursor = nullptr;
+    _large_end = nullptr;
+    _large_alloc_count = 0;
+    _large_free_count = 0;
+    _large_live_bytes = 0;
+
+    _owned_slot_count = 0;
+    _owned_large_count = 0;
+}
+
+void cc::node_arena::register_dtor(void* ptr, cc::function_ptr<void(void*)> dtor)
+{
+    using record_t = impl::node_arena_dtor_record;
+    auto const record_ptr = _allocator.allocate_node_bytes(cc::node_class_index_for<record_t>(), sizeof(record_t),
+                                                           alignof(record_t));
+    auto const record = new (cc::placement_new, record_ptr) record_t{dtor, ptr, _last_dtor};
+    _last_dtor = record;
+    _owned_slot_count += 1;
+}
+
+cc::isize cc::node_arena::count_live_slots() const { return _allocator.collect_stats().total_live_slots(); }
+
+cc::byte* cc::node_arena::allocate_block(isize size_bytes)
+{
+    CC_ASSERT(size_bytes % impl::node_slab_carver::chunk_size_bytes == 0, "blocks must consist of whole chunks");
+
+    auto const total_size = size_bytes + isize(sizeof(block_footer));
+    cc::byte* block = nullptr;
+    _backing->allocate_bytes(&block, total_size, total_size, impl::node_slab_carver::chunk_size_bytes,
+                             _backing->userdata);
+    CC_ASSERT(block != nullptr, "backing resource must return non-null for block allocation");
+
+    auto const footer_ptr = block + size_bytes;
+    new (cc::placement_new, footer_ptr) block_footer{_last_block_footer, block, total_size};
+    _last_block_footer = footer_ptr;
+
+    _block_count += 1;
+    _allocated_bytes += total_size;
+    return block;
+}
+
+cc::node_allocator& cc::node_arena::resource_get_allocator(void* userdata)
+{
+    return static_cast<node_arena*>(userdata)->_allocator;
+}
+
+cc::byte* cc::node_arena::resource_allocate_node_bytes_large(node_class_index idx,
+                                                             isize size_bytes,
+                                                             isize alignment,
+                                                             void* userdata)
+{
+    CC_UNUSED(idx);
+    auto& arena = *static_cast<node_arena*>(userdata);
+    constexpr auto chunk_size = impl::node_slab_carver::chunk_size_bytes;
+
+    // header requires 8-byte alignment
+    alignment = cc::max(alignment, isize(8));
+
+    // worst case size including header and alignment padding
+    auto const required_bytes = size_bytes + large_header_size + alignment;
+
+    cc::byte* ptr = nullptr;
+    if (required_bytes > arena._block_size_bytes / large_dedicated_block_divisor)
+    {
+        // dedicated block, does not affect the current bump region
+        auto const block = arena.allocate_block(cc::align_up(required_bytes, chunk_size));
+        ptr = cc::align_up(block + large_header_size, alignment);
+    }
+    else
+    {
+        if (arena._large_cursor != nullptr)
+            ptr = cc::align_up(arena._large_cursor + large_header_size, alignment);
+
+        if (ptr == nullptr || ptr + size_bytes > arena._large_end)
+        {
+            // start a new bump region from the chunks of the current (or a new) block
+            auto const chunk_count = cc::int_div_round_up(required_bytes, chunk_size);
+            auto region = arena._carver.try_carve_chunks(chunk_count);
+            if (region == nullptr)
+            {
+                auto const block = arena.allocate_block(arena._block_size_bytes);
+                arena._carver.set_block(block, block + arena._block_size_bytes);
+                region = arena._carver.try_carve_chunks(chunk_count);
+                CC_ASSERT(region != nullptr, "a fresh block must fit the large node region");
+            }
+
+            arena._large_end = region + chunk_count * chunk_size;
+            ptr = cc::align_up(region + large_header_size, alignment);
+        }
+
+        arena._large_cursor = ptr + size_bytes;
+    }
+
+    // write header: size, resource pointer (required at ptr - 8 by node_allocation_free_large)
+    *reinterpret_cast<isize*>(ptr - 16) = size_bytes;                          // NOLINT
+    *reinterpret_cast<cc::node_memory_resource**>(ptr - 8) = &arena._resource; // NOLINT
+
+    // live bytes are also updated by (possibly remote) frees
+    arena._large_alloc_count += 1;
+    cc::atomic_add(arena._large_live_bytes, size_bytes + large_header_size);
+    return ptr;
+}
+
+cc::byte* cc::node_arena::resource_refill_slabs_and_allocate_node_bytes(node_allocator::slab_info& slabs,
+                                                                       node_class_index idx,
+                                                                       void* userdata)
+{
+    auto& arena = *static_cast<node_arena*>(userdata);
+
+    auto slab = arena._carver.try_carve_slab(idx);
+    if (slab == nullptr)
+    {
+        auto const block = arena.allocate_block(arena._block_size_bytes);
+        arena._carver.set_block(block, block + arena._block_size_bytes);
+        slab = arena._carver.try_carve_slab(idx);
+        CC_ASSERT(slab != nullptr, "a fresh block must fit any slab");
+    }
+
+    arena._slab_count[isize(idx)] += 1;
+    return cc::impl::node_link_slab_and_allocate(slabs, idx, slab);
+}
+
+void cc::node_arena::resource_deallocate_node_bytes_large(cc::byte* ptr, node_class_index idx, void* userdata)
+{
+    CC_UNUSED(idx);
+    auto& arena = *static_cast<node_arena*>(userdata);
+
+    // bump memory is only released on reset, we just keep the statistics up to date
+    // this might be called from other threads, so the counters are updated atomically
+    auto const size_bytes = *reinterpret_cast<isize*>(ptr - 16); // NOLINT
+    cc::atomic_add(arena._large_free_count, isize(1));
+    cc::atomic_sub(arena._large_live_bytes, size_bytes + large_header_size);
+}
+
+void cc::node_arena::resource_collect_stats(node_memory_resource_stats& stats, void* userdata)
+{
+    auto const& arena = *static_cast<node_arena const*>(userdata);
+
+    for (isize i = 0; i < isize(node_class_index::small_count); ++i)
+    {
+        stats.slab_count[i] = arena._slab_count[i];
+        stats.slab_bytes += arena._slab_count[i] * cc::node_slab_size_bytes_for_class(node_class_index(i));
+    }
+
+    stats.backing_count = arena._block_count;
+    stats.backing_bytes = arena._allocated_bytes;
+
+    // frees might run concurrently on other threads
+    stats.large_alloc_count = arena._large_alloc_count;
+    stats.large_free_count = cc::atomic_load(arena._large_free_count, std::memory_order_relaxed);
+    stats.large_live_count = stats.large_alloc_count - stats.large_free_count;
+    stats.large_live_bytes = cc::atomic_load(arena._large_live_bytes, std::memory_order_relaxed);
+}
@@ -0,0 +1,163 @@
+#pragma once
+
+#include <clean-core/fwd.hh>
+#include <clean-core/node_allocation.hh>
+#include <clean-core/utility.hh>
+
+namespace cc::impl
+{
+// record for arena-owned objects with non-trivial destructors
+// these records are themselves nodes allocated from the arena
+struct node_arena_dtor_record
+{
+    cc::function_ptr<void(void*)> dtor = nullptr;
+    void* ptr = nullptr;
+    node_arena_dtor_record* prev = nullptr;
+};
+} // namespace cc::impl
+
+/// A node_memory_resource that hands out slabs and large nodes from a bump arena and releases them all at once.
+/// Designed for request-scoped work (parsing, planning, ...) where many nodes die together:
+/// instead of O(#nodes) atomic frees, teardown is O(#blocks) via reset() or the destructor.
+///
+/// Memory is requested from a backing cc::memory_resource in blocks (256 KiB by default).
+/// Slabs are carved from these blocks like in the default resource (see impl::node_slab_carver),
+/// so node_allocation_free and all slab invariants keep working unchanged.
+/// Large nodes (> small_max) are bump-allocated from the same blocks; freeing them only updates statistics.
+///
+/// There are two ways to allocate from the arena:
+///   - regular node_allocation<T> (and containers on top of it) using allocator():
+///     these must be freed before reset(), which asserts that no such node is alive anymore
+///   - emplace<T>(args...) creates arena-owned objects without a handle:
+///     reset() runs their destructors (in reverse creation order) before releasing the memory
+///
+/// The arena owns a single node_allocator that is returned for all threads.
+/// Like most cc types, the arena is NOT thread-safe: all allocations must be externally synchronized.
+/// Freeing from any thread is still fine (it is the usual wait-free freemap update).
+///
+/// The arena is pinned in memory (non-copyable, non-movable) as its allocator and resource refer to it.
+///
+/// Usage:
+///   cc::node_arena arena;
+///
+///   auto n = cc::node_allocation<Foo>::create_from(arena.allocator(), 1, 2);
+///   auto& bar = arena.emplace<Bar>("owned by the arena");
+///   n.reset();
+///
+///   arena.reset(); // destroys bar, drops all slabs at once
+struct cc::node_arena
+{
+    static constexpr isize default_block_size_bytes = isize(256) << 10;
+
+    // allocation
+public:
+    /// The allocator handing out nodes from this arena.
+    /// Same as resource().get_allocator(...) and valid for the lifetime of the arena (also across resets).
+    [[nodiscard]] node_allocator& allocator() { return _allocator; }
+
+    /// The node_memory_resource of this arena, e.g. for code that takes a node_memory_resource*.
+    [[nodiscard]] node_memory_resource* resource() { return &_resource; }
+
+    /// Creates an arena-owned T and returns a reference to it.
+    /// The object lives until the next reset() (or the destruction of the arena).
+    /// Non-trivial destructors are recorded and run by reset() in reverse creation order.
+    template <class T, class... Args>
+    T& emplace(Args&&... args)
+    {
+        static_assert(std::is_object_v<T> && !std::is_const_v<T>, "arena objects must be non-const objects");
+        static_assert(requires { T(cc::forward<Args>(args)...); }, "T is not constructible from the provided "
+                                                                   "argument types");
+
+        auto const ptr = _allocator.allocate_node_bytes(cc::node_class_index_for<T>(), sizeof(T), alignof(T));
+        auto const obj = new (cc::placement_new, ptr) T(cc::forward<Args>(args)...);
+
+        if constexpr (cc::node_class_index_for<T>() > node_class_index::small_max)
+            _owned_large_count += 1;
+        else
+            _owned_slot_count += 1;
+
+        if constexpr (!std::is_trivially_destructible_v<T>)
+            register_dtor(obj, [](void* p) { static_cast<T*>(p)->~T(); });
+
+        return *obj;
+    }
+
+    /// Releases all memory of the arena at once.
+    /// First runs the destructors of all objects created via emplace (in reverse creation order),
+    /// then asserts that no other node from this arena is alive,
+    /// and finally returns all blocks to the backing resource.
+    /// The arena stays usable afterwards.
+    void reset();
+
+    // queries
+public:
+    /// Number of blocks currently requested from the backing resource.
+    [[nodiscard]] isize block_count() const { return _block_count; }
+
+    /// Total bytes currently requested from the backing resource.
+    [[nodiscard]] isize allocated_bytes() const { return _allocated_bytes; }
+
+    // ctors
+public:
+    /// Creates an arena backed by cc::default_memory_resource with the default block size.
+    node_arena() : node_arena(nullptr, default_block_size_bytes) {}
+
+    /// Creates an arena backed by the given memory resource (nullptr means default_memory_resource).
+    /// block_size_bytes is rounded up to a multiple of the slab chunk size (16 KiB).
+    /// Large nodes that do not fit comfortably into a block get a dedicated backing allocation.
+    explicit node_arena(memory_resource const* backing, isize block_size_bytes = default_block_size_bytes);
+
+    ~node_arena();
+
+    node_arena(node_arena const&) = delete;
+    node_arena(node_arena&&) = delete;
+    node_arena& operator=(node_arena const&) = delete;
+    node_arena& operator=(node_arena&&) = delete;
+
+private:
+    void register_dtor(void* ptr, cc::function_ptr<void(void*)> dtor);
+
+    [[nodiscard]] isize count_live_slots() const;
+
+    // block management, blocks form a singly-linked list via their footers
+    [[nodiscard]] cc::byte* allocate_block(isize size_bytes);
+
+    // resource functions, userdata is the arena
+    static node_allocator& resource_get_allocator(void* userdata);
+    static cc::byte* resource_allocate_node_bytes_large(node_class_index idx,
+                                                        isize size_bytes,
+                                                        isize alignment,
+                                                        void* userdata);
+    static cc::byte* resource_refill_slabs_and_allocate_node_bytes(node_allocator::slab_info& slabs,
+                                                                   node_class_index idx,
+                                                                   void* userdata);
+    static void resource_deallocate_node_bytes_large(cc::byte* ptr, node_class_index idx, void* userdata);
+    static void resource_collect_stats(node_memory_resource_stats& stats, void* userdata);
+
+private:
+    node_memory_resource _resource;
+    node_allocator _allocator;
+
+    // backing
+    memory_resource const* _backing = nullptr;
+    isize _block_size_bytes = 0;
+    cc::byte* _last_block_footer = nullptr;
+    isize _block_count = 0;
+    isize _allocated_bytes = 0;
+
+    // slab carving from the current block
+    impl::node_slab_carver _carver;
+    isize _slab_count[isize(node_class_index::small_count)] = {};
+
+    // bump region for large nodes
+    cc::byte* _large_cursor = nullptr;
+    cc::byte* _large_end = nullptr;
+    isize _large_alloc_count = 0;
+    isize _large_free_count = 0;
+    isize _large_live_bytes = 0;
+
+    // arena-owned objects (created via emplace)
+    impl::node_arena_dtor_record* _last_dtor = nullptr;
+    isize _owned_slot_count = 0;
+    isize _owned_large_count = 0;
+};
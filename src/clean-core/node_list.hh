@@ -0,0 +1,536 @@
+#pragma once
+
+#include <clean-core/fwd.hh>
+#include <clean-core/node_allocation.hh>
+#include <clean-core/utility.hh>
+
+#include <initializer_list>
+
+namespace cc::impl
+{
+/// Node shared by all node-based sequence containers (node_list, node_stack, node_queue).
+/// Singly-linked containers only use next, so a node (and its handle) can move between all of them.
+/// The links are first so that traversal touches the start of each slot.
+template <class T>
+struct list_node
+{
+    list_node* next = nullptr;
+    list_node* prev = nullptr;
+    T value;
+
+    template <class... Args>
+    explicit list_node(Args&&... args) : value(cc::forward<Args>(args)...)
+    {
+    }
+};
+
+template <class T>
+[[nodiscard]] CC_FORCE_INLINE list_node<T>* list_node_allocate(node_allocator& alloc, auto&&... args)
+{
+    using node_t = list_node<T>;
+    auto const ptr = alloc.allocate_node_bytes(cc::node_class_index_for<node_t>(), sizeof(node_t), alignof(node_t));
+    return new (cc::placement_new, ptr) node_t(cc::forward<decltype(args)>(args)...);
+}
+
+template <class T>
+CC_FORCE_INLINE void list_node_destroy(list_node<T>* node)
+{
+    node->~list_node<T>();
+    cc::node_allocation_free(reinterpret_cast<cc::byte*>(node), cc::node_class_index_for<list_node<T>>()); // NOLINT
+}
+
+/// Returns the allocator for a container resource (nullptr means the default node memory resource).
+[[nodiscard]] inline node_allocator& list_allocator_for(node_memory_resource* resource)
+{
+    return resource == nullptr ? cc::default_node_allocator() : resource->get_allocator(resource->userdata);
+}
+
+/// Forward/bidirectional iterator over list nodes.
+/// end() is nullptr, so decrementing end() is not supported.
+template <class T, bool IsConst>
+struct list_iterator
+{
+    using node_t = list_node<T>;
+    using value_t = std::conditional_t<IsConst, T const, T>;
+
+    [[nodiscard]] value_t& operator*() const
+    {
+        CC_ASSERT(node != nullptr, "dereferencing end iterator");
+        return node->value;
+    }
+    [[nodiscard]] value_t* operator->() const
+    {
+        CC_ASSERT(node != nullptr, "dereferencing end iterator");
+        return &node->value;
+    }
+
+    list_iterator& operator++()
+    {
+        CC_ASSERT(node != nullptr, "incrementing end iterator");
+        node = node->next;
+        return *this;
+    }
+    list_iterator& operator--()
+    {
+        CC_ASSERT(node != nullptr, "decrementing end iterator is not supported");
+        node = node->prev;
+        return *this;
+    }
+
+    [[nodiscard]] bool operator==(list_iterator const& rhs) const { return node == rhs.node; }
+
+    // const iterators can be created from mutable ones
+    operator list_iterator<T, true>() const
+        requires(!IsConst)
+    {
+        return {node};
+    }
+
+    node_t* node = nullptr;
+};
+} // namespace cc::impl
+
+/// Move-only owning handle for a single node that is currently not part of any container.
+/// Obtained by extracting a node from node_list, node_stack or node_queue (or via create_from),
+/// and inserted into any of them again without reallocating.
+/// Like node_allocation, destruction calls ~T() and returns the slot via a wait-free freemap update.
+///
+/// Usage:
+///   auto h = lru.extract(it);           // unlink, no deallocation
+///   h->touch_count++;
+///   recent.push_front(cc::move(h));     // relink, no allocation
+template <class T>
+struct cc::list_node_handle
+{
+    using node_t = impl::list_node<T>;
+
+    // properties
+public:
+    [[nodiscard]] bool is_valid() const { return _node != nullptr; }
+    explicit operator bool() const { return _node != nullptr; }
+
+    // smart pointer interface
+public:
+    [[nodiscard]] T& operator*() const
+    {
+        CC_ASSERT(_node != nullptr, "dereferencing null list_node_handle");
+        return _node->value;
+    }
+    [[nodiscard]] T* operator->() const
+    {
+        CC_ASSERT(_node != nullptr, "dereferencing null list_node_handle");
+        return &_node->value;
+    }
+
+    // factory
+public:
+    /// Allocates a detached node, e.g. to prepare nodes outside of a container (or outside a lock).
+    template <class... Args>
+    [[nodiscard]] static list_node_handle create_from(node_allocator& alloc, Args&&... args)
+    {
+        static_assert(requires { T(cc::forward<Args>(args)...); }, "T is not constructible from the provided args");
+
+        return list_node_handle(impl::list_node_allocate<T>(alloc, cc::forward<Args>(args)...));
+    }
+
+    // ctors/dtor
+public:
+    list_node_handle() = default;
+
+    list_node_handle(list_node_handle&& rhs) noexcept : _node(cc::exchange(rhs._node, nullptr)) {}
+    list_node_handle& operator=(list_node_handle&& rhs) noexcept
+    {
+        // take ownership from rhs while it's definitely still alive
+        node_t* new_node = cc::exchange(rhs._node, nullptr);
+
+        // now release current ownership
+        reset();
+
+        // and adopt the stolen pointer
+        _node = new_node;
+        return *this;
+    }
+    list_node_handle(list_node_handle const&) = delete;
+    list_node_handle& operator=(list_node_handle const&) = delete;
+
+    ~list_node_handle()
+    {
+        if (_node != nullptr)
+            impl::list_node_destroy(_node);
+    }
+
+    /// Destroys the node (if any) and resets to empty state.
+    void reset()
+    {
+        if (_node != nullptr)
+            impl::list_node_destroy(cc::exchange(_node, nullptr));
+    }
+
+    // container interop
+public:
+    explicit list_node_handle(node_t* node) : _node(node) {}
+
+    /// Releases ownership of the node, the caller is responsible for linking or destroying it.
+    [[nodiscard]] node_t* release_node() { return cc::exchange(_node, nullptr); }
+
+private:
+    node_t* _node = nullptr;
+};
+
+/// Doubly-linked list of T stored in node memory (see node_allocation.hh).
+/// Each element lives in its own node slot together with its links, so slab locality keeps traversal cache-friendly.
+///
+/// Guarantees:
+///   - pointers, references and iterators stay valid until their element is removed (no reallocation ever)
+///   - all insertions and removals at known positions are O(1), size() is O(1)
+///   - splicing whole lists or single nodes between lists is O(1) and never reallocates
+///   - nodes can be extracted as list_node_handle<T> and inserted into any node_list/node_stack/node_queue
+///
+/// Nodes are allocated through the allocator of the list's node_memory_resource (nullptr means default).
+/// Nodes can be freed from any thread, but like all cc containers, a list is not thread-safe.
+/// Splicing moves nodes between lists independently of their resources (freeing never needs the resource).
+///
+/// Typical use: LRU lists (move_to_front on access, pop_back on eviction), intrusive-style free lists.
+template <class T>
+struct cc::node_list
+{
+    static_assert(std::is_object_v<T> && !std::is_const_v<T>, "node_list elements must be non-const objects");
+
+    using node_t = impl::list_node<T>;
+    using iterator = impl::list_iterator<T, false>;
+    using const_iterator = impl::list_iterator<T, true>;
+    using handle_t = list_node_handle<T>;
+
+    // element access
+public:
+    [[nodiscard]] T& front()
+    {
+        CC_ASSERT(_head != nullptr, "front() on empty node_list");
+        return _head->value;
+    }
+    [[nodiscard]] T const& front() const
+    {
+        CC_ASSERT(_head != nullptr, "front() on empty node_list");
+        return _head->value;
+    }
+    [[nodiscard]] T& back()
+    {
+        CC_ASSERT(_tail != nullptr, "back() on empty node_list");
+        return _tail->value;
+    }
+    [[nodiscard]] T const& back() const
+    {
+        CC_ASSERT(_tail != nullptr, "back() on empty node_list");
+        return _tail->value;
+    }
+
+    // iterators
+public:
+    [[nodiscard]] iterator begin() { return {_head}; }
+    [[nodiscard]] iterator end() { return {}; }
+    [[nodiscard]] const_iterator begin() const { return {_head}; }
+    [[nodiscard]] const_iterator end() const { return {}; }
+
+    /// Iterator to the last element (or end() if empty), e.g. for reverse traversal via operator--.
+    [[nodiscard]] iterator last() { return {_tail}; }
+    [[nodiscard]] const_iterator last() const { return {_tail}; }
+
+    // queries
+public:
+    [[nodiscard]] isize size() const { return _size; }
+    [[nodiscard]] bool empty() const { return _size == 0; }
+
+    // adding elements
+public:
+    template <class... Args>
+    T& emplace_front(Args&&... args)
+    {
+        auto const node = impl::list_node_allocate<T>(allocator(), cc::forward<Args>(args)...);
+        link_before(_head, node);
+        return node->value;
+    }
+    template <class... Args>
+    T& emplace_back(Args&&... args)
+    {
+        auto const node = impl::list_node_allocate<T>(allocator(), cc::forward<Args>(args)...);
+        link_before(nullptr, node);
+        return node->value;
+    }
+    /// Constructs a new element before pos (pos == end() appends) and returns an iterator to it.
+    template <class... Args>
+    iterator emplace_before(const_iterator pos, Args&&... args)
+    {
+        auto const node = impl::list_node_allocate<T>(allocator(), cc::forward<Args>(args)...);
+        link_before(pos.node, node);
+        return {node};
+    }
+
+    T& push_front(T const& value) { return emplace_front(value); }
+    T& push_front(T&& value) { return emplace_front(cc::move(value)); }
+    T& push_back(T const& value) { return emplace_back(value); }
+    T& push_back(T&& value) { return emplace_back(cc::move(value)); }
+    iterator insert_before(const_iterator pos, T const& value) { return emplace_before(pos, value); }
+    iterator insert_before(const_iterator pos, T&& value) { return emplace_before(pos, cc::move(value)); }
+
+    /// Links a detached node without allocating. The handle is empty afterwards.
+    T& push_front(handle_t&& handle) { return insert_before(begin(), cc::move(handle)).node->value; }
+    T& push_back(handle_t&& handle) { return insert_before(end(), cc::move(handle)).node->value; }
+    iterator insert_before(const_iterator pos, handle_t&& handle)
+    {
+        CC_ASSERT(handle.is_valid(), "cannot insert an empty list_node_handle");
+        auto const node = handle.release_node();
+        link_before(pos.node, node);
+        return {node};
+    }
+
+    // removing elements
+public:
+    [[nodiscard("use remove_front() if you don't need the return value")]] T pop_front()
+    {
+        CC_ASSERT(_head != nullptr, "pop_front() on empty node_list");
+        auto const node = _head;
+        unlink(node);
+        T value = cc::move(node->value);
+        impl::list_node_destroy(node);
+        return value;
+    }
+    [[nodiscard("use remove_back() if you don't need the return value")]] T pop_back()
+    {
+        CC_ASSERT(_tail != nullptr, "pop_back() on empty node_list");
+        auto const node = _tail;
+        unlink(node);
+        T value = cc::move(node->value);
+        impl::list_node_destroy(node);
+        return value;
+    }
+
+    void remove_front()
+    {
+        CC_ASSERT(_head != nullptr, "remove_front() on empty node_list");
+        remove_at(begin());
+    }
+    void remove_back()
+    {
+        CC_ASSERT(_tail != nullptr, "remove_back() on empty node_list");
+        remove_at(last());
+    }
+
+    /// Removes the element at pos and returns an iterator to the following element.
+    iterator remove_at(const_iterator pos)
+    {
+        CC_ASSERT(pos.node != nullptr, "cannot remove end()");
+        auto const next = pos.node->next;
+        unlink(pos.node);
+        impl::list_node_destroy(pos.node);
+        return {next};
+    }
+
+    /// Removes all elements matching the predicate, returns the number of removed elements.
+    /// The predicate is called with (T const&) or (isize, T const&), where the index is the position before removal.
+    template <class Pred>
+    isize remove_all_where(Pred&& pred)
+    {
+        static_assert(cc::is_invocable_r<bool, Pred, T const&> || cc::is_invocable_r<bool, Pred, isize, T const&>,
+                      "remove_all_where: predicate must take T const& or (isize, T const&) and return bool");
+
+        isize removed = 0;
+        isize idx = 0;
+        auto node = _head;
+        while (node != nullptr)
+        {
+            auto const next = node->next;
+            if (cc::invoke_with_optional_idx(idx, pred, static_cast<T const&>(node->value)))
+            {
+                unlink(node);
+                impl::list_node_destroy(node);
+                ++removed;
+            }
+            node = next;
+            ++idx;
+        }
+        return removed;
+    }
+
+    /// Destroys all elements. O(size).
+    void clear()
+    {
+        auto node = _head;
+        while (node != nullptr)
+            impl::list_node_destroy(cc::exchange(node, node->next));
+
+        _head = nullptr;
+        _tail = nullptr;
+        _size = 0;
+    }
+
+    // node handles
+public:
+    /// Unlinks the element at pos without deallocating it.
+    [[nodiscard]] handle_t extract(const_iterator pos)
+    {
+        CC_ASSERT(pos.node != nullptr, "cannot extract end()");
+        unlink(pos.node);
+        return handle_t(pos.node);
+    }
+    [[nodiscard]] handle_t extract_front()
+    {
+        CC_ASSERT(_head != nullptr, "extract_front() on empty node_list");
+        return extract(begin());
+    }
+    [[nodiscard]] handle_t extract_back()
+    {
+        CC_ASSERT(_tail != nullptr, "extract_back() on empty node_list");
+        return extract(last());
+    }
+
+    // splicing
+public:
+    /// Moves the element at pos (of this list) to the front, e.g. on access in an LRU list. O(1).
+    void move_to_front(const_iterator pos)
+    {
+        CC_ASSERT(pos.node != nullptr, "cannot move end()");
+        if (pos.node == _head)
+            return;
+        unlink(pos.node);
+        link_before(_head, pos.node);
+    }
+    /// Moves the element at pos (of this list) to the back. O(1).
+    void move_to_back(const_iterator pos)
+    {
+        CC_ASSERT(pos.node != nullptr, "cannot move end()");
+        if (pos.node == _tail)
+            return;
+        unlink(pos.node);
+        link_before(nullptr, pos.node);
+    }
+
+    /// Moves the element at other_pos from other (may be this list) before pos. O(1), no reallocation.
+    void splice_before(const_iterator pos, node_list& other, const_iterator other_pos)
+    {
+        CC_ASSERT(other_pos.node != nullptr, "cannot splice end()");
+        if (pos.node == other_pos.node)
+            return;
+        other.unlink(other_pos.node);
+        link_before(pos.node, other_pos.node);
+    }
+
+    /// Moves all elements of other before pos, leaving other empty. O(1), no reallocation.
+    void splice_before(const_iterator pos, node_list& other)
+    {
+        CC_ASSERT(&other != this, "cannot splice a list into itself");
+        if (other.empty())
+            return;
+
+        auto const first = other._head;
+        auto const last = other._tail;
+        auto const count = other._size;
+        other._head = nullptr;
+        other._tail = nullptr;
+        other._size = 0;
+
+        auto const next = pos.node;
+        auto const prev = next != nullptr ? next->prev : _tail;
+        first->prev = prev;
+        last->next = next;
+        (prev != nullptr ? prev->next : _head) = first;
+        (next != nullptr ? next->prev : _tail) = last;
+        _size += count;
+    }
+    void splice_front(node_list& other) { splice_before(begin(), other); }
+    void splice_back(node_list& other) { splice_before(end(), other); }
+
+    // factories
+public:
+    /// Creates an empty list allocating nodes from the given resource (nullptr means default).
+    [[nodiscard]] static node_list create_with_resource(node_memory_resource* resource)
+    {
+        node_list l;
+        l._resource = resource;
+        return l;
+    }
+
+    // ctors/dtor
+public:
+    node_list() = default;
+    node_list(std::initializer_list<T> init)
+    {
+        for (auto const& v : init)
+            emplace_back(v);
+    }
+
+    node_list(node_list&& rhs) noexcept
+      : _head(cc::exchange(rhs._head, nullptr)),
+        _tail(cc::exchange(rhs._tail, nullptr)),
+        _size(cc::exchange(rhs._size, 0)),
+        _resource(rhs._resource)
+    {
+    }
+    node_list& operator=(node_list&& rhs) noexcept
+    {
+        // take ownership from rhs first, rhs might be owned by one of our elements
+        auto const new_head = cc::exchange(rhs._head, nullptr);
+        auto const new_tail = cc::exchange(rhs._tail, nullptr);
+        auto const new_size = cc::exchange(rhs._size, 0);
+        auto const new_resource = rhs._resource;
+
+        clear();
+
+        _head = new_head;
+        _tail = new_tail;
+        _size = new_size;
+        _resource = new_resource;
+        return *this;
+    }
+
+    /// Deep copy, the copy uses the same resource.
+    node_list(node_list const& rhs) : _resource(rhs._resource)
+    {
+        for (auto const& v : rhs)
+            emplace_back(v);
+    }
+    /// Deep copy into this list, the nodes are allocated from our own resource.
+    node_list& operator=(node_list const& rhs)
+    {
+        if (this != &rhs)
+        {
+            auto copy = create_with_resource(_resource);
+            for (auto const& v : rhs)
+                copy.emplace_back(v);
+            *this = cc::move(copy);
+        }
+        return *this;
+    }
+
+    ~node_list() { clear(); }
+
+private:
+    [[nodiscard]] node_allocator& allocator() const { return impl::list_allocator_for(_resource); }
+
+    // links a detached node before next (nullptr appends)
+    void link_before(node_t* next, node_t* node)
+    {
+        auto const prev = next != nullptr ? next->prev : _tail;
+        node->prev = prev;
+        node->next = next;
+        (prev != nullptr ? prev->next : _head) = node;
+        (next != nullptr ? next->prev : _tail) = node;
+        ++_size;
+    }
+
+    // unlinks a node of this list without destroying it
+    void unlink(node_t* node)
+    {
+        CC_ASSERT(_size > 0, "unlinking from an empty node_list");
+        (node->prev != nullptr ? node->prev->next : _head) = node->next;
+        (node->next != nullptr ? node->next->prev : _tail) = node->prev;
+        node->next = nullptr;
+        node->prev = nullptr;
+        --_size;
+    }
+
+private:
+    node_t* _head = nullptr;
+    node_t* _tail = nullptr;
+    isize _size = 0;
+    node_memory_resource* _resource = nullptr;
+};
@@ -0,0 +1,218 @@
+#pragma once
+
+#include <clean-core/node_list.hh>
+
+/// Singly-linked FIFO queue of T stored in node memory (see node_allocation.hh).
+/// Uses the same nodes as node_list, so node handles move freely between node_list, node_stack and node_queue.
+///
+/// Guarantees:
+///   - push_back/pop_front/extract_front are O(1) and never move existing elements
+///   - appending another queue is O(1)
+///
+/// Compared to ringbuffer, the queue never reallocates and elements have stable addresses,
+/// at the cost of one node per element.
+template <class T>
+struct cc::node_queue
+{
+    static_assert(std::is_object_v<T> && !std::is_const_v<T>, "node_queue elements must be non-const objects");
+
+    using node_t = impl::list_node<T>;
+    using iterator = impl::list_iterator<T, false>;
+    using const_iterator = impl::list_iterator<T, true>;
+    using handle_t = list_node_handle<T>;
+
+    // element access
+public:
+    [[nodiscard]] T& front()
+    {
+        CC_ASSERT(_head != nullptr, "front() on empty node_queue");
+        return _head->value;
+    }
+    [[nodiscard]] T const& front() const
+    {
+        CC_ASSERT(_head != nullptr, "front() on empty node_queue");
+        return _head->value;
+    }
+    [[nodiscard]] T& back()
+    {
+        CC_ASSERT(_tail != nullptr, "back() on empty node_queue");
+        return _tail->value;
+    }
+    [[nodiscard]] T const& back() const
+    {
+        CC_ASSERT(_tail != nullptr, "back() on empty node_queue");
+        return _tail->value;
+    }
+
+    // iterators (front to back, forward only)
+public:
+    [[nodiscard]] iterator begin() { return {_head}; }
+    [[nodiscard]] iterator end() { return {}; }
+    [[nodiscard]] const_iterator begin() const { return {_head}; }
+    [[nodiscard]] const_iterator end() const { return {}; }
+
+    // queries
+public:
+    [[nodiscard]] isize size() const { return _size; }
+    [[nodiscard]] bool empty() const { return _size == 0; }
+
+    // adding elements
+public:
+    template <class... Args>
+    T& emplace_back(Args&&... args)
+    {
+        auto const node = impl::list_node_allocate<T>(impl::list_allocator_for(_resource), cc::forward<Args>(args)...);
+        link_back(node);
+        return node->value;
+    }
+    T& push_back(T const& value) { return emplace_back(value); }
+    T& push_back(T&& value) { return emplace_back(cc::move(value)); }
+
+    /// Links a detached node without allocating. The handle is empty afterwards.
+    T& push_back(handle_t&& handle)
+    {
+        CC_ASSERT(handle.is_valid(), "cannot push an empty list_node_handle");
+        auto const node = handle.release_node();
+        link_back(node);
+        return node->value;
+    }
+
+    // removing elements
+public:
+    [[nodiscard("use remove_front() if you don't need the return value")]] T pop_front()
+    {
+        CC_ASSERT(_head != nullptr, "pop_front() on empty node_queue");
+        auto const node = unlink_front();
+        T value = cc::move(node->value);
+        impl::list_node_destroy(node);
+        return value;
+    }
+    void remove_front()
+    {
+        CC_ASSERT(_head != nullptr, "remove_front() on empty node_queue");
+        impl::list_node_destroy(unlink_front());
+    }
+
+    /// Unlinks the front node without deallocating it.
+    [[nodiscard]] handle_t extract_front()
+    {
+        CC_ASSERT(_head != nullptr, "extract_front() on empty node_queue");
+        return handle_t(unlink_front());
+    }
+
+    /// Destroys all elements. O(size).
+    void clear()
+    {
+        auto node = _head;
+        while (node != nullptr)
+            impl::list_node_destroy(cc::exchange(node, node->next));
+
+        _head = nullptr;
+        _tail = nullptr;
+        _size = 0;
+    }
+
+    // splicing
+public:
+    /// Appends all elements of other (in order), leaving other empty. O(1).
+    void splice_back(node_queue& other)
+    {
+        CC_ASSERT(&other != this, "cannot splice a queue into itself");
+        if (other.empty())
+            return;
+
+        (_tail != nullptr ? _tail->next : _head) = other._head;
+        _tail = other._tail;
+        _size += other._size;
+
+        other._head = nullptr;
+        other._tail = nullptr;
+        other._size = 0;
+    }
+
+    // factories
+public:
+    /// Creates an empty queue allocating nodes from the given resource (nullptr means default).
+    [[nodiscard]] static node_queue create_with_resource(node_memory_resource* resource)
+    {
+        node_queue q;
+        q._resource = resource;
+        return q;
+    }
+
+    // ctors/dtor
+public:
+    node_queue() = default;
+
+    node_queue(node_queue&& rhs) noexcept
+      : _head(cc::exchange(rhs._head, nullptr)),
+        _tail(cc::exchange(rhs._tail, nullptr)),
+        _size(cc::exchange(rhs._size, 0)),
+        _resource(rhs._resource)
+    {
+    }
+    node_queue& operator=(node_queue&& rhs) noexcept
+    {
+        // take ownership from rhs first, rhs might be owned by one of our elements
+        auto const new_head = cc::exchange(rhs._head, nullptr);
+        auto const new_tail = cc::exchange(rhs._tail, nullptr);
+        auto const new_size = cc::exchange(rhs._size, 0);
+        auto const new_resource = rhs._resource;
+
+        clear();
+
+        _head = new_head;
+        _tail = new_tail;
+        _size = new_size;
+        _resource = new_resource;
+        return *this;
+    }
+
+    /// Deep copy, the copy uses the same resource.
+    node_queue(node_queue const& rhs) : _resource(rhs._resource)
+    {
+        for (auto const& v : rhs)
+            emplace_back(v);
+    }
+    /// Deep copy into this queue, the nodes are allocated from our own resource.
+    node_queue& operator=(node_queue const& rhs)
+    {
+        if (this != &rhs)
+        {
+            auto copy = create_with_resource(_resource);
+            for (auto const& v : rhs)
+                copy.emplace_back(v);
+            *this = cc::move(copy);
+        }
+        return *this;
+    }
+
+    ~node_queue() { clear(); }
+
+private:
+    void link_back(node_t* node)
+    {
+        node->prev = nullptr;
+        node->next = nullptr;
+        (_tail != nullptr ? _tail->next : _head) = node;
+        _tail = node;
+        ++_size;
+    }
+
+    node_t* unlink_front()
+    {
+        auto const node = _head;
+        _head = node->next;
+        if (_head == nullptr)
+            _tail = nullptr;
+        node->next = nullptr;
+        --_size;
+        return node;
+    }
+
+private:
+    node_t* _head = nullptr;
+    node_t* _tail = nullptr;
+    isize _size = 0;
+    node_memory_resource* _resource = nullptr;
+};
@@ -0,0 +1,218 @@
+#pragma once
+
+#include <clean-core/node_list.hh>
+
+/// Singly-linked LIFO stack of T stored in node memory (see node_allocation.hh).
+/// Uses the same nodes as node_list, so node handles move freely between node_list, node_stack and node_queue.
+///
+/// Guarantees:
+///   - push/pop/extract are O(1) and never move existing elements
+///   - splicing another stack on top is O(1) (the bottom node is tracked for that)
+///
+/// Typical use: free lists of pre-allocated nodes (push(handle) / extract_top() never touch the allocator).
+template <class T>
+struct cc::node_stack
+{
+    static_assert(std::is_object_v<T> && !std::is_const_v<T>, "node_stack elements must be non-const objects");
+
+    using node_t = impl::list_node<T>;
+    using iterator = impl::list_iterator<T, false>;
+    using const_iterator = impl::list_iterator<T, true>;
+    using handle_t = list_node_handle<T>;
+
+    // element access
+public:
+    [[nodiscard]] T& top()
+    {
+        CC_ASSERT(_top != nullptr, "top() on empty node_stack");
+        return _top->value;
+    }
+    [[nodiscard]] T const& top() const
+    {
+        CC_ASSERT(_top != nullptr, "top() on empty node_stack");
+        return _top->value;
+    }
+
+    // iterators (top to bottom, forward only)
+public:
+    [[nodiscard]] iterator begin() { return {_top}; }
+    [[nodiscard]] iterator end() { return {}; }
+    [[nodiscard]] const_iterator begin() const { return {_top}; }
+    [[nodiscard]] const_iterator end() const { return {}; }
+
+    // queries
+public:
+    [[nodiscard]] isize size() const { return _size; }
+    [[nodiscard]] bool empty() const { return _size == 0; }
+
+    // adding elements
+public:
+    template <class... Args>
+    T& emplace(Args&&... args)
+    {
+        auto const node = impl::list_node_allocate<T>(impl::list_allocator_for(_resource), cc::forward<Args>(args)...);
+        link_top(node);
+        return node->value;
+    }
+    T& push(T const& value) { return emplace(value); }
+    T& push(T&& value) { return emplace(cc::move(value)); }
+
+    /// Links a detached node without allocating. The handle is empty afterwards.
+    T& push(handle_t&& handle)
+    {
+        CC_ASSERT(handle.is_valid(), "cannot push an empty list_node_handle");
+        auto const node = handle.release_node();
+        link_top(node);
+        return node->value;
+    }
+
+    // removing elements
+public:
+    [[nodiscard("use remove_top() if you don't need the return value")]] T pop()
+    {
+        CC_ASSERT(_top != nullptr, "pop() on empty node_stack");
+        auto const node = unlink_top();
+        T value = cc::move(node->value);
+        impl::list_node_destroy(node);
+        return value;
+    }
+    void remove_top()
+    {
+        CC_ASSERT(_top != nullptr, "remove_top() on empty node_stack");
+        impl::list_node_destroy(unlink_top());
+    }
+
+    /// Unlinks the top node without deallocating it.
+    [[nodiscard]] handle_t extract_top()
+    {
+        CC_ASSERT(_top != nullptr, "extract_top() on empty node_stack");
+        return handle_t(unlink_top());
+    }
+
+    /// Destroys all elements. O(size).
+    void clear()
+    {
+        auto node = _top;
+        while (node != nullptr)
+            impl::list_node_destroy(cc::exchange(node, node->next));
+
+        _top = nullptr;
+        _bottom = nullptr;
+        _size = 0;
+    }
+
+    // splicing
+public:
+    /// Moves all elements of other on top of this stack (other's top becomes the new top), leaving other empty. O(1).
+    void splice_top(node_stack& other)
+    {
+        CC_ASSERT(&other != this, "cannot splice a stack into itself");
+        if (other.empty())
+            return;
+
+        other._bottom->next = _top;
+        if (_top == nullptr)
+            _bottom = other._bottom;
+        _top = other._top;
+        _size += other._size;
+
+        other._top = nullptr;
+        other._bottom = nullptr;
+        other._size = 0;
+    }
+
+    // factories
+public:
+    /// Creates an empty stack allocating nodes from the given resource (nullptr means default).
+    [[nodiscard]] static node_stack create_with_resource(node_memory_resource* resource)
+    {
+        node_stack s;
+        s._resource = resource;
+        return s;
+    }
+
+    // ctors/dtor
+public:
+    node_stack() = default;
+
+    node_stack(node_stack&& rhs) noexcept
+      : _top(cc::exchange(rhs._top, nullptr)),
+        _bottom(cc::exchange(rhs._bottom, nullptr)),
+        _size(cc::exchange(rhs._size, 0)),
+        _resource(rhs._resource)
+    {
+    }
+    node_stack& operator=(node_stack&& rhs) noexcept
+    {
+        // take ownership from rhs first, rhs might be owned by one of our elements
+        auto const new_top = cc::exchange(rhs._top, nullptr);
+        auto const new_bottom = cc::exchange(rhs._bottom, nullptr);
+        auto const new_size = cc::exchange(rhs._size, 0);
+        auto const new_resource = rhs._resource;
+
+        clear();
+
+        _top = new_top;
+        _bottom = new_bottom;
+        _size = new_size;
+        _resource = new_resource;
+        return *this;
+    }
+
+    /// Deep copy (preserving order), the copy uses the same resource.
+    node_stack(node_stack const& rhs) : _resource(rhs._resource) { append_copies_of(rhs); }
+    /// Deep copy into this stack, the nodes are allocated from our own resource.
+    node_stack& operator=(node_stack const& rhs)
+    {
+        if (this != &rhs)
+        {
+            auto copy = create_with_resource(_resource);
+            copy.append_copies_of(rhs);
+            *this = cc::move(copy);
+        }
+        return *this;
+    }
+
+    ~node_stack() { clear(); }
+
+private:
+    // appends copies of all elements of rhs at the bottom (keeps their order), allocated from our resource
+    void append_copies_of(node_stack const& rhs)
+    {
+        auto& alloc = impl::list_allocator_for(_resource);
+        for (auto const& v : rhs)
+        {
+            auto const node = impl::list_node_allocate<T>(alloc, v);
+            (_bottom != nullptr ? _bottom->next : _top) = node;
+            _bottom = node;
+            ++_size;
+        }
+    }
+
+    void link_top(node_t* node)
+    {
+        node->prev = nullptr;
+        node->next = _top;
+        if (_top == nullptr)
+            _bottom = node;
+        _top = node;
+        ++_size;
+    }
+
+    node_t* unlink_top()
+    {
+        auto const node = _top;
+        _top = node->next;
+        if (_top == nullptr)
+            _bottom = nullptr;
+        node->next = nullptr;
+        --_size;
+        return node;
+    }
+
+private:
+    node_t* _top = nullptr;
+    node_t* _bottom = nullptr;
+    isize _size = 0;
+    node_memory_resource* _resource = nullptr;
+};
@@ -1,11 +1,427 @@
 #pragma once
 
+#include <clean-core/allocation.hh>
+#include <clean-core/bit.hh>
 #include <clean-core/fwd.hh>
+#include <clean-core/impl/object_lifetime_util.hh>
+#include <clean-core/span.hh>
+#include <clean-core/utility.hh>
 
-/// Circular buffer for elements of type T with efficient push/pop at both ends
-/// Maintains a fixed-capacity queue with wrap-around behavior
+#include <initializer_list>
+
+/// A logically contiguous range of ring buffer slots, split into at most two physical spans.
+/// first comes before second, second is empty unless the range wraps around the end of the storage.
+///
+/// Usage:
+///   auto r = rb.readable_regions();
+///   process(r.first);
+///   process(r.second);
+template <class T>
+struct cc::ring_regions
+{
+    cc::span<T> first;
+    cc::span<T> second;
+
+    [[nodiscard]] isize size() const { return first.size() + second.size(); }
+    [[nodiscard]] bool empty() const { return first.empty() && second.empty(); }
+};
+
+namespace cc::impl
+{
+/// Iterator over ring buffer slots, idx is the unmasked physical position.
+template <class T>
+struct ring_iterator
+{
+    [[nodiscard]] CC_FORCE_INLINE T& operator*() const { return slots[idx & mask]; }
+
+    CC_FORCE_INLINE ring_iterator& operator++()
+    {
+        ++idx;
+        return *this;
+    }
+
+    [[nodiscard]] bool operator==(ring_iterator const& rhs) const { return idx == rhs.idx; }
+
+    T* slots;
+    isize mask;
+    isize idx;
+};
+} // namespace cc::impl
+
+/// Growable circular buffer with O(1) push/pop at both ends.
+///
+/// Storage is a cc::allocation<T> whose capacity is always a power of two,
+/// so logical index i lives in slot (head + i) & (capacity - 1), without any division.
+/// Unlike vector/devector, the live range may wrap around the end of the storage,
+/// so the allocation's live window stays empty and the ringbuffer manages element lifetimes itself.
+///
+/// Bulk I/O without per-element calls:
+///   - readable_regions() exposes the live elements as at most two spans, commit_read(n) drops the first n
+///   - writable_regions(n) exposes n free slots after the back, commit_write(n) makes them live
+///     (trivially copyable T only, the slots are uninitialized memory)
+///   - push_back_range / pop_front_to copy whole ranges with at most two memcpy calls each for trivial T
+///
+/// Pushing into a full buffer doubles the capacity and moves the elements to the start of the new storage.
+/// Growth invalidates all references and regions,
+/// pushes and pops without growth keep references to other elements valid.
+///
+/// Usage:
+///   auto samples = cc::ringbuffer<f32>::create_with_capacity(4096);
+///   auto w = samples.writable_regions(256);
+///   read_from_device(w.first);
+///   read_from_device(w.second);
+///   samples.commit_write(256);
+///   ...
+///   auto r = samples.readable_regions();
+///   process(r.first);
+///   process(r.second);
+///   samples.commit_read(r.size());
 template <class T>
 struct cc::ringbuffer
 {
-    // TODO: implement ringbuffer
+    static_assert(std::is_object_v<T> && !std::is_const_v<T>, "ringbuffer elements must be non-const objects");
+
+    using iterator = impl::ring_iterator<T>;
+    using const_iterator = impl::ring_iterator<T const>;
+
+    // element access
+public:
+    /// Returns the element at logical index i (0 is the front).
+    [[nodiscard]] T& operator[](isize i)
+    {
+        CC_ASSERT(0 <= i && i < _size, "index out of bounds");
+        return slots()[(_head + i) & mask()];
+    }
+    [[nodiscard]] T const& operator[](isize i) const
+    {
+        CC_ASSERT(0 <= i && i < _size, "index out of bounds");
+        return slots()[(_head + i) & mask()];
+    }
+
+    [[nodiscard]] T& front()
+    {
+        CC_ASSERT(_size > 0, "ringbuffer is empty");
+        return slots()[_head];
+    }
+    [[nodiscard]] T const& front() const
+    {
+        CC_ASSERT(_size > 0, "ringbuffer is empty");
+        return slots()[_head];
+    }
+
+    [[nodiscard]] T& back()
+    {
+        CC_ASSERT(_size > 0, "ringbuffer is empty");
+        return slots()[(_head + _size - 1) & mask()];
+    }
+    [[nodiscard]] T const& back() const
+    {
+        CC_ASSERT(_size > 0, "ringbuffer is empty");
+        return slots()[(_head + _size - 1) & mask()];
+    }
+
+    // iteration (front to back)
+public:
+    [[nodiscard]] iterator begin() { return {slots(), mask(), _head}; }
+    [[nodiscard]] iterator end() { return {slots(), mask(), _head + _size}; }
+    [[nodiscard]] const_iterator begin() const { return {slots(), mask(), _head}; }
+    [[nodiscard]] const_iterator end() const { return {slots(), mask(), _head + _size}; }
+
+    // queries
+public:
+    [[nodiscard]] isize size() const { return _size; }
+    [[nodiscard]] bool empty() const { return _size == 0; }
+
+    /// Number of slots in the storage, 0 or a power of two.
+    [[nodiscard]] isize capacity() const { return _capacity; }
+
+    // single element operations
+public:
+    template <class... Args>
+    T& emplace_back(Args&&... args)
+    {
+        if (_size == _capacity)
+        {
+            // construct first, args might alias an element of the old storage
+            auto const new_capacity = grown_capacity(_size + 1);
+            auto storage = allocate_storage(new_capacity);
+            auto& r = *new (cc::placement_new, storage.obj_start + _size) T(cc::forward<Args>(args)...);
+            move_to_storage(cc::move(storage), new_capacity);
+            ++_size;
+            return r;
+        }
+        auto& r = *new (cc::placement_new, slots() + ((_head + _size) & mask())) T(cc::forward<Args>(args)...);
+        ++_size;
+        return r;
+    }
+    T& push_back(T const& value) { return emplace_back(value); }
+    T& push_back(T&& value) { return emplace_back(cc::move(value)); }
+
+    template <class... Args>
+    T& emplace_front(Args&&... args)
+    {
+        if (_size == _capacity)
+        {
+            auto const new_capacity = grown_capacity(_size + 1);
+            auto storage = allocate_storage(new_capacity);
+            auto& r = *new (cc::placement_new, storage.obj_start + new_capacity - 1) T(cc::forward<Args>(args)...);
+            move_to_storage(cc::move(storage), new_capacity);
+            _head = new_capacity - 1;
+            ++_size;
+            return r;
+        }
+        auto const new_head = cc::wrapped_decrement(_head, _capacity);
+        auto& r = *new (cc::placement_new, slots() + new_head) T(cc::forward<Args>(args)...);
+        _head = new_head;
+        ++_size;
+        return r;
+    }
+    T& push_front(T const& value) { return emplace_front(value); }
+    T& push_front(T&& value) { return emplace_front(cc::move(value)); }
+
+    /// Removes and returns the first element.
+    [[nodiscard("use remove_front() if you don't need the return value")]] T pop_front()
+    {
+        CC_ASSERT(_size > 0, "cannot pop from empty ringbuffer");
+        auto value = cc::move(slots()[_head]);
+        remove_front();
+        return value;
+    }
+    void remove_front()
+    {
+        CC_ASSERT(_size > 0, "cannot remove from empty ringbuffer");
+        slots()[_head].~T();
+        _head = cc::wrapped_increment(_head, _capacity);
+        --_size;
+    }
+
+    /// Removes and returns the last element.
+    [[nodiscard("use remove_back() if you don't need the return value")]] T pop_back()
+    {
+        CC_ASSERT(_size > 0, "cannot pop from empty ringbuffer");
+        auto value = cc::move(back());
+        remove_back();
+        return value;
+    }
+    void remove_back()
+    {
+        CC_ASSERT(_size > 0, "cannot remove from empty ringbuffer");
+        back().~T();
+        --_size;
+    }
+
+    // bulk operations
+public:
+    /// The live elements (front to back) as at most two spans.
+    [[nodiscard]] ring_regions<T> readable_regions() { return regions_at(_head, _size); }
+    [[nodiscard]] ring_regions<T const> readable_regions() const
+    {
+        auto const r = const_cast<ringbuffer*>(this)->readable_regions();
+        return {r.first, r.second};
+    }
+
+    /// Removes the first count elements, typically after processing them via readable_regions().
+    void commit_read(isize count)
+    {
+        CC_ASSERT(0 <= count && count <= _size, "cannot read more elements than available");
+        auto const r = regions_at(_head, count);
+        impl::destroy_objects_in_reverse(r.first.data(), r.first.data() + r.first.size());
+        impl::destroy_objects_in_reverse(r.second.data(), r.second.data() + r.second.size());
+        _head = (_head + count) & mask();
+        _size -= count;
+    }
+
+    /// Makes room for count more elements (growing if needed) and returns the count free slots after the back.
+    /// The slots are uninitialized until commit_write, so this is only available for trivially copyable T.
+    [[nodiscard]] ring_regions<T> writable_regions(isize count)
+    {
+        static_assert(std::is_trivially_copyable_v<T>,
+                      "writable regions are uninitialized memory, use push_back_range for non-trivial types");
+        CC_ASSERT(count >= 0, "count must be non-negative");
+        reserve(_size + count);
+        return regions_at((_head + _size) & mask(), count);
+    }
+
+    /// Appends count elements that were written into writable_regions(count) or a larger earlier request.
+    void commit_write(isize count)
+    {
+        static_assert(std::is_trivially_copyable_v<T>,
+                      "writable regions are only available for trivially copyable types");
+        CC_ASSERT(0 <= count && count <= _capacity - _size, "cannot commit more elements than were made writable");
+        _size += count;
+    }
+
+    /// Appends copies of all values at the back (at most two memcpy calls for trivially copyable T).
+    void push_back_range(cc::span<T const> values)
+    {
+        CC_ASSERT(values.empty() || !(slots() <= values.data() && values.data() < slots() + _capacity),
+                  "values must not alias the ringbuffer storage");
+        reserve(_size + values.size());
+        auto const r = regions_at((_head + _size) & mask(), values.size());
+        auto dest = r.first.data();
+        impl::copy_create_objects_to(dest, values.data(), values.data() + r.first.size());
+        _size += r.first.size();
+        dest = r.second.data();
+        impl::copy_create_objects_to(dest, values.data() + r.first.size(), values.data() + values.size());
+        _size += r.second.size();
+    }
+
+    /// Moves up to dest.size() elements from the front into dest (assigning to the existing objects there)
+    /// and removes them. Returns the number of moved elements.
+    isize pop_front_to(cc::span<T> dest)
+    {
+        auto const count = cc::min(dest.size(), _size);
+        auto const r = regions_at(_head, count);
+        if constexpr (std::is_trivially_copyable_v<T>)
+        {
+            if (!r.first.empty())
+                cc::memcpy(dest.data(), r.first.data(), r.first.size() * sizeof(T));
+            if (!r.second.empty())
+                cc::memcpy(dest.data() + r.first.size(), r.second.data(), r.second.size() * sizeof(T));
+        }
+        else
+        {
+            for (isize i = 0; i < count; ++i)
+                dest[i] = cc::move(slots()[(_head + i) & mask()]);
+        }
+        commit_read(count);
+        return count;
+    }
+
+    /// Destroys all elements but keeps the storage.
+    void clear() { commit_read(_size); }
+
+    // capacity
+public:
+    /// Makes sure that count elements fit without growing (the capacity is rounded up to a power of two).
+    void reserve(isize count)
+    {
+        CC_ASSERT(count >= 0, "count must be non-negative");
+        if (count > _capacity)
+        {
+            auto const new_capacity = isize(cc::bit_ceil(u64(count)));
+            move_to_storage(allocate_storage(new_capacity), new_capacity);
+        }
+    }
+
+    // factories
+public:
+    /// Creates an empty ringbuffer that allocates from the given resource (nullptr means default).
+    [[nodiscard]] static ringbuffer create_with_resource(cc::memory_resource const* resource)
+    {
+        ringbuffer rb;
+        rb._data.custom_resource = resource;
+        return rb;
+    }
+
+    /// Creates an empty ringbuffer with room for at least count elements.
+    [[nodiscard]] static ringbuffer create_with_capacity(isize count, cc::memory_resource const* resource = nullptr)
+    {
+        auto rb = ringbuffer::create_with_resource(resource);
+        rb.reserve(count);
+        return rb;
+    }
+
+    // ctors/dtor
+public:
+    ringbuffer() = default;
+
+    ringbuffer(std::initializer_list<T> values)
+    {
+        push_back_range(cc::span<T const>(values.begin(), isize(values.size())));
+    }
+
+    ringbuffer(ringbuffer&& rhs) noexcept
+      : _data(cc::move(rhs._data)),
+        _head(cc::exchange(rhs._head, 0)),
+        _size(cc::exchange(rhs._size, 0)),
+        _capacity(cc::exchange(rhs._capacity, 0))
+    {
+    }
+    ringbuffer& operator=(ringbuffer&& rhs) noexcept
+    {
+        // take ownership from rhs first, rhs might be owned by one of our elements
+        auto new_data = cc::move(rhs._data);
+        auto const new_head = cc::exchange(rhs._head, 0);
+        auto const new_size = cc::exchange(rhs._size, 0);
+        auto const new_capacity = cc::exchange(rhs._capacity, 0);
+
+        // destroys our elements, the move assignment of _data then frees the old storage
+        clear();
+
+        _data = cc::move(new_data);
+        _head = new_head;
+        _size = new_size;
+        _capacity = new_capacity;
+        return *this;
+    }
+
+    /// Deep copy into linear storage, the copy uses the same resource.
+    ringbuffer(ringbuffer const& rhs)
+    {
+        _data.custom_resource = rhs._data.custom_resource;
+        auto const r = rhs.readable_regions();
+        reserve(rhs._size);
+        push_back_range(r.first);
+        push_back_range(r.second);
+    }
+    ringbuffer& operator=(ringbuffer const& rhs)
+    {
+        if (this != &rhs)
+        {
+            clear();
+            auto const r = rhs.readable_regions();
+            reserve(rhs._size);
+            push_back_range(r.first);
+            push_back_range(r.second);
+        }
+        return *this;
+    }
+
+    ~ringbuffer() { clear(); }
+
+private:
+    [[nodiscard]] T* slots() const { return _data.obj_start; }
+    [[nodiscard]] isize mask() const { return _capacity - 1; }
+
+    // the count slots starting at physical index start
+    [[nodiscard]] ring_regions<T> regions_at(isize start, isize count) const
+    {
+        auto const first = cc::min(count, _capacity - start);
+        if (count == 0)
+            return {};
+        return {cc::span<T>(slots() + start, first), cc::span<T>(slots(), count - first)};
+    }
+
+    [[nodiscard]] isize grown_capacity(isize min_count) const
+    {
+        return isize(cc::bit_ceil(u64(cc::max(min_count, cc::max(_capacity * 2, isize(8))))));
+    }
+
+    [[nodiscard]] cc::allocation<T> allocate_storage(isize capacity) const
+    {
+        CC_ASSERT(cc::has_single_bit(u64(capacity)), "ringbuffer capacity must be a power of two");
+        return cc::allocation<T>::create_empty(capacity, alignof(T), _data.custom_resource);
+    }
+
+    // moves all elements to the start of new storage (its live window stays empty)
+    void move_to_storage(cc::allocation<T> storage, isize capacity)
+    {
+        auto const r = regions_at(_head, _size);
+        auto dest = storage.obj_start;
+        impl::move_create_objects_to(dest, r.first.data(), r.first.data() + r.first.size());
+        impl::move_create_objects_to(dest, r.second.data(), r.second.data() + r.second.size());
+        impl::destroy_objects_in_reverse(r.first.data(), r.first.data() + r.first.size());
+        impl::destroy_objects_in_reverse(r.second.data(), r.second.data() + r.second.size());
+
+        _capacity = capacity;
+        _data = cc::move(storage);
+        _head = 0;
+    }
+
+private:
+    cc::allocation<T> _data;
+    isize _head = 0; // slot of the front element
+    isize _size = 0;
+    isize _capacity = 0;
 };
@@ -1,11 +1,289 @@
 #pragma once
 
 #include <clean-core/fwd.hh>
+#include <clean-core/impl/hash_table.hh>
+#include <clean-core/span.hh>
+#include <clean-core/vector.hh>
 
-/// Associative container storing unique elements of type T
-/// Provides efficient membership testing and set operations
+#include <initializer_list>
+
+namespace cc::impl
+{
+template <class T>
+struct set_traits
+{
+    [[nodiscard]] CC_FORCE_INLINE static T const& key_of(T const& s) { return s; }
+};
+
+template <class T>
+struct set_iterator
+{
+    [[nodiscard]] CC_FORCE_INLINE T const& operator*() const { return _cursor.slots[_cursor.idx]; }
+
+    CC_FORCE_INLINE set_iterator& operator++()
+    {
+        _cursor.advance();
+        return *this;
+    }
+
+    [[nodiscard]] friend bool operator==(set_iterator const& it, cc::sentinel) { return it._cursor.remaining == 0; }
+
+    hash_table_cursor<T> _cursor;
+};
+} // namespace cc::impl
+
+/// Hash set of unique T elements with Swiss-table style open addressing.
+/// Shares its engine with cc::map (see impl/hash_table.hh), elements are stored inline in one flat slot array.
+///
+/// Elements are hashed via cc::make_hash (see hash.hh) and compared via ==.
+/// Lookup and insertion are templated on the key type, so a set<cc::string> can be queried with string_view.
+///
+/// Bulk operations are built for membership-heavy workloads (dedup, joins):
+///   - contains_each/count_contained probe a whole span of keys in blocks,
+///     hashing and prefetching a block before probing it so that cache misses overlap
+///   - create_union/create_intersection/create_difference build a new set without rehashing the inputs
+///   - extract_to_vector moves all elements into a cc::vector
+///
+/// Guarantees and caveats:
+///   - contains/insert/remove are O(1) on average
+///   - insertions may rehash: pointers and references to elements are invalidated when the set grows
+///   - iteration order is unspecified and changes on rehash
+///   - elements are immutable through iteration (changing them would corrupt the table)
+///
+/// Usage:
+///   cc::set<int> seen;
+///   seen.insert_range(ids);
+///   if (seen.insert(42)) // true if 42 was new
+///       ...
+///   auto common = cc::set<int>::create_intersection(a, b);
 template <class T>
 struct cc::set
 {
-    // TODO: implement set
+    static_assert(std::is_object_v<T> && !std::is_const_v<T>, "set elements must be non-const objects");
+
+    using element_t = T;
+    using iterator = impl::set_iterator<T>;
+
+    // queries
+public:
+    template <class KeyT>
+    [[nodiscard]] CC_FORCE_INLINE bool contains(KeyT const& key) const
+    {
+        return _table.find(key, cc::make_hash(key)) != nullptr;
+    }
+
+    /// Writes contains(keys[i]) into out[i] for all keys, using batched probing.
+    void contains_each(cc::span<T const> keys, cc::span<bool> out) const
+    {
+        CC_ASSERT(out.size() == keys.size(), "output span must have one entry per key");
+        _table.find_batched(
+            keys.size(), [&](isize i) -> T const& { return keys[i]; },
+            [&](isize i, T const* s, u64) { out[i] = s != nullptr; });
+    }
+
+    /// Returns how many of the keys are contained in the set (duplicate keys are counted each time).
+    [[nodiscard]] isize count_contained(cc::span<T const> keys) const
+    {
+        isize count = 0;
+        _table.find_batched(
+            keys.size(), [&](isize i) -> T const& { return keys[i]; },
+            [&](isize, T const* s, u64) { count += s != nullptr; });
+        return count;
+    }
+
+    [[nodiscard]] isize size() const { return _table.size(); }
+    [[nodiscard]] bool empty() const { return _table.size() == 0; }
+
+    /// Number of slots. Up to 7/8 of them can be filled before the set grows.
+    [[nodiscard]] isize capacity() const { return _table.capacity(); }
+
+    // iteration
+public:
+    [[nodiscard]] iterator begin() const { return {_table.cursor()}; }
+    [[nodiscard]] cc::sentinel end() const { return {}; }
+
+    // insertion
+public:
+    /// Inserts key (converted to T) unless an equal element is present.
+    /// Returns true if the element was inserted.
+    template <class KeyT>
+    bool insert(KeyT&& key)
+    {
+        auto const hash = cc::make_hash(key);
+        if (_table.find(key, hash) != nullptr)
+            return false;
+        _table.insert_new(hash, cc::forward<KeyT>(key));
+        return true;
+    }
+
+    /// Inserts all elements that are not yet present. Returns the number of inserted elements.
+    /// Reserves room for all of them upfront, so at most one rehash happens.
+    isize insert_range(cc::span<T const> elements)
+    {
+        reserve(size() + elements.size());
+
+        auto const old_size = size();
+        _table.find_batched(
+            elements.size(), [&](isize i) -> T const& { return elements[i]; },
+            [&](isize i, T const* s, u64 hash)
+            {
+                // each probe runs right before its callback, so duplicates within the input are found as well
+                if (s == nullptr)
+                    _table.construct_at(_table.prepare_insert(hash), hash, elements[i]);
+            });
+        return size() - old_size;
+    }
+
+    // removal
+public:
+    /// Removes key if present. Returns true if an element was removed.
+    template <class KeyT>
+    bool remove(KeyT const& key)
+    {
+        auto const s = _table.find(key, cc::make_hash(key));
+        if (s == nullptr)
+            return false;
+        _table.erase_at(s - _table.slots());
+        return true;
+    }
+
+    /// Removes all elements for which pred(element) returns true. Returns the number of removed elements.
+    template <class Pred>
+    isize remove_all_where(Pred&& pred)
+    {
+        return _table.erase_all_where([&](T& s) { return bool(pred(static_cast<T const&>(s))); });
+    }
+
+    /// Removes all elements but keeps the capacity.
+    void clear() { _table.clear(); }
+
+    /// Moves all elements into a new vector (in iteration order) and leaves the set empty with its capacity.
+    /// The vector uses the memory resource of the set.
+    [[nodiscard]] cc::vector<T> extract_to_vector()
+    {
+        auto result = cc::vector<T>::create_with_capacity(size(), _table.custom_resource());
+        for (auto cur = _table.cursor(); cur.remaining > 0; cur.advance())
+            result.push_back_stable(cc::move(cur.slots[cur.idx]));
+        _table.clear();
+        return result;
+    }
+
+    // capacity
+public:
+    /// Makes sure that count elements fit without rehashing.
+    void reserve(isize count) { _table.reserve(count); }
+
+    /// Rebuilds the table for max(size(), count) elements, removing all tombstones.
+    /// rehash(0) shrinks the set to fit (and frees all memory of an empty set).
+    void rehash(isize count = 0) { _table.rehash(count); }
+
+    // factories
+public:
+    /// Creates an empty set that allocates from the given resource (nullptr means default).
+    [[nodiscard]] static set create_with_resource(cc::memory_resource const* resource)
+    {
+        set s;
+        s._table = table_t::create_with_resource(resource);
+        return s;
+    }
+
+    /// Creates an empty set with room for count elements.
+    [[nodiscard]] static set create_with_capacity(isize count, cc::memory_resource const* resource = nullptr)
+    {
+        auto s = set::create_with_resource(resource);
+        s.reserve(count);
+        return s;
+    }
+
+    /// Creates a set with all elements of a and b. Uses the memory resource of a.
+    [[nodiscard]] static set create_union(set const& a, set const& b)
+    {
+        // the table is sized for both inputs upfront and built once
+        // elements of a are unique, so they are placed without a lookup,
+        // elements of b are probed against a (in blocks) instead of the growing result
+        auto result = set::create_with_capacity(a.size() + b.size(), a._table.custom_resource());
+        for (auto cur = a._table.cursor(); cur.remaining > 0; cur.advance())
+        {
+            auto const& e = static_cast<T const&>(cur.slots[cur.idx]);
+            auto const hash = cc::make_hash(e);
+            result._table.construct_at(result._table.prepare_insert(hash), hash, e);
+        }
+        for_each_probed(b, a,
+                        [&](T const& e, bool found, u64 hash)
+                        {
+                            if (!found)
+                                result._table.construct_at(result._table.prepare_insert(hash), hash, e);
+                        });
+        return result;
+    }
+
+    /// Creates a set with all elements of a that are also in b. Uses the memory resource of a.
+    [[nodiscard]] static set create_intersection(set const& a, set const& b)
+    {
+        // iterate the smaller set and probe the larger one, the result is at most as large as the smaller set
+        auto const& smaller = a.size() <= b.size() ? a : b;
+        auto const& larger = a.size() <= b.size() ? b : a;
+
+        auto result = set::create_with_capacity(smaller.size(), a._table.custom_resource());
+        for_each_probed(smaller, larger,
+                        [&](T const& e, bool found, u64 hash)
+                        {
+                            if (found)
+                                result._table.construct_at(result._table.prepare_insert(hash), hash, e);
+                        });
+        return result;
+    }
+
+    /// Creates a set with all elements of a that are not in b. Uses the memory resource of a.
+    [[nodiscard]] static set create_difference(set const& a, set const& b)
+    {
+        auto result = set::create_with_capacity(a.size(), a._table.custom_resource());
+        for_each_probed(a, b,
+                        [&](T const& e, bool found, u64 hash)
+                        {
+                            if (!found)
+                                result._table.construct_at(result._table.prepare_insert(hash), hash, e);
+                        });
+        return result;
+    }
+
+    // ctors/dtor
+public:
+    set() = default;
+
+    set(std::initializer_list<T> elements)
+    {
+        insert_range(cc::span<T const>(elements.begin(), isize(elements.size())));
+    }
+
+    set(set const&) = default;
+    set(set&&) = default;
+    set& operator=(set const&) = default;
+    set& operator=(set&&) = default;
+
+private:
+    using table_t = impl::hash_table<T, impl::set_traits<T>>;
+
+    // calls f(element, contained_in_probed, hash) for all elements of source,
+    // probing in blocks so that the cache misses in probed overlap
+    template <class F>
+    static void for_each_probed(set const& source, set const& probed, F&& f)
+    {
+        constexpr isize block_size = 64;
+        T const* block[block_size];
+
+        auto cur = source._table.cursor();
+        while (cur.remaining > 0)
+        {
+            isize n = 0;
+            for (; n < block_size && cur.remaining > 0; ++n, cur.advance())
+                block[n] = &cur.slots[cur.idx];
+
+            probed._table.find_batched(
+                n, [&](isize i) -> T const& { return *block[i]; },
+                [&](isize i, T const* s, u64 hash) { f(*block[i], s != nullptr, hash); });
+        }
+    }
+
+    table_t _table;
 };
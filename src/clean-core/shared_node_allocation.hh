@@ -0,0 +1,202 @@
+#pragma once
+
+#include <clean-core/fwd.hh>
+#include <clean-core/node_allocation.hh>
+#include <clean-core/utility.hh>
+
+#include <atomic>
+
+namespace cc::impl
+{
+// the node stored in a single slot: the value followed by its reference count
+// placing the counter after T keeps T at the start of the slot (and thus at slot alignment)
+// and lets small T share their padding with the counter (e.g. a 12 byte T still fits a 16 byte class)
+template <class T>
+struct shared_node
+{
+    T value;
+    u32 refcount = 1;
+
+    template <class... Args>
+    explicit shared_node(Args&&... args) : value(cc::forward<Args>(args)...)
+    {
+    }
+};
+} // namespace cc::impl
+
+/// Reference-counted owning handle for a single T stored in node memory.
+/// The counter is co-located with T in the same node slot (see impl::shared_node), so there is exactly
+/// one allocation per object and no separate control block (unlike std::shared_ptr).
+/// The handle itself is a single pointer.
+///
+/// Copying increments the counter, destruction decrements it.
+/// The last handle destroys T and returns the slot via node_allocation_free (wait-free, from any thread).
+///
+/// IsAtomic selects the counter semantics:
+///   - shared_node_allocation<T>: atomic counter, handles to the same object can be copied/destroyed concurrently
+///   - local_shared_node_allocation<T>: plain counter, all handles to the same object must stay on one thread
+///     (or be externally synchronized). Freeing the slot itself is still cross-thread safe.
+///
+/// Like std::shared_ptr, this only makes the counter thread-safe, not T itself,
+/// and a single handle object must not be modified concurrently.
+///
+/// There are no weak references, no aliasing, and no custom deleters:
+/// the slot class is always derived from the node type.
+///
+/// Usage:
+///   auto a = cc::shared_node_allocation<Foo>::create_from(cc::default_node_allocator(), 1, 2);
+///   auto b = a;     // one atomic increment
+///   a.reset();      // one atomic decrement, b keeps Foo alive
+///   b->bar();
+template <class T, bool IsAtomic>
+struct cc::basic_shared_node_allocation
+{
+    static_assert(std::is_object_v<T> && !std::is_const_v<T>,
+                  "allocations need to refer to non-const objects, not references/functions/void");
+
+    using node_t = impl::shared_node<T>;
+
+    // properties
+public:
+    [[nodiscard]] bool is_valid() const { return _node != nullptr; }
+    explicit operator bool() const { return _node != nullptr; }
+
+    /// Number of handles currently sharing the object (0 for an empty handle).
+    /// In the atomic variant, this is only a snapshot if other threads hold handles.
+    [[nodiscard]] isize use_count() const
+    {
+        if (_node == nullptr)
+            return 0;
+
+        if constexpr (IsAtomic)
+            return isize(std::atomic_ref<u32>(_node->refcount).load(std::memory_order_relaxed));
+        else
+            return isize(_node->refcount);
+    }
+
+    /// True iff this is the only handle to the object.
+    [[nodiscard]] bool is_unique() const { return use_count() == 1; }
+
+    // smart pointer interface
+public:
+    [[nodiscard]] T& operator*() const
+    {
+        CC_ASSERT(_node != nullptr, "dereferencing null shared_node_allocation");
+        return _node->value;
+    }
+    [[nodiscard]] T* operator->() const
+    {
+        CC_ASSERT(_node != nullptr, "dereferencing null shared_node_allocation");
+        return &_node->value;
+    }
+
+    /// Pointer to the shared T or nullptr for an empty handle.
+    [[nodiscard]] T* get() const { return _node == nullptr ? nullptr : &_node->value; }
+
+    /// Handles are equal if they share the same object (or are both empty).
+    [[nodiscard]] bool operator==(basic_shared_node_allocation const& rhs) const { return _node == rhs._node; }
+
+    // factory
+public:
+    template <class... Args>
+    [[nodiscard]] static basic_shared_node_allocation create_from(node_allocator& alloc, Args&&... args)
+    {
+        static_assert(
+            requires { T(cc::forward<Args>(args)...); }, "T is not constructible from the provided argument "
+                                                         "types");
+
+        auto const ptr = alloc.allocate_node_bytes(cc::node_class_index_for<node_t>(), sizeof(node_t), alignof(node_t));
+
+        basic_shared_node_allocation n;
+        n._node = new (cc::placement_new, ptr) node_t(cc::forward<Args>(args)...);
+        return n;
+    }
+
+    // ctors/dtor
+public:
+    basic_shared_node_allocation() = default;
+
+    basic_shared_node_allocation(basic_shared_node_allocation const& rhs) : _node(rhs._node)
+    {
+        if (_node != nullptr)
+            acquire(_node);
+    }
+    basic_shared_node_allocation& operator=(basic_shared_node_allocation const& rhs)
+    {
+        // acquire first so that self-assignment cannot drop the last reference
+        auto const new_node = rhs._node;
+        if (new_node != nullptr)
+            acquire(new_node);
+
+        reset();
+
+        _node = new_node;
+        return *this;
+    }
+
+    basic_shared_node_allocation(basic_shared_node_allocation&& rhs) noexcept : _node(cc::exchange(rhs._node, nullptr))
+    {
+    }
+    basic_shared_node_allocation& operator=(basic_shared_node_allocation&& rhs) noexcept
+    {
+        // take ownership from rhs while it's definitely still alive
+        node_t* new_node = cc::exchange(rhs._node, nullptr);
+
+        // now release current ownership
+        reset();
+
+        // and adopt the stolen pointer
+        _node = new_node;
+        return *this;
+    }
+
+    /// Drops this reference. The last reference destroys T and returns the slot to its slab.
+    ~basic_shared_node_allocation()
+    {
+        if (_node != nullptr)
+            release(_node);
+    }
+
+    /// Drops this reference (if any) and resets to empty state.
+    /// Safe to call on an already-empty handle.
+    void reset()
+    {
+        if (_node != nullptr)
+            release(cc::exchange(_node, nullptr));
+    }
+
+private:
+    static void acquire(node_t* node)
+    {
+        // increments need no ordering: a new reference can only be created from an existing one
+        u32 old_count;
+        if constexpr (IsAtomic)
+            old_count = std::atomic_ref<u32>(node->refcount).fetch_add(1, std::memory_order_relaxed);
+        else
+            old_count = node->refcount++;
+
+        CC_ASSERT(old_count > 0, "acquiring an already destroyed shared_node_allocation");
+        CC_ASSERT(old_count < ~u32(0), "shared_node_allocation reference count overflow");
+    }
+
+    static void release(node_t* node)
+    {
+        // the decrement releases our writes to T, the last owner acquires all of them before destruction
+        u32 old_count;
+        if constexpr (IsAtomic)
+            old_count = std::atomic_ref<u32>(node->refcount).fetch_sub(1, std::memory_order_acq_rel);
+        else
+            old_count = node->refcount--;
+
+        CC_ASSERT(old_count > 0, "releasing an already destroyed shared_node_allocation");
+
+        if (old_count == 1)
+        {
+            node->~node_t();
+            cc::node_allocation_free((cc::byte*)node, cc::node_class_index_for<node_t>());
+        }
+    }
+
+private:
+    node_t* _node = nullptr;
+};
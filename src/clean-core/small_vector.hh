@@ -0,0 +1,741 @@
+#pragma once
+
+#include <clean-core/fwd.hh>
+#include <clean-core/impl/object_lifetime_util.hh>
+#include <clean-core/optional.hh>
+#include <clean-core/span.hh>
+#include <clean-core/utility.hh>
+#include <clean-core/vector.hh>
+
+#include <initializer_list>
+#include <type_traits>
+
+// TODO:
+// - equality, order, hashing
+// - insert/emplace at arbitrary positions
+
+/// Vector of T elements that stores up to N elements inline and spills to the heap beyond that.
+/// Same value semantics and interface as cc::vector, but small instances never allocate.
+///
+/// Performance design:
+///   - layout is two element pointers, the end of the current buffer, the memory resource,
+///     followed by N * sizeof(T) inline bytes; the hot paths (push_back, indexing, iteration)
+///     only look at the pointers and never branch on inline vs heap
+///   - growth uses the same policy as cc::vector (allocating_container::alloc_grow_size_for,
+///     cache-line aligned cc::allocation, in-place resize first), so a spilled small_vector behaves like a vector
+///   - the heap buffer is a regular cc::allocation<T>: extract_allocation() / extract_vector() hand it
+///     over to cc::vector without copying (inline elements have to be moved into a new allocation)
+///   - inline elements move element-wise, so moving a small_vector is O(size()) while it is inline
+///   - shrink_to_fit() moves the elements back inline if they fit
+///
+/// Constructing from existing elements (e.g. `push_back(v[0])`) is safe during growth.
+/// Any growth that switches buffers invalidates pointers, references, and iterators.
+///
+/// Usage:
+///   struct node { cc::small_vector<u32, 6> neighbors; ... };
+///   n.neighbors.push_back(idx); // no allocation for up to 6 neighbors
+///
+///   cc::vector<u32> all = n.neighbors.extract_vector(); // hands over a heap buffer as is
+template <class T, cc::isize N>
+struct cc::small_vector
+{
+    static_assert(std::is_object_v<T> && !std::is_const_v<T>,
+                  "small_vector elements need to be non-const objects, not references/functions/void");
+    static_assert(N > 0, "small_vector inline capacity must be positive");
+
+    /// Growth policy and allocation alignment shared with cc::vector.
+    using alloc_policy = cc::allocating_container<T, cc::vector<T>>;
+
+    // element access
+public:
+    /// Returns a reference to the element at index i.
+    /// Precondition: 0 <= i < size().
+    [[nodiscard]] T& operator[](isize i)
+    {
+        CC_ASSERT(0 <= i && i < size(), "index out of bounds");
+        return _obj_start[i];
+    }
+    [[nodiscard]] T const& operator[](isize i) const
+    {
+        CC_ASSERT(0 <= i && i < size(), "index out of bounds");
+        return _obj_start[i];
+    }
+
+    /// Returns a reference to the first element.
+    /// Precondition: !empty().
+    [[nodiscard]] T& front()
+    {
+        CC_ASSERT(!empty(), "cannot access front of empty small_vector");
+        return _obj_start[0];
+    }
+    [[nodiscard]] T const& front() const
+    {
+        CC_ASSERT(!empty(), "cannot access front of empty small_vector");
+        return _obj_start[0];
+    }
+
+    /// Returns a reference to the last element.
+    /// Precondition: !empty().
+    [[nodiscard]] T& back()
+    {
+        CC_ASSERT(!empty(), "cannot access back of empty small_vector");
+        return _obj_end[-1];
+    }
+    [[nodiscard]] T const& back() const
+    {
+        CC_ASSERT(!empty(), "cannot access back of empty small_vector");
+        return _obj_end[-1];
+    }
+
+    /// Returns a pointer to the first element (inline or on the heap).
+    [[nodiscard]] T* data() { return _obj_start; }
+    [[nodiscard]] T const* data() const { return _obj_start; }
+
+    // iterators
+public:
+    [[nodiscard]] T* begin() { return _obj_start; }
+    [[nodiscard]] T* end() { return _obj_end; }
+    [[nodiscard]] T const* begin() const { return _obj_start; }
+    [[nodiscard]] T const* end() const { return _obj_end; }
+
+    // queries
+public:
+    /// Returns the number of elements.
+    [[nodiscard]] isize size() const { return _obj_end - _obj_start; }
+    /// Returns the size in bytes of the live elements.
+    [[nodiscard]] isize size_bytes() const { return size() * isize(sizeof(T)); }
+    [[nodiscard]] bool empty() const { return _obj_start == _obj_end; }
+
+    /// True if the elements live in the inline storage (i.e. nothing is allocated).
+    [[nodiscard]] bool is_inline() const { return _obj_start == inline_data(); }
+
+    /// Returns the compile-time inline capacity N.
+    [[nodiscard]] static constexpr isize inline_capacity() { return N; }
+
+    // capacity queries
+public:
+    /// Returns the total capacity (elements that can be stored without reallocation).
+    [[nodiscard]] isize capacity() const { return isize(_alloc_end - (cc::byte*)_obj_start) / isize(sizeof(T)); }
+
+    /// Returns how many more elements fit without reallocation.
+    [[nodiscard]] isize capacity_back() const { return isize(_alloc_end - (cc::byte*)_obj_end) / isize(sizeof(T)); }
+
+    [[nodiscard]] bool has_capacity_back_for(isize count) const
+    {
+        return _alloc_end - (cc::byte*)_obj_end >= count * isize(sizeof(T));
+    }
+
+    // factories
+public:
+    /// Creates a small_vector with "size" many default-constructed elements.
+    [[nodiscard]] static small_vector create_defaulted(isize size, cc::memory_resource const* resource = nullptr)
+    {
+        auto v = small_vector::create_with_resource(resource);
+        v.resize_to_defaulted(size);
+        return v;
+    }
+
+    /// Creates a small_vector with "size" many copies of value.
+    [[nodiscard]] static small_vector create_filled(isize size,
+                                                    T const& value,
+                                                    cc::memory_resource const* resource = nullptr)
+    {
+        auto v = small_vector::create_with_resource(resource);
+        v.resize_to_filled(size, value);
+        return v;
+    }
+
+    /// Creates a small_vector with "size" many uninitialized elements (only for trivial types).
+    [[nodiscard]] static small_vector create_uninitialized(isize size, cc::memory_resource const* resource = nullptr)
+    {
+        auto v = small_vector::create_with_resource(resource);
+        v.resize_to_uninitialized(size);
+        return v;
+    }
+
+    /// Creates a small_vector holding copies of the elements of source.
+    [[nodiscard]] static small_vector create_copy_of(cc::span<T const> source,
+                                                     cc::memory_resource const* resource = nullptr)
+    {
+        auto v = small_vector::create_with_capacity(source.size(), resource);
+        impl::copy_create_objects_to(v._obj_end, source.data(), source.data() + source.size());
+        return v;
+    }
+
+    /// Creates an empty small_vector that can hold at least "capacity" elements without reallocation.
+    /// Allocates only if capacity > N.
+    [[nodiscard]] static small_vector create_with_capacity(isize capacity,
+                                                           cc::memory_resource const* resource = nullptr)
+    {
+        auto v = small_vector::create_with_resource(resource);
+        v.reserve(capacity);
+        return v;
+    }
+
+    /// Creates an empty small_vector that spills into the given memory resource.
+    /// resource can be nullptr, which means the global default allocator will be used.
+    [[nodiscard]] static small_vector create_with_resource(cc::memory_resource const* resource)
+    {
+        small_vector v;
+        v._custom_resource = resource;
+        return v;
+    }
+
+    // appending operations
+public:
+    /// Constructs a new element at the back, spilling to (or growing) the heap if necessary.
+    /// If has_capacity_back_for(1) is true, no invalidation of any kind occurs.
+    /// Amortized O(1) complexity.
+    template <class... Args>
+    T& emplace_back(Args&&... args)
+    {
+        static_assert(
+            requires { T(cc::forward<Args>(args)...); }, "emplace_back: T is not constructible from "
+                                                         "the provided argument types");
+
+        if (this->has_capacity_back_for(1)) [[likely]]
+            return this->emplace_back_stable(cc::forward<Args>(args)...);
+
+        T* p = nullptr;
+        this->grow_and_construct(1,
+                                 [&](T*& dest_end)
+                                 {
+                                     p = new (cc::placement_new, dest_end) T(cc::forward<Args>(args)...);
+                                     ++dest_end;
+                                 });
+        return *p;
+    }
+
+    T& push_back(T const& value) { return this->emplace_back(value); }
+    T& push_back(T&& value) { return this->emplace_back(cc::move(value)); }
+
+    /// Constructs a new element at the back using existing capacity.
+    /// Requires `has_capacity_back_for(1)` to be true; caller must ensure capacity in advance.
+    /// No allocation occurs; pointers, references, and iterators remain valid (stable operation).
+    template <class... Args>
+    T& emplace_back_stable(Args&&... args)
+    {
+        static_assert(
+            requires { T(cc::forward<Args>(args)...); }, "emplace_back_stable: T is not constructible from "
+                                                         "the provided argument types");
+        CC_ASSERT(this->has_capacity_back_for(1), "not enough capacity for emplace_back_stable");
+        auto const p = new (cc::placement_new, _obj_end) T(cc::forward<Args>(args)...);
+        ++_obj_end; // _after_ so exceptions in T(...) leave state valid
+        return *p;
+    }
+
+    T& push_back_stable(T const& value) { return this->emplace_back_stable(value); }
+    T& push_back_stable(T&& value) { return this->emplace_back_stable(cc::move(value)); }
+
+    // single element removal
+public:
+    /// Removes and returns the last element by move.
+    /// Precondition: !empty().
+    [[nodiscard("use remove_back() if you don't need the return value")]] T pop_back()
+    {
+        CC_ASSERT(!empty(), "cannot pop from empty container");
+        auto value = cc::move(back());
+        remove_back();
+        return value;
+    }
+
+    /// Removes the last element.
+    /// Precondition: !empty().
+    void remove_back()
+    {
+        CC_ASSERT(!empty(), "cannot remove from empty container");
+        --_obj_end;
+        _obj_end->~T();
+    }
+
+    /// Removes and returns the element at the given index, preserving order.
+    /// O(n) complexity due to element compaction.
+    [[nodiscard("use remove_at() if you don't need the return value")]] T pop_at(isize idx)
+    {
+        CC_ASSERT(0 <= idx && idx < size(), "index out of bounds");
+        auto value = cc::move(_obj_start[idx]);
+        remove_at(idx);
+        return value;
+    }
+
+    /// Removes the element at the given index, preserving order.
+    /// O(n) complexity due to element compaction (a memmove for trivially copyable T).
+    void remove_at(isize idx)
+    {
+        CC_ASSERT(0 <= idx && idx < size(), "index out of bounds");
+        impl::compact_move_objects_backward(_obj_start + idx, _obj_start + idx + 1, _obj_end);
+        remove_back();
+    }
+
+    /// Removes and returns the element at the given index by moving the last element into its place.
+    /// Does not preserve relative order of elements. O(1).
+    [[nodiscard("use remove_at_unordered() if you don't need the return value")]] T pop_at_unordered(isize idx)
+    {
+        CC_ASSERT(0 <= idx && idx < size(), "index out of bounds");
+        auto value = cc::move(_obj_start[idx]);
+        remove_at_unordered(idx);
+        return value;
+    }
+
+    /// Removes the element at the given index by moving the last element into its place.
+    /// Does not preserve relative order of elements. O(1).
+    void remove_at_unordered(isize idx)
+    {
+        CC_ASSERT(0 <= idx && idx < size(), "index out of bounds");
+        --_obj_end;
+        if (_obj_start + idx != _obj_end)
+            _obj_start[idx] = cc::move(*_obj_end);
+        _obj_end->~T();
+    }
+
+    // range removal
+public:
+    /// Removes [start, start + count) by moving the last count elements into the gap. O(count).
+    void remove_at_range_unordered(isize start, isize count)
+    {
+        CC_ASSERT(0 <= start && 0 <= count && start + count <= size(), "range out of bounds");
+        if (count == 0)
+            return;
+        // the tail may overlap the gap, so only move the part of it that lies behind the gap
+        auto const tail_start = cc::max(start + count, size() - count);
+        impl::compact_move_objects_backward(_obj_start + start, _obj_start + tail_start, _obj_end);
+        resize_down_to(size() - count);
+    }
+
+    /// Removes [start, end) by moving the last elements into the gap. O(end - start).
+    void remove_from_to_unordered(isize start, isize end)
+    {
+        CC_ASSERT(0 <= start && start <= end && end <= size(), "range out of bounds");
+        this->remove_at_range_unordered(start, end - start);
+    }
+
+    /// Removes [start, start + count) while preserving relative order.
+    void remove_at_range(isize start, isize count)
+    {
+        CC_ASSERT(0 <= start && 0 <= count && start + count <= size(), "range out of bounds");
+        if (count == 0)
+            return;
+        impl::compact_move_objects_backward(_obj_start + start, _obj_start + start + count, _obj_end);
+        resize_down_to(size() - count);
+    }
+
+    /// Removes [start, end) while preserving relative order.
+    void remove_from_to(isize start, isize end)
+    {
+        CC_ASSERT(0 <= start && start <= end && end <= size(), "range out of bounds");
+        this->remove_at_range(start, end - start);
+    }
+
+    // predicate-based removal
+public:
+    /// Removes all elements for which the predicate returns true, preserving the order of the others.
+    /// Predicate is invoked as pred(element) or pred(idx, element).
+    /// Returns the number of removed elements.
+    template <class Pred>
+    isize remove_all_where(Pred&& pred)
+    {
+        static_assert(cc::is_invocable_r<bool, Pred, T&> || cc::is_invocable_r<bool, Pred, isize, T&>,
+                      "remove_all_where: predicate must be invocable with T& or (isize, T&) and return bool");
+        return compact_where([&](isize idx, T& e) { return !cc::invoke_with_optional_idx(idx, pred, e); });
+    }
+
+    /// Removes the first element for which the predicate returns true.
+    /// Returns the index of the removed element, or cc::nullopt if no element matched.
+    template <class Pred>
+    cc::optional<isize> remove_first_where(Pred&& pred)
+    {
+        static_assert(cc::is_invocable_r<bool, Pred, T&> || cc::is_invocable_r<bool, Pred, isize, T&>,
+                      "remove_first_where: predicate must be invocable with T& or (isize, T&) and return bool");
+        for (isize i = 0; i < size(); ++i)
+            if (cc::invoke_with_optional_idx(i, pred, _obj_start[i]))
+            {
+                remove_at(i);
+                return i;
+            }
+        return cc::nullopt;
+    }
+
+    /// Removes the last element for which the predicate returns true.
+    /// Returns the index of the removed element, or cc::nullopt if no element matched.
+    template <class Pred>
+    cc::optional<isize> remove_last_where(Pred&& pred)
+    {
+        static_assert(cc::is_invocable_r<bool, Pred, T&> || cc::is_invocable_r<bool, Pred, isize, T&>,
+                      "remove_last_where: predicate must be invocable with T& or (isize, T&) and return bool");
+        for (isize i = size() - 1; i >= 0; --i)
+            if (cc::invoke_with_optional_idx(i, pred, _obj_start[i]))
+            {
+                remove_at(i);
+                return i;
+            }
+        return cc::nullopt;
+    }
+
+    /// Removes all elements equal to value, returns how many were removed.
+    isize remove_all_value(T const& value)
+    {
+        static_assert(requires { bool(value == value); }, "remove_all_value: T must support operator==");
+        return this->remove_all_where([&value](T const& elem) { return elem == value; });
+    }
+
+    /// Removes the first element equal to value, returns its index or cc::nullopt.
+    cc::optional<isize> remove_first_value(T const& value)
+    {
+        static_assert(requires { bool(value == value); }, "remove_first_value: T must support operator==");
+        return this->remove_first_where([&value](T const& elem) { return elem == value; });
+    }
+
+    /// Removes the last element equal to value, returns its index or cc::nullopt.
+    cc::optional<isize> remove_last_value(T const& value)
+    {
+        static_assert(requires { bool(value == value); }, "remove_last_value: T must support operator==");
+        return this->remove_last_where([&value](T const& elem) { return elem == value; });
+    }
+
+    /// Keeps only the elements for which the predicate returns true, preserving their order.
+    /// Returns the number of removed elements.
+    template <class Pred>
+    isize retain_all_where(Pred&& pred)
+    {
+        static_assert(cc::is_invocable_r<bool, Pred, T&> || cc::is_invocable_r<bool, Pred, isize, T&>,
+                      "retain_all_where: predicate must be invocable with T& or (isize, T&) and return bool");
+        return compact_where([&](isize idx, T& e) { return bool(cc::invoke_with_optional_idx(idx, pred, e)); });
+    }
+
+    // resizing operations
+public:
+    /// Shrinks to new_size by destroying trailing elements.
+    /// Precondition: new_size <= size().
+    /// Does not reallocate or change capacity.
+    void resize_down_to(isize new_size)
+    {
+        CC_ASSERT(0 <= new_size && new_size <= size(), "resize_down_to: new_size must be <= size()");
+        impl::destroy_objects_in_reverse(_obj_start + new_size, _obj_end);
+        _obj_end = _obj_start + new_size;
+    }
+
+    /// Resizes to new_size, new elements are constructed as T(args...) (args are not forwarded).
+    /// args may refer to elements of this small_vector.
+    template <class... Args>
+    void resize_to_constructed(isize new_size, Args&&... args)
+    {
+        static_assert(
+            requires { T(args...); }, "resize_to_constructed: T is not constructible from the provided "
+                                      "argument types");
+        CC_ASSERT(new_size >= 0, "new size must be non-negative");
+        if (new_size <= size())
+        {
+            resize_down_to(new_size);
+            return;
+        }
+
+        auto const count = new_size - size();
+        auto const construct = [&](T*& dest_end)
+        {
+            for (isize i = 0; i < count; ++i)
+            {
+                new (cc::placement_new, dest_end) T(args...);
+                ++dest_end;
+            }
+        };
+
+        if (this->has_capacity_back_for(count))
+            construct(_obj_end);
+        else
+            this->grow_and_construct(count, construct);
+    }
+
+    void resize_to_defaulted(isize new_size)
+    {
+        static_assert(std::is_default_constructible_v<T>, "resize_to_defaulted requires T to be default constructible");
+        this->resize_to_constructed(new_size);
+    }
+
+    void resize_to_filled(isize new_size, T const& value)
+    {
+        static_assert(std::is_copy_constructible_v<T>, "resize_to_filled requires T to be copy constructible");
+        this->resize_to_constructed(new_size, value);
+    }
+
+    /// Resizes to new_size, new elements are left uninitialized (trivial types only).
+    void resize_to_uninitialized(isize new_size)
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "resize_to_uninitialized requires T to be trivially copyable");
+        static_assert(std::is_trivially_destructible_v<T>, "resize_to_uninitialized requires T to be trivially "
+                                                           "destructible");
+        CC_ASSERT(new_size >= 0, "new size must be non-negative");
+        this->reserve(new_size);
+        _obj_end = _obj_start + new_size;
+    }
+
+    template <class... Args>
+    void clear_resize_to_constructed(isize new_size, Args&&... args)
+    {
+        this->clear();
+        this->resize_to_constructed(new_size, args...);
+    }
+    void clear_resize_to_defaulted(isize new_size)
+    {
+        this->clear();
+        this->resize_to_defaulted(new_size);
+    }
+    void clear_resize_to_filled(isize new_size, T const& value)
+    {
+        this->clear();
+        this->resize_to_filled(new_size, value);
+    }
+    void clear_resize_to_uninitialized(isize new_size)
+    {
+        this->clear();
+        this->resize_to_uninitialized(new_size);
+    }
+
+    // capacity management
+public:
+    /// Ensures at least `count` elements can be stored without reallocation.
+    /// Uses exponential growth strategy to amortize future reallocations.
+    void reserve(isize count)
+    {
+        if (count > capacity())
+            this->grow_and_construct(count - size(), [](T*&) {});
+    }
+
+    /// Ensures capacity for `count` more elements at the back (exponential growth).
+    void reserve_back(isize count) { this->reserve(size() + count); }
+
+    /// Reduces capacity to match size.
+    /// Moves the elements back into the inline storage if they fit, otherwise shrinks the heap allocation.
+    void shrink_to_fit()
+    {
+        if (is_inline())
+            return;
+
+        auto heap = this->release_heap();
+        if (isize(heap.obj_end - heap.obj_start) <= N)
+        {
+            // heap destroys the moved-from elements and frees the allocation
+            impl::move_create_objects_to(_obj_end, heap.obj_start, heap.obj_end);
+            return;
+        }
+
+        auto const tight_size
+            = cc::align_up((heap.obj_end - heap.obj_start) * isize(sizeof(T)), alloc_policy::alloc_alignment);
+        if (heap.alloc_size_bytes() != tight_size)
+            heap.resize_alloc(tight_size, tight_size, alloc_policy::alloc_alignment);
+        this->adopt_heap(heap);
+    }
+
+    // other mutations
+public:
+    /// Destroys all elements, size becomes 0.
+    /// Keeps the current buffer (including a heap buffer).
+    void clear()
+    {
+        impl::destroy_objects_in_reverse(_obj_start, _obj_end);
+        _obj_end = _obj_start;
+    }
+
+    /// Copies value into every element.
+    void fill(T const& value)
+    {
+        for (auto& e : *this)
+            e = value;
+    }
+
+    // ctors / allocation management
+public:
+    small_vector() = default;
+
+    small_vector(std::initializer_list<T> init, cc::memory_resource const* resource = nullptr)
+      : _custom_resource(resource)
+    {
+        this->reserve(isize(init.size()));
+        impl::copy_create_objects_to(_obj_end, init.begin(), init.end());
+    }
+
+    /// Deep copy, uses inline storage if the elements fit.
+    small_vector(small_vector const& rhs) : _custom_resource(rhs._custom_resource)
+    {
+        this->reserve(rhs.size());
+        impl::copy_create_objects_to(_obj_end, rhs._obj_start, rhs._obj_end);
+    }
+
+    /// Steals a heap buffer, moves inline elements one by one. rhs is empty afterwards.
+    small_vector(small_vector&& rhs) noexcept(std::is_nothrow_move_constructible_v<T>)
+      : _custom_resource(rhs._custom_resource)
+    {
+        this->take_elements_of(rhs);
+    }
+
+    /// Deep copy, keeps the memory resource of *this and reuses the current buffer if it is large enough.
+    small_vector& operator=(small_vector const& rhs)
+    {
+        if (this != &rhs)
+        {
+            this->clear();
+            this->reserve(rhs.size());
+            impl::copy_create_objects_to(_obj_end, rhs._obj_start, rhs._obj_end);
+        }
+        return *this;
+    }
+
+    small_vector& operator=(small_vector&& rhs) noexcept(std::is_nothrow_move_constructible_v<T>)
+    {
+        if (this != &rhs)
+        {
+            // rhs can be owned by one of our elements, and inline elements live inside rhs itself,
+            // so empty rhs into tmp (moving inline elements, stealing a heap buffer) before destroying ours
+            small_vector tmp(cc::move(rhs));
+            this->destroy_and_reset();
+            _custom_resource = tmp._custom_resource;
+            this->take_elements_of(tmp);
+        }
+        return *this;
+    }
+
+    ~small_vector() { this->destroy_and_reset(); }
+
+    /// Extracts the elements as a cc::allocation, leaving *this empty (with inline storage).
+    /// A heap buffer is handed over as is (no copies), inline elements are moved into a new tight allocation.
+    [[nodiscard]] cc::allocation<T> extract_allocation()
+    {
+        if (!is_inline())
+            return this->release_heap();
+
+        auto const byte_size = cc::align_up(size_bytes(), alloc_policy::alloc_alignment);
+        auto result = cc::allocation<T>::create_empty_bytes(byte_size, byte_size, alloc_policy::alloc_alignment,
+                                                            _custom_resource);
+        impl::move_create_objects_to(result.obj_end, _obj_start, _obj_end);
+        this->clear();
+        return result;
+    }
+
+    /// Converts into a cc::vector, see extract_allocation().
+    [[nodiscard]] cc::vector<T> extract_vector()
+    {
+        return cc::vector<T>::create_from_allocation(this->extract_allocation());
+    }
+
+private:
+    [[nodiscard]] T* inline_data() { return reinterpret_cast<T*>(_inline); }
+    [[nodiscard]] T const* inline_data() const { return reinterpret_cast<T const*>(_inline); }
+
+    /// Makes room for `count` more elements and constructs them via construct_new(dest_end),
+    /// which must construct exactly `count` elements at dest_end, incrementing it after each.
+    /// New elements are constructed before the old ones move, so they may be initialized from them.
+    template <class ConstructF>
+    CC_COLD_FUNC void grow_and_construct(isize count, ConstructF&& construct_new)
+    {
+        auto const obj_size = size();
+        auto const new_size_min = alloc_policy::alloc_grow_size_for(capacity() * isize(sizeof(T)),
+                                                                    (obj_size + count) * isize(sizeof(T)));
+        auto const new_size_max = new_size_min + cc::min(new_size_min, alloc_policy::alloc_max_slack);
+
+        // try growing the heap buffer in place first
+        if (!is_inline())
+        {
+            auto heap = this->release_heap();
+            auto const resized = heap.try_resize_alloc_inplace(new_size_min, new_size_max);
+            this->adopt_heap(heap);
+            if (resized)
+            {
+                construct_new(_obj_end);
+                return;
+            }
+        }
+
+        // the new allocation only tracks the new elements until the old ones are moved over (exception safety)
+        auto new_heap = cc::allocation<T>::create_empty_bytes(new_size_min, new_size_max,
+                                                              alloc_policy::alloc_alignment, _custom_resource);
+        new_heap.obj_start += obj_size;
+        new_heap.obj_end = new_heap.obj_start;
+        construct_new(new_heap.obj_end);
+        impl::move_create_objects_to_reverse(new_heap.obj_start, _obj_start, _obj_end);
+
+        this->destroy_and_reset();
+        this->adopt_heap(new_heap);
+    }
+
+    /// Reassembles the heap buffer (with its live elements) as an owning cc::allocation
+    /// and resets *this to empty inline storage.
+    [[nodiscard]] cc::allocation<T> release_heap()
+    {
+        CC_ASSERT(!is_inline(), "no heap buffer to release");
+        cc::allocation<T> heap;
+        heap.obj_start = _obj_start;
+        heap.obj_end = _obj_end;
+        heap.alloc_start = (cc::byte*)_obj_start;
+        heap.alloc_end = _alloc_end;
+        heap.alignment = alloc_policy::alloc_alignment;
+        heap.custom_resource = _custom_resource;
+
+        _obj_start = inline_data();
+        _obj_end = inline_data();
+        _alloc_end = _inline + sizeof(_inline);
+        return heap;
+    }
+
+    /// Takes ownership of the buffer and elements of heap, *this must be empty.
+    void adopt_heap(cc::allocation<T>& heap)
+    {
+        CC_ASSERT(empty(), "adopt_heap would leak elements");
+        CC_ASSERT(heap.obj_start == (T*)heap.alloc_start, "small_vector allocations have no front capacity");
+        CC_ASSERT(heap.alignment == alloc_policy::alloc_alignment, "unexpected allocation alignment");
+        _obj_start = heap.obj_start;
+        _obj_end = heap.obj_end;
+        _alloc_end = heap.alloc_end;
+        heap.obj_start = nullptr;
+        heap.obj_end = nullptr;
+        heap.alloc_start = nullptr;
+        heap.alloc_end = nullptr;
+    }
+
+    /// Destroys all elements and frees the heap buffer, *this is empty inline afterwards.
+    void destroy_and_reset()
+    {
+        if (is_inline())
+            this->clear();
+        else
+            (void)this->release_heap(); // destroys the elements and frees the buffer
+    }
+
+    /// Moves the elements of rhs into *this (empty, inline), rhs is empty afterwards.
+    void take_elements_of(small_vector& rhs)
+    {
+        if (rhs.is_inline())
+        {
+            impl::move_create_objects_to(_obj_end, rhs._obj_start, rhs._obj_end);
+            rhs.clear();
+        }
+        else
+        {
+            auto heap = rhs.release_heap();
+            this->adopt_heap(heap);
+        }
+    }
+
+    // single pass compaction: keeps elements where keep(idx, elem) is true, returns the number removed
+    template <class KeepF>
+    isize compact_where(KeepF&& keep)
+    {
+        auto const p = _obj_start;
+        auto const count = size();
+        isize write = 0;
+        for (isize read = 0; read < count; ++read)
+        {
+            if (!keep(read, p[read]))
+                continue;
+            if (write != read)
+                p[write] = cc::move(p[read]);
+            ++write;
+        }
+        resize_down_to(write);
+        return count - write;
+    }
+
+    T* _obj_start = inline_data();
+    T* _obj_end = inline_data();
+    cc::byte* _alloc_end = _inline + sizeof(_inline);
+    cc::memory_resource const* _custom_resource = nullptr;
+    alignas(T) cc::byte _inline[N * sizeof(T)];
+};
@@ -0,0 +1,501 @@
+#pragma once
+
+#include <clean-core/allocation.hh>
+#include <clean-core/fwd.hh>
+#include <clean-core/impl/object_lifetime_util.hh>
+#include <clean-core/macros.hh>
+#include <clean-core/span.hh>
+#include <clean-core/tuple.hh>
+#include <clean-core/utility.hh>
+
+#include <new>
+#include <type_traits>
+#include <utility> // index_sequence
+
+// TODO:
+// - insert/emplace at arbitrary positions
+// - shrink_to_fit, equality, hashing
+
+namespace cc::impl
+{
+/// Zipped iterator over the rows of a cc::soa_vector.
+/// Dereferences to a tuple of references to the fields of the current row.
+/// Ts are const-qualified for const iteration.
+template <class... Ts>
+struct soa_iterator
+{
+    cc::tuple<Ts*...> columns;
+    isize idx = 0;
+
+    [[nodiscard]] constexpr cc::tuple<Ts&...> operator*() const
+    {
+        return [&]<std::size_t... Is>(std::index_sequence<Is...>)
+        { return cc::tuple<Ts&...>(columns.template get<Is>()[idx]...); }(std::index_sequence_for<Ts...>{});
+    }
+
+    constexpr soa_iterator& operator++()
+    {
+        ++idx;
+        return *this;
+    }
+
+    [[nodiscard]] constexpr bool operator==(soa_iterator const& rhs) const { return idx == rhs.idx; }
+};
+} // namespace cc::impl
+
+/// Structure-of-arrays container: a growable sequence of rows (Ts...) where each field lives in its own
+/// contiguous column, so kernels that touch only some fields stream only those bytes.
+///
+/// Performance design:
+///   - all columns share a single cc::allocation, one block per column, each starting at column_alignment
+///     (at least a cache line): column spans are SIMD-aligned and columns never share a cache line
+///   - columns grow together (exponentially), a growth is one allocation and one move per column
+///   - column<I>() returns a plain cc::span<T> for per-field kernels, the hot loops never see the other columns
+///   - iteration is zipped: it yields cc::tuple<Ts&...> rows that support structured bindings
+///   - remove_all_where / remove_at_unordered compact all columns in the same pass
+///   - growth, copies and remove_at use memcpy / memmove for trivially copyable columns
+///
+/// Field types must be nothrow move constructible.
+/// If a field constructor may throw, emplace_back builds the row as a cc::tuple<Ts...> first,
+/// so a failing construction never leaves a partially constructed row behind.
+/// Any growth invalidates spans, pointers, references, and iterators.
+///
+/// Usage:
+///   cc::soa_vector<vec3, vec3, f32> particles; // position, velocity, lifetime
+///   particles.push_back(pos, vel, 2.f);
+///
+///   // per-field kernels
+///   for (auto& t : particles.column<2>())
+///       t -= dt;
+///
+///   // zipped iteration
+///   for (auto [p, v, t] : particles)
+///       p += v * dt;
+///
+///   particles.remove_all_where([](vec3 const&, vec3 const&, f32 t) { return t <= 0; });
+template <class... Ts>
+struct cc::soa_vector
+{
+    static_assert(sizeof...(Ts) > 0, "soa_vector needs at least one column");
+    static_assert(((std::is_object_v<Ts> && !std::is_const_v<Ts>) && ...), "columns must be non-const object types");
+    static_assert((std::is_nothrow_move_constructible_v<Ts> && ...), "columns must be nothrow move constructible");
+
+    /// Type of the fields in the I-th column.
+    template <isize I>
+    using column_t = impl::tuple_element_t<I, Ts...>;
+
+    /// One row as references to its fields.
+    using reference = cc::tuple<Ts&...>;
+    using const_reference = cc::tuple<Ts const&...>;
+
+    using iterator = impl::soa_iterator<Ts...>;
+    using const_iterator = impl::soa_iterator<Ts const...>;
+
+    /// Alignment of the first element of every column.
+    static constexpr isize column_alignment = []
+    {
+        auto a = isize(std::hardware_destructive_interference_size);
+        ((a = cc::max(a, isize(alignof(Ts)))), ...);
+        return a;
+    }();
+
+    // queries
+public:
+    /// Returns the number of columns (fields per row).
+    [[nodiscard]] static constexpr isize column_count() { return sizeof...(Ts); }
+
+    /// Returns the number of rows.
+    [[nodiscard]] isize size() const { return _size; }
+    [[nodiscard]] bool empty() const { return _size == 0; }
+
+    /// Returns the number of rows that fit without growing.
+    [[nodiscard]] isize capacity() const { return _capacity; }
+
+    /// Returns the memory resource used for the allocation (nullptr for the default resource).
+    [[nodiscard]] cc::memory_resource const* resource() const { return _alloc.custom_resource; }
+
+    // access
+public:
+    /// Returns the I-th column as a contiguous span of size() fields.
+    /// The span is invalidated by any growth.
+    template <isize I>
+    [[nodiscard]] cc::span<column_t<I>> column()
+    {
+        return cc::span<column_t<I>>(this->template column_ptr<I>(), _size);
+    }
+    template <isize I>
+    [[nodiscard]] cc::span<column_t<I> const> column() const
+    {
+        return cc::span<column_t<I> const>(this->template column_ptr<I>(), _size);
+    }
+
+    /// Returns references to the fields of row idx.
+    /// Precondition: 0 <= idx < size().
+    [[nodiscard]] reference operator[](isize idx)
+    {
+        CC_ASSERT(0 <= idx && idx < _size, "index out of bounds");
+        return this->row_at(idx, indices{});
+    }
+    [[nodiscard]] const_reference operator[](isize idx) const
+    {
+        CC_ASSERT(0 <= idx && idx < _size, "index out of bounds");
+        return this->row_at(idx, indices{});
+    }
+
+    /// Returns references to the fields of the last row.
+    /// Precondition: !empty().
+    [[nodiscard]] reference back()
+    {
+        CC_ASSERT(_size > 0, "back() on empty soa_vector");
+        return this->row_at(_size - 1, indices{});
+    }
+    [[nodiscard]] const_reference back() const
+    {
+        CC_ASSERT(_size > 0, "back() on empty soa_vector");
+        return this->row_at(_size - 1, indices{});
+    }
+
+    // iteration
+public:
+    /// Zipped iteration over all rows, e.g. `for (auto [pos, vel] : v)`.
+    [[nodiscard]] iterator begin() { return {_columns, 0}; }
+    [[nodiscard]] iterator end() { return {_columns, _size}; }
+    [[nodiscard]] const_iterator begin() const { return {this->const_columns(indices{}), 0}; }
+    [[nodiscard]] const_iterator end() const { return {this->const_columns(indices{}), _size}; }
+
+    // push / emplace
+public:
+    /// Appends a row constructed from one argument per column and returns references to it.
+    /// Arguments may refer to existing rows, even if the columns grow.
+    template <class... Args>
+    reference emplace_back(Args&&... args)
+    {
+        static_assert(sizeof...(Args) == sizeof...(Ts), "emplace_back takes one argument per column");
+        static_assert((std::is_constructible_v<Ts, Args&&> && ...), "columns not constructible from arguments");
+
+        if (_size == _capacity) [[unlikely]]
+            this->grow_and_construct(this->grow_capacity_for(_size + 1), [&](cc::tuple<Ts*...> const& columns)
+                                     { construct_row_at(columns, _size, cc::forward<Args>(args)...); });
+        else
+            construct_row_at(_columns, _size, cc::forward<Args>(args)...);
+
+        ++_size;
+        return this->row_at(_size - 1, indices{});
+    }
+
+    /// Appends a row with copies of the given fields and returns references to it.
+    reference push_back(Ts const&... values) { return this->emplace_back(values...); }
+
+    /// Makes sure that at least `count` rows fit without growing.
+    void reserve(isize count)
+    {
+        if (count > _capacity)
+            this->grow_and_construct(count, [](cc::tuple<Ts*...> const&) {});
+    }
+
+    /// Grows to new_size rows with value-initialized fields (zero for trivial types).
+    /// Precondition: new_size >= size().
+    void resize_to_defaulted(isize new_size)
+    {
+        CC_ASSERT(new_size >= _size, "resize_to_defaulted cannot shrink, use resize_down_to()");
+        this->reserve(new_size);
+        for (; _size < new_size; ++_size)
+            construct_row_at(_columns, _size);
+    }
+
+    // removal
+public:
+    /// Removes the last row.
+    /// Precondition: !empty().
+    void remove_back()
+    {
+        CC_ASSERT(_size > 0, "remove_back() on empty soa_vector");
+        --_size;
+        [&]<std::size_t... Is>(std::index_sequence<Is...>)
+        { (this->template column_ptr<Is>()[_size].~Ts(), ...); }(indices{});
+    }
+
+    /// Removes row idx and moves the following rows one to the front, preserving order.
+    /// Precondition: 0 <= idx < size().
+    /// O(size() - idx) per column.
+    void remove_at(isize idx)
+    {
+        CC_ASSERT(0 <= idx && idx < _size, "index out of bounds");
+        [&]<std::size_t... Is>(std::index_sequence<Is...>)
+        {
+            (impl::compact_move_objects_backward(this->template column_ptr<Is>() + idx,
+                                                 this->template column_ptr<Is>() + idx + 1,
+                                                 this->template column_ptr<Is>() + _size),
+             ...);
+        }(indices{});
+        this->remove_back();
+    }
+
+    /// Removes row idx by moving the last row into it, all columns at once.
+    /// Does not preserve the order of rows (hence _unordered suffix).
+    /// Precondition: 0 <= idx < size().
+    /// O(1) complexity.
+    void remove_at_unordered(isize idx)
+    {
+        CC_ASSERT(0 <= idx && idx < _size, "index out of bounds");
+        auto const last = _size - 1;
+        if (idx != last)
+            [&]<std::size_t... Is>(std::index_sequence<Is...>)
+            {
+                ((this->template column_ptr<Is>()[idx] = cc::move(this->template column_ptr<Is>()[last])), ...);
+            }(indices{});
+        this->remove_back();
+    }
+
+    /// Removes all rows for which the predicate returns true and returns the number of removed rows.
+    /// Predicate is invoked as pred(fields...) or pred(idx, fields...) with one reference per column.
+    /// Preserves the order of surviving rows.
+    /// Single pass over all columns: surviving rows are moved forward field by field as they are found.
+    template <class Pred>
+    isize remove_all_where(Pred&& pred)
+    {
+        static_assert(cc::is_invocable_r<bool, Pred, Ts&...> || cc::is_invocable_r<bool, Pred, isize, Ts&...>,
+                      "remove_all_where: predicate must be invocable with (Ts&...) or (isize, Ts&...) and return bool");
+
+        return [&]<std::size_t... Is>(std::index_sequence<Is...>)
+        {
+            auto const columns = cc::tuple<Ts*...>(this->template column_ptr<Is>()...);
+            auto const size = _size;
+            isize write = 0;
+            for (isize read = 0; read < size; ++read)
+            {
+                if (cc::invoke_with_optional_idx(read, pred, columns.template get<Is>()[read]...))
+                    continue;
+
+                if (write != read)
+                    ((columns.template get<Is>()[write] = cc::move(columns.template get<Is>()[read])), ...);
+                ++write;
+            }
+
+            auto const removed = size - write;
+            this->resize_down_to(write);
+            return removed;
+        }(indices{});
+    }
+
+    /// Destroys the trailing rows so that new_size rows remain.
+    /// Precondition: 0 <= new_size <= size().
+    void resize_down_to(isize new_size)
+    {
+        CC_ASSERT(0 <= new_size && new_size <= _size, "resize_down_to cannot grow");
+        [&]<std::size_t... Is>(std::index_sequence<Is...>)
+        {
+            (impl::destroy_objects_in_reverse(this->template column_ptr<Is>() + new_size,
+                                              this->template column_ptr<Is>() + _size),
+             ...);
+        }(indices{});
+        _size = new_size;
+    }
+
+    /// Destroys all rows, keeps the capacity.
+    void clear() { this->resize_down_to(0); }
+
+    // ctors
+public:
+    soa_vector() = default;
+    ~soa_vector() { this->clear(); }
+
+    /// Creates an empty soa_vector that allocates from the given memory resource.
+    [[nodiscard]] static soa_vector create_with_resource(cc::memory_resource const* resource)
+    {
+        soa_vector v;
+        v._alloc.custom_resource = resource;
+        return v;
+    }
+
+    /// Creates an empty soa_vector with room for `capacity` rows.
+    [[nodiscard]] static soa_vector create_with_capacity(isize capacity, cc::memory_resource const* resource = nullptr)
+    {
+        auto v = soa_vector::create_with_resource(resource);
+        v.reserve(capacity);
+        return v;
+    }
+
+    soa_vector(soa_vector&& rhs) noexcept
+      : _alloc(cc::move(rhs._alloc)), _columns(rhs._columns), _size(rhs._size), _capacity(rhs._capacity)
+    {
+        rhs.reset_storage();
+    }
+    soa_vector& operator=(soa_vector&& rhs) noexcept
+    {
+        if (this != &rhs)
+        {
+            // rhs can be owned by one of our rows or even live inside our column block,
+            // so all of its storage is read into locals before our rows and block are released
+            auto new_alloc = cc::move(rhs._alloc);
+            auto const new_columns = rhs._columns;
+            auto const new_size = rhs._size;
+            auto const new_capacity = rhs._capacity;
+            rhs.reset_storage();
+
+            // destroys our rows, the move assignment of _alloc then frees the old storage
+            this->clear();
+            _alloc = cc::move(new_alloc);
+            _columns = new_columns;
+            _size = new_size;
+            _capacity = new_capacity;
+        }
+        return *this;
+    }
+
+    // deep copy with a tight allocation
+    soa_vector(soa_vector const& rhs)
+    {
+        _alloc.custom_resource = rhs._alloc.custom_resource;
+        this->reserve(rhs._size);
+        [&]<std::size_t... Is>(std::index_sequence<Is...>)
+        {
+            if constexpr ((std::is_nothrow_copy_constructible_v<Ts> && ...))
+            {
+                (((void)[&]
+                  {
+                      auto dest_end = this->template column_ptr<Is>();
+                      impl::copy_create_objects_to(dest_end, rhs.template column_ptr<Is>(),
+                                                   rhs.template column_ptr<Is>() + rhs._size);
+                  }()),
+                 ...);
+                _size = rhs._size;
+            }
+            else
+            {
+                // row by row, so a throwing copy leaves only complete rows behind
+                for (; _size < rhs._size; ++_size)
+                    construct_row_at(_columns, _size, rhs.template column_ptr<Is>()[_size]...);
+            }
+        }(indices{});
+    }
+    soa_vector& operator=(soa_vector const& rhs)
+    {
+        if (this != &rhs)
+            *this = soa_vector(rhs);
+        return *this;
+    }
+
+private:
+    using indices = std::index_sequence_for<Ts...>;
+
+    cc::allocation<cc::byte> _alloc; // owns the bytes of all columns, its live range stays empty
+    cc::tuple<Ts*...> _columns = {};
+    isize _size = 0;
+    isize _capacity = 0;
+
+    template <std::size_t I>
+    [[nodiscard]] auto* column_ptr() const
+    {
+        return _columns.template get<I>();
+    }
+
+    template <std::size_t... Is>
+    [[nodiscard]] reference row_at(isize idx, std::index_sequence<Is...>)
+    {
+        return reference(this->template column_ptr<Is>()[idx]...);
+    }
+    template <std::size_t... Is>
+    [[nodiscard]] const_reference row_at(isize idx, std::index_sequence<Is...>) const
+    {
+        return const_reference(this->template column_ptr<Is>()[idx]...);
+    }
+
+    template <std::size_t... Is>
+    [[nodiscard]] cc::tuple<Ts const*...> const_columns(std::index_sequence<Is...>) const
+    {
+        return cc::tuple<Ts const*...>(this->template column_ptr<Is>()...);
+    }
+
+    /// Bytes needed for `capacity` rows: one block per column, each rounded up to column_alignment.
+    [[nodiscard]] static isize bytes_for(isize capacity)
+    {
+        return (isize(0) + ... + cc::align_up(capacity * isize(sizeof(Ts)), column_alignment));
+    }
+
+    /// Column pointers for `capacity` rows in the block starting at base (see bytes_for).
+    [[nodiscard]] static cc::tuple<Ts*...> columns_in(cc::byte* base, isize capacity)
+    {
+        isize offset = 0;
+        auto const next = [&]<class T>(T*)
+        {
+            auto const p = reinterpret_cast<T*>(base + offset);
+            offset += cc::align_up(capacity * isize(sizeof(T)), column_alignment);
+            return p;
+        };
+        // braced initialization evaluates in order, so the columns are laid out in declaration order
+        return cc::tuple<Ts*...>{next((Ts*)nullptr)...};
+    }
+
+    [[nodiscard]] isize grow_capacity_for(isize min_capacity) const
+    {
+        return cc::max(min_capacity, cc::max(_capacity * 2, isize(8)));
+    }
+
+    /// Constructs the fields of row idx in the given columns from one argument per column
+    /// (value-initialized without arguments).
+    /// Either all fields are constructed or none: if any field constructor may throw,
+    /// the row is first built as a tuple and then moved into the columns.
+    template <class... Args>
+    static void construct_row_at(cc::tuple<Ts*...> const& columns, isize idx, Args&&... args)
+    {
+        [&]<std::size_t... Is>(std::index_sequence<Is...>)
+        {
+            if constexpr (sizeof...(Args) == 0)
+            {
+                if constexpr ((std::is_nothrow_default_constructible_v<Ts> && ...))
+                    (new (cc::placement_new, columns.template get<Is>() + idx) Ts(), ...);
+                else
+                {
+                    cc::tuple<Ts...> row = {};
+                    (new (cc::placement_new, columns.template get<Is>() + idx) Ts(cc::move(row.template get<Is>())),
+                     ...);
+                }
+            }
+            else if constexpr ((std::is_nothrow_constructible_v<Ts, Args&&> && ...))
+                (new (cc::placement_new, columns.template get<Is>() + idx) Ts(cc::forward<Args>(args)), ...);
+            else
+            {
+                cc::tuple<Ts...> row(cc::forward<Args>(args)...);
+                (new (cc::placement_new, columns.template get<Is>() + idx) Ts(cc::move(row.template get<Is>())), ...);
+            }
+        }(indices{});
+    }
+
+    /// Moves all rows into a new allocation for new_capacity rows.
+    /// construct_new(columns) is called first to construct new rows in the new columns,
+    /// so new rows may be initialized from existing ones.
+    template <class ConstructF>
+    CC_COLD_FUNC void grow_and_construct(isize new_capacity, ConstructF&& construct_new)
+    {
+        auto const byte_size = bytes_for(new_capacity);
+        auto new_alloc = cc::allocation<cc::byte>::create_empty_bytes(byte_size, byte_size, column_alignment,
+                                                                      _alloc.custom_resource);
+        auto const new_columns = columns_in(new_alloc.alloc_start, new_capacity);
+        construct_new(new_columns);
+
+        [&]<std::size_t... Is>(std::index_sequence<Is...>)
+        {
+            (((void)[&]
+              {
+                  auto const src = this->template column_ptr<Is>();
+                  auto dest_end = new_columns.template get<Is>();
+                  impl::move_create_objects_to(dest_end, src, src + _size);
+                  impl::destroy_objects_in_reverse(src, src + _size);
+              }()),
+             ...);
+        }(indices{});
+
+        _alloc = cc::move(new_alloc);
+        _columns = new_columns;
+        _capacity = new_capacity;
+    }
+
+    /// Forgets the storage after it was moved out (keeps no rows, no allocation).
+    void reset_storage()
+    {
+        _columns = {};
+        _size = 0;
+        _capacity = 0;
+    }
+};
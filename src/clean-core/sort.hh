@@ -0,0 +1,909 @@
+#pragma once
+
+#include <clean-core/allocation.hh>
+#include <clean-core/bit.hh>
+#include <clean-core/fwd.hh>
+#include <clean-core/impl/object_lifetime_util.hh>
+#include <clean-core/macros.hh>
+#include <clean-core/utility.hh>
+
+#include <concepts>
+#include <cstring>
+#include <type_traits>
+#include <utility> // index_sequence
+
+// =========================================================================================================
+// Sorting
+// =========================================================================================================
+//
+// All functions sort contiguous ranges in place: cc::span, cc::vector, cc::array, ...
+// (anything with data() and size()).
+//
+// Unstable comparison sort:
+//   sort(range)                         - ascending by <, pattern-defeating quicksort
+//   sort(range, less)                   - by a strict weak ordering less(a, b)
+//   sort_by_key(range, key)             - ascending by key(element) < key(other)
+//
+// Stable comparison sort:
+//   stable_sort(range)                  - ascending by <, merge sort, equal elements keep their order
+//   stable_sort(range, less, resource)  - scratch buffer of size() / 2 elements from resource
+//
+// Radix sort (stable, O(n) for integer and floating point keys, trivially copyable elements):
+//   radix_sort(range)                   - elements are the keys
+//   radix_sort_by_key(range, key)       - key(element) returns an integer or floating point key
+//
+// Queries:
+//   is_sorted(range)                    - true if no element is less than its predecessor
+//   is_sorted(range, less)
+
+namespace cc::impl
+{
+template <class Range>
+concept sort_range = requires(Range& r) {
+    { r.size() } -> std::convertible_to<isize>;
+} && std::is_pointer_v<decltype(std::declval<Range&>().data())>;
+
+template <class Range>
+using sort_element_t = std::remove_pointer_t<decltype(std::declval<Range&>().data())>;
+
+struct sort_default_less
+{
+    template <class T>
+    [[nodiscard]] CC_FORCE_INLINE constexpr bool operator()(T const& a, T const& b) const
+    {
+        return a < b;
+    }
+};
+
+// pdqsort tuning, see Orson Peters, "Pattern-defeating Quicksort" (2021)
+constexpr isize sort_insertion_threshold = 24; // insertion sort below this size
+constexpr isize sort_ninther_threshold = 128;  // pseudomedian of nine above this size, median of three below
+constexpr isize sort_partial_insertion_limit = 8; // moves allowed before giving up on an almost sorted range
+constexpr isize sort_block_size = 64;             // elements per block in branchless partitioning
+constexpr isize sort_branchless_threshold = 128;  // smaller ranges partition faster with branches
+
+// =========================================================================================================
+// Sorting networks
+// =========================================================================================================
+
+/// Compare-exchange: afterwards !less(b, a).
+/// The branchless variant selects via conditional moves, so random input does not cause mispredictions.
+template <bool Branchless, class T, class Less>
+CC_FORCE_INLINE void sort_compare_exchange(T& a, T& b, Less& less)
+{
+    if constexpr (Branchless)
+    {
+        T const x = a;
+        T const y = b;
+        bool const swapped = less(y, x);
+        a = swapped ? y : x;
+        b = swapped ? x : y;
+    }
+    else if (less(b, a))
+        cc::swap(a, b);
+}
+
+struct sort_network_pair
+{
+    u8 a;
+    u8 b;
+};
+
+// size-optimal networks for 2 to 8 elements (Knuth, TAOCP Vol. 3, 5.3.4)
+constexpr sort_network_pair sort_network_2[] = {{0, 1}};
+constexpr sort_network_pair sort_network_3[] = {{1, 2}, {0, 2}, {0, 1}};
+constexpr sort_network_pair sort_network_4[] = {{0, 1}, {2, 3}, {0, 2}, {1, 3}, {1, 2}};
+constexpr sort_network_pair sort_network_5[]
+    = {{0, 1}, {3, 4}, {2, 4}, {2, 3}, {0, 3}, {0, 2}, {1, 4}, {1, 3}, {1, 2}};
+constexpr sort_network_pair sort_network_6[]
+    = {{1, 2}, {4, 5}, {0, 2}, {3, 5}, {0, 1}, {3, 4}, {2, 5}, {0, 3}, {1, 4}, {2, 4}, {1, 3}, {2, 3}};
+constexpr sort_network_pair sort_network_7[] = {{1, 2}, {3, 4}, {5, 6}, {0, 2}, {3, 5}, {4, 6}, {0, 1}, {4, 5},
+                                                {2, 6}, {0, 4}, {1, 5}, {0, 3}, {2, 5}, {1, 3}, {2, 4}, {2, 3}};
+constexpr sort_network_pair sort_network_8[]
+    = {{0, 2}, {1, 3}, {4, 6}, {5, 7}, {0, 4}, {1, 5}, {2, 6}, {3, 7}, {0, 1}, {2, 3},
+       {4, 5}, {6, 7}, {2, 4}, {3, 5}, {1, 4}, {3, 6}, {1, 2}, {3, 4}, {5, 6}};
+
+// fully unrolled at compile time, every comparison is independent of the data
+template <auto const& Network, class T, class Less>
+CC_FORCE_INLINE void sort_network(T* data, Less& less)
+{
+    [&]<std::size_t... Is>(std::index_sequence<Is...>)
+    {
+        (impl::sort_compare_exchange<true>(data[Network[Is].a], data[Network[Is].b], less), ...);
+    }(std::make_index_sequence<sizeof(Network) / sizeof(Network[0])>{});
+}
+
+/// Sorts up to 8 elements with a sorting network, returns false for larger n.
+template <class T, class Less>
+bool sort_tiny(T* data, isize n, Less& less)
+{
+    switch (n)
+    {
+    case 0:
+    case 1: return true;
+    case 2: impl::sort_network<sort_network_2>(data, less); return true;
+    case 3: impl::sort_network<sort_network_3>(data, less); return true;
+    case 4: impl::sort_network<sort_network_4>(data, less); return true;
+    case 5: impl::sort_network<sort_network_5>(data, less); return true;
+    case 6: impl::sort_network<sort_network_6>(data, less); return true;
+    case 7: impl::sort_network<sort_network_7>(data, less); return true;
+    case 8: impl::sort_network<sort_network_8>(data, less); return true;
+    default: return false;
+    }
+}
+
+// =========================================================================================================
+// Insertion and heap sort
+// =========================================================================================================
+
+/// Stable insertion sort of [begin, end).
+template <class T, class Less>
+void sort_insertion(T* begin, T* end, Less& less)
+{
+    if (begin == end)
+        return;
+
+    for (auto cur = begin + 1; cur != end; ++cur)
+    {
+        if (!less(*cur, cur[-1]))
+            continue;
+
+        T tmp = cc::move(*cur);
+        auto sift = cur;
+        do
+        {
+            *sift = cc::move(sift[-1]);
+            --sift;
+        } while (sift != begin && less(tmp, sift[-1]));
+        *sift = cc::move(tmp);
+    }
+}
+
+/// Insertion sort without the lower bound check, begin[-1] must not be greater than any element in [begin, end).
+template <class T, class Less>
+void sort_insertion_unguarded(T* begin, T* end, Less& less)
+{
+    if (begin == end)
+        return;
+
+    for (auto cur = begin + 1; cur != end; ++cur)
+    {
+        if (!less(*cur, cur[-1]))
+            continue;
+
+        T tmp = cc::move(*cur);
+        auto sift = cur;
+        do
+        {
+            *sift = cc::move(sift[-1]);
+            --sift;
+        } while (less(tmp, sift[-1]));
+        *sift = cc::move(tmp);
+    }
+}
+
+/// Insertion sort that gives up after sort_partial_insertion_limit moves.
+/// Returns true if [begin, end) is sorted afterwards.
+template <class T, class Less>
+bool sort_insertion_partial(T* begin, T* end, Less& less)
+{
+    if (begin == end)
+        return true;
+
+    isize moves = 0;
+    for (auto cur = begin + 1; cur != end; ++cur)
+    {
+        if (less(*cur, cur[-1]))
+        {
+            T tmp = cc::move(*cur);
+            auto sift = cur;
+            do
+            {
+                *sift = cc::move(sift[-1]);
+                --sift;
+            } while (sift != begin && less(tmp, sift[-1]));
+            *sift = cc::move(tmp);
+            moves += cur - sift;
+        }
+
+        if (moves > sort_partial_insertion_limit)
+            return false;
+    }
+    return true;
+}
+
+template <class T, class Less>
+void sort_sift_down(T* data, isize idx, isize n, Less& less)
+{
+    while (true)
+    {
+        auto child = 2 * idx + 1;
+        if (child >= n)
+            return;
+        if (child + 1 < n && less(data[child], data[child + 1]))
+            ++child;
+        if (!less(data[idx], data[child]))
+            return;
+        cc::swap(data[idx], data[child]);
+        idx = child;
+    }
+}
+
+/// O(n log n) worst case fallback when quicksort keeps picking bad pivots.
+template <class T, class Less>
+void sort_heap(T* data, isize n, Less& less)
+{
+    for (auto i = n / 2; i-- > 0;)
+        impl::sort_sift_down(data, i, n, less);
+    for (auto end = n; end-- > 1;)
+    {
+        cc::swap(data[0], data[end]);
+        impl::sort_sift_down(data, 0, end, less);
+    }
+}
+
+// =========================================================================================================
+// Pattern-defeating quicksort
+// =========================================================================================================
+
+template <class T, class Less>
+CC_FORCE_INLINE void sort3(T* a, T* b, T* c, Less& less)
+{
+    impl::sort_compare_exchange<false>(*a, *b, less);
+    impl::sort_compare_exchange<false>(*b, *c, less);
+    impl::sort_compare_exchange<false>(*a, *b, less);
+}
+
+template <class T>
+struct sort_partition_result
+{
+    T* pivot;
+    bool was_partitioned; // no element had to be swapped
+};
+
+/// Partitions [begin, end) around the pivot *begin: elements less than the pivot go to the left.
+/// Elements equal to the pivot go to the right.
+/// Requires a median-of-3 pivot selection, so that the scans are bounded without range checks.
+template <class T, class Less>
+sort_partition_result<T> sort_partition_right(T* begin, T* end, Less& less)
+{
+    T pivot = cc::move(*begin);
+    auto first = begin;
+    auto last = end;
+
+    // find the first element >= pivot (exists because of the median of 3)
+    while (less(*++first, pivot))
+    {
+    }
+
+    // find the last element < pivot, guarded if no element was skipped on the left
+    if (first - 1 == begin)
+        while (first < last && !less(*--last, pivot))
+        {
+        }
+    else
+        while (!less(*--last, pivot))
+        {
+        }
+
+    auto const was_partitioned = first >= last;
+    while (first < last)
+    {
+        cc::swap(*first, *last);
+        while (less(*++first, pivot))
+        {
+        }
+        while (!less(*--last, pivot))
+        {
+        }
+    }
+
+    auto const pivot_pos = first - 1;
+    *begin = cc::move(*pivot_pos);
+    *pivot_pos = cc::move(pivot);
+    return {pivot_pos, was_partitioned};
+}
+
+/// Moves the elements at first + offsets_l[i] and last - offsets_r[i] to the other side.
+/// use_swaps keeps the number of moves linear for descending inputs, otherwise a cyclic permutation saves moves.
+template <class T>
+CC_FORCE_INLINE void sort_swap_offsets(T* first,
+                                       T* last,
+                                       u8 const* offsets_l,
+                                       u8 const* offsets_r,
+                                       isize num,
+                                       bool use_swaps)
+{
+    if (use_swaps)
+    {
+        for (isize i = 0; i < num; ++i)
+            cc::swap(first[offsets_l[i]], *(last - offsets_r[i]));
+    }
+    else if (num > 0)
+    {
+        auto l = first + offsets_l[0];
+        auto r = last - offsets_r[0];
+        T tmp = cc::move(*l);
+        *l = cc::move(*r);
+        for (isize i = 1; i < num; ++i)
+        {
+            l = first + offsets_l[i];
+            *r = cc::move(*l);
+            r = last - offsets_r[i];
+            *l = cc::move(*r);
+        }
+        *r = cc::move(tmp);
+    }
+}
+
+/// Same contract as sort_partition_right, but comparisons only write offsets into small buffers
+/// and never decide a branch (BlockQuicksort, Edelkamp and Weiss 2016).
+/// The elements on the wrong side are then swapped in bulk.
+template <class T, class Less>
+sort_partition_result<T> sort_partition_right_branchless(T* begin, T* end, Less& less)
+{
+    T pivot = cc::move(*begin);
+    auto first = begin;
+    auto last = end;
+
+    while (less(*++first, pivot))
+    {
+    }
+
+    if (first - 1 == begin)
+        while (first < last && !less(*--last, pivot))
+        {
+        }
+    else
+        while (!less(*--last, pivot))
+        {
+        }
+
+    auto const was_partitioned = first >= last;
+    if (!was_partitioned)
+    {
+        cc::swap(*first, *last);
+        ++first;
+
+        alignas(64) u8 offsets_l[sort_block_size];
+        alignas(64) u8 offsets_r[sort_block_size];
+
+        auto offsets_l_base = first;
+        auto offsets_r_base = last;
+        isize num_l = 0;
+        isize num_r = 0;
+        isize start_l = 0;
+        isize start_r = 0;
+
+        while (first < last)
+        {
+            // refill the empty offset blocks from the unknown range [first, last)
+            auto const num_unknown = isize(last - first);
+            auto const left_split = num_l == 0 ? (num_r == 0 ? num_unknown / 2 : num_unknown) : 0;
+            auto const right_split = num_r == 0 ? num_unknown - left_split : 0;
+
+            // elements >= pivot on the left are on the wrong side
+            auto const left_count = cc::min(left_split, sort_block_size);
+            for (isize i = 0; i < left_count; ++i)
+            {
+                offsets_l[num_l] = u8(i);
+                num_l += !less(*first, pivot);
+                ++first;
+            }
+
+            // elements < pivot on the right are on the wrong side
+            auto const right_count = cc::min(right_split, sort_block_size);
+            for (isize i = 0; i < right_count;)
+            {
+                offsets_r[num_r] = u8(++i);
+                num_r += less(*--last, pivot);
+            }
+
+            auto const num = cc::min(num_l, num_r);
+            impl::sort_swap_offsets(offsets_l_base, offsets_r_base, offsets_l + start_l, offsets_r + start_r, num,
+                                    num_l == num_r);
+            num_l -= num;
+            num_r -= num;
+            start_l += num;
+            start_r += num;
+
+            if (num_l == 0)
+            {
+                start_l = 0;
+                offsets_l_base = first;
+            }
+            if (num_r == 0)
+            {
+                start_r = 0;
+                offsets_r_base = last;
+            }
+        }
+
+        // one side may still have misplaced elements, move them to the boundary
+        if (num_l > 0)
+        {
+            while (num_l-- > 0)
+                cc::swap(offsets_l_base[offsets_l[start_l + num_l]], *--last);
+            first = last;
+        }
+        if (num_r > 0)
+        {
+            while (num_r-- > 0)
+            {
+                cc::swap(*(offsets_r_base - offsets_r[start_r + num_r]), *first);
+                ++first;
+            }
+            last = first;
+        }
+    }
+
+    auto const pivot_pos = first - 1;
+    *begin = cc::move(*pivot_pos);
+    *pivot_pos = cc::move(pivot);
+    return {pivot_pos, was_partitioned};
+}
+
+/// Partitions [begin, end) around the pivot *begin, elements equal to the pivot go to the left.
+/// Used when the pivot equals the element before the range: then no element is less than the pivot,
+/// and all elements equal to it are done after this pass (linear time for many duplicates).
+template <class T, class Less>
+T* sort_partition_left(T* begin, T* end, Less& less)
+{
+    T pivot = cc::move(*begin);
+    auto first = begin;
+    auto last = end;
+
+    while (less(pivot, *--last))
+    {
+    }
+
+    if (last + 1 == end)
+        while (first < last && !less(pivot, *++first))
+        {
+        }
+    else
+        while (!less(pivot, *++first))
+        {
+        }
+
+    while (first < last)
+    {
+        cc::swap(*first, *last);
+        while (less(pivot, *--last))
+        {
+        }
+        while (!less(pivot, *++first))
+        {
+        }
+    }
+
+    auto const pivot_pos = last;
+    *begin = cc::move(*pivot_pos);
+    *pivot_pos = cc::move(pivot);
+    return pivot_pos;
+}
+
+/// Sorts [begin, end).
+/// bad_allowed is the number of unbalanced partitions before switching to heapsort.
+/// leftmost is false if begin[-1] exists and is not greater than any element in the range.
+template <bool Branchless, class T, class Less>
+void sort_pdq_loop(T* begin, T* end, Less& less, int bad_allowed, bool leftmost = true)
+{
+    while (true)
+    {
+        auto const size = isize(end - begin);
+        if (size < sort_insertion_threshold)
+        {
+            if (leftmost)
+                impl::sort_insertion(begin, end, less);
+            else
+                impl::sort_insertion_unguarded(begin, end, less);
+            return;
+        }
+
+        // pivot: median of 3, or pseudomedian of 9 for large ranges, moved to *begin
+        auto const s2 = size / 2;
+        if (size > sort_ninther_threshold)
+        {
+            impl::sort3(begin, begin + s2, end - 1, less);
+            impl::sort3(begin + 1, begin + (s2 - 1), end - 2, less);
+            impl::sort3(begin + 2, begin + (s2 + 1), end - 3, less);
+            impl::sort3(begin + (s2 - 1), begin + s2, begin + (s2 + 1), less);
+            cc::swap(*begin, begin[s2]);
+        }
+        else
+            impl::sort3(begin + s2, begin, end - 1, less);
+
+        // the pivot equals the element before the range: everything equal to it is in place after one partition
+        if (!leftmost && !less(begin[-1], *begin))
+        {
+            begin = impl::sort_partition_left(begin, end, less) + 1;
+            continue;
+        }
+
+        sort_partition_result<T> part;
+        if (Branchless && size > sort_branchless_threshold)
+            part = impl::sort_partition_right_branchless(begin, end, less);
+        else
+            part = impl::sort_partition_right(begin, end, less);
+        auto const pivot_pos = part.pivot;
+
+        auto const l_size = isize(pivot_pos - begin);
+        auto const r_size = isize(end - (pivot_pos + 1));
+        auto const highly_unbalanced = l_size < size / 8 || r_size < size / 8;
+
+        if (highly_unbalanced)
+        {
+            // too many bad pivots, guarantee O(n log n)
+            if (--bad_allowed == 0)
+            {
+                impl::sort_heap(begin, size, less);
+                return;
+            }
+
+            // break up patterns that produced the bad pivot
+            if (l_size >= sort_insertion_threshold)
+            {
+                cc::swap(begin[0], begin[l_size / 4]);
+                cc::swap(pivot_pos[-1], pivot_pos[-(l_size / 4)]);
+                if (l_size > sort_ninther_threshold)
+                {
+                    cc::swap(begin[1], begin[l_size / 4 + 1]);
+                    cc::swap(begin[2], begin[l_size / 4 + 2]);
+                    cc::swap(pivot_pos[-2], pivot_pos[-(l_size / 4 + 1)]);
+                    cc::swap(pivot_pos[-3], pivot_pos[-(l_size / 4 + 2)]);
+                }
+            }
+            if (r_size >= sort_insertion_threshold)
+            {
+                cc::swap(pivot_pos[1], pivot_pos[1 + r_size / 4]);
+                cc::swap(end[-1], end[-(r_size / 4)]);
+                if (r_size > sort_ninther_threshold)
+                {
+                    cc::swap(pivot_pos[2], pivot_pos[2 + r_size / 4]);
+                    cc::swap(pivot_pos[3], pivot_pos[3 + r_size / 4]);
+                    cc::swap(end[-2], end[-(1 + r_size / 4)]);
+                    cc::swap(end[-3], end[-(2 + r_size / 4)]);
+                }
+            }
+        }
+        else if (part.was_partitioned && impl::sort_insertion_partial(begin, pivot_pos, less)
+                 && impl::sort_insertion_partial(pivot_pos + 1, end, less))
+        {
+            // a balanced partition without swaps hints at (almost) sorted input
+            return;
+        }
+
+        // recurse into the left part, loop on the right part
+        impl::sort_pdq_loop<Branchless>(begin, pivot_pos, less, bad_allowed, leftmost);
+        begin = pivot_pos + 1;
+        leftmost = false;
+    }
+}
+
+template <bool Branchless, class T, class Less>
+void sort_unstable(T* data, isize n, Less& less)
+{
+    if constexpr (Branchless)
+        if (impl::sort_tiny(data, n, less))
+            return;
+
+    if (n < 2)
+        return;
+
+    impl::sort_pdq_loop<Branchless>(data, data + n, less, int(cc::bit_width(u64(n))));
+}
+
+// comparisons are cheap and elements are cheap to copy: branchless partitioning and sorting networks pay off
+template <class T>
+constexpr bool sort_prefers_branchless = std::is_trivially_copyable_v<T> && sizeof(T) <= 2 * sizeof(void*);
+
+// =========================================================================================================
+// Stable merge sort
+// =========================================================================================================
+
+constexpr isize sort_stable_insertion_threshold = 16;
+
+/// Sorts data[0..n) stably, scratch is uninitialized storage for n / 2 elements.
+template <class T, class Less>
+void sort_merge(T* data, isize n, T* scratch, Less& less)
+{
+    if (n <= sort_stable_insertion_threshold)
+    {
+        impl::sort_insertion(data, data + n, less);
+        return;
+    }
+
+    auto const mid = n / 2;
+    impl::sort_merge(data, mid, scratch, less);
+    impl::sort_merge(data + mid, n - mid, scratch, less);
+
+    // already in order (e.g. presorted runs)
+    if (!less(data[mid], data[mid - 1]))
+        return;
+
+    // move the left run out and merge both runs back into data, ties take the left run first
+    auto buf_end = scratch;
+    impl::move_create_objects_to(buf_end, data, data + mid);
+
+    auto left = scratch;
+    auto right = data + mid;
+    auto const right_end = data + n;
+    auto out = data;
+    while (left != buf_end && right != right_end)
+    {
+        if (less(*right, *left))
+            *out++ = cc::move(*right++);
+        else
+            *out++ = cc::move(*left++);
+    }
+    while (left != buf_end)
+        *out++ = cc::move(*left++);
+
+    impl::destroy_objects_in_reverse(scratch, buf_end);
+}
+
+// =========================================================================================================
+// LSD radix sort
+// =========================================================================================================
+
+constexpr isize sort_radix_insertion_threshold = 64;
+
+// when radix_sort may use a comparison sort instead (measured against sort_unstable on random keys):
+// the histograms need about 96 elements per scattered byte to pay off,
+// and scatter passes over data that does not fit in cache lose if they move more than 32 bytes per element
+constexpr isize sort_radix_min_elements_per_byte = 96;
+constexpr isize sort_radix_cache_bytes = isize(4) << 20;
+constexpr isize sort_radix_max_uncached_bytes = 32;
+
+/// Maps a key to an unsigned integer of the same size with the same order.
+/// Signed integers flip the sign bit.
+/// Floating point numbers flip the sign bit if positive and all bits if negative, so that
+/// -inf < negative < -0 < +0 < positive < inf (NaNs go to the ends according to their sign bit).
+template <class K>
+[[nodiscard]] CC_FORCE_INLINE constexpr auto sort_radix_bits(K key)
+{
+    static_assert(std::is_integral_v<K> || std::is_floating_point_v<K>,
+                  "radix sort keys must be integers or floating point numbers");
+
+    if constexpr (std::is_same_v<K, bool>)
+        return u8(key);
+    else if constexpr (std::is_floating_point_v<K>)
+    {
+        static_assert(sizeof(K) == 4 || sizeof(K) == 8, "only 32 and 64 bit floating point keys are supported");
+        using U = std::conditional_t<sizeof(K) == 4, u32, u64>;
+        constexpr auto shift = int(sizeof(U) * 8 - 1);
+        auto const bits = cc::bit_cast<U>(key);
+        auto const mask = U(U(0) - (bits >> shift)) | (U(1) << shift);
+        return U(bits ^ mask);
+    }
+    else if constexpr (std::is_signed_v<K>)
+    {
+        using U = std::make_unsigned_t<K>;
+        return U(U(key) ^ U(U(1) << (sizeof(U) * 8 - 1)));
+    }
+    else
+        return key;
+}
+
+/// Stable LSD radix sort with 8 bit digits.
+/// One pass computes the histograms of all digits, digits that are equal for all keys are skipped.
+/// Scatters alternate between data and a scratch buffer from resource.
+/// KeysOnly: the elements are their own keys, so equal keys are indistinguishable and stability is not observable.
+/// Then a comparison sort by the same bits is used when it is expected to be faster.
+template <bool KeysOnly, class T, class KeyF>
+void sort_radix(T* data, isize n, KeyF& key, cc::memory_resource const* resource)
+{
+    static_assert(std::is_trivially_copyable_v<T>, "radix sort requires trivially copyable elements");
+
+    auto const bits_of = [&key](T const& v) { return impl::sort_radix_bits(key(v)); };
+    auto less = [&bits_of](T const& a, T const& b) { return bits_of(a) < bits_of(b); };
+    using bits_t = decltype(bits_of(*data));
+    constexpr isize digit_count = sizeof(bits_t);
+
+    if (n <= sort_radix_insertion_threshold)
+    {
+        if constexpr (KeysOnly)
+            impl::sort_unstable<true>(data, n, less);
+        else
+            impl::sort_insertion(data, data + n, less);
+        return;
+    }
+
+    // digits in which any key differs from the first one, the others need no pass
+    auto const first_bits = bits_of(data[0]);
+    bits_t varying = 0;
+    for (isize i = 1; i < n; ++i)
+        varying |= bits_t(bits_of(data[i]) ^ first_bits);
+
+    isize passes = 0;
+    for (isize d = 0; d < digit_count; ++d)
+        passes += ((varying >> (8 * d)) & 0xFF) != 0;
+    if (passes == 0)
+        return; // all keys are equal
+
+    if constexpr (KeysOnly)
+    {
+        auto const scattered_bytes = passes * isize(sizeof(T));
+        if (n < sort_radix_min_elements_per_byte * scattered_bytes
+            || (n * isize(sizeof(T)) > sort_radix_cache_bytes && scattered_bytes > sort_radix_max_uncached_bytes))
+        {
+            impl::sort_unstable<true>(data, n, less);
+            return;
+        }
+    }
+
+    isize counts[digit_count][256] = {};
+    for (isize i = 0; i < n; ++i)
+    {
+        auto const bits = bits_of(data[i]);
+        for (isize d = 0; d < digit_count; ++d)
+            ++counts[d][(bits >> (8 * d)) & 0xFF];
+    }
+
+    auto scratch = cc::allocation<T>::create_empty(n, alignof(T), resource);
+    auto src = data;
+    auto dst = scratch.obj_start;
+    for (isize d = 0; d < digit_count; ++d)
+    {
+        auto const shift = int(8 * d);
+        if (((varying >> shift) & 0xFF) == 0)
+            continue;
+
+        auto const& count = counts[d];
+        isize offsets[256];
+        isize sum = 0;
+        for (isize b = 0; b < 256; ++b)
+        {
+            offsets[b] = sum;
+            sum += count[b];
+        }
+
+        // trivially copyable elements, so the scratch buffer needs no constructed objects
+        for (isize i = 0; i < n; ++i)
+            std::memcpy(static_cast<void*>(dst + offsets[(bits_of(src[i]) >> shift) & 0xFF]++), src + i, sizeof(T));
+
+        cc::swap(src, dst);
+    }
+
+    if (src != data)
+        std::memcpy(static_cast<void*>(data), src, n * sizeof(T));
+}
+} // namespace cc::impl
+
+namespace cc
+{
+// =========================================================================================================
+// Unstable comparison sort
+// =========================================================================================================
+
+/// Sorts the elements of range ascending by <.
+/// Pattern-defeating quicksort: O(n log n) worst case, O(n) for sorted, reversed and all-equal inputs,
+/// and linear passes for runs of equal elements.
+/// Small trivially copyable elements use branchless block partitioning and sorting networks for up to 8 elements.
+/// The order of equal elements is unspecified, see stable_sort() and radix_sort().
+/// Usage:
+///   cc::vector<int> v = {3, 1, 2};
+///   cc::sort(v); // 1 2 3
+///   cc::sort(cc::span<int>(v.data(), 2));
+template <impl::sort_range Range>
+void sort(Range&& range)
+{
+    using T = impl::sort_element_t<Range>;
+    static_assert(!std::is_const_v<T>, "cannot sort a range of const elements");
+    impl::sort_default_less less;
+    impl::sort_unstable<impl::sort_prefers_branchless<T>>(range.data(), isize(range.size()), less);
+}
+
+/// Sorts the elements of range by the strict weak ordering less(a, b).
+/// Same algorithm as sort(range).
+/// Usage:
+///   cc::sort(v, [](int a, int b) { return a > b; }); // descending
+template <impl::sort_range Range, class Less>
+void sort(Range&& range, Less&& less)
+{
+    using T = impl::sort_element_t<Range>;
+    static_assert(!std::is_const_v<T>, "cannot sort a range of const elements");
+    static_assert(cc::is_invocable_r<bool, Less&, T const&, T const&>, "less must be callable as less(a, b) -> bool");
+    impl::sort_unstable<impl::sort_prefers_branchless<T>>(range.data(), isize(range.size()), less);
+}
+
+/// Sorts the elements of range ascending by key(element) (unstable).
+/// key is called for every comparison, so it should be cheap (e.g. a member access).
+/// For integer and floating point keys, radix_sort_by_key() is usually faster for large ranges.
+/// Usage:
+///   cc::sort_by_key(entities, [](entity const& e) { return e.depth; });
+template <impl::sort_range Range, class KeyF>
+void sort_by_key(Range&& range, KeyF&& key)
+{
+    using T = impl::sort_element_t<Range>;
+    static_assert(!std::is_const_v<T>, "cannot sort a range of const elements");
+    auto less = [&key](T const& a, T const& b) { return key(a) < key(b); };
+    impl::sort_unstable<impl::sort_prefers_branchless<T>>(range.data(), isize(range.size()), less);
+}
+
+// =========================================================================================================
+// Stable comparison sort
+// =========================================================================================================
+
+/// Sorts the elements of range by less(a, b), equal elements keep their relative order.
+/// Top-down merge sort: O(n log n) comparisons, O(n) for presorted runs.
+/// Allocates a scratch buffer of size() / 2 elements from resource (nullptr for the default resource),
+/// ranges of up to 16 elements are insertion sorted without allocating.
+/// less and the move operations of the elements must not throw.
+/// Usage:
+///   cc::stable_sort(rows, [](row const& a, row const& b) { return a.group < b.group; });
+///   cc::stable_sort(rows, less, &frame_arena_resource);
+template <impl::sort_range Range, class Less = impl::sort_default_less>
+void stable_sort(Range&& range, Less&& less = {}, cc::memory_resource const* resource = nullptr)
+{
+    using T = impl::sort_element_t<Range>;
+    static_assert(!std::is_const_v<T>, "cannot sort a range of const elements");
+    static_assert(cc::is_invocable_r<bool, Less&, T const&, T const&>, "less must be callable as less(a, b) -> bool");
+
+    auto const data = range.data();
+    auto const n = isize(range.size());
+    if (n <= impl::sort_stable_insertion_threshold)
+    {
+        impl::sort_insertion(data, data + n, less);
+        return;
+    }
+
+    auto scratch = cc::allocation<T>::create_empty(n / 2, alignof(T), resource);
+    impl::sort_merge(data, n, scratch.obj_start, less);
+}
+
+// =========================================================================================================
+// Radix sort
+// =========================================================================================================
+
+/// Sorts a range of integers or floating point numbers ascending in O(n).
+/// Stable LSD radix sort with 8 bit digits, digits that are equal for all elements are skipped
+/// (e.g. sorting u64 values below 2^16 takes two passes).
+/// Allocates a scratch buffer of size() elements from resource (nullptr for the default resource).
+/// Floating point numbers are ordered by their bits: -0 before +0, NaNs at the ends depending on their sign.
+/// Usage:
+///   cc::vector<u32> ids = ...;
+///   cc::radix_sort(ids);
+template <impl::sort_range Range>
+void radix_sort(Range&& range, cc::memory_resource const* resource = nullptr)
+{
+    using T = impl::sort_element_t<Range>;
+    static_assert(!std::is_const_v<T>, "cannot sort a range of const elements");
+    static_assert(std::is_integral_v<T> || std::is_floating_point_v<T>,
+                  "radix_sort sorts integers and floating point numbers, use radix_sort_by_key() for other types");
+    auto key = [](T v) { return v; };
+    impl::sort_radix<true>(range.data(), isize(range.size()), key, resource);
+}
+
+/// Sorts a range of trivially copyable elements ascending by an integer or floating point key(element) in O(n).
+/// Stable: elements with equal keys keep their relative order.
+/// key is called once per element and pass, so it should be cheap (e.g. a member access).
+/// Allocates a scratch buffer of size() elements from resource (nullptr for the default resource).
+/// Usage:
+///   cc::radix_sort_by_key(particles, [](particle const& p) { return p.depth; });
+///   cc::radix_sort_by_key(entries, [](entry const& e) { return e.hash; }, &scratch_resource);
+template <impl::sort_range Range, class KeyF>
+void radix_sort_by_key(Range&& range, KeyF&& key, cc::memory_resource const* resource = nullptr)
+{
+    using T = impl::sort_element_t<Range>;
+    static_assert(!std::is_const_v<T>, "cannot sort a range of const elements");
+    impl::sort_radix<false>(range.data(), isize(range.size()), key, resource);
+}
+
+// =========================================================================================================
+// Queries
+// =========================================================================================================
+
+/// Returns true if no element of range is less than its predecessor.
+template <impl::sort_range Range, class Less = impl::sort_default_less>
+[[nodiscard]] bool is_sorted(Range&& range, Less&& less = {})
+{
+    auto const data = range.data();
+    auto const n = isize(range.size());
+    for (isize i = 1; i < n; ++i)
+        if (less(data[i], data[i - 1]))
+            return false;
+    return true;
+}
+} // namespace cc
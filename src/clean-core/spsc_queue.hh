@@ -0,0 +1,423 @@
+#pragma once
+
+#include <clean-core/allocation.hh>
+#include <clean-core/atomic_wait.hh>
+#include <clean-core/bit.hh>
+#include <clean-core/fwd.hh>
+#include <clean-core/impl/object_lifetime_util.hh>
+#include <clean-core/optional.hh>
+#include <clean-core/ringbuffer.hh> // cc::ring_regions
+#include <clean-core/span.hh>
+
+#include <atomic>
+#include <new>
+
+/// Bounded lock-free queue for exactly one producer thread and one consumer thread.
+///
+/// Elements live in a power-of-two ring of slots, head and tail are free-running counters
+/// (slot = counter & mask), so "full" and "empty" never need a reserved slot.
+///
+/// Performance design:
+///   - head (consumer) and tail (producer) live on separate cache lines, each next to the owner's
+///     cached copy of the other side's index: the remote index is only re-read when the cached one
+///     says the queue looks full/empty, so in steady state each side only touches its own line
+///   - batch operations (push_range/pop_to, writable_regions/readable_regions) move many elements
+///     with a single index publication
+///   - blocking variants spin briefly, yield, then sleep via cc::atomic_wait (futex on Linux);
+///     a peer only pays for a wakeup syscall when the other side actually sleeps
+///
+/// Thread safety: producer functions (push*, try_push*, writable_regions, commit_write) must only be called
+/// from one thread at a time, consumer functions (pop*, try_pop*, readable_regions, commit_read) likewise.
+/// size() and empty() may be called from anywhere but are only snapshots.
+///
+/// The queue is neither copyable nor movable (the threads hold references to it).
+///
+/// Usage:
+///   auto q = cc::spsc_queue<message>::create_with_capacity(1024);
+///   // producer thread
+///   q.push(msg);                  // blocks while full
+///   if (!q.try_push(msg)) ...     // never blocks
+///   // consumer thread
+///   message batch[64];
+///   auto n = q.pop_to(batch);     // blocks until at least one element is available
+template <class T>
+struct cc::spsc_queue
+{
+    static_assert(std::is_object_v<T> && !std::is_const_v<T>, "queue elements must be non-const objects");
+
+    // queries
+public:
+    /// Maximum number of elements in the queue (a power of two).
+    [[nodiscard]] isize capacity() const { return _mask + 1; }
+
+    /// Number of elements at the time of the call (exact only if neither side is active).
+    [[nodiscard]] isize size() const
+    {
+        auto const head = _consumer.head.load(std::memory_order_acquire);
+        auto const tail = _producer.tail.load(std::memory_order_acquire);
+        return tail - head;
+    }
+    [[nodiscard]] bool empty() const { return size() == 0; }
+
+    // producer
+public:
+    /// Constructs an element at the back unless the queue is full. Returns true if the element was pushed.
+    template <class... Args>
+    bool try_emplace(Args&&... args)
+    {
+        auto const tail = _producer.tail.load(std::memory_order_relaxed);
+        if (free_slots(tail, 1) == 0)
+            return false;
+        new (cc::placement_new, _slots + (tail & _mask)) T(cc::forward<Args>(args)...);
+        publish_tail(tail + 1);
+        return true;
+    }
+    bool try_push(T const& value) { return try_emplace(value); }
+    bool try_push(T&& value) { return try_emplace(cc::move(value)); }
+
+    /// Pushes an element, waiting while the queue is full.
+    template <class... Args>
+    void emplace(Args&&... args)
+    {
+        auto const tail = _producer.tail.load(std::memory_order_relaxed);
+        wait_for_free_slots(tail, 1);
+        new (cc::placement_new, _slots + (tail & _mask)) T(cc::forward<Args>(args)...);
+        publish_tail(tail + 1);
+    }
+    void push(T const& value) { emplace(value); }
+    void push(T&& value) { emplace(cc::move(value)); }
+
+    /// Copies as many values as fit (from the front of values) with a single publication.
+    /// Returns the number of pushed values.
+    isize try_push_range(cc::span<T const> values)
+    {
+        auto const tail = _producer.tail.load(std::memory_order_relaxed);
+        auto const count = cc::min(values.size(), free_slots(tail, values.size()));
+        if (count > 0)
+        {
+            copy_to_slots(tail, values.data(), count);
+            publish_tail(tail + count);
+        }
+        return count;
+    }
+
+    /// Copies all values, waiting for free slots as needed. Publishes once per chunk of available slots.
+    void push_range(cc::span<T const> values)
+    {
+        auto tail = _producer.tail.load(std::memory_order_relaxed);
+        isize pushed = 0;
+        while (pushed < values.size())
+        {
+            auto const count = cc::min(values.size() - pushed, wait_for_free_slots(tail, 1));
+            copy_to_slots(tail, values.data() + pushed, count);
+            tail += count;
+            pushed += count;
+            publish_tail(tail);
+        }
+    }
+
+    /// All currently free slots as at most two spans, to be filled in place and published via commit_write.
+    /// The slots are uninitialized memory, so this is only available for trivially copyable T.
+    [[nodiscard]] ring_regions<T> writable_regions()
+    {
+        static_assert(std::is_trivially_copyable_v<T>,
+                      "writable regions are uninitialized memory, use push_range for non-trivial types");
+        auto const tail = _producer.tail.load(std::memory_order_relaxed);
+        return regions_at(tail, free_slots(tail, capacity()));
+    }
+
+    /// Publishes the first count slots of the last writable_regions() to the consumer.
+    void commit_write(isize count)
+    {
+        static_assert(std::is_trivially_copyable_v<T>,
+                      "writable regions are only available for trivially copyable types");
+        auto const tail = _producer.tail.load(std::memory_order_relaxed);
+        CC_ASSERT(0 <= count && count <= capacity() - (tail - _producer.head_cache),
+                  "cannot commit more slots than were writable");
+        publish_tail(tail + count);
+    }
+
+    // consumer
+public:
+    /// Removes and returns the front element, or nullopt if the queue is empty.
+    [[nodiscard]] cc::optional<T> try_pop()
+    {
+        auto const head = _consumer.head.load(std::memory_order_relaxed);
+        if (available(head, 1) == 0)
+            return cc::nullopt;
+        return take_front(head);
+    }
+
+    /// Removes and returns the front element, waiting while the queue is empty.
+    [[nodiscard]] T pop()
+    {
+        auto const head = _consumer.head.load(std::memory_order_relaxed);
+        wait_for_elements(head, 1);
+        return take_front(head);
+    }
+
+    /// Moves up to dest.size() elements into dest (assigning to the existing objects there)
+    /// with a single publication. Returns the number of moved elements.
+    isize try_pop_to(cc::span<T> dest)
+    {
+        auto const head = _consumer.head.load(std::memory_order_relaxed);
+        auto const count = cc::min(dest.size(), available(head, dest.size()));
+        if (count > 0)
+            move_from_slots(head, dest.data(), count);
+        return count;
+    }
+
+    /// Like try_pop_to, but waits until at least one element is available (if dest is not empty).
+    isize pop_to(cc::span<T> dest)
+    {
+        if (dest.empty())
+            return 0;
+        auto const head = _consumer.head.load(std::memory_order_relaxed);
+        auto const count = cc::min(dest.size(), wait_for_elements(head, 1));
+        move_from_slots(head, dest.data(), count);
+        return count;
+    }
+
+    /// All currently available elements (front to back) as at most two spans, to be processed in place.
+    /// Release them via commit_read.
+    [[nodiscard]] ring_regions<T> readable_regions()
+    {
+        auto const head = _consumer.head.load(std::memory_order_relaxed);
+        return regions_at(head, available(head, capacity()));
+    }
+
+    /// Destroys the first count elements and hands their slots back to the producer.
+    void commit_read(isize count)
+    {
+        auto const head = _consumer.head.load(std::memory_order_relaxed);
+        CC_ASSERT(0 <= count && count <= _consumer.tail_cache - head, "cannot read more elements than were readable");
+        auto const r = regions_at(head, count);
+        impl::destroy_objects_in_reverse(r.first.data(), r.first.data() + r.first.size());
+        impl::destroy_objects_in_reverse(r.second.data(), r.second.data() + r.second.size());
+        publish_head(head + count);
+    }
+
+    // factories
+public:
+    /// Creates a queue with room for at least count elements (rounded up to a power of two).
+    [[nodiscard]] static spsc_queue create_with_capacity(isize count, cc::memory_resource const* resource = nullptr)
+    {
+        CC_ASSERT(count > 0, "queue capacity must be positive");
+        return spsc_queue(isize(cc::bit_ceil(u64(count))), resource);
+    }
+
+    // ctors/dtor
+public:
+    spsc_queue(spsc_queue const&) = delete;
+    spsc_queue(spsc_queue&&) = delete;
+    spsc_queue& operator=(spsc_queue const&) = delete;
+    spsc_queue& operator=(spsc_queue&&) = delete;
+
+    ~spsc_queue()
+    {
+        auto const head = _consumer.head.load(std::memory_order_relaxed);
+        auto const tail = _producer.tail.load(std::memory_order_relaxed);
+        auto const r = regions_at(head, tail - head);
+        impl::destroy_objects_in_reverse(r.first.data(), r.first.data() + r.first.size());
+        impl::destroy_objects_in_reverse(r.second.data(), r.second.data() + r.second.size());
+    }
+
+private:
+    static constexpr isize cache_line = std::hardware_destructive_interference_size;
+
+    // a blocking call first spins, then yields its time slice (cheap when both sides share a core), then sleeps
+    static constexpr int spin_count = 64;
+    static constexpr int yield_count = 16;
+
+    spsc_queue(isize capacity, cc::memory_resource const* resource)
+      : _storage(cc::allocation<T>::create_empty(capacity, cc::max(isize(alignof(T)), cache_line), resource)),
+        _slots(_storage.obj_start),
+        _mask(capacity - 1)
+    {
+    }
+
+    // the count slots starting at counter pos
+    [[nodiscard]] ring_regions<T> regions_at(isize pos, isize count) const
+    {
+        if (count == 0)
+            return {};
+        auto const start = pos & _mask;
+        auto const first = cc::min(count, capacity() - start);
+        return {cc::span<T>(_slots + start, first), cc::span<T>(_slots, count - first)};
+    }
+
+    // free slots after tail, only re-reads the consumer's head if the cached one shows fewer than wanted
+    [[nodiscard]] CC_FORCE_INLINE isize free_slots(isize tail, isize wanted)
+    {
+        auto free = capacity() - (tail - _producer.head_cache);
+        if (free < wanted)
+        {
+            _producer.head_cache = _consumer.head.load(std::memory_order_acquire);
+            free = capacity() - (tail - _producer.head_cache);
+        }
+        return free;
+    }
+
+    // elements after head, only re-reads the producer's tail if the cached one shows fewer than wanted
+    [[nodiscard]] CC_FORCE_INLINE isize available(isize head, isize wanted)
+    {
+        auto avail = _consumer.tail_cache - head;
+        if (avail < wanted)
+        {
+            _consumer.tail_cache = _producer.tail.load(std::memory_order_acquire);
+            avail = _consumer.tail_cache - head;
+        }
+        return avail;
+    }
+
+    // spin, yield, then sleep until at least min_count slots are free, returns the number of free slots
+    isize wait_for_free_slots(isize tail, isize min_count)
+    {
+        for (auto i = 0;; ++i)
+        {
+            auto const free = free_slots(tail, min_count);
+            if (free >= min_count)
+                return free;
+            if (i < spin_count)
+            {
+                cc::cpu_relax();
+                continue;
+            }
+            if (i < spin_count + yield_count)
+            {
+                cc::yield_thread();
+                continue;
+            }
+
+            // announce before the final check, the consumer checks the flag after publishing its head
+            // the re-check must be seq_cst as well, an acquire load could be ordered before the flag store
+            _wait.producer_sleeping.store(1, std::memory_order_seq_cst);
+            _producer.head_cache = _consumer.head.load(std::memory_order_seq_cst);
+            if (capacity() - (tail - _producer.head_cache) >= min_count)
+                _wait.producer_sleeping.store(0, std::memory_order_relaxed);
+            else
+                cc::atomic_wait(_wait.producer_sleeping, 1);
+        }
+    }
+
+    // spin, yield, then sleep until at least min_count elements are available, returns the number of available elements
+    isize wait_for_elements(isize head, isize min_count)
+    {
+        for (auto i = 0;; ++i)
+        {
+            auto const avail = available(head, min_count);
+            if (avail >= min_count)
+                return avail;
+            if (i < spin_count)
+            {
+                cc::cpu_relax();
+                continue;
+            }
+            if (i < spin_count + yield_count)
+            {
+                cc::yield_thread();
+                continue;
+            }
+
+            _wait.consumer_sleeping.store(1, std::memory_order_seq_cst);
+            _consumer.tail_cache = _producer.tail.load(std::memory_order_seq_cst);
+            if (_consumer.tail_cache - head >= min_count)
+                _wait.consumer_sleeping.store(0, std::memory_order_relaxed);
+            else
+                cc::atomic_wait(_wait.consumer_sleeping, 1);
+        }
+    }
+
+    // seq_cst store + seq_cst flag load pairs with the sleeper's flag store + index load (Dekker style),
+    // so either the sleeper sees the new index or we see its flag and wake it up
+    CC_FORCE_INLINE void publish_tail(isize tail)
+    {
+        _producer.tail.store(tail, std::memory_order_seq_cst);
+        if (_wait.consumer_sleeping.load(std::memory_order_seq_cst) != 0) [[unlikely]]
+        {
+            _wait.consumer_sleeping.store(0, std::memory_order_relaxed);
+            cc::atomic_wake_one(_wait.consumer_sleeping);
+        }
+    }
+
+    CC_FORCE_INLINE void publish_head(isize head)
+    {
+        _consumer.head.store(head, std::memory_order_seq_cst);
+        if (_wait.producer_sleeping.load(std::memory_order_seq_cst) != 0) [[unlikely]]
+        {
+            _wait.producer_sleeping.store(0, std::memory_order_relaxed);
+            cc::atomic_wake_one(_wait.producer_sleeping);
+        }
+    }
+
+    void copy_to_slots(isize tail, T const* values, isize count)
+    {
+        auto const r = regions_at(tail, count);
+        auto dest = r.first.data();
+        impl::copy_create_objects_to(dest, values, values + r.first.size());
+        dest = r.second.data();
+        impl::copy_create_objects_to(dest, values + r.first.size(), values + count);
+    }
+
+    void move_from_slots(isize head, T* dest, isize count)
+    {
+        auto const r = regions_at(head, count);
+        if constexpr (std::is_trivially_copyable_v<T>)
+        {
+            if (!r.first.empty())
+                cc::memcpy(dest, r.first.data(), r.first.size() * sizeof(T));
+            if (!r.second.empty())
+                cc::memcpy(dest + r.first.size(), r.second.data(), r.second.size() * sizeof(T));
+        }
+        else
+        {
+            for (isize i = 0; i < r.first.size(); ++i)
+                dest[i] = cc::move(r.first[i]);
+            for (isize i = 0; i < r.second.size(); ++i)
+                dest[r.first.size() + i] = cc::move(r.second[i]);
+            impl::destroy_objects_in_reverse(r.first.data(), r.first.data() + r.first.size());
+            impl::destroy_objects_in_reverse(r.second.data(), r.second.data() + r.second.size());
+        }
+        publish_head(head + count);
+    }
+
+    [[nodiscard]] T take_front(isize head)
+    {
+        auto& slot = _slots[head & _mask];
+        T value = cc::move(slot);
+        slot.~T();
+        publish_head(head + 1);
+        return value;
+    }
+
+private:
+    // written by the producer
+    struct alignas(cache_line) producer_line
+    {
+        std::atomic<isize> tail = 0;
+        isize head_cache = 0;
+    };
+
+    // written by the consumer
+    struct alignas(cache_line) consumer_line
+    {
+        std::atomic<isize> head = 0;
+        isize tail_cache = 0;
+    };
+
+    // only written around sleeping, so it stays shared in both caches
+    struct alignas(cache_line) wait_line
+    {
+        std::atomic<u32> producer_sleeping = 0;
+        std::atomic<u32> consumer_sleeping = 0;
+    };
+
+    producer_line _producer;
+    consumer_line _consumer;
+    wait_line _wait;
+
+    // read-only after construction
+    cc::allocation<T> _storage;
+    T* _slots = nullptr;
+    isize _mask = 0;
+};
@@ -618,6 +618,25 @@ public:
     /// Complexity: O(size()).
     [[nodiscard]] bool operator==(string const& rhs) const { return string_view(*this) == string_view(rhs); }
 
+    /// Lexicographic ordering against strings and anything convertible to string_view (e.g. for sorted containers).
+    /// Complexity: O(min(size(), rhs.size())).
+    [[nodiscard]] friend bool operator<(string const& lhs, string const& rhs)
+    {
+        return string_view(lhs) < string_view(rhs);
+    }
+    template <class S>
+    [[nodiscard]] friend bool operator<(string const& lhs, S const& rhs)
+        requires(std::convertible_to<S const&, string_view> && !std::is_same_v<S, string>)
+    {
+        return string_view(lhs) < string_view(rhs);
+    }
+    template <class S>
+    [[nodiscard]] friend bool operator<(S const& lhs, string const& rhs)
+        requires(std::convertible_to<S const&, string_view> && !std::is_same_v<S, string>)
+    {
+        return string_view(lhs) < string_view(rhs);
+    }
+
     /// Checks if this string starts with the given prefix.
     /// Returns true if the string begins with the prefix.
     /// Complexity: O(prefix.size()).
@@ -1,11 +1,219 @@
 #pragma once
 
 #include <clean-core/fwd.hh>
+#include <clean-core/macros.hh>
+#include <clean-core/utility.hh>
 
-/// Fixed-size heterogeneous collection of values with types Ts
-/// Provides compile-time indexed access to elements
+#include <compare>
+#include <concepts>
+#include <cstring>
+#include <type_traits>
+#include <utility> // index_sequence, tuple_size, tuple_element
+
+namespace cc::impl
+{
+struct tuple_construct_tag
+{
+};
+
+/// One element of a cc::tuple. The index keeps leaves of equal types distinct.
+/// Empty element types take no space: the member is [[no_unique_address]], so the leaf is empty as well
+/// and the empty base optimization applies to it.
+template <std::size_t I, class T>
+struct tuple_leaf
+{
+    CC_NO_UNIQUE_ADDRESS T value;
+
+    tuple_leaf() = default;
+
+    template <class U>
+    constexpr tuple_leaf(tuple_construct_tag, U&& v) : value(cc::forward<U>(v))
+    {
+    }
+};
+
+template <class IndexSeq, class... Ts>
+struct tuple_storage;
+
+/// Flat layout: every leaf is a direct base, so there is no recursive inheritance
+/// and instantiating a tuple of n elements needs n + 2 classes at depth 1.
+template <std::size_t... Is, class... Ts>
+struct tuple_storage<std::index_sequence<Is...>, Ts...> : tuple_leaf<Is, Ts>...
+{
+    tuple_storage() = default;
+
+    template <class... Us>
+    constexpr explicit tuple_storage(tuple_construct_tag tag, Us&&... args)
+      : tuple_leaf<Is, Ts>(tag, cc::forward<Us>(args))...
+    {
+    }
+};
+
+// element type lookup by derived-to-base deduction (no recursive template instantiation)
+template <std::size_t I, class T>
+std::type_identity<T> tuple_leaf_type(tuple_leaf<I, T> const&); // declaration only
+
+template <std::size_t I, class... Ts>
+using tuple_element_t = typename decltype(impl::tuple_leaf_type<I>(
+    std::declval<tuple_storage<std::index_sequence_for<Ts...>, Ts...> const&>()))::type;
+
+template <class T>
+constexpr bool is_tuple = false;
+template <class... Ts>
+constexpr bool is_tuple<cc::tuple<Ts...>> = true;
+
+/// Elements whose operator== is equivalent to comparing their bytes:
+/// integers, enums, pointers (unique object representation), empty types (no bytes to compare),
+/// and nested tuples with the same property.
+template <class T>
+constexpr bool tuple_bytewise_element = std::is_empty_v<T>
+                                     || (std::is_scalar_v<T> && std::has_unique_object_representations_v<T>);
+template <class... Ts>
+constexpr bool tuple_bytewise_element<cc::tuple<Ts...>> = cc::tuple<Ts...>::is_bytewise_comparable;
+
+template <class T>
+concept tuple_orderable_element = std::three_way_comparable<T> || requires(T const& v) {
+    { v < v } -> std::convertible_to<bool>;
+};
+
+// uses <=> if available and derives a weak ordering from < otherwise (e.g. for cc::string)
+template <class T>
+[[nodiscard]] constexpr auto tuple_compare_element(T const& a, T const& b)
+{
+    if constexpr (std::three_way_comparable<T>)
+        return a <=> b;
+    else if (a < b)
+        return std::weak_ordering::less;
+    else if (b < a)
+        return std::weak_ordering::greater;
+    else
+        return std::weak_ordering::equivalent;
+}
+
+// bytes of the tuple that carry values (empty elements take no space)
+template <class... Ts>
+constexpr std::size_t tuple_value_bytes = (std::size_t(0) + ... + (std::is_empty_v<Ts> ? 0 : sizeof(Ts)));
+} // namespace cc::impl
+
+/// Fixed-size heterogeneous collection of values with types Ts.
+/// Provides compile-time indexed access to elements and supports structured bindings.
+///
+/// Compared to std::tuple:
+///   - flat layout (one base class per element), no recursive inheritance, so it is cheap to compile
+///   - empty element types take no storage (e.g. sizeof(cc::tuple<int, empty_tag>) == sizeof(int))
+///   - trivially copyable / movable / destructible / default constructible whenever all Ts are,
+///     so containers memcpy them and they can live in shared memory or be bit_cast
+///   - element order in memory is the declaration order
+///
+/// Equality and hashing compare bytes (memcmp / cc::hash_bytes) when that is equivalent to the element-wise
+/// versions: all elements are integers, enums, pointers, empty types or such tuples, and there is no padding.
+/// This makes tuples fast composite keys for cc::map / cc::set. Otherwise, they work element by element.
+///
+/// Usage:
+///   cc::tuple<int, float, cc::string> t = {1, 2.f, "three"};
+///   auto [i, f, s] = t;
+///   t.get<0>() = 42;
+///
+///   cc::map<cc::tuple<u32, u32>, edge_data> edges;
+///   edges[cc::tuple(from, to)] = ...;
 template <class... Ts>
-struct cc::tuple
+struct cc::tuple : impl::tuple_storage<std::index_sequence_for<Ts...>, Ts...>
+{
+    using storage_t = impl::tuple_storage<std::index_sequence_for<Ts...>, Ts...>;
+
+    /// True if == and hashing compare the raw bytes of the tuple (see type docs).
+    static constexpr bool is_bytewise_comparable
+        = (impl::tuple_bytewise_element<Ts> && ...) && sizeof(storage_t) == impl::tuple_value_bytes<Ts...>;
+
+    // queries
+public:
+    /// Returns the number of elements.
+    [[nodiscard]] static constexpr isize size() { return sizeof...(Ts); }
+
+    // tuple protocol
+public:
+    /// Returns the I-th element, forwarding the value category of the tuple.
+    /// Supports structured bindings.
+    /// Requires 0 <= I < size() (compile-time check).
+    template <isize I>
+    [[nodiscard]] constexpr auto&& get(this auto&& self)
+    {
+        static_assert(0 <= I && I < isize(sizeof...(Ts)), "index out of bounds");
+        using leaf_t = impl::tuple_leaf<I, impl::tuple_element_t<I, Ts...>>;
+        return static_cast<decltype(self)&&>(self).leaf_t::value;
+    }
+
+    // comparison
+public:
+    [[nodiscard]] friend constexpr bool operator==(tuple const& a, tuple const& b)
+        requires(std::equality_comparable<Ts> && ...)
+    {
+        if constexpr (is_bytewise_comparable && sizeof...(Ts) > 0)
+        {
+            if !consteval
+            {
+                return std::memcmp(&a, &b, sizeof(tuple)) == 0;
+            }
+        }
+        return a.equals_elementwise(b, std::index_sequence_for<Ts...>{});
+    }
+
+    /// Lexicographic comparison.
+    /// Elements without <=> are compared via their operator<.
+    [[nodiscard]] friend constexpr auto operator<=>(tuple const& a, tuple const& b)
+        requires(impl::tuple_orderable_element<Ts> && ...)
+    {
+        return a.compare_elementwise(b, std::index_sequence_for<Ts...>{});
+    }
+
+    // ctors
+public:
+    tuple() = default;
+
+    /// Constructs each element from the corresponding argument.
+    template <class... Us>
+        requires(sizeof...(Us) == sizeof...(Ts) && sizeof...(Ts) > 0
+                 && !(sizeof...(Us) == 1 && (std::is_same_v<std::remove_cvref_t<Us>, tuple> && ...))
+                 && (std::is_constructible_v<Ts, Us &&> && ...))
+    constexpr tuple(Us&&... args) : storage_t(impl::tuple_construct_tag{}, cc::forward<Us>(args)...)
+    {
+    }
+
+private:
+    template <std::size_t... Is>
+    [[nodiscard]] constexpr bool equals_elementwise(tuple const& rhs, std::index_sequence<Is...>) const
+    {
+        return ((this->template get<Is>() == rhs.template get<Is>()) && ...);
+    }
+
+    template <std::size_t... Is>
+    [[nodiscard]] constexpr auto compare_elementwise(tuple const& rhs, std::index_sequence<Is...>) const
+    {
+        using ordering = std::common_comparison_category_t<decltype(impl::tuple_compare_element(
+            std::declval<Ts const&>(), std::declval<Ts const&>()))...>;
+        ordering result = std::strong_ordering::equal;
+        // stops at the first element that is not equivalent
+        (void)(((result = impl::tuple_compare_element(this->template get<Is>(), rhs.template get<Is>())) == 0) && ...);
+        return result;
+    }
+};
+
+namespace cc
+{
+template <class... Ts>
+tuple(Ts...) -> tuple<Ts...>;
+}
+
+/// Specialization of std::tuple_size for cc::tuple to enable structured bindings.
+template <class... Ts>
+struct std::tuple_size<cc::tuple<Ts...>> : std::integral_constant<std::size_t, sizeof...(Ts)>
+{
+};
+
+/// Specialization of std::tuple_element for cc::tuple to enable structured bindings.
+template <std::size_t I, class... Ts>
+struct std::tuple_element<I, cc::tuple<Ts...>>
 {
-    // TODO: implement tuple
+    static_assert(I < sizeof...(Ts), "index out of bounds");
+    using type = cc::impl::tuple_element_t<I, Ts...>;
 };
@@ -7,8 +7,6 @@
 // - sequence entry points
 // - retyping APIs
 // - equality, order, hashing
-// - insert/emplace at arbitrary positions
-// - push_back_range
 // - contains/contains_where/find/find_where/count/count_where
 // - sort
 // - assign (replace parts of content)
@@ -71,6 +69,15 @@ public:
     using base::push_back;           // add element at back (with allocation if needed)
     using base::push_back_stable;    // add element at back (requires capacity)
 
+    using base::append_uninitialized; // append N uninitialized elements, returns them as span (trivial types only)
+    using base::push_back_range;      // append copies of a span (grows at most once)
+
+    // insertion
+public:
+    using base::emplace_at;      // construct element at index (shifts the tail back)
+    using base::insert_at;       // insert element at index (shifts the tail back)
+    using base::insert_range_at; // insert copies of a span at index (grows at most once, shifts the tail once)
+
     // single element removal
 public:
     using base::pop_back;    // remove and return last element
@@ -132,10 +139,6 @@ public:
     using base::clear; // destroy all elements, size becomes 0
     using base::fill;  // fill all elements with value
 
-    // TODO: insert(Iterator pos, T const& value) - insert element at position
-    // TODO: insert(Iterator pos, T&& value) - insert element at position
-    // TODO: insert(Iterator pos, isize count, T const& value) - insert multiple copies
-
     // ctors / allocation management
 public:
     // unique_vector has move-only semantics
@@ -7,6 +7,10 @@
 #include <initializer_list>
 #include <type_traits>
 
+#if defined(CC_COMPILER_MSVC) && defined(CC_HAS_SSE2)
+#include <xmmintrin.h>
+#endif
+
 // =========================================================================================================
 // Utility functions for common operations
 // =========================================================================================================
@@ -65,6 +69,7 @@
 //   new(cc::placement_new, ptr) T    - placement new with explicit tag type
 //   storage_for<T>                   - uninitialized storage for manual lifetime management
 //   memcpy(dest, src, count)         - copy bytes from src to dest
+//   prefetch(ptr)                    - hint to load the cache line at ptr (never faults)
 //
 // Scope utilities:
 //   CC_DEFER { code }                - execute code at scope-exit (RAII cleanup)
@@ -852,6 +857,16 @@ struct placement_new_tag
 template <class T>
 union storage_for // NOLINT(cppcoreguidelines-special-member-functions)
 {
+    // explicit ctor for non-trivial T: some compilers (e.g. GCC 12) otherwise delete the defaulted one
+    // despite the initializer on dummy
+    constexpr storage_for()
+        requires(!std::is_trivially_default_constructible_v<T>)
+    {
+    }
+    constexpr storage_for()
+        requires std::is_trivially_default_constructible_v<T>
+    = default;
+
     // empty dtor in order to not initialize value but preserve triviality
     ~storage_for()
         requires(!std::is_trivially_destructible_v<T>)
@@ -878,6 +893,19 @@ union storage_for // NOLINT(cppcoreguidelines-special-member-functions)
 ///   cc::memcpy(buffer, "hello", 6);
 using std::memcpy;
 
+/// Hint to move the cache line at p into L1, never faults (p may be any address).
+/// Useful for overlapping the cache misses of independent random accesses, e.g. a batch of lookups.
+CC_FORCE_INLINE void prefetch(void const* p)
+{
+#if defined(CC_COMPILER_MSVC) && defined(CC_HAS_SSE2)
+    _mm_prefetch(static_cast<char const*>(p), _MM_HINT_T0);
+#elif defined(CC_COMPILER_POSIX)
+    __builtin_prefetch(p);
+#else
+    (void)p;
+#endif
+}
+
 // =========================================================================================================
 // Scope utilities
 // =========================================================================================================
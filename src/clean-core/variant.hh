@@ -1,13 +1,508 @@
 #pragma once
 
+#include <clean-core/assert.hh>
 #include <clean-core/fwd.hh>
+#include <clean-core/macros.hh>
+#include <clean-core/utility.hh>
 
-namespace cc
+#include <concepts>
+#include <type_traits>
+#include <utility> // index_sequence
+
+namespace cc::impl
 {
+/// Storage for exactly one of Ts (or none while a variant switches alternatives).
+/// Trivially copyable / destructible if all Ts are, otherwise copy is deleted and the variant manages lifetimes.
 template <class... Ts>
-struct variant
+union variant_union
+{
+};
+
+template <class T, class... Ts>
+union variant_union<T, Ts...>
 {
-    // TODO: implement variant
+    T head;
+    variant_union<Ts...> tail;
+
+    constexpr variant_union() {} // no active member
+
+    variant_union(variant_union const&) = default;
+    variant_union& operator=(variant_union const&) = default;
+
+    ~variant_union()
+        requires(std::is_trivially_destructible_v<T> && (std::is_trivially_destructible_v<Ts> && ...))
+    = default;
+    constexpr ~variant_union()
+        requires(!std::is_trivially_destructible_v<T> || (!std::is_trivially_destructible_v<Ts> || ...))
+    {
+    }
 };
 
-} // namespace cc
+template <std::size_t I, class U>
+[[nodiscard]] CC_FORCE_INLINE constexpr auto&& variant_union_get(U&& u)
+{
+    if constexpr (I == 0)
+        return cc::forward<U>(u).head;
+    else
+        return impl::variant_union_get<I - 1>(cc::forward<U>(u).tail);
+}
+
+template <std::size_t I, class... Ts>
+using variant_alternative_t
+    = std::remove_reference_t<decltype(impl::variant_union_get<I>(std::declval<variant_union<Ts...>&>()))>;
+
+template <std::size_t I, class F, class StorageRef>
+using variant_visit_result_t
+    = decltype(cc::invoke(std::declval<F&>(), impl::variant_union_get<I>(std::declval<StorageRef>())));
+
+/// Returns the index of the single true entry, -1 if there is none and -2 if there are several.
+template <std::size_t N>
+[[nodiscard]] constexpr isize variant_find_unique(bool const (&matches)[N])
+{
+    isize result = -1;
+    for (std::size_t i = 0; i < N; ++i)
+        if (matches[i])
+            result = result == -1 ? isize(i) : -2;
+    return result;
+}
+
+/// Alternative selected by the converting constructor and assignment:
+/// the alternative of exactly the same type, otherwise the only alternative constructible from U.
+template <class U, class... Ts>
+[[nodiscard]] consteval isize variant_select_index()
+{
+    constexpr isize exact = impl::variant_find_unique({std::is_same_v<std::remove_cvref_t<U>, Ts>...});
+    if constexpr (exact != -1)
+        return exact;
+    else
+        return impl::variant_find_unique({std::is_constructible_v<Ts, U&&>...});
+}
+
+/// Calls f(std::integral_constant<std::size_t, index>{}) for a runtime index < N.
+/// This is a switch over 32 alternatives at a time, so f is inlined into each case and the compiler emits
+/// a jump table (or a branch cascade for few alternatives) instead of calls through function pointers.
+/// Alternatives beyond the first 32 are handled by a chained switch in the default case.
+template <class R, std::size_t N, std::size_t Offset = 0, class F>
+CC_FORCE_INLINE constexpr R variant_dispatch(isize index, F&& f)
+{
+#define CC_IMPL_VARIANT_DISPATCH_CASE(I)                                 \
+    case I:                                                              \
+        if constexpr (Offset + I < N)                                    \
+            return f(std::integral_constant<std::size_t, Offset + I>{}); \
+        else                                                             \
+            CC_BUILTIN_UNREACHABLE;
+
+    switch (index - isize(Offset))
+    {
+        CC_IMPL_VARIANT_DISPATCH_CASE(0)
+        CC_IMPL_VARIANT_DISPATCH_CASE(1)
+        CC_IMPL_VARIANT_DISPATCH_CASE(2)
+        CC_IMPL_VARIANT_DISPATCH_CASE(3)
+        CC_IMPL_VARIANT_DISPATCH_CASE(4)
+        CC_IMPL_VARIANT_DISPATCH_CASE(5)
+        CC_IMPL_VARIANT_DISPATCH_CASE(6)
+        CC_IMPL_VARIANT_DISPATCH_CASE(7)
+        CC_IMPL_VARIANT_DISPATCH_CASE(8)
+        CC_IMPL_VARIANT_DISPATCH_CASE(9)
+        CC_IMPL_VARIANT_DISPATCH_CASE(10)
+        CC_IMPL_VARIANT_DISPATCH_CASE(11)
+        CC_IMPL_VARIANT_DISPATCH_CASE(12)
+        CC_IMPL_VARIANT_DISPATCH_CASE(13)
+        CC_IMPL_VARIANT_DISPATCH_CASE(14)
+        CC_IMPL_VARIANT_DISPATCH_CASE(15)
+        CC_IMPL_VARIANT_DISPATCH_CASE(16)
+        CC_IMPL_VARIANT_DISPATCH_CASE(17)
+        CC_IMPL_VARIANT_DISPATCH_CASE(18)
+        CC_IMPL_VARIANT_DISPATCH_CASE(19)
+        CC_IMPL_VARIANT_DISPATCH_CASE(20)
+        CC_IMPL_VARIANT_DISPATCH_CASE(21)
+        CC_IMPL_VARIANT_DISPATCH_CASE(22)
+        CC_IMPL_VARIANT_DISPATCH_CASE(23)
+        CC_IMPL_VARIANT_DISPATCH_CASE(24)
+        CC_IMPL_VARIANT_DISPATCH_CASE(25)
+        CC_IMPL_VARIANT_DISPATCH_CASE(26)
+        CC_IMPL_VARIANT_DISPATCH_CASE(27)
+        CC_IMPL_VARIANT_DISPATCH_CASE(28)
+        CC_IMPL_VARIANT_DISPATCH_CASE(29)
+        CC_IMPL_VARIANT_DISPATCH_CASE(30)
+        CC_IMPL_VARIANT_DISPATCH_CASE(31)
+    default:
+        if constexpr (Offset + 32 < N)
+            return impl::variant_dispatch<R, N, Offset + 32>(index, f);
+        else
+            CC_BUILTIN_UNREACHABLE;
+    }
+
+#undef CC_IMPL_VARIANT_DISPATCH_CASE
+}
+} // namespace cc::impl
+
+/// Type-safe tagged union holding exactly one value of one of the types Ts, similar to std::variant.
+///
+/// Compared to std::variant:
+///   - the discriminant is as small as possible (u8 for up to 256 alternatives) and stored after the value,
+///     e.g. sizeof(cc::variant<u32, float>) == 8
+///   - no valueless_by_exception state: a variant always holds a value
+///     (alternatives must be nothrow move constructible, those whose constructor may throw
+///      are constructed into a temporary before switching)
+///   - visit is a switch over the index, so the visitor is inlined into each case (no function pointer table)
+///   - trivially copyable / destructible whenever all Ts are
+///   - conversion from a value picks the alternative of the same type or else the only constructible one,
+///     ambiguous conversions do not compile (use create_emplaced<T>(...) instead)
+///
+/// Usage:
+///   using message = cc::variant<move_cmd, attack_cmd, chat_msg>;
+///   message m = move_cmd{...};
+///   m.visit([&](auto const& cmd) { handle(cmd); });
+///
+///   if (m.is<chat_msg>())
+///       print(m.get<chat_msg>().text);
+///   if (auto* cmd = m.get_ptr<attack_cmd>())
+///       ...
+template <class... Ts>
+struct cc::variant
+{
+    static_assert(sizeof...(Ts) > 0, "variant needs at least one alternative");
+    static_assert(sizeof...(Ts) <= 65536, "too many alternatives");
+    static_assert((std::is_object_v<Ts> && ...) && (!std::is_array_v<Ts> && ...),
+                  "variant alternatives must be non-array object types (no references/void)");
+    static_assert((std::is_nothrow_move_constructible_v<Ts> && ...), "alternatives must be nothrow move constructible");
+
+    using index_t = std::conditional_t<(sizeof...(Ts) <= 256), u8, u16>;
+
+    template <isize I>
+    using alternative_t = impl::variant_alternative_t<I, Ts...>;
+
+    // queries
+public:
+    /// Returns the number of alternatives.
+    [[nodiscard]] static constexpr isize alternative_count() { return sizeof...(Ts); }
+
+    /// Returns the index of alternative T, which must occur exactly once in Ts (compile-time check).
+    template <class T>
+    [[nodiscard]] static constexpr isize index_of()
+    {
+        constexpr isize idx = impl::variant_find_unique({std::is_same_v<T, Ts>...});
+        static_assert(idx != -1, "T is not an alternative of this variant");
+        static_assert(idx != -2, "T occurs several times in this variant, use the index instead");
+        return idx;
+    }
+
+    /// Returns the index of the held alternative.
+    [[nodiscard]] constexpr isize index() const { return _index; }
+
+    /// Returns true if the variant holds a T.
+    template <class T>
+    [[nodiscard]] constexpr bool is() const
+    {
+        return _index == index_of<T>();
+    }
+
+    // access
+public:
+    /// Returns the I-th alternative, forwarding the value category of the variant.
+    /// Requires index() == I.
+    template <isize I>
+    [[nodiscard]] constexpr auto&& get(this auto&& self)
+    {
+        static_assert(0 <= I && I < isize(sizeof...(Ts)), "index out of bounds");
+        CC_ASSERT(self._index == I, "variant does not hold the requested alternative");
+        return impl::variant_union_get<I>(static_cast<decltype(self)&&>(self)._storage);
+    }
+
+    /// Returns the held T, forwarding the value category of the variant.
+    /// Requires is<T>().
+    template <class T>
+    [[nodiscard]] constexpr auto&& get(this auto&& self)
+    {
+        return static_cast<decltype(self)&&>(self).template get<index_of<T>()>();
+    }
+
+    /// Returns a pointer to the held T, or nullptr if the variant holds another alternative.
+    template <class T>
+    [[nodiscard]] constexpr T* get_ptr()
+    {
+        return is<T>() ? &impl::variant_union_get<index_of<T>()>(_storage) : nullptr;
+    }
+    template <class T>
+    [[nodiscard]] constexpr T const* get_ptr() const
+    {
+        return is<T>() ? &impl::variant_union_get<index_of<T>()>(_storage) : nullptr;
+    }
+
+    /// Calls f with the held value (forwarding the value category of the variant) and returns its result.
+    /// f must return the same type for all alternatives.
+    /// Usage:
+    ///   auto const area = shape.visit([](auto const& s) { return s.area(); });
+    template <class F>
+    constexpr decltype(auto) visit(this auto&& self, F&& f)
+    {
+        return variant::impl_visit(static_cast<decltype(self)&&>(self), f);
+    }
+
+    // modification
+public:
+    /// Destroys the held value and constructs the I-th alternative from args.
+    /// Returns a reference to the new value.
+    /// WARNING: if that constructor is noexcept, args must not refer to the current value (it is destroyed first).
+    template <isize I, class... Args>
+    constexpr alternative_t<I>& emplace(Args&&... args)
+    {
+        using T = alternative_t<I>;
+        static_assert(std::is_constructible_v<T, Args&&...>, "alternative is not constructible from these arguments");
+
+        if constexpr (std::is_nothrow_constructible_v<T, Args&&...>)
+        {
+            impl_destroy();
+            new (cc::placement_new, &impl::variant_union_get<I>(_storage)) T(cc::forward<Args>(args)...);
+            _index = index_t(I);
+        }
+        else
+        {
+            // never leaves the variant without a value, even if the constructor throws
+            impl_replace_with<I>(T(cc::forward<Args>(args)...));
+        }
+        return impl::variant_union_get<I>(_storage);
+    }
+
+    /// Destroys the held value and constructs a T from args.
+    template <class T, class... Args>
+    constexpr T& emplace(Args&&... args)
+    {
+        return emplace<index_of<T>()>(cc::forward<Args>(args)...);
+    }
+
+    /// Assigns to the held value if it has the selected alternative, otherwise switches alternatives.
+    template <class U, isize I = impl::variant_select_index<U, Ts...>()>
+        requires(!std::is_same_v<std::remove_cvref_t<U>, variant> && I >= 0)
+    constexpr variant& operator=(U&& value)
+    {
+        if constexpr (std::is_assignable_v<alternative_t<I>&, U&&>)
+        {
+            if (_index == I)
+            {
+                impl::variant_union_get<I>(_storage) = cc::forward<U>(value);
+                return *this;
+            }
+        }
+        emplace<I>(cc::forward<U>(value));
+        return *this;
+    }
+
+    // comparison
+public:
+    /// Equal if both hold the same alternative with equal values.
+    [[nodiscard]] friend constexpr bool operator==(variant const& a, variant const& b)
+        requires(std::equality_comparable<Ts> && ...)
+    {
+        if (a._index != b._index)
+            return false;
+        return impl::variant_dispatch<bool, sizeof...(Ts)>(
+            a._index,
+            [&](auto i)
+            {
+                constexpr auto I = decltype(i)::value;
+                return bool(impl::variant_union_get<I>(a._storage) == impl::variant_union_get<I>(b._storage));
+            });
+    }
+
+    // construction
+public:
+    /// Holds a value-initialized first alternative.
+    constexpr variant()
+        requires std::is_default_constructible_v<alternative_t<0>>
+    {
+        new (cc::placement_new, &_storage.head) alternative_t<0>();
+    }
+
+    /// Holds the alternative of the same type as value, or else the only alternative constructible from it.
+    template <class U, isize I = impl::variant_select_index<U, Ts...>()>
+        requires(!std::is_same_v<std::remove_cvref_t<U>, variant> && I >= 0)
+    constexpr variant(U&& value) : _index(index_t(I)) // NOLINT
+    {
+        new (cc::placement_new, &impl::variant_union_get<I>(_storage)) alternative_t<I>(cc::forward<U>(value));
+    }
+
+    /// Creates a variant holding the I-th alternative constructed in-place from args.
+    /// Also works for ambiguous conversions and duplicate alternatives.
+    template <isize I, class... Args>
+    [[nodiscard]] static constexpr variant create_emplaced(Args&&... args)
+    {
+        static_assert(std::is_constructible_v<alternative_t<I>, Args&&...>,
+                      "alternative is not constructible from these arguments");
+        variant v{impl_uninitialized_tag{}};
+        new (cc::placement_new, &impl::variant_union_get<I>(v._storage)) alternative_t<I>(cc::forward<Args>(args)...);
+        v._index = index_t(I);
+        return v;
+    }
+
+    /// Creates a variant holding a T constructed in-place from args.
+    template <class T, class... Args>
+    [[nodiscard]] static constexpr variant create_emplaced(Args&&... args)
+    {
+        return create_emplaced<index_of<T>()>(cc::forward<Args>(args)...);
+    }
+
+    // trivial copy/move/destroy - defaulted when all alternatives allow bitwise operations
+public:
+    variant(variant&&)
+        requires(std::is_trivially_copyable_v<Ts> && ...)
+    = default;
+    variant(variant const&)
+        requires(std::is_trivially_copyable_v<Ts> && ...)
+    = default;
+    variant& operator=(variant&&)
+        requires(std::is_trivially_copyable_v<Ts> && ...)
+    = default;
+    variant& operator=(variant const&)
+        requires(std::is_trivially_copyable_v<Ts> && ...)
+    = default;
+
+    ~variant()
+        requires(std::is_trivially_destructible_v<Ts> && ...)
+    = default;
+
+    // non-trivial copy/move/destroy
+public:
+    /// Moves the held value, rhs keeps its (moved-from) alternative.
+    constexpr variant(variant&& rhs) noexcept
+        requires(!(std::is_trivially_copyable_v<Ts> && ...))
+      : _index(rhs._index)
+    {
+        impl_construct_from(cc::move(rhs));
+    }
+
+    constexpr variant(variant const& rhs)
+        requires(!(std::is_trivially_copyable_v<Ts> && ...) && (std::is_copy_constructible_v<Ts> && ...))
+      : _index(rhs._index)
+    {
+        impl_construct_from(rhs);
+    }
+
+    /// Move-assigns if both hold the same alternative, otherwise destroys and move-constructs.
+    /// rhs keeps its (moved-from) alternative.
+    constexpr variant& operator=(variant&& rhs) noexcept((std::is_nothrow_move_assignable_v<Ts> && ...))
+        requires(!(std::is_trivially_copyable_v<Ts> && ...))
+    {
+        if (this == &rhs)
+            return *this;
+
+        if (_index == rhs._index)
+        {
+            impl::variant_dispatch<void, sizeof...(Ts)>(_index,
+                                                        [&](auto i)
+                                                        {
+                                                            constexpr auto I = decltype(i)::value;
+                                                            impl::variant_union_get<I>(_storage)
+                                                                = cc::move(impl::variant_union_get<I>(rhs._storage));
+                                                        });
+        }
+        else
+        {
+            // rhs can be reachable through our current alternative (e.g. a tree of variants),
+            // so its value is moved out before that alternative is destroyed
+            impl::variant_dispatch<void, sizeof...(Ts)>(
+                rhs._index,
+                [&](auto i)
+                {
+                    constexpr auto I = decltype(i)::value;
+                    impl_replace_with<I>(alternative_t<I>(cc::move(impl::variant_union_get<I>(rhs._storage))));
+                });
+        }
+        return *this;
+    }
+
+    /// Copy-assigns if both hold the same alternative, otherwise copies into a temporary and switches alternatives.
+    constexpr variant& operator=(variant const& rhs)
+        requires(!(std::is_trivially_copyable_v<Ts> && ...)
+                 && ((std::is_copy_constructible_v<Ts> && std::is_copy_assignable_v<Ts>) && ...))
+    {
+        if (this == &rhs)
+            return *this;
+
+        impl::variant_dispatch<void, sizeof...(Ts)>(
+            rhs._index,
+            [&](auto i)
+            {
+                constexpr auto I = decltype(i)::value;
+                auto const& value = impl::variant_union_get<I>(rhs._storage);
+                if (_index == I)
+                    impl::variant_union_get<I>(_storage) = value;
+                else // copied before our value is destroyed, rhs might be reachable through it
+                    impl_replace_with<I>(alternative_t<I>(value));
+            });
+        return *this;
+    }
+
+    constexpr ~variant()
+        requires(!(std::is_trivially_destructible_v<Ts> && ...))
+    {
+        impl_destroy();
+    }
+
+    // implementation helpers
+private:
+    struct impl_uninitialized_tag
+    {
+    };
+    constexpr explicit variant(impl_uninitialized_tag) {}
+
+    template <class Self, class F>
+    static constexpr decltype(auto) impl_visit(Self&& self, F& f)
+    {
+        using storage_ref = decltype((cc::forward<Self>(self)._storage));
+        using R = impl::variant_visit_result_t<0, F, storage_ref>;
+        static_assert([]<std::size_t... Is>(std::index_sequence<Is...>)
+                      { return (std::is_same_v<R, impl::variant_visit_result_t<Is, F, storage_ref>> && ...); }(
+                          std::index_sequence_for<Ts...>{}),
+                      "visitor must return the same type for all alternatives");
+
+        return impl::variant_dispatch<R, sizeof...(Ts)>(
+            self._index, [&](auto i) -> R
+            { return cc::invoke(f, impl::variant_union_get<decltype(i)::value>(cc::forward<Self>(self)._storage)); });
+    }
+
+    // constructs the alternative _index from the same alternative of rhs (copy or move)
+    template <class V>
+    constexpr void impl_construct_from(V&& rhs)
+    {
+        impl::variant_dispatch<void, sizeof...(Ts)>(
+            _index,
+            [&](auto i)
+            {
+                constexpr auto I = decltype(i)::value;
+                new (cc::placement_new, &impl::variant_union_get<I>(_storage))
+                    alternative_t<I>(impl::variant_union_get<I>(cc::forward<V>(rhs)._storage));
+            });
+    }
+
+    // destroys the held value and switches to the I-th alternative, value must not alias the held value
+    template <isize I>
+    constexpr void impl_replace_with(alternative_t<I>&& value) noexcept
+    {
+        impl_destroy();
+        new (cc::placement_new, &impl::variant_union_get<I>(_storage)) alternative_t<I>(cc::move(value));
+        _index = index_t(I);
+    }
+
+    constexpr void impl_destroy()
+    {
+        if constexpr (!(std::is_trivially_destructible_v<Ts> && ...))
+        {
+            impl::variant_dispatch<void, sizeof...(Ts)>(_index,
+                                                        [&](auto i)
+                                                        {
+                                                            using T = alternative_t<decltype(i)::value>;
+                                                            impl::variant_union_get<decltype(i)::value>(_storage).~T();
+                                                        });
+        }
+    }
+
+    // members
+private:
+    impl::variant_union<Ts...> _storage;
+
+    /// Index of the alternative in _storage.
+    /// Placed after _storage so that small alternatives share its alignment padding.
+    index_t _index = 0;
+};
@@ -0,0 +1,284 @@
+#include <clean-core/bitset.hh>
+#include <clean-core/vector.hh>
+
+#include <nexus/test.hh>
+
+#include <random>
+#include <vector>
+
+using namespace cc::primitive_defines;
+
+namespace
+{
+// compares every bit plus the word-level invariant (bits past size are zero)
+bool matches(cc::bitset const& b, std::vector<bool> const& ref)
+{
+    if (b.size() != isize(ref.size()))
+        return false;
+    for (isize i = 0; i < b.size(); ++i)
+        if (b.test(i) != ref[i])
+            return false;
+    if (b.size() % 64 != 0 && (b.words()[b.word_count() - 1] >> (b.size() % 64)) != 0)
+        return false;
+    return true;
+}
+
+cc::bitset random_bitset(isize size, std::mt19937& rng, std::vector<bool>& ref)
+{
+    auto b = cc::bitset::create_with_size(size);
+    ref.assign(size, false);
+    for (isize i = 0; i < size; ++i)
+    {
+        auto const v = rng() % 3 == 0;
+        b.set(i, v);
+        ref[i] = v;
+    }
+    return b;
+}
+
+bool same_indices(cc::vector<isize> const& a, cc::vector<isize> const& b)
+{
+    if (a.size() != b.size())
+        return false;
+    for (isize i = 0; i < a.size(); ++i)
+        if (a[i] != b[i])
+            return false;
+    return true;
+}
+} // namespace
+
+TEST("bitset - basics")
+{
+    cc::bitset empty;
+    CHECK(empty.empty());
+    CHECK(empty.count() == 0);
+    CHECK(empty.none());
+    CHECK(empty.all());
+    CHECK(empty.find_first() == -1);
+
+    auto b = cc::bitset::create_with_size(130);
+    CHECK(b.size() == 130);
+    CHECK(b.word_count() == 3);
+    CHECK(b.none());
+
+    b.set(0);
+    b.set(64);
+    b.set(129);
+    CHECK(b.count() == 3);
+    CHECK(b[64]);
+    CHECK(!b[63]);
+    CHECK(b.find_first() == 0);
+    CHECK(b.find_next(0) == 64);
+    CHECK(b.find_next(64) == 129);
+    CHECK(b.find_next(129) == -1);
+
+    b.flip(64);
+    b.clear(0);
+    CHECK(b.count() == 1);
+    CHECK(b.find_first() == 129);
+
+    b.set(5, true);
+    b.set(129, false);
+    CHECK(b.count() == 1);
+    CHECK(b.test(5));
+
+    auto full = cc::bitset::create_filled(130, true);
+    CHECK(full.all());
+    CHECK(full.count() == 130);
+    CHECK(full.words()[2] == 0b11);
+}
+
+TEST("bitset - bitwise ops against std::vector<bool>")
+{
+    std::mt19937 rng(1);
+    for (isize size : {1, 63, 64, 65, 127, 128, 500, 1000, 4099})
+    {
+        std::vector<bool> ra, rb;
+        auto a = random_bitset(size, rng, ra);
+        auto const b = random_bitset(size, rng, rb);
+
+        auto r_and = ra, r_or = ra, r_xor = ra, r_andnot = ra, r_not = ra;
+        isize expected_count = 0;
+        for (isize i = 0; i < size; ++i)
+        {
+            r_and[i] = ra[i] && rb[i];
+            r_or[i] = ra[i] || rb[i];
+            r_xor[i] = ra[i] != rb[i];
+            r_andnot[i] = ra[i] && !rb[i];
+            r_not[i] = !ra[i];
+            expected_count += ra[i];
+        }
+
+        CHECK(a.count() == expected_count);
+        CHECK(matches(a & b, r_and));
+        CHECK(matches(a | b, r_or));
+        CHECK(matches(a ^ b, r_xor));
+        CHECK(matches(~a, r_not));
+        CHECK((~~a) == a);
+
+        auto c = a;
+        c.and_not(b);
+        CHECK(matches(c, r_andnot));
+        CHECK(c != a || r_andnot == ra);
+
+        a |= b;
+        CHECK(matches(a, r_or));
+        a &= b;
+        CHECK(a == b);
+        a ^= b;
+        CHECK(a.none());
+    }
+}
+
+TEST("bitset - ranges and find")
+{
+    std::mt19937 rng(2);
+    constexpr isize size = 777;
+    auto b = cc::bitset::create_with_size(size);
+    std::vector<bool> ref(size, false);
+
+    for (auto iter = 0; iter < 300; ++iter)
+    {
+        auto const start = isize(rng() % size);
+        auto const count = isize(rng() % (size - start + 1));
+        auto const value = rng() % 2 == 0;
+        if (value)
+            b.set_range(start, count);
+        else
+            b.clear_range(start, count);
+        for (isize i = start; i < start + count; ++i)
+            ref[i] = value;
+    }
+    CHECK(matches(b, ref));
+
+    // find_next walks exactly the set bits
+    auto consistent = true;
+    isize pos = -1;
+    for (isize i = 0; i < size; ++i)
+        if (ref[i])
+        {
+            pos = b.find_next(pos);
+            consistent &= pos == i;
+        }
+    consistent &= b.find_next(pos) == -1;
+    CHECK(consistent);
+
+    // sparse bits far apart exercise the empty-word skipping
+    auto sparse = cc::bitset::create_with_size(100'000);
+    sparse.set(3);
+    sparse.set(70'000);
+    sparse.set(99'999);
+    CHECK(sparse.find_next(3) == 70'000);
+    CHECK(sparse.find_next(70'000) == 99'999);
+
+    b.set_all();
+    CHECK(b.all());
+    b.clear_range(size - 1, 1);
+    CHECK(!b.all());
+    b.clear_all();
+    CHECK(b.none());
+}
+
+TEST("bitset - set bit iteration")
+{
+    std::mt19937 rng(3);
+    std::vector<bool> ref;
+    auto const b = random_bitset(1000, rng, ref);
+
+    cc::vector<isize> expected;
+    for (isize i = 0; i < 1000; ++i)
+        if (ref[i])
+            expected.push_back(i);
+
+    cc::vector<isize> from_range;
+    for (isize i : b.set_bits())
+        from_range.push_back(i);
+    CHECK(same_indices(from_range, expected));
+
+    cc::vector<isize> from_callback;
+    b.for_each_set_bit([&](isize i) { from_callback.push_back(i); });
+    CHECK(same_indices(from_callback, expected));
+
+    auto const none = cc::bitset::create_with_size(300);
+    auto visited = 0;
+    for ([[maybe_unused]] isize i : none.set_bits())
+        ++visited;
+    CHECK(visited == 0);
+}
+
+TEST("bitset - resize and push_back")
+{
+    cc::bitset b;
+    std::vector<bool> ref;
+    std::mt19937 rng(4);
+    for (auto i = 0; i < 1000; ++i)
+    {
+        auto const v = rng() % 2 == 0;
+        b.push_back(v);
+        ref.push_back(v);
+    }
+    CHECK(matches(b, ref));
+
+    b.resize(70);
+    ref.resize(70);
+    CHECK(matches(b, ref));
+
+    // re-grown bits must not resurrect the old values
+    b.resize(300);
+    ref.resize(300, false);
+    CHECK(matches(b, ref));
+
+    b.resize(400, true);
+    ref.resize(400, true);
+    CHECK(matches(b, ref));
+
+    b.resize(0);
+    CHECK(b.empty());
+    CHECK(b.word_count() == 0);
+
+    u64 const words[] = {0xFFFF'0000'0000'00FF, ~u64(0)};
+    auto const w = cc::bitset::create_from_words(words, 72);
+    CHECK(w.count() == 8 + 16 + 8);
+    CHECK(w.words()[1] == 0xFF);
+}
+
+TEST("bitset - copy and move")
+{
+    auto a = cc::bitset::create_with_size(200);
+    a.set_range(10, 100);
+
+    auto b = a;
+    CHECK(b == a);
+    b.clear(50);
+    CHECK(b != a);
+
+    auto small = cc::bitset::create_with_size(3);
+    small = a;
+    CHECK(small == a);
+
+    b = a;
+    CHECK(b == a);
+
+    auto c = cc::move(b);
+    CHECK(c == a);
+    CHECK(b.empty());
+    CHECK(b.word_count() == 0);
+
+    b = cc::move(c);
+    CHECK(b == a);
+    CHECK(c.empty());
+}
+
+#if CC_ASSERT_ENABLED
+TEST("bitset - asserts")
+{
+    auto b = cc::bitset::create_with_size(10);
+    CHECK_ASSERTS((void)b.test(10));
+    CHECK_ASSERTS(b.set(-1));
+    CHECK_ASSERTS(b.set_range(5, 6));
+    CHECK_ASSERTS((void)b.find_next(10));
+
+    auto other = cc::bitset::create_with_size(11);
+    CHECK_ASSERTS(b &= other);
+}
+#endif
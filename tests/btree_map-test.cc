@@ -0,0 +1,376 @@
+#include <clean-core/btree_map.hh>
+#include <clean-core/node_arena.hh>
+#include <clean-core/string.hh>
+#include <clean-core/to_string.hh>
+
+#include <nexus/test.hh>
+
+#include <map>
+#include <memory>
+#include <random>
+
+using namespace cc::primitive_defines;
+
+namespace
+{
+template <class K, class V>
+bool same_entries(cc::btree_map<K, V> const& m, std::map<K, V> const& ref)
+{
+    if (m.size() != isize(ref.size()))
+        return false;
+    auto it = ref.begin();
+    for (auto [k, v] : m)
+    {
+        if (it == ref.end() || k != it->first || v != it->second)
+            return false;
+        ++it;
+    }
+    return it == ref.end();
+}
+
+// random inserts, lookups, range queries and removals against std::map
+template <class K>
+void check_against_std_map(u32 seed, int key_range, int ops)
+{
+    std::mt19937 rng(seed);
+    cc::btree_map<K, int> m;
+    std::map<K, int> ref;
+
+    for (auto i = 0; i < ops; ++i)
+    {
+        auto const k = K(int(rng() % u32(key_range)) - key_range / 3);
+        auto const op = rng() % 8;
+        if (op < 4)
+        {
+            m.insert_or_assign(k, i);
+            ref[k] = i;
+        }
+        else if (op < 6)
+        {
+            REQUIRE(m.remove(k) == (ref.erase(k) > 0));
+        }
+        else if (op < 7)
+        {
+            auto const p = m.get_ptr(k);
+            auto const r = ref.find(k);
+            REQUIRE((p != nullptr) == (r != ref.end()));
+            if (p != nullptr)
+                REQUIRE(*p == r->second);
+        }
+        else
+        {
+            auto const lb = m.lower_bound(k);
+            auto const ub = m.upper_bound(k);
+            auto const rlb = ref.lower_bound(k);
+            auto const rub = ref.upper_bound(k);
+            REQUIRE((lb == m.end()) == (rlb == ref.end()));
+            REQUIRE((ub == m.end()) == (rub == ref.end()));
+            if (rlb != ref.end())
+                REQUIRE((*lb).key == rlb->first);
+            if (rub != ref.end())
+                REQUIRE((*ub).key == rub->first);
+        }
+    }
+    REQUIRE(same_entries(m, ref));
+
+    // drain in random order to exercise all rebalancing paths
+    cc::vector<K> keys;
+    for (auto const& [k, v] : ref)
+        keys.push_back(k);
+    for (auto i = keys.size() - 1; i > 0; --i)
+        cc::swap(keys[i], keys[isize(rng() % u32(i + 1))]);
+    for (auto i = 0; i < keys.size(); ++i)
+    {
+        REQUIRE(m.remove(keys[i]));
+        ref.erase(keys[i]);
+        if (i % 97 == 0)
+            REQUIRE(same_entries(m, ref));
+    }
+    CHECK(m.empty());
+    CHECK(m.begin() == m.end());
+}
+} // namespace
+
+TEST("btree_map - basics")
+{
+    cc::btree_map<int, int> m;
+    CHECK(m.empty());
+    CHECK(m.get_ptr(1) == nullptr);
+    CHECK(m.begin() == m.end());
+    CHECK(m.lower_bound(0) == m.end());
+    CHECK(!m.remove(1));
+
+    m.insert_or_assign(5, 50);
+    m.insert_or_assign(1, 10);
+    m.insert_or_assign(3, 30);
+    CHECK(m.size() == 3);
+    CHECK(m.get(5) == 50);
+    CHECK(m.contains(1));
+    CHECK(!m.contains(2));
+
+    m.insert_or_assign(3, 31);
+    CHECK(m.get(3) == 31);
+    CHECK(!m.try_insert(3, 0));
+    CHECK(m.try_insert(4, 40));
+    m[0] += 7;
+    CHECK(m.get(0) == 7);
+    CHECK(m.get_or_emplace(0, 100) == 7);
+    CHECK(m.size() == 5);
+
+    auto prev = -1;
+    for (auto [k, v] : m)
+    {
+        CHECK(k > prev);
+        prev = k;
+        v += 1;
+    }
+    CHECK(m.get(4) == 41);
+
+    CHECK(m.remove(3));
+    CHECK(!m.remove(3));
+    CHECK(m.pop(0).value() == 8);
+    CHECK(!m.pop(0).has_value());
+    CHECK(m.size() == 3);
+
+    m.clear();
+    CHECK(m.empty());
+    m[2] = 1;
+    CHECK(m.size() == 1);
+}
+
+TEST("btree_map - range queries")
+{
+    cc::btree_map<u64, u64> m;
+    for (u64 i = 0; i < 1000; ++i)
+        m.insert_or_assign(i * 2, i);
+
+    // all keys in [100, 200]
+    u64 sum = 0;
+    isize count = 0;
+    for (auto it = m.lower_bound(u64(100)); it != m.end() && (*it).key <= 200; ++it)
+    {
+        sum += (*it).key;
+        ++count;
+    }
+    CHECK(count == 51);
+    CHECK(sum == 51 * 150);
+
+    CHECK((*m.lower_bound(u64(101))).key == 102);
+    CHECK((*m.upper_bound(u64(100))).key == 102);
+    CHECK((*m.upper_bound(u64(99))).key == 100);
+    CHECK(m.lower_bound(u64(1999)) == m.end());
+    CHECK(m.upper_bound(u64(1998)) == m.end());
+    CHECK((*m.lower_bound(u64(0))).key == 0);
+
+    auto const& cm = m;
+    CHECK((*cm.lower_bound(u64(7))).value == 4);
+}
+
+TEST("btree_map - randomized against std::map")
+{
+    check_against_std_map<int>(1, 50, 2000);
+    check_against_std_map<int>(2, 5000, 30000);
+    check_against_std_map<u32>(3, 3000, 20000);
+    check_against_std_map<u64>(4, 3000, 20000);
+    check_against_std_map<i16>(5, 1000, 10000);
+    check_against_std_map<f32>(6, 3000, 20000);
+    check_against_std_map<f64>(7, 3000, 20000);
+}
+
+TEST("btree_map - increasing and decreasing insertion")
+{
+    std::map<int, int> ref;
+    cc::btree_map<int, int> up;
+    cc::btree_map<int, int> down;
+    for (auto i = 0; i < 10000; ++i)
+    {
+        up.insert_or_assign(i, i);
+        down.insert_or_assign(9999 - i, 9999 - i);
+        ref[i] = i;
+    }
+    CHECK(same_entries(up, ref));
+    CHECK(same_entries(down, ref));
+
+    // removing a contiguous range merges many neighboring nodes
+    for (auto i = 2000; i < 8000; ++i)
+    {
+        REQUIRE(up.remove(i));
+        ref.erase(i);
+    }
+    CHECK(same_entries(up, ref));
+    CHECK((*up.lower_bound(2000)).key == 8000);
+}
+
+TEST("btree_map - string keys")
+{
+    cc::btree_map<cc::string, int> m = {{"pear", 2}, {"apple", 1}, {"plum", 3}, {"apple", 4}};
+    CHECK(m.size() == 3);
+    CHECK(m.get("apple") == 4);
+    CHECK(m.get(cc::string_view("plum")) == 3);
+    CHECK((*m.begin()).key == "apple");
+
+    std::mt19937 rng(8);
+    std::map<cc::string, int> ref;
+    for (auto i = 0; i < 5000; ++i)
+    {
+        auto k = cc::to_string(rng() % 2000);
+        if (rng() % 3 == 0)
+        {
+            REQUIRE(m.remove(k) == (ref.erase(k) > 0));
+        }
+        else
+        {
+            m[k] = i;
+            ref[k] = i;
+        }
+    }
+    for (auto const& [k, v] : ref)
+        REQUIRE(m.get(k) == v);
+
+    auto copy = m;
+    copy["zzz"] = 5;
+    CHECK(copy.size() == m.size() + 1);
+    CHECK(!m.contains("zzz"));
+
+    auto moved = cc::move(copy);
+    CHECK(copy.empty());
+    CHECK(moved.get("zzz") == 5);
+    moved = m;
+    CHECK(moved.size() == m.size());
+}
+
+TEST("btree_map - bulk load")
+{
+    for (auto n : {0, 1, 2, 13, 100, 5000})
+    {
+        cc::vector<int> keys;
+        cc::vector<cc::string> values;
+        std::map<int, cc::string> ref;
+        for (auto i = 0; i < n; ++i)
+        {
+            keys.push_back(i * 3);
+            values.push_back(cc::to_string(i));
+            ref[i * 3] = cc::to_string(i);
+        }
+
+        auto m = cc::btree_map<int, cc::string>::create_from_sorted(cc::move(keys), cc::move(values));
+        REQUIRE(same_entries(m, ref));
+
+        // the right edge of a bulk-loaded tree is only partially filled
+        for (auto i = n - 1; i >= 0 && i > n - 40; --i)
+        {
+            REQUIRE(m.remove(i * 3));
+            ref.erase(i * 3);
+        }
+        m.insert_or_assign(1, "x");
+        ref[1] = "x";
+        REQUIRE(same_entries(m, ref));
+    }
+
+    SECTION("bulk-loaded trees rebalance like grown ones")
+    {
+        // sizes around multiples of the leaf and inner capacities, so the last nodes of each level are balanced
+        std::mt19937 rng(7);
+        for (auto n : {3, 15, 16, 17, 31, 33, 255, 256, 257, 1000, 4097, 20'000})
+        {
+            cc::vector<int> keys;
+            cc::vector<int> values;
+            for (auto i = 0; i < n; ++i)
+            {
+                keys.push_back(i);
+                values.push_back(-i);
+            }
+            auto m = cc::btree_map<int, int>::create_from_sorted(cc::move(keys), cc::move(values));
+            REQUIRE(m.size() == n);
+
+            auto copy = m;
+            cc::vector<int> order;
+            for (auto i = 0; i < n; ++i)
+                order.push_back(i);
+            for (auto i = n - 1; i > 0; --i)
+                cc::swap(order[i], order[isize(rng() % u32(i + 1))]);
+            for (auto i = 0; i < n; ++i)
+            {
+                REQUIRE(copy.get(order[i]) == -order[i]);
+                REQUIRE(m.remove(order[i]));
+                if (i % 101 == 0)
+                    REQUIRE(m.lower_bound(order[i]) == m.upper_bound(order[i]));
+            }
+            CHECK(m.empty());
+            CHECK(copy.size() == n);
+        }
+    }
+}
+
+TEST("btree_map - custom node resource")
+{
+    cc::node_arena arena;
+    {
+        auto m = cc::btree_map<int, int>::create_with_resource(arena.resource());
+        for (auto i = 0; i < 1000; ++i)
+            m.insert_or_assign(i * 7 % 1000, i);
+        CHECK(m.size() == 1000);
+        for (auto i = 0; i < 1000; i += 2)
+            CHECK(m.remove(i));
+        CHECK(m.size() == 500);
+
+        auto const copy = m;
+        CHECK(copy.get(1) == m.get(1));
+
+    }
+
+    SECTION("copy assignment allocates from the target resource")
+    {
+        cc::btree_map<int, int> plain;
+        auto in_arena = cc::btree_map<int, int>::create_with_resource(arena.resource());
+        for (auto i = 0; i < 500; ++i)
+            in_arena.insert_or_assign(i, i);
+
+        // reset asserts that no arena node is alive, so plain must not hold any
+        plain = in_arena;
+        in_arena.clear();
+        arena.reset();
+        CHECK(plain.size() == 500);
+        CHECK(plain.get(499) == 499);
+
+        in_arena = plain;
+        CHECK(arena.allocated_bytes() > 0);
+        CHECK(in_arena.get(499) == 499);
+    }
+}
+
+TEST("btree_map - subobject-safe move assignment")
+{
+    // a map whose values own maps of the same type
+    struct tree
+    {
+        int id = 0;
+        std::unique_ptr<cc::btree_map<int, tree>> children;
+    };
+
+    cc::btree_map<int, tree> m;
+    for (auto i = 0; i < 100; ++i)
+        m.insert_or_assign(i, tree{i, nullptr});
+
+    m.get(3).children = std::make_unique<cc::btree_map<int, tree>>();
+    for (auto i = 0; i < 50; ++i)
+        m.get(3).children->insert_or_assign(1000 + i, tree{1000 + i, nullptr});
+
+    // rhs lives inside a value of m, it must be taken before m releases its nodes
+    m = cc::move(*m.get(3).children);
+    CHECK(m.size() == 50);
+    CHECK(m.get(1010).id == 1010);
+}
+
+#if CC_ASSERT_ENABLED
+TEST("btree_map - asserts")
+{
+    cc::btree_map<int, int> m;
+    CHECK_ASSERTS((void)m.get(1));
+    CHECK_ASSERTS((void)*m.begin());
+
+    cc::vector<int> keys = {2, 1};
+    cc::vector<int> values = {0, 0};
+    CHECK_ASSERTS((void)cc::btree_map<int, int>::create_from_sorted(cc::move(keys), cc::move(values)));
+}
+#endif
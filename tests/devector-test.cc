@@ -0,0 +1,250 @@
+#include <clean-core/devector.hh>
+
+#include <nexus/test.hh>
+
+#include <deque>
+#include <random>
+#include <string>
+
+using namespace cc::primitive_defines;
+
+namespace
+{
+struct tracked
+{
+    static inline int alive = 0;
+    int value;
+
+    tracked(int v) : value(v) { ++alive; }
+    tracked(tracked const& rhs) : value(rhs.value) { ++alive; }
+    tracked(tracked&& rhs) noexcept : value(rhs.value) { ++alive; }
+    tracked& operator=(tracked const&) = default;
+    tracked& operator=(tracked&&) = default;
+    ~tracked() { --alive; }
+
+    bool operator==(int rhs) const { return value == rhs; }
+};
+
+template <class V>
+bool has_values(V const& v, std::initializer_list<int> values)
+{
+    if (v.size() != isize(values.size()))
+        return false;
+    isize i = 0;
+    for (auto x : values)
+        if (!(v[i++] == x))
+            return false;
+    return true;
+}
+} // namespace
+
+TEST("devector - basics")
+{
+    cc::devector<int> d;
+    CHECK(d.empty());
+    CHECK(d.capacity() == 0);
+
+    d.push_back(2);
+    d.push_front(1);
+    d.emplace_back(3);
+    d.emplace_front(0);
+    CHECK(has_values(d, {0, 1, 2, 3}));
+    CHECK(d.front() == 0);
+    CHECK(d.back() == 3);
+    CHECK(d.capacity() >= 4);
+
+    CHECK(d.pop_front() == 0);
+    CHECK(d.pop_back() == 3);
+    d.remove_front();
+    CHECK(has_values(d, {2}));
+
+    cc::devector<int> l = {1, 2, 3};
+    CHECK(has_values(l, {1, 2, 3}));
+    auto copy = l;
+    copy.push_front(0);
+    CHECK(has_values(copy, {0, 1, 2, 3}));
+    CHECK(has_values(l, {1, 2, 3}));
+
+    auto sum = 0;
+    for (auto x : copy)
+        sum += x;
+    CHECK(sum == 6);
+}
+
+TEST("devector - front and back growth")
+{
+    SECTION("push_front only")
+    {
+        cc::devector<int> d;
+        for (auto i = 0; i < 1000; ++i)
+            d.push_front(i);
+        auto ok = true;
+        for (auto i = 0; i < 1000; ++i)
+            ok &= d[i] == 999 - i;
+        CHECK(ok);
+
+        // capacity follows the push direction
+        CHECK(d.capacity_front() > d.capacity_back());
+    }
+    SECTION("push_back only")
+    {
+        cc::devector<int> d;
+        for (auto i = 0; i < 1000; ++i)
+            d.push_back(i);
+        CHECK(d.back() == 999);
+        CHECK(d.capacity_back() > d.capacity_front());
+    }
+    SECTION("reserve")
+    {
+        cc::devector<int> d = {1, 2};
+        d.reserve_front(10);
+        CHECK(d.has_capacity_front_for(10));
+        d.reserve_back(20);
+        CHECK(d.has_capacity_back_for(20));
+        CHECK(d.has_capacity_front_for(10));
+
+        auto const p = d.data();
+        for (auto i = 0; i < 10; ++i)
+            d.push_front(0);
+        CHECK(d.data() == p - 10);
+        CHECK(d.size() == 12);
+    }
+    SECTION("aliasing arguments")
+    {
+        cc::devector<std::string> d;
+        d.push_back("a string that is long enough to not use sso");
+        for (auto i = 0; i < 100; ++i)
+        {
+            d.push_front(d.back());
+            d.push_back(d.front());
+        }
+        auto ok = true;
+        for (auto const& s : d)
+            ok &= s == "a string that is long enough to not use sso";
+        CHECK(ok);
+        CHECK(d.size() == 201);
+    }
+}
+
+TEST("devector - queue reuses its allocation")
+{
+    cc::devector<int> d;
+    for (auto i = 0; i < 100; ++i)
+        d.push_back(i);
+
+    auto next = 100;
+    auto cycle = [&](int count)
+    {
+        for (auto i = 0; i < count; ++i)
+        {
+            d.remove_front();
+            d.push_back(next++);
+        }
+    };
+
+    // may grow once until at most half of the allocation is in use
+    cycle(1000);
+    auto const capacity = d.capacity();
+    CHECK(capacity <= 4 * 100);
+
+    // from then on, the front gap is recycled by re-centering
+    cycle(10'000);
+    CHECK(d.capacity() == capacity);
+    CHECK(d.size() == 100);
+    CHECK(d.front() == next - 100);
+    CHECK(d.back() == next - 1);
+}
+
+TEST("devector - random operations against std::deque")
+{
+    std::mt19937 rng(7);
+    cc::devector<tracked> d;
+    std::deque<int> ref;
+    tracked::alive = 0;
+
+    auto ok = true;
+    for (auto i = 0; i < 20'000; ++i)
+    {
+        auto const op = rng() % 8;
+        if (op < 3)
+        {
+            d.emplace_back(i);
+            ref.push_back(i);
+        }
+        else if (op < 6)
+        {
+            d.emplace_front(i);
+            ref.push_front(i);
+        }
+        else if (!ref.empty() && op == 6)
+        {
+            auto const idx = isize(rng() % ref.size());
+            ok &= d.pop_at(idx) == ref[idx];
+            ref.erase(ref.begin() + idx);
+        }
+        else if (!ref.empty())
+        {
+            if (rng() % 2)
+            {
+                d.remove_front();
+                ref.pop_front();
+            }
+            else
+            {
+                d.remove_back();
+                ref.pop_back();
+            }
+        }
+
+        ok &= d.size() == isize(ref.size());
+        ok &= tracked::alive == int(ref.size());
+    }
+    CHECK(ok);
+
+    auto same = true;
+    for (isize i = 0; i < d.size(); ++i)
+        same &= d[i] == ref[i];
+    CHECK(same);
+
+    d.clear();
+    CHECK(tracked::alive == 0);
+}
+
+TEST("devector - remove_at shifts the shorter side")
+{
+    cc::devector<int> d = {0, 1, 2, 3, 4, 5, 6, 7};
+    auto const p = d.data();
+
+    d.remove_at(1);
+    CHECK(has_values(d, {0, 2, 3, 4, 5, 6, 7}));
+    CHECK(d.data() == p + 1);
+
+    d.remove_at(5);
+    CHECK(has_values(d, {0, 2, 3, 4, 5, 7}));
+    CHECK(d.data() == p + 1);
+
+    tracked::alive = 0;
+    {
+        cc::devector<tracked> t;
+        for (auto i = 0; i < 6; ++i)
+            t.emplace_back(i);
+        t.remove_at(2);
+        CHECK(has_values(t, {0, 1, 3, 4, 5}));
+        CHECK(t.pop_at(0) == 0);
+        CHECK(tracked::alive == 4);
+    }
+    CHECK(tracked::alive == 0);
+}
+
+#if CC_ASSERT_ENABLED
+TEST("devector - asserts")
+{
+    cc::devector<int> d;
+    CHECK_ASSERTS(d.remove_front());
+    CHECK_ASSERTS(d.remove_at(0));
+    CHECK_ASSERTS(d.push_front_stable(1));
+
+    d.push_back(1);
+    CHECK_ASSERTS((void)d[1]);
+}
+#endif
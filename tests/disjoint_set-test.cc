@@ -0,0 +1,176 @@
+#include <clean-core/disjoint_set.hh>
+#include <clean-core/vector.hh>
+
+#include <nexus/test.hh>
+
+#include <atomic>
+#include <random>
+#include <thread>
+
+using namespace cc::primitive_defines;
+
+namespace
+{
+// reference: relabel every element with the smallest element of its set
+template <class IdxT>
+cc::vector<isize> brute_force_labels(isize n, cc::span<cc::pair<IdxT, IdxT> const> edges)
+{
+    auto labels = cc::vector<isize>::create_defaulted(n);
+    for (isize i = 0; i < n; ++i)
+        labels[i] = i;
+    auto changed = true;
+    while (changed)
+    {
+        changed = false;
+        for (auto const& e : edges)
+        {
+            auto const l = cc::min(labels[e.first], labels[e.second]);
+            if (labels[e.first] != l || labels[e.second] != l)
+            {
+                labels[e.first] = labels[e.second] = l;
+                changed = true;
+            }
+        }
+    }
+    return labels;
+}
+
+cc::vector<cc::pair<u32, u32>> random_edges(isize n, isize m, u32 seed)
+{
+    std::mt19937 rng(seed);
+    cc::vector<cc::pair<u32, u32>> edges;
+    for (isize i = 0; i < m; ++i)
+        edges.push_back({u32(rng() % n), u32(rng() % n)});
+    return edges;
+}
+} // namespace
+
+TEST("disjoint_set - basics")
+{
+    cc::disjoint_set<int> empty;
+    CHECK(empty.empty());
+    CHECK(empty.set_count() == 0);
+
+    auto ds = cc::disjoint_set<int>::create_with_size(6);
+    CHECK(ds.size() == 6);
+    CHECK(ds.set_count() == 6);
+    CHECK(!ds.same_set(0, 1));
+    CHECK(ds.set_size(3) == 1);
+
+    CHECK(ds.unite(0, 1));
+    CHECK(ds.unite(2, 3));
+    CHECK(ds.unite(1, 3));
+    CHECK(!ds.unite(0, 2));
+    CHECK(ds.set_count() == 3);
+    CHECK(ds.same_set(0, 3));
+    CHECK(!ds.same_set(0, 4));
+    CHECK(ds.set_size(2) == 4);
+    CHECK(ds.find(0) == ds.find(3));
+
+    auto const x = ds.add();
+    CHECK(x == 6);
+    CHECK(ds.set_count() == 4);
+    CHECK(ds.unite(x, 5));
+    CHECK(ds.set_size(5) == 2);
+
+    auto copy = ds;
+    ds.reset();
+    CHECK(ds.set_count() == 7);
+    CHECK(!ds.same_set(0, 1));
+    CHECK(copy.same_set(0, 1));
+    CHECK(copy.set_count() == 3);
+}
+
+TEST("disjoint_set - unite_all against brute force")
+{
+    constexpr isize n = 2000;
+    auto const edges = random_edges(n, 1500, 1);
+    auto const labels = brute_force_labels<u32>(n, edges);
+
+    auto ds = cc::disjoint_set<u32>::create_with_size(n);
+    auto const merges = ds.unite_all(edges);
+    CHECK(merges == n - ds.set_count());
+
+    isize expected_sets = 0;
+    for (isize i = 0; i < n; ++i)
+        expected_sets += labels[i] == i;
+    CHECK(ds.set_count() == expected_sets);
+
+    auto consistent = true;
+    for (isize i = 0; i < n; ++i)
+        consistent &= ds.same_set(u32(i), u32(labels[i]));
+    for (isize i = 1; i < n; ++i)
+        consistent &= ds.same_set(u32(i), u32(i - 1)) == (labels[i] == labels[i - 1]);
+    CHECK(consistent);
+}
+
+TEST("concurrent_disjoint_set - single thread")
+{
+    auto ds = cc::concurrent_disjoint_set<u32>::create_with_size(5);
+    CHECK(ds.count_sets() == 5);
+    CHECK(ds.unite(4, 3));
+    CHECK(ds.unite(1, 4));
+    CHECK(!ds.unite(3, 1));
+    CHECK(ds.same_set(1, 3));
+    CHECK(!ds.same_set(0, 3));
+    CHECK(ds.count_sets() == 3);
+
+    // linking by index makes the smallest element the root
+    CHECK(ds.find(4) == 1);
+    ds.flatten();
+    CHECK(ds.find(3) == 1);
+
+    ds.reset();
+    CHECK(ds.count_sets() == 5);
+}
+
+TEST("concurrent_disjoint_set - many threads")
+{
+    constexpr isize n = 50'000;
+    constexpr isize threads = 4;
+    auto const edges = random_edges(n, 40'000, 2);
+
+    auto reference = cc::disjoint_set<u32>::create_with_size(n);
+    reference.unite_all(edges);
+
+    auto ds = cc::concurrent_disjoint_set<u32>::create_with_size(n);
+    std::atomic<isize> merges = 0;
+    cc::vector<std::thread> workers;
+    auto const chunk = edges.size() / threads;
+    for (isize t = 0; t < threads; ++t)
+        workers.push_back(std::thread(
+            [&, t]
+            {
+                auto const end = t + 1 == threads ? edges.size() : (t + 1) * chunk;
+                merges += ds.unite_all(cc::span<cc::pair<u32, u32> const>(edges.data() + t * chunk, end - t * chunk));
+                // finds racing with unites of other threads
+                for (isize i = t; i < n; i += 97)
+                    (void)ds.find(u32(i));
+            }));
+    for (auto& w : workers)
+        w.join();
+
+    CHECK(merges.load() == n - reference.set_count());
+    CHECK(ds.count_sets() == reference.set_count());
+
+    ds.flatten();
+    auto consistent = true;
+    for (isize i = 1; i < n; ++i)
+        consistent &= (ds.find(u32(i)) == ds.find(u32(i - 1))) == reference.same_set(u32(i), u32(i - 1));
+    for (auto const& e : edges)
+        consistent &= ds.find(e.first) == ds.find(e.second);
+    CHECK(consistent);
+}
+
+#if CC_ASSERT_ENABLED
+TEST("disjoint_set - asserts")
+{
+    auto ds = cc::disjoint_set<int>::create_with_size(3);
+    CHECK_ASSERTS((void)ds.find(3));
+    CHECK_ASSERTS((void)ds.find(-1));
+    CHECK_ASSERTS((void)cc::disjoint_set<u8>::create_with_size(300));
+
+    auto cds = cc::concurrent_disjoint_set<u32>::create_with_size(3);
+    CHECK_ASSERTS((void)cds.find(3));
+}
+#endif
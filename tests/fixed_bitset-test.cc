@@ -0,0 +1,248 @@
+#include <clean-core/fixed_bitset.hh>
+#include <clean-core/flags.hh>
+
+#include <nexus/test.hh>
+
+#include <random>
+#include <type_traits>
+
+using namespace cc::primitive_defines;
+
+// ============================================================================
+// Compile-time checks
+// ============================================================================
+
+// smallest word type, no overhead
+static_assert(sizeof(cc::fixed_bitset<1>) == 1);
+static_assert(sizeof(cc::fixed_bitset<8>) == 1);
+static_assert(sizeof(cc::fixed_bitset<9>) == 2);
+static_assert(sizeof(cc::fixed_bitset<32>) == 4);
+static_assert(sizeof(cc::fixed_bitset<33>) == 8);
+static_assert(sizeof(cc::fixed_bitset<64>) == 8);
+static_assert(sizeof(cc::fixed_bitset<65>) == 16);
+static_assert(sizeof(cc::fixed_bitset<1000>) == 128);
+static_assert(std::is_trivially_copyable_v<cc::fixed_bitset<100>>);
+
+namespace
+{
+enum class state : u8
+{
+    visible,
+    selected,
+    dirty,
+    locked,
+};
+
+enum class channel
+{
+    first = 0,
+    last = 99,
+};
+
+constexpr cc::fixed_bitset<70> make_constexpr_bits()
+{
+    cc::fixed_bitset<70> b;
+    b.set(1);
+    b.set(65);
+    b.set(69, true);
+    b.flip(1);
+    return b;
+}
+} // namespace
+
+static_assert(sizeof(cc::flags<state>) == 1);
+static_assert(sizeof(cc::flags<channel, 100>) == 16);
+
+// everything is usable at compile time
+static_assert(make_constexpr_bits().count() == 2);
+static_assert(make_constexpr_bits().find_first() == 65);
+static_assert(make_constexpr_bits().find_next(65) == 69);
+static_assert((~make_constexpr_bits()).count() == 68);
+static_assert(cc::fixed_bitset<5>::create_filled(true).to_bits() == 0b11111);
+static_assert(cc::fixed_bitset<12>::create_from_bits(0xFFFF).count() == 12);
+static_assert(cc::flags<state>(state::visible, state::dirty).has(state::dirty));
+static_assert(!cc::flags<state>(state::visible, state::dirty).has(state::selected));
+static_assert((cc::flags<state>(state::visible) | state::locked).count() == 2);
+
+TEST("fixed_bitset - basics")
+{
+    cc::fixed_bitset<10> b;
+    CHECK(b.size() == 10);
+    CHECK(b.none());
+    CHECK(b.find_first() == -1);
+
+    b.set(0);
+    b.set(9);
+    CHECK(b.count() == 2);
+    CHECK(b.test(9));
+    CHECK(!b[5]);
+    CHECK(b.find_first() == 0);
+    CHECK(b.find_next(0) == 9);
+    CHECK(b.find_next(9) == -1);
+    CHECK(b.to_bits() == 0b10'0000'0001);
+
+    b.set_all();
+    CHECK(b.all());
+    CHECK(b.to_bits() == 0b11'1111'1111);
+    b.clear(3);
+    CHECK(!b.all());
+    b.flip_all();
+    CHECK(b.count() == 1);
+    CHECK(b.test(3));
+
+    cc::fixed_bitset<0> zero;
+    CHECK(zero.none());
+    CHECK(zero.all());
+    CHECK(zero.count() == 0);
+    CHECK(zero.find_first() == -1);
+}
+
+TEST("fixed_bitset - multi word against reference")
+{
+    std::mt19937 rng(1);
+    constexpr isize n = 300; // 5 words: unrolled path
+    constexpr isize big_n = 1100; // 18 words: loop path
+
+    auto check = [&]<isize N>(cc::fixed_bitset<N> a, cc::fixed_bitset<N> b)
+    {
+        bool ra[N] = {}, rb[N] = {};
+        for (isize i = 0; i < N; ++i)
+        {
+            ra[i] = rng() % 3 == 0;
+            rb[i] = rng() % 2 == 0;
+            a.set(i, ra[i]);
+            b.set(i, rb[i]);
+        }
+
+        auto const r_and = a & b;
+        auto const r_or = a | b;
+        auto const r_xor = a ^ b;
+        auto const r_not = ~a;
+        auto r_andnot = a;
+        r_andnot.and_not(b);
+
+        auto ok = true;
+        isize count = 0;
+        auto contains = true, intersects = false;
+        for (isize i = 0; i < N; ++i)
+        {
+            ok &= r_and[i] == (ra[i] && rb[i]);
+            ok &= r_or[i] == (ra[i] || rb[i]);
+            ok &= r_xor[i] == (ra[i] != rb[i]);
+            ok &= r_not[i] == !ra[i];
+            ok &= r_andnot[i] == (ra[i] && !rb[i]);
+            count += ra[i];
+            contains &= !rb[i] || ra[i];
+            intersects |= ra[i] && rb[i];
+        }
+        CHECK(ok);
+        CHECK(a.count() == count);
+        CHECK(r_not.count() == N - count);
+        CHECK(a.contains(b) == contains);
+        CHECK(a.intersects(b) == intersects);
+        CHECK(r_or.contains(a));
+        CHECK((~~a) == a);
+
+        auto pos = isize(-1);
+        auto found = true;
+        for (isize i = 0; i < N; ++i)
+            if (ra[i])
+            {
+                pos = a.find_next(pos);
+                found &= pos == i;
+            }
+        CHECK(found);
+        CHECK(a.find_next(pos) == -1);
+
+        isize visited = 0;
+        auto in_order = true;
+        for (isize i : a.set_bits())
+        {
+            in_order &= ra[i];
+            ++visited;
+        }
+        CHECK(in_order);
+        CHECK(visited == count);
+
+        isize callback_visited = 0;
+        a.for_each_set_bit([&](isize i) { callback_visited += ra[i]; });
+        CHECK(callback_visited == count);
+    };
+    check(cc::fixed_bitset<n>(), cc::fixed_bitset<n>());
+    check(cc::fixed_bitset<big_n>(), cc::fixed_bitset<big_n>());
+    check(cc::fixed_bitset<64>(), cc::fixed_bitset<64>());
+    check(cc::fixed_bitset<13>(), cc::fixed_bitset<13>());
+}
+
+TEST("fixed_bitset - words")
+{
+    cc::fixed_bitset<100> b;
+    b.set_word(1, ~u64(0));
+    CHECK(b.count() == 36);
+    CHECK(b.word(1) == (u64(1) << 36) - 1);
+    CHECK(b.find_first() == 64);
+
+    // set_bits() copies, so iterating a temporary is fine
+    isize visited = 0;
+    for ([[maybe_unused]] isize i : (b | cc::fixed_bitset<100>::create_filled(false)).set_bits())
+        ++visited;
+    CHECK(visited == 36);
+}
+
+TEST("flags - basics")
+{
+    cc::flags<state> s;
+    CHECK(s.empty());
+    CHECK(!s.has(state::visible));
+
+    s.set(state::visible);
+    s |= state::dirty;
+    CHECK(s.has(state::visible));
+    CHECK(s.has(state::dirty));
+    CHECK(s.count() == 2);
+    CHECK(s.has_any({state::selected, state::dirty}));
+    CHECK(!s.has_all({state::selected, state::dirty}));
+    CHECK(s.has_all({state::visible, state::dirty}));
+
+    s.clear(state::visible);
+    CHECK(s == state::dirty);
+    s.flip(state::locked);
+    s.set(state::selected, true);
+    CHECK(s == cc::flags<state>(state::dirty, state::locked, state::selected));
+
+    s.clear({state::dirty, state::locked});
+    CHECK(s == state::selected);
+
+    auto const inverted = ~s;
+    CHECK(inverted.count() == 7);
+    CHECK((inverted & s).none());
+    CHECK((inverted ^ s).count() == 8);
+
+    cc::flags<state> seen;
+    auto n = 0;
+    for (state f : cc::flags<state>(state::locked, state::visible))
+    {
+        seen.set(f);
+        ++n;
+    }
+    CHECK(n == 2);
+    CHECK(seen == cc::flags<state>(state::visible, state::locked));
+
+    cc::flags<channel, 100> channels = {channel::first, channel::last};
+    CHECK(channels.count() == 2);
+    CHECK(channels.bits().find_next(0) == 99);
+}
+
+#if CC_ASSERT_ENABLED
+TEST("fixed_bitset - asserts")
+{
+    cc::fixed_bitset<10> b;
+    CHECK_ASSERTS((void)b.test(10));
+    CHECK_ASSERTS(b.set(-1));
+    CHECK_ASSERTS((void)b.find_next(10));
+    CHECK_ASSERTS((void)b.word(1));
+
+    cc::flags<state> s;
+    CHECK_ASSERTS(s.set(state(8)));
+}
+#endif
@@ -0,0 +1,224 @@
+#include <clean-core/fixed_vector.hh>
+
+#include <nexus/test.hh>
+
+#include <cstring>
+#include <string>
+#include <type_traits>
+
+using namespace cc::primitive_defines;
+
+// ============================================================================
+// Compile-time checks
+// ============================================================================
+
+// compact size field: no pointers, no capacity
+static_assert(sizeof(cc::fixed_vector<u8, 7>) == 8);
+static_assert(sizeof(cc::fixed_vector<u32, 3>) == 16);
+static_assert(sizeof(cc::fixed_vector<u8, 300>) == 302);
+static_assert(alignof(cc::fixed_vector<double, 2>) == alignof(double));
+
+// trivially copyable elements make the whole vector trivially copyable
+static_assert(std::is_trivially_copyable_v<cc::fixed_vector<int, 4>>);
+static_assert(std::is_trivially_destructible_v<cc::fixed_vector<int, 4>>);
+static_assert(!std::is_trivially_copyable_v<cc::fixed_vector<std::string, 4>>);
+static_assert(cc::fixed_vector<int, 4>::capacity() == 4);
+
+namespace
+{
+struct tracked
+{
+    static inline int alive = 0;
+    int value;
+
+    tracked(int v) : value(v) { ++alive; }
+    tracked(tracked const& rhs) : value(rhs.value) { ++alive; }
+    tracked(tracked&& rhs) noexcept : value(rhs.value) { ++alive; }
+    tracked& operator=(tracked const&) = default;
+    tracked& operator=(tracked&&) = default;
+    ~tracked() { --alive; }
+
+    bool operator==(tracked const& rhs) const { return value == rhs.value; }
+};
+
+template <class V>
+bool has_values(V const& v, std::initializer_list<int> values)
+{
+    if (v.size() != isize(values.size()))
+        return false;
+    isize i = 0;
+    for (auto x : values)
+        if (!(v[i++] == x))
+            return false;
+    return true;
+}
+} // namespace
+
+TEST("fixed_vector - basics")
+{
+    cc::fixed_vector<int, 4> v;
+    CHECK(v.empty());
+    CHECK(v.capacity_back() == 4);
+
+    v.push_back(1);
+    v.emplace_back(2);
+    v.push_back(3);
+    CHECK(v.size() == 3);
+    CHECK(v.front() == 1);
+    CHECK(v.back() == 3);
+    CHECK(!v.full());
+
+    CHECK(v.try_push_back(4) != nullptr);
+    CHECK(v.full());
+    CHECK(v.try_push_back(5) == nullptr);
+    CHECK(has_values(v, {1, 2, 3, 4}));
+
+    CHECK(v.pop_back() == 4);
+    v.remove_at(0);
+    CHECK(has_values(v, {2, 3}));
+
+    auto sum = 0;
+    for (auto x : v)
+        sum += x;
+    CHECK(sum == 5);
+
+    v.clear();
+    CHECK(v.empty());
+}
+
+TEST("fixed_vector - removals")
+{
+    cc::fixed_vector<int, 10> v = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+
+    v.remove_at_unordered(1);
+    CHECK(has_values(v, {0, 9, 2, 3, 4, 5, 6, 7, 8}));
+
+    v.remove_at_range(2, 3);
+    CHECK(has_values(v, {0, 9, 5, 6, 7, 8}));
+
+    v.remove_at_range_unordered(1, 2);
+    CHECK(has_values(v, {0, 7, 8, 6}));
+
+    // the tail overlaps the gap
+    v.remove_from_to_unordered(1, 4);
+    CHECK(has_values(v, {0}));
+
+    v = {5, 1, 5, 2, 5, 3};
+    CHECK(v.remove_all_value(5) == 3);
+    CHECK(has_values(v, {1, 2, 3}));
+
+    v = {1, 2, 3, 2, 1};
+    CHECK(v.remove_first_value(2) == isize(1));
+    CHECK(v.remove_last_where([](int x) { return x == 1; }) == isize(3));
+    CHECK(!v.remove_first_value(7).has_value());
+    CHECK(has_values(v, {1, 3, 2}));
+
+    v = {0, 1, 2, 3, 4, 5};
+    CHECK(v.retain_all_where([](isize i, int) { return i % 2 == 0; }) == 3);
+    CHECK(has_values(v, {0, 2, 4}));
+}
+
+TEST("fixed_vector - resizing and factories")
+{
+    auto v = cc::fixed_vector<int, 8>::create_filled(3, 7);
+    CHECK(has_values(v, {7, 7, 7}));
+
+    v.resize_to_defaulted(5);
+    CHECK(has_values(v, {7, 7, 7, 0, 0}));
+
+    v.resize_down_to(2);
+    v.resize_to_filled(4, 1);
+    CHECK(has_values(v, {7, 7, 1, 1}));
+
+    v.clear_resize_to_filled(2, 3);
+    CHECK(has_values(v, {3, 3}));
+
+    v.fill(9);
+    CHECK(has_values(v, {9, 9}));
+
+    int const src[] = {4, 5, 6};
+    auto const c = cc::fixed_vector<int, 8>::create_copy_of(src);
+    CHECK(has_values(c, {4, 5, 6}));
+
+    auto u = cc::fixed_vector<int, 8>::create_uninitialized(8);
+    CHECK(u.full());
+}
+
+TEST("fixed_vector - trivially copyable bulk copies")
+{
+    struct item
+    {
+        int id;
+        cc::fixed_vector<u16, 5> links;
+    };
+    static_assert(std::is_trivially_copyable_v<item>);
+
+    item items[3] = {};
+    for (auto i = 0; i < 3; ++i)
+    {
+        items[i].id = i;
+        for (auto j = 0; j <= i; ++j)
+            items[i].links.push_back(u16(10 * i + j));
+    }
+
+    item copies[3];
+    std::memcpy(copies, items, sizeof(items));
+    CHECK(copies[2].links.size() == 3);
+    CHECK(has_values(copies[2].links, {20, 21, 22}));
+    CHECK(has_values(copies[0].links, {0}));
+
+    auto moved = cc::move(copies[1].links);
+    CHECK(has_values(moved, {10, 11}));
+}
+
+TEST("fixed_vector - non-trivial elements")
+{
+    tracked::alive = 0;
+    {
+        cc::fixed_vector<tracked, 6> v;
+        v.emplace_back(1);
+        v.emplace_back(2);
+        v.emplace_back(3);
+        CHECK(tracked::alive == 3);
+
+        auto copy = v;
+        CHECK(tracked::alive == 6);
+        CHECK(has_values(copy, {1, 2, 3}));
+
+        auto moved = cc::move(copy);
+        CHECK(copy.empty());
+        CHECK(tracked::alive == 6);
+
+        moved.remove_at(0);
+        CHECK(has_values(moved, {2, 3}));
+        CHECK(tracked::alive == 5);
+
+        v = moved;
+        CHECK(has_values(v, {2, 3}));
+        CHECK(tracked::alive == 4);
+
+        CHECK(v.remove_all_where([](tracked const& t) { return t.value == 3; }) == 1);
+        CHECK(tracked::alive == 3);
+
+        cc::fixed_vector<std::string, 3> s = {"a", "long string that does not fit into sso"};
+        s.push_back("c");
+        auto s2 = cc::move(s);
+        CHECK(s2[1] == "long string that does not fit into sso");
+        CHECK(s.empty());
+    }
+    CHECK(tracked::alive == 0);
+}
+
+#if CC_ASSERT_ENABLED
+TEST("fixed_vector - asserts")
+{
+    cc::fixed_vector<int, 2> v = {1, 2};
+    CHECK_ASSERTS(v.push_back(3));
+    CHECK_ASSERTS((void)v[2]);
+    CHECK_ASSERTS(v.resize_to_defaulted(3));
+
+    cc::fixed_vector<int, 2> e;
+    CHECK_ASSERTS(e.remove_back());
+    CHECK_ASSERTS((void)e.front());
+}
+#endif
@@ -0,0 +1,256 @@
+#include <clean-core/flat_map.hh>
+#include <clean-core/flat_set.hh>
+#include <clean-core/string.hh>
+#include <clean-core/to_string.hh>
+
+#include <nexus/test.hh>
+
+#include <map>
+#include <random>
+#include <set>
+
+using namespace cc::primitive_defines;
+
+namespace
+{
+template <class K, class V>
+bool same_entries(cc::flat_map<K, V> const& m, std::map<K, V> const& ref)
+{
+    if (m.size() != isize(ref.size()))
+        return false;
+    auto it = ref.begin();
+    for (auto [k, v] : m)
+    {
+        if (k != it->first || v != it->second)
+            return false;
+        ++it;
+    }
+    return true;
+}
+} // namespace
+
+TEST("flat_map - basics")
+{
+    cc::flat_map<int, int> m;
+    CHECK(m.empty());
+    CHECK(m.get_ptr(1) == nullptr);
+    CHECK(m.index_of(1) == -1);
+    CHECK(m.begin() == m.end());
+
+    m.insert_or_assign(5, 50);
+    m.insert_or_assign(1, 10);
+    m.insert_or_assign(3, 30);
+    CHECK(m.size() == 3);
+    CHECK(m.keys()[0] == 1);
+    CHECK(m.keys()[1] == 3);
+    CHECK(m.keys()[2] == 5);
+    CHECK(m.values()[1] == 30);
+    CHECK(m.get(5) == 50);
+    CHECK(m.index_of(3) == 1);
+
+    m.insert_or_assign(3, 31);
+    CHECK(m.get(3) == 31);
+    CHECK(!m.try_insert(3, 0));
+    CHECK(m.try_insert(4, 40));
+    m[0] += 7;
+    CHECK(m.get(0) == 7);
+    CHECK(m.size() == 5);
+
+    // ordered iteration
+    auto prev = -1;
+    for (auto [k, v] : m)
+    {
+        CHECK(k > prev);
+        prev = k;
+        v += 1;
+    }
+    CHECK(m.get(4) == 41);
+
+    // range queries
+    CHECK(m.lower_bound(2) == 2);
+    CHECK(m.upper_bound(3) == 3);
+    CHECK(m.lower_bound(3) == 2);
+    CHECK(m.lower_bound(100) == m.size());
+    CHECK(m.upper_bound(-100) == 0);
+
+    CHECK(m.remove(3));
+    CHECK(!m.remove(3));
+    CHECK(m.pop(0).value() == 8);
+    CHECK(!m.pop(0).has_value());
+    CHECK(m.remove_all_where([](int k, int) { return k > 4; }) == 1);
+    CHECK(m.size() == 2);
+    CHECK(m.keys()[0] == 1);
+    CHECK(m.keys()[1] == 4);
+}
+
+TEST("flat_map - inserting references to own elements")
+{
+    // heap-allocated strings, so reading a freed element is caught by the sanitizers
+    auto const long_value = cc::string("a value that is definitely too long for the small string buffer");
+
+    cc::flat_map<int, cc::string> m;
+    m.insert_or_assign(0, long_value);
+
+    // every insert reads an element of the map it grows (and shifts)
+    for (auto i = 1; i < 100; ++i)
+    {
+        m.insert_or_assign(-i, m.values()[0]);
+        m.try_insert(1000 - i, m.values()[m.size() - 1]);
+        m.get_or_emplace(100 + i, m.get(0));
+    }
+    CHECK(m.size() == 298);
+    for (auto const& v : m.values())
+        REQUIRE(v == long_value);
+
+    SECTION("flat_set")
+    {
+        cc::flat_set<cc::string> s = {long_value};
+        for (auto i = 1; i < 60; ++i)
+        {
+            // a new prefix of an element, inserted before it
+            auto const prefix = cc::string_view(s.elements()[s.size() - 1]).subview(0, 60 - i);
+            REQUIRE(s.insert(prefix));
+        }
+        CHECK(s.size() == 60);
+        CHECK(s.elements()[59] == long_value);
+    }
+}
+
+TEST("flat_map - heterogeneous lookup")
+{
+    cc::flat_map<cc::string, int> m = {{"pear", 2}, {"apple", 1}, {"plum", 3}, {"apple", 4}};
+    CHECK(m.size() == 3);
+    CHECK(m.get("apple") == 4); // later duplicates win
+    CHECK(m.get(cc::string_view("plum")) == 3);
+    CHECK(m.keys()[0] == "apple");
+    CHECK(!m.contains("cherry"));
+
+    auto copy = m;
+    copy["cherry"] = 5;
+    CHECK(m.size() == 3);
+    CHECK(copy.size() == 4);
+    CHECK(copy.keys()[1] == "cherry");
+}
+
+TEST("flat_map - bulk build")
+{
+    std::mt19937 rng(1);
+    for (auto n : {0, 1, 2, 17, 100, 5000})
+    {
+        cc::vector<int> keys;
+        cc::vector<cc::string> values;
+        std::map<int, cc::string> ref;
+        for (auto i = 0; i < n; ++i)
+        {
+            auto const k = int(rng() % u32(n + 1));
+            keys.push_back(k);
+            values.push_back(cc::to_string(i));
+            ref[k] = cc::to_string(i);
+        }
+
+        auto const m = cc::flat_map<int, cc::string>::create_from_unsorted(cc::move(keys), cc::move(values));
+        REQUIRE(same_entries(m, ref));
+    }
+
+    // presorted and adversarial inputs
+    cc::vector<int> keys;
+    cc::vector<int> values;
+    for (auto i = 0; i < 1000; ++i)
+    {
+        keys.push_back(i % 2 == 0 ? i : 1000 - i);
+        values.push_back(i);
+    }
+    auto const m = cc::flat_map<int, int>::create_from_unsorted(cc::move(keys), cc::move(values));
+    CHECK(m.size() == 1000);
+    CHECK(m.get(1) == 999);
+
+    cc::vector<int> sorted_keys = {1, 2, 3};
+    cc::vector<int> sorted_values = {10, 20, 30};
+    auto const s = cc::flat_map<int, int>::create_from_sorted(cc::move(sorted_keys), cc::move(sorted_values));
+    CHECK(s.get(2) == 20);
+}
+
+TEST("flat_map - merge_sorted")
+{
+    std::mt19937 rng(2);
+    cc::flat_map<int, int> m;
+    std::map<int, int> ref;
+
+    for (auto round = 0; round < 50; ++round)
+    {
+        std::map<int, int> batch;
+        for (auto i = 0; i < 40; ++i)
+            batch[int(rng() % 1000)] = round;
+
+        cc::vector<int> keys;
+        cc::vector<int> values;
+        for (auto [k, v] : batch)
+        {
+            keys.push_back(k);
+            values.push_back(v);
+        }
+
+        auto const before = isize(ref.size());
+        for (auto [k, v] : batch)
+            ref[k] = v;
+
+        REQUIRE(m.merge_sorted(keys, values) == isize(ref.size()) - before);
+        REQUIRE(same_entries(m, ref));
+    }
+}
+
+TEST("flat_set - basics and bulk operations")
+{
+    cc::flat_set<int> s = {5, 1, 3, 1};
+    CHECK(s.size() == 3);
+    CHECK(s[0] == 1);
+    CHECK(s.contains(3));
+    CHECK(!s.contains(2));
+    CHECK(s.insert(2));
+    CHECK(!s.insert(2));
+    CHECK(s.index_of(2) == 1);
+    CHECK(s.remove(1));
+    CHECK(s.lower_bound(4) == 2);
+
+    CHECK(s.merge_sorted({0, 3, 4, 10}) == 3);
+    cc::vector<int> expected = {0, 2, 3, 4, 5, 10};
+    REQUIRE(s.size() == expected.size());
+    for (auto i = 0; i < s.size(); ++i)
+        CHECK(s[i] == expected[i]);
+
+    CHECK(s.remove_all_where([](int v) { return v % 2 == 0; }) == 4);
+    CHECK(s.size() == 2);
+
+    auto v = s.extract_to_vector();
+    CHECK(s.empty());
+    CHECK(v.size() == 2);
+    CHECK(v[0] == 3);
+
+    std::mt19937 rng(3);
+    cc::vector<u64> raw;
+    std::set<u64> ref;
+    for (auto i = 0; i < 10000; ++i)
+    {
+        auto const x = u64(rng() % 3000);
+        raw.push_back(x);
+        ref.insert(x);
+    }
+    auto const big = cc::flat_set<u64>::create_from_unsorted(cc::move(raw));
+    REQUIRE(big.size() == isize(ref.size()));
+    auto it = ref.begin();
+    for (auto x : big)
+        REQUIRE(x == *it++);
+}
+
+#if CC_ASSERT_ENABLED
+TEST("flat_map - asserts")
+{
+    cc::flat_map<int, int> m;
+    CHECK_ASSERTS((void)m.get(1));
+    CHECK_ASSERTS(m.merge_sorted({2, 1}, {0, 0}));
+    CHECK_ASSERTS(m.merge_sorted({1}, {0, 0}));
+
+    cc::flat_set<int> s;
+    CHECK_ASSERTS(s.merge_sorted({1, 1}));
+}
+#endif
@@ -0,0 +1,94 @@
+#include <clean-core/hash.hh>
+#include <clean-core/string.hh>
+
+#include <nexus/test.hh>
+
+#include <unordered_set>
+
+using namespace cc::primitive_defines;
+
+namespace
+{
+enum class color : u8
+{
+    red,
+    green
+};
+
+struct with_member
+{
+    int a = 0;
+    [[nodiscard]] u64 hash() const { return cc::make_hash(a, 7); }
+};
+} // namespace
+
+TEST("hash - consistency across types")
+{
+    // strings hash by content
+    auto const h = cc::make_hash(cc::string_view("hello"));
+    CHECK(cc::make_hash("hello") == h);
+    CHECK(cc::make_hash(cc::string("hello")) == h);
+    char const* cstr = "hello";
+    CHECK(cc::make_hash(cstr) == h);
+    CHECK(cc::make_hash("hellO") != h);
+
+    // integers hash by value
+    CHECK(cc::make_hash(i32(-3)) == cc::make_hash(i64(-3)));
+    CHECK(cc::make_hash(u8(200)) == cc::make_hash(200));
+    CHECK(cc::make_hash(1) != cc::make_hash(2));
+
+    // floats: 0.0 == -0.0
+    CHECK(cc::make_hash(0.0) == cc::make_hash(-0.0));
+    CHECK(cc::make_hash(1.5f) == cc::make_hash(1.5));
+
+    // enums, pointers, members, pairs
+    CHECK(cc::make_hash(color::red) != cc::make_hash(color::green));
+    int x = 0;
+    CHECK(cc::make_hash(&x) == cc::make_hash(static_cast<void const*>(&x)));
+    CHECK(cc::make_hash(with_member{3}) == cc::make_hash(3, 7));
+    CHECK(cc::make_hash(cc::pair<int, int>{1, 2}) == cc::make_hash(1, 2));
+
+    // combining is order-dependent
+    CHECK(cc::make_hash(1, 2) != cc::make_hash(2, 1));
+}
+
+TEST("hash - bytes")
+{
+    char buf[64];
+    for (auto i = 0; i < 64; ++i)
+        buf[i] = char(i * 7);
+
+    // every length and every flipped byte gives a new hash
+    std::unordered_set<u64> seen;
+    for (auto len = 0; len <= 64; ++len)
+    {
+        CHECK(cc::hash_bytes(buf, len) == cc::hash_bytes(buf, len));
+        seen.insert(cc::hash_bytes(buf, len));
+
+        for (auto i = 0; i < len; ++i)
+        {
+            buf[i] ^= 1;
+            seen.insert(cc::hash_bytes(buf, len));
+            buf[i] ^= 1;
+        }
+    }
+    CHECK(seen.size() == 65 + 64 * 65 / 2);
+
+    // seeds change the hash
+    CHECK(cc::hash_bytes(buf, 10, 1) != cc::hash_bytes(buf, 10, 2));
+}
+
+TEST("hash - bit distribution")
+{
+    // low and high bits are used by hash tables, both must change for sequential integers
+    std::unordered_set<u64> low;
+    std::unordered_set<u64> high;
+    for (auto i = 0; i < 1024; ++i)
+    {
+        auto const h = cc::make_hash(i);
+        low.insert(h & 0x7F);
+        high.insert(h >> 54);
+    }
+    CHECK(low.size() > 120);
+    CHECK(high.size() > 600);
+}
@@ -0,0 +1,420 @@
+#include <clean-core/map.hh>
+#include <clean-core/string.hh>
+#include <clean-core/to_string.hh>
+
+#include <nexus/test.hh>
+
+#include <new>
+#include <random>
+#include <unordered_map>
+
+using namespace cc::primitive_defines;
+
+namespace
+{
+struct tracked
+{
+    static inline int live = 0;
+
+    int value = 0;
+
+    explicit tracked(int v) : value(v) { ++live; }
+    tracked(tracked const& rhs) : value(rhs.value) { ++live; }
+    tracked(tracked&& rhs) noexcept : value(rhs.value) { ++live; }
+    tracked& operator=(tracked const&) = default;
+    tracked& operator=(tracked&&) = default;
+    ~tracked() { --live; }
+};
+
+struct point
+{
+    int x = 0;
+    int y = 0;
+
+    bool operator==(point const&) const = default;
+    [[nodiscard]] u64 hash() const { return cc::make_hash(x, y); }
+};
+
+// hashes everything to the same value to force long probe sequences
+struct colliding
+{
+    int value = 0;
+
+    bool operator==(colliding const&) const = default;
+    [[nodiscard]] u64 hash() const { return 0x1234; }
+};
+
+struct counting_resource : cc::memory_resource
+{
+    int allocations = 0;
+    int deallocations = 0;
+
+    counting_resource()
+    {
+        allocate_bytes = [](cc::byte** out_ptr, isize min_bytes, isize, isize alignment, void* userdata) -> isize
+        {
+            auto* self = static_cast<counting_resource*>(userdata);
+            if (min_bytes == 0)
+            {
+                *out_ptr = nullptr;
+                return 0;
+            }
+            ++self->allocations;
+            *out_ptr = static_cast<cc::byte*>(::operator new(min_bytes, std::align_val_t(alignment)));
+            return min_bytes;
+        };
+        deallocate_bytes = [](cc::byte* p, isize, isize alignment, void* userdata)
+        {
+            auto* self = static_cast<counting_resource*>(userdata);
+            ++self->deallocations;
+            ::operator delete(p, std::align_val_t(alignment));
+        };
+        userdata = this;
+    }
+};
+} // namespace
+
+TEST("map - basics")
+{
+    cc::map<int, int> m;
+    CHECK(m.empty());
+    CHECK(m.size() == 0);
+    CHECK(m.capacity() == 0);
+    CHECK(m.get_ptr(1) == nullptr);
+    CHECK(!m.contains(1));
+    CHECK(!m.remove(1));
+    CHECK(m.begin() == m.end());
+
+    m.insert_or_assign(1, 10);
+    m.insert_or_assign(2, 20);
+    CHECK(m.size() == 2);
+    CHECK(m.get(1) == 10);
+    CHECK(*m.get_ptr(2) == 20);
+    CHECK(m.contains(2));
+    CHECK(m.capacity() >= 16);
+
+    SECTION("overwrite")
+    {
+        m.insert_or_assign(1, 11);
+        CHECK(m.size() == 2);
+        CHECK(m.get(1) == 11);
+    }
+
+    SECTION("try_insert")
+    {
+        CHECK(!m.try_insert(1, 99));
+        CHECK(m.get(1) == 10);
+        CHECK(m.try_insert(3, 30));
+        CHECK(m.get(3) == 30);
+    }
+
+    SECTION("operator[]")
+    {
+        m[3] += 5;
+        CHECK(m.get(3) == 5);
+        m[1] += 5;
+        CHECK(m.get(1) == 15);
+        CHECK(m.size() == 3);
+    }
+
+    SECTION("remove and pop")
+    {
+        CHECK(m.remove(1));
+        CHECK(!m.remove(1));
+        CHECK(!m.contains(1));
+        CHECK(m.size() == 1);
+
+        auto const v = m.pop(2);
+        CHECK(v.has_value());
+        CHECK(v.value() == 20);
+        CHECK(!m.pop(2).has_value());
+        CHECK(m.empty());
+    }
+
+    SECTION("iteration")
+    {
+        m.insert_or_assign(3, 30);
+        auto key_sum = 0;
+        auto value_sum = 0;
+        for (auto [k, v] : m)
+        {
+            key_sum += k;
+            value_sum += v;
+            v += 1; // values are mutable through the entry
+        }
+        CHECK(key_sum == 6);
+        CHECK(value_sum == 60);
+        CHECK(m.get(3) == 31);
+
+        auto const& cm = m;
+        auto count = 0;
+        for (auto e : cm)
+        {
+            CHECK(e.value == e.key * 10 + 1);
+            ++count;
+        }
+        CHECK(count == 3);
+    }
+
+    SECTION("clear keeps capacity")
+    {
+        auto const cap = m.capacity();
+        m.clear();
+        CHECK(m.empty());
+        CHECK(m.capacity() == cap);
+        CHECK(!m.contains(1));
+        m.insert_or_assign(1, 1);
+        CHECK(m.get(1) == 1);
+    }
+}
+
+TEST("map - initializer list and copy/move")
+{
+    cc::map<int, cc::string> m = {{1, "one"}, {2, "two"}, {3, "three"}};
+    CHECK(m.size() == 3);
+    CHECK(m.get(2) == "two");
+
+    auto copy = m;
+    copy.insert_or_assign(4, "four");
+    copy.get(1) = "uno";
+    CHECK(m.size() == 3);
+    CHECK(m.get(1) == "one");
+    CHECK(copy.size() == 4);
+    CHECK(copy.get(1) == "uno");
+
+    auto moved = cc::move(copy);
+    CHECK(copy.empty());
+    CHECK(moved.size() == 4);
+    CHECK(moved.get(4) == "four");
+
+    moved = m;
+    CHECK(moved.size() == 3);
+    CHECK(!moved.contains(4));
+
+    // moved-from maps are usable
+    copy.insert_or_assign(7, "seven");
+    CHECK(copy.get(7) == "seven");
+}
+
+TEST("map - heterogeneous lookup")
+{
+    cc::map<cc::string, int> m;
+    m["apple"] = 1;
+    m.insert_or_assign(cc::string_view("pear"), 2);
+    m.insert_or_assign(cc::string("plum"), 3);
+
+    CHECK(m.get("apple") == 1);
+    CHECK(m.get(cc::string_view("pear")) == 2);
+    CHECK(m.get(cc::string("plum")) == 3);
+    CHECK(m.get_ptr("cherry") == nullptr);
+    CHECK(m.contains(cc::string_view("apple")));
+    CHECK(m.remove("pear"));
+    CHECK(m.size() == 2);
+
+    // integer keys of different widths
+    cc::map<i64, int> im;
+    im.insert_or_assign(-5, 1);
+    CHECK(im.get(i32(-5)) == 1);
+    CHECK(im.contains(i16(-5)));
+}
+
+TEST("map - custom keys")
+{
+    cc::map<point, int> m;
+    m.insert_or_assign(point{1, 2}, 12);
+    m.insert_or_assign(point{2, 1}, 21);
+    CHECK(m.get(point{1, 2}) == 12);
+    CHECK(m.get(point{2, 1}) == 21);
+    CHECK(!m.contains(point{1, 1}));
+
+    cc::map<cc::pair<int, int>, int> pm;
+    pm.insert_or_assign(cc::pair<int, int>{3, 4}, 34);
+    CHECK(pm.get(cc::pair<int, int>{3, 4}) == 34);
+}
+
+TEST("map - growth and element lifetime")
+{
+    tracked::live = 0;
+    {
+        cc::map<int, tracked> m;
+        for (auto i = 0; i < 1000; ++i)
+            m.try_insert(i, i * 2);
+        CHECK(m.size() == 1000);
+        CHECK(tracked::live == 1000);
+        CHECK(m.capacity() >= 1000 + 1000 / 8);
+
+        for (auto i = 0; i < 1000; ++i)
+            REQUIRE(m.get(i).value == i * 2);
+
+        for (auto i = 0; i < 1000; i += 2)
+            m.remove(i);
+        CHECK(tracked::live == 500);
+        CHECK(m.remove_all_where([](int k, tracked const&) { return k % 3 == 0; }) == 167);
+        CHECK(m.size() == 333);
+        CHECK(tracked::live == 333);
+
+        auto copy = m;
+        CHECK(tracked::live == 666);
+
+        m.rehash();
+        CHECK(m.capacity() == 512);
+        for (auto i = 1; i < 1000; i += 2)
+            REQUIRE(m.contains(i) == (i % 3 != 0));
+    }
+    CHECK(tracked::live == 0);
+
+    SECTION("rehash(0) frees empty maps")
+    {
+        cc::map<int, int> m;
+        m.reserve(100);
+        CHECK(m.capacity() == 128);
+        m.rehash(0);
+        CHECK(m.capacity() == 0);
+    }
+}
+
+TEST("map - inserting references to own elements while growing")
+{
+    // long enough to be heap-allocated, so reading a freed slot is caught by the sanitizers
+    auto const long_value = cc::string("a value that is definitely too long for the small string buffer");
+
+    cc::map<int, cc::string> m;
+    m.insert_or_assign(0, long_value);
+
+    // crosses several growth thresholds, each insert reads an element of the table it grows
+    for (auto i = 1; i < 200; ++i)
+    {
+        m.insert_or_assign(i, m.get(i - 1));
+        m.try_insert(-i, m.get(i / 2));
+        m.get_or_emplace(1000 + i, m.get(0));
+    }
+    for (auto i = 0; i < 200; ++i)
+        REQUIRE(m.get(i) == long_value);
+    CHECK(m.get(-199) == long_value);
+    CHECK(m.get(1199) == long_value);
+
+    SECTION("keys referencing values")
+    {
+        cc::map<cc::string, cc::string> names;
+        for (auto i = 0; i < 100; ++i)
+        {
+            auto const key = long_value + cc::to_string(i);
+            names.insert_or_assign(key, key + " value");
+            // the new key is a value of the table
+            REQUIRE(names.try_insert(names.get(key), key));
+        }
+        CHECK(names.size() == 200);
+    }
+}
+
+TEST("map - reserve avoids rehash")
+{
+    cc::map<int, int> m;
+    m.reserve(1000);
+    auto const cap = m.capacity();
+    auto const* first = &m[0];
+    for (auto i = 1; i < 1000; ++i)
+        m[i] = i;
+    CHECK(m.capacity() == cap);
+    CHECK(&m.get(0) == first);
+}
+
+TEST("map - collisions and tombstones")
+{
+    // all keys share one probe sequence
+    cc::map<colliding, int> m;
+    for (auto i = 0; i < 100; ++i)
+        m.insert_or_assign(colliding{i}, i);
+    for (auto i = 0; i < 100; ++i)
+        REQUIRE(m.get(colliding{i}) == i);
+
+    for (auto i = 0; i < 100; i += 3)
+        m.remove(colliding{i});
+    for (auto i = 0; i < 100; ++i)
+        REQUIRE(m.contains(colliding{i}) == (i % 3 != 0));
+
+    // churn on a small table exercises tombstone cleanup without growing
+    cc::map<int, int> small;
+    for (auto i = 0; i < 10000; ++i)
+    {
+        small.insert_or_assign(i, i);
+        if (i >= 10)
+            REQUIRE(small.remove(i - 10));
+    }
+    CHECK(small.size() == 10);
+    CHECK(small.capacity() <= 32);
+}
+
+TEST("map - randomized against std::unordered_map")
+{
+    std::mt19937 rng(12345);
+    cc::map<u32, u32> m;
+    std::unordered_map<u32, u32> ref;
+
+    for (auto i = 0; i < 50000; ++i)
+    {
+        auto const key = u32(rng() % 2000);
+        switch (rng() % 4)
+        {
+        case 0:
+        case 1:
+            m.insert_or_assign(key, u32(i));
+            ref[key] = u32(i);
+            break;
+        case 2:
+            REQUIRE(m.remove(key) == (ref.erase(key) > 0));
+            break;
+        case 3:
+        {
+            auto const p = m.get_ptr(key);
+            auto const it = ref.find(key);
+            REQUIRE((p != nullptr) == (it != ref.end()));
+            if (p != nullptr)
+                REQUIRE(*p == it->second);
+            break;
+        }
+        }
+        REQUIRE(m.size() == isize(ref.size()));
+    }
+
+    isize count = 0;
+    for (auto [k, v] : m)
+    {
+        REQUIRE(ref.at(k) == v);
+        ++count;
+    }
+    CHECK(count == isize(ref.size()));
+}
+
+TEST("map - custom memory resource")
+{
+    counting_resource resource;
+    {
+        auto m = cc::map<int, int>::create_with_resource(&resource);
+        CHECK(resource.allocations == 0);
+
+        for (auto i = 0; i < 100; ++i)
+            m[i] = i;
+        CHECK(resource.allocations > 0);
+
+        // copies and rehashes stay on the same resource
+        auto const before = resource.allocations;
+        auto copy = m;
+        CHECK(resource.allocations == before + 1);
+        copy.rehash();
+        CHECK(resource.allocations == before + 2);
+
+        auto with_cap = cc::map<int, int>::create_with_capacity(50, &resource);
+        CHECK(with_cap.capacity() == 64);
+    }
+    CHECK(resource.allocations == resource.deallocations);
+}
+
+#if CC_ASSERT_ENABLED
+TEST("map - asserts")
+{
+    cc::map<int, int> m;
+    CHECK_ASSERTS((void)m.get(1));
+    CHECK_ASSERTS(m.reserve(-1));
+}
+#endif
@@ -0,0 +1,221 @@
+#include <clean-core/mpmc_queue.hh>
+#include <clean-core/string.hh>
+#include <clean-core/unique_function.hh>
+#include <clean-core/vector.hh>
+
+#include <nexus/test.hh>
+
+#include <atomic>
+#include <thread>
+
+using namespace cc::primitive_defines;
+
+TEST("mpmc_queue - single thread")
+{
+    auto q = cc::mpmc_queue<int>::create_with_capacity(5);
+    CHECK(q.capacity() == 8);
+    CHECK(q.empty());
+    CHECK(!q.try_pop().has_value());
+
+    for (auto i = 0; i < 8; ++i)
+        CHECK(q.try_push(i));
+    CHECK(!q.try_push(8));
+    CHECK(q.size() == 8);
+
+    CHECK(q.try_pop().value() == 0);
+    CHECK(q.try_pop().value() == 1);
+    CHECK(q.size() == 6);
+
+    // batch operations wrap around the end of the slots
+    int const values[] = {8, 9, 10};
+    CHECK(q.try_push_range(values) == 2);
+    int out[16] = {};
+    CHECK(q.try_pop_to(out) == 8);
+    for (auto i = 0; i < 8; ++i)
+        CHECK(out[i] == i + 2);
+    CHECK(q.try_pop_to(out) == 0);
+    CHECK(q.empty());
+
+    CHECK(q.try_push_range(values) == 3);
+    CHECK(q.try_pop().value() == 8);
+    CHECK(q.size() == 2);
+
+    CHECK(cc::mpmc_queue<int>::create_with_capacity(1).capacity() == 2);
+}
+
+TEST("mpmc_queue - move-only payloads")
+{
+    auto q = cc::mpmc_queue<cc::unique_function<int()>>::create_with_capacity(4);
+    auto sum = 0;
+
+    cc::unique_function<int()> f = [] { return 1; };
+    CHECK(q.try_push(cc::move(f)));
+    CHECK(q.try_emplace([] { return 2; }));
+
+    cc::unique_function<int()> fs[3] = {[] { return 3; }, [] { return 4; }, [] { return 5; }};
+    CHECK(q.try_push_moved_range(fs) == 2);
+    CHECK(fs[2]() == 5);
+
+    // a failed push leaves the value intact
+    CHECK(!q.try_push(cc::move(fs[2])));
+    CHECK(fs[2]() == 5);
+
+    sum += q.try_pop().value()();
+    cc::unique_function<int()> out[4];
+    CHECK(q.try_pop_to(out) == 3);
+    for (auto i = 0; i < 3; ++i)
+        sum += out[i]();
+    CHECK(sum == 1 + 2 + 3 + 4);
+
+    // leftovers are destroyed with the queue
+    CHECK(q.try_push(cc::move(fs[2])));
+    auto s = cc::mpmc_queue<cc::string>::create_with_capacity(4);
+    s.try_push("leftover");
+}
+
+TEST("mpmc_queue - many producers and consumers")
+{
+    constexpr int producers = 4;
+    constexpr int consumers = 4;
+    constexpr u64 per_producer = 50'000;
+
+    auto q = cc::mpmc_queue<u64>::create_with_capacity(64);
+    std::atomic<u64> received_count = 0;
+    std::atomic<u64> received_sum = 0;
+    std::atomic<bool> in_order = true;
+
+    cc::vector<std::thread> threads;
+    for (auto p = 0; p < producers; ++p)
+        threads.push_back(std::thread(
+            [&q, p]
+            {
+                // value = producer id in the high bits, sequence number in the low bits
+                u64 const base = u64(p) << 32;
+                u64 batch[5];
+                for (u64 i = 0; i < per_producer;)
+                {
+                    if (i % 2 == 0 && i + 5 <= per_producer)
+                    {
+                        for (auto j = 0; j < 5; ++j)
+                            batch[j] = base + i + u64(j);
+                        i += u64(q.try_push_range(batch));
+                    }
+                    else if (q.try_push(base + i))
+                        ++i;
+                    else
+                        std::this_thread::yield();
+                }
+            }));
+
+    for (auto c = 0; c < consumers; ++c)
+        threads.push_back(std::thread(
+            [&]
+            {
+                // a single consumer sees the elements of each producer in push order
+                u64 last[producers] = {};
+                bool seen[producers] = {};
+                u64 buffer[7];
+                u64 sum = 0;
+                while (received_count.load() < producers * per_producer)
+                {
+                    auto const n = q.try_pop_to(buffer);
+                    for (isize i = 0; i < n; ++i)
+                    {
+                        auto const p = buffer[i] >> 32;
+                        auto const seq = buffer[i] & 0xFFFF'FFFF;
+                        if (seen[p] && seq <= last[p])
+                            in_order = false;
+                        seen[p] = true;
+                        last[p] = seq;
+                        sum += seq;
+                    }
+                    received_count += u64(n);
+                    if (n == 0)
+                        std::this_thread::yield();
+                }
+                received_sum += sum;
+            }));
+
+    for (auto& t : threads)
+        t.join();
+
+    CHECK(received_count.load() == producers * per_producer);
+    CHECK(received_sum.load() == producers * (per_producer * (per_producer - 1) / 2));
+    CHECK(in_order.load());
+    CHECK(q.empty());
+}
+
+TEST("blocking_mpmc_queue - many producers and consumers")
+{
+    constexpr int producers = 3;
+    constexpr int consumers = 3;
+    constexpr u64 per_producer = 20'000;
+
+    // a tiny queue forces both sides to park
+    auto q = cc::blocking_mpmc_queue<u64>::create_with_capacity(4);
+    std::atomic<u64> received_sum = 0;
+
+    cc::vector<std::thread> threads;
+    for (auto p = 0; p < producers; ++p)
+        threads.push_back(std::thread(
+            [&q]
+            {
+                u64 batch[3];
+                for (u64 i = 1; i <= per_producer;)
+                {
+                    if (i % 4 == 0 && i + 3 <= per_producer + 1)
+                    {
+                        for (auto j = 0; j < 3; ++j)
+                            batch[j] = i + u64(j);
+                        q.push_range(batch);
+                        i += 3;
+                    }
+                    else
+                        q.push(i++);
+                }
+            }));
+
+    for (auto c = 0; c < consumers; ++c)
+        threads.push_back(std::thread(
+            [&q, &received_sum]
+            {
+                // 0 is the stop signal, a batch may grab several of them, so extra ones are passed on
+                u64 sum = 0;
+                u64 buffer[2];
+                while (true)
+                {
+                    auto const n = q.pop_to(buffer);
+                    auto stops = 0;
+                    for (isize i = 0; i < n; ++i)
+                    {
+                        if (buffer[i] == 0)
+                            ++stops;
+                        sum += buffer[i];
+                    }
+                    if (stops > 0)
+                    {
+                        for (auto i = 1; i < stops; ++i)
+                            q.push(0);
+                        break;
+                    }
+                }
+                received_sum += sum;
+            }));
+
+    for (auto p = 0; p < producers; ++p)
+        threads[p].join();
+    for (auto c = 0; c < consumers; ++c)
+        q.push(0);
+    for (auto c = 0; c < consumers; ++c)
+        threads[producers + c].join();
+
+    CHECK(received_sum.load() == producers * (per_producer * (per_producer + 1) / 2));
+    CHECK(q.empty());
+}
+
+#if CC_ASSERT_ENABLED
+TEST("mpmc_queue - asserts")
+{
+    CHECK_ASSERTS((void)cc::mpmc_queue<int>::create_with_capacity(0));
+}
+#endif
@@ -1,9 +1,11 @@
 #include <clean-core/node_allocation.hh>
+#include <clean-core/string.hh>
 #include <clean-core/vector.hh>
 
 #include <nexus/test.hh>
 
 #include <array>
+#include <thread>
 
 using namespace cc::primitive_defines;
 
@@ -57,7 +59,7 @@ struct T16B
 static_assert(sizeof(T16B) == 16);
 static_assert(alignof(T16B) == 8);
 
-// 32B class (index 5, size 32)
+// 32B class (index 6, size 32)
 struct T32B
 {
     u64 data[4] = {};
@@ -70,7 +72,7 @@ struct T32B
 static_assert(sizeof(T32B) == 32);
 static_assert(alignof(T32B) == 8);
 
-// 64B class (index 6, size 64)
+// 64B class (index 8, size 64)
 struct T64B
 {
     u64 data[8] = {};
@@ -83,7 +85,7 @@ struct T64B
 static_assert(sizeof(T64B) == 64);
 static_assert(alignof(T64B) == 8);
 
-// 128B class (index 7, size 128)
+// 128B class (index 10, size 128)
 struct T128B
 {
     u64 data[16] = {};
@@ -96,7 +98,7 @@ struct T128B
 static_assert(sizeof(T128B) == 128);
 static_assert(alignof(T128B) == 8);
 
-// 256B class (index 8, size 256 - at small_max boundary)
+// 256B class (index 12, size 256 - at small_max boundary)
 struct T256B
 {
     u64 data[32] = {};
@@ -213,7 +215,7 @@ static_assert(!std::is_copy_constructible_v<ImmovableType>);
 static_assert(!std::is_move_constructible_v<ImmovableType>);
 
 // Weird struct: 24B with align 8 (doesn't fit power-of-two perfectly)
-// Will be allocated in 32B class (next power of 2)
+// Will be allocated in the 24B intermediate class
 struct T24B_Align8
 {
     u64 a = 0;
@@ -225,7 +227,7 @@ static_assert(sizeof(T24B_Align8) == 24);
 static_assert(alignof(T24B_Align8) == 8);
 
 // Weird struct: 65B with align 1 (just over 64B boundary)
-// Will be allocated in 128B class
+// Will be allocated in the 96B intermediate class
 struct alignas(1) T65B_Align1
 {
     u8 data[65] = {};
@@ -1706,3 +1708,352 @@ TEST("node_allocation - move-assignment from subobject safety")
         }
     }
 }
+
+TEST("node_allocation - size class geometry")
+{
+    // class sizes and index mapping
+    static_assert(cc::node_class_index_for<u8>() == cc::node_class_index(0));
+    static_assert(cc::node_class_index_for<u64>() == cc::node_class_index(3));
+    static_assert(cc::node_class_index_for<T16B>() == cc::node_class_index(4));
+    static_assert(cc::node_class_index_for<T24B_Align8>() == cc::node_class_index(5));
+    static_assert(cc::node_class_index_for<T32B>() == cc::node_class_index(6));
+    static_assert(cc::node_class_index_for<T65B_Align1>() == cc::node_class_index(9));
+    static_assert(cc::node_class_index_for<T256B>() == cc::node_class_index::small_max);
+    static_assert(cc::node_class_index_for<T999B_Align2>() > cc::node_class_index::small_max);
+
+    // over-aligned types skip intermediate classes
+    static_assert(cc::node_class_index_from_size_and_align(24, 16) == cc::node_class_index(6));
+    static_assert(cc::node_class_index_from_size_and_align(48, 16) == cc::node_class_index(7));
+    static_assert(cc::node_class_index_from_size_and_align(48, 32) == cc::node_class_index(8));
+    static_assert(cc::node_class_index_from_size_and_align(136, 8) == cc::node_class_index(11));
+    static_assert(cc::node_class_index_from_size_and_align(193, 8) == cc::node_class_index(12));
+
+    isize const expected_sizes[] = {1, 2, 4, 8, 16, 24, 32, 48, 64, 96, 128, 192, 256};
+    static_assert(std::size(expected_sizes) == isize(cc::node_class_index::small_count));
+
+    for (isize i = 0; i < isize(cc::node_class_index::small_count); ++i)
+    {
+        auto const idx = cc::node_class_index(i);
+        auto const slot_size = cc::node_slot_size_bytes_for_class(idx);
+        auto const slab_size = cc::node_slab_size_bytes_for_class(idx);
+        auto const freemap = cc::node_slab_initial_freemap_for_class(idx);
+
+        CHECK(slot_size == expected_sizes[i]);
+        CHECK(cc::has_single_bit(u64(slab_size)));
+        CHECK(slab_size <= cc::impl::node_slab_carver::chunk_size_bytes);
+
+        // every class uses at least 2/3 of its slab
+        CHECK(cc::popcount(freemap) * slot_size * 3 >= slab_size * 2);
+
+        // every usable slot lies behind the 16 byte header, inside the slab, and maps back to its index
+        alignas(16384) static cc::byte slab[16384];
+        for (u64 s = 0; s < 64; ++s)
+        {
+            if ((freemap & (u64(1) << s)) == 0)
+                continue;
+
+            auto const ptr = cc::node_slot_ptr_for(slab, idx, s);
+            CHECK(ptr - slab >= 16);
+            CHECK(ptr - slab + slot_size <= slab_size);
+            CHECK(cc::node_slot_index_for_ptr(ptr, slab, idx) == s);
+            CHECK(cc::node_slab_base_for_ptr(ptr + slot_size - 1, idx) == slab);
+            CHECK(cc::is_aligned(ptr, cc::min(slot_size & -slot_size, isize(16))));
+        }
+    }
+}
+
+TEST("node_allocation - intermediate size classes")
+{
+    struct alignas(16) T48B_Align16
+    {
+        u64 data[6] = {};
+    };
+    struct T136B
+    {
+        u64 data[17] = {};
+    };
+
+    auto& alloc = cc::default_node_allocator();
+
+    cc::vector<cc::node_allocation<T48B_Align16>> n48;
+    cc::vector<cc::node_allocation<T136B>> n136;
+    for (int i = 0; i < 200; ++i)
+    {
+        n48.push_back(cc::node_allocation<T48B_Align16>::create_from(alloc));
+        n48.back()->data[5] = u64(i);
+        CHECK(cc::is_aligned(n48.back().ptr, 16));
+
+        n136.push_back(cc::node_allocation<T136B>::create_from(alloc));
+        n136.back()->data[16] = u64(i);
+    }
+
+    // free every other node and reallocate, slots must be reused
+    for (int i = 0; i < 200; i += 2)
+    {
+        n48[i].reset();
+        n136[i].reset();
+    }
+    for (int i = 0; i < 200; i += 2)
+    {
+        n48[i] = cc::node_allocation<T48B_Align16>::create_from(alloc);
+        n48[i]->data[5] = u64(i);
+        n136[i] = cc::node_allocation<T136B>::create_from(alloc);
+        n136[i]->data[16] = u64(i);
+    }
+
+    for (int i = 0; i < 200; ++i)
+    {
+        CHECK(n48[i]->data[5] == u64(i));
+        CHECK(n136[i]->data[16] == u64(i));
+    }
+}
+
+TEST("node_allocation - statistics")
+{
+    // a dedicated allocator keeps the numbers independent of other tests
+    cc::node_allocator alloc(cc::default_node_memory_resource);
+
+    auto const idx8 = isize(cc::node_class_index_for<u64>());
+    auto const usable8 = isize(cc::popcount(cc::node_slab_initial_freemap_for_class(cc::node_class_index_for<u64>())));
+    CHECK(usable8 == 62);
+
+    SECTION("fresh allocator")
+    {
+        auto const stats = alloc.collect_stats();
+        CHECK(stats.total_slab_count() == 0);
+        CHECK(stats.total_slab_bytes() == 0);
+        CHECK(stats.total_live_slots() == 0);
+        CHECK(stats.large_alloc_count == 0);
+        for (auto const& c : stats.classes)
+        {
+            CHECK(c.refill_count == 0);
+            CHECK(c.ring_scan_count == 0);
+        }
+    }
+
+    SECTION("live slots follow allocations and frees")
+    {
+        cc::vector<cc::node_allocation<u64>> nodes;
+        for (int i = 0; i < 10; ++i)
+            nodes.push_back(cc::node_allocation<u64>::create_from(alloc, i));
+
+        auto stats = alloc.collect_stats();
+        CHECK(stats.classes[idx8].slab_count == 1);
+        CHECK(stats.classes[idx8].slot_capacity == usable8);
+        CHECK(stats.classes[idx8].live_slots == 10);
+        CHECK(stats.classes[idx8].refill_count == 1);
+        CHECK(stats.classes[idx8].ring_scan_count == 0);
+        CHECK(stats.total_live_slots() == 10);
+        CHECK(stats.total_live_bytes() == 10 * 8);
+        CHECK(stats.total_slab_bytes() == cc::node_slab_size_bytes_for_class(cc::node_class_index_for<u64>()));
+
+        nodes.remove_back();
+        nodes.remove_back();
+        CHECK(alloc.collect_stats().classes[idx8].live_slots == 8);
+
+        nodes.clear();
+        CHECK(alloc.collect_stats().classes[idx8].live_slots == 0);
+    }
+
+    SECTION("exhausted slab triggers ring scan and refill")
+    {
+        cc::vector<cc::node_allocation<u64>> nodes;
+        for (isize i = 0; i < usable8; ++i)
+            nodes.push_back(cc::node_allocation<u64>::create_from(alloc, i));
+
+        auto stats = alloc.collect_stats();
+        CHECK(stats.classes[idx8].refill_count == 1);
+        CHECK(stats.classes[idx8].ring_scan_count == 0);
+
+        nodes.push_back(cc::node_allocation<u64>::create_from(alloc, 0));
+
+        stats = alloc.collect_stats();
+        CHECK(stats.classes[idx8].refill_count == 2);
+        CHECK(stats.classes[idx8].ring_scan_count == 1);
+        CHECK(stats.classes[idx8].live_slots >= 1);
+    }
+
+    SECTION("other classes are tracked separately")
+    {
+        auto a = cc::node_allocation<T16B>::create_from(alloc, 1);
+        auto b = cc::node_allocation<T256B>::create_from(alloc, 2);
+
+        auto const stats = alloc.collect_stats();
+        CHECK(stats.classes[isize(cc::node_class_index_for<T16B>())].live_slots == 1);
+        CHECK(stats.classes[isize(cc::node_class_index_for<T256B>())].live_slots == 1);
+        CHECK(stats.classes[idx8].slab_count == 0);
+        CHECK(stats.total_slab_count() == 2);
+    }
+
+    SECTION("large nodes")
+    {
+        auto const before = cc::collect_stats(*cc::default_node_memory_resource);
+
+        {
+            auto n = cc::node_allocation<T999B_Align2>::create_from(alloc, 7);
+
+            auto const stats = alloc.collect_stats();
+            CHECK(stats.large_alloc_count == 1);
+            CHECK(stats.large_alloc_bytes == isize(sizeof(T999B_Align2)));
+
+            auto const during = cc::collect_stats(*cc::default_node_memory_resource);
+            CHECK(during.large_alloc_count == before.large_alloc_count + 1);
+            CHECK(during.large_live_count == before.large_live_count + 1);
+            CHECK(during.large_live_bytes > before.large_live_bytes + isize(sizeof(T999B_Align2)) - 1);
+        }
+
+        auto const after = cc::collect_stats(*cc::default_node_memory_resource);
+        CHECK(after.large_free_count == before.large_free_count + 1);
+        CHECK(after.large_live_count == before.large_live_count);
+        CHECK(after.large_live_bytes == before.large_live_bytes);
+
+        // allocator counters are cumulative
+        CHECK(alloc.collect_stats().large_alloc_count == 1);
+    }
+
+    SECTION("resource counts slabs of all allocators")
+    {
+        auto const before = cc::collect_stats(*cc::default_node_memory_resource);
+
+        auto n = cc::node_allocation<u64>::create_from(alloc, 1);
+
+        auto const after = cc::collect_stats(*cc::default_node_memory_resource);
+        CHECK(after.slab_count[idx8] == before.slab_count[idx8] + 1);
+        CHECK(after.slab_bytes
+              == before.slab_bytes + cc::node_slab_size_bytes_for_class(cc::node_class_index_for<u64>()));
+    }
+
+    SECTION("resource without statistics")
+    {
+        cc::node_memory_resource resource;
+        auto const stats = cc::collect_stats(resource);
+        CHECK(stats.slab_bytes == 0);
+        CHECK(stats.large_live_count == 0);
+    }
+
+    SECTION("debug string")
+    {
+        auto n0 = cc::node_allocation<u64>::create_from(alloc, 1);
+        auto n1 = cc::node_allocation<T999B_Align2>::create_from(alloc, 2);
+
+        auto const s = alloc.collect_stats().to_string();
+        CHECK(s.starts_with("node_allocator stats"));
+        CHECK(s.contains("reclaimed"));
+        CHECK(s.contains("large: 1 allocations"));
+
+        auto const rs = cc::collect_stats(*cc::default_node_memory_resource).to_string();
+        CHECK(rs.starts_with("node_memory_resource stats"));
+        CHECK(rs.contains("large:"));
+    }
+}
+
+TEST("node_allocation - slab ring reuse")
+{
+    cc::node_allocator alloc(cc::default_node_memory_resource);
+    auto const idx8 = isize(cc::node_class_index_for<u64>());
+
+    cc::vector<cc::node_allocation<u64>> nodes;
+    for (int i = 0; i < 500; ++i)
+        nodes.push_back(cc::node_allocation<u64>::create_from(alloc, i));
+
+    auto const stats_full = alloc.collect_stats();
+    CHECK(stats_full.classes[idx8].live_slots == 500);
+    CHECK(stats_full.classes[idx8].slab_count == stats_full.classes[idx8].refill_count);
+
+    SECTION("freed slots are reused instead of refilling")
+    {
+        nodes.clear();
+        CHECK(alloc.collect_stats().classes[idx8].live_slots == 0);
+
+        for (int i = 0; i < 500; ++i)
+            nodes.push_back(cc::node_allocation<u64>::create_from(alloc, i));
+
+        auto const stats = alloc.collect_stats();
+        CHECK(stats.classes[idx8].refill_count == stats_full.classes[idx8].refill_count);
+        CHECK(stats.classes[idx8].slab_count == stats_full.classes[idx8].slab_count);
+        CHECK(stats.classes[idx8].live_slots == 500);
+        CHECK(stats.classes[idx8].scan_reclaimed_count > 0);
+
+        for (int i = 0; i < 500; ++i)
+            CHECK(*nodes[i] == u64(i));
+    }
+
+    SECTION("sparse frees in many slabs are found round-robin")
+    {
+        // free every 4th node, spreading free slots over all slabs
+        for (int i = 0; i < 500; i += 4)
+            nodes[i].reset();
+
+        cc::vector<cc::node_allocation<u64>> more;
+        for (int i = 0; i < 125; ++i)
+            more.push_back(cc::node_allocation<u64>::create_from(alloc, i));
+
+        // a few refills may happen due to the bounded scan, but most slots must be reused
+        auto const stats = alloc.collect_stats();
+        CHECK(stats.classes[idx8].live_slots == 500);
+        CHECK(stats.classes[idx8].refill_count <= stats_full.classes[idx8].refill_count + 2);
+    }
+
+    SECTION("remote frees are picked up")
+    {
+        std::thread([&] { nodes.clear(); }).join();
+
+        for (int i = 0; i < 500; ++i)
+            nodes.push_back(cc::node_allocation<u64>::create_from(alloc, i));
+
+        auto const stats = alloc.collect_stats();
+        CHECK(stats.classes[idx8].refill_count == stats_full.classes[idx8].refill_count);
+        CHECK(stats.classes[idx8].scan_reclaimed_count > 0);
+    }
+}
+
+TEST("node_allocation - superblock carving")
+{
+    cc::node_allocator alloc(cc::default_node_memory_resource);
+
+    auto const before = cc::collect_stats(*cc::default_node_memory_resource);
+
+    // allocate a few slabs of every class
+    cc::vector<cc::node_allocation<u8>> n1;
+    cc::vector<cc::node_allocation<u64>> n8;
+    cc::vector<cc::node_allocation<T24B_Align8>> n24;
+    cc::vector<cc::node_allocation<T256B>> n256;
+    for (int i = 0; i < 300; ++i)
+    {
+        n1.push_back(cc::node_allocation<u8>::create_from(alloc, u8(i)));
+        n8.push_back(cc::node_allocation<u64>::create_from(alloc, i));
+        n24.push_back(cc::node_allocation<T24B_Align8>::create_from(alloc, i));
+        n256.push_back(cc::node_allocation<T256B>::create_from(alloc, i));
+    }
+
+    // slabs of all classes are self-aligned, otherwise slab base recovery would break
+    auto const stats = alloc.collect_stats();
+    for (isize i = 0; i < isize(cc::node_class_index::small_count); ++i)
+    {
+        auto base = alloc.slabs().slab_base[i];
+        if (base == nullptr)
+            continue;
+
+        auto slab = base;
+        do
+        {
+            CHECK(cc::is_aligned(slab, cc::node_slab_size_bytes_for_class(cc::node_class_index(i))));
+            slab = cc::node_slab_next_for_base(slab);
+        } while (slab != base);
+    }
+
+    // far fewer backing allocations than slabs (each superblock holds many slabs)
+    auto const after = cc::collect_stats(*cc::default_node_memory_resource);
+    auto const new_slabs = stats.total_slab_count();
+    CHECK(new_slabs > 10);
+    CHECK(after.backing_count - before.backing_count <= 2);
+    CHECK(after.backing_bytes >= after.slab_bytes);
+
+    for (int i = 0; i < 300; ++i)
+    {
+        CHECK(*n1[i] == u8(i));
+        CHECK(*n8[i] == u64(i));
+        CHECK(n24[i]->c == u64(i) * 3);
+        CHECK(n256[i]->data[31] == u64(i));
+    }
+}
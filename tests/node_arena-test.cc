@@ -0,0 +1,203 @@
+#include <clean-core/node_arena.hh>
+#include <clean-core/node_list.hh>
+#include <clean-core/vector.hh>
+
+#include <nexus/test.hh>
+
+using namespace cc::primitive_defines;
+
+namespace
+{
+struct dtor_counter
+{
+    int* counter = nullptr;
+    int value = 0;
+
+    dtor_counter(int* c, int v) : counter(c), value(v) {}
+    ~dtor_counter() { *counter += 1; }
+};
+
+struct alignas(128) over_aligned
+{
+    u64 data[20] = {};
+};
+
+struct big_node
+{
+    byte data[4000] = {};
+};
+} // namespace
+
+TEST("node_arena - basic node allocation")
+{
+    cc::node_arena arena;
+    CHECK(arena.block_count() == 0);
+    CHECK(arena.allocated_bytes() == 0);
+
+    SECTION("single node")
+    {
+        auto n = cc::node_allocation<int>::create_from(arena.allocator(), 42);
+        CHECK(*n == 42);
+        CHECK(arena.block_count() == 1);
+        CHECK(arena.allocated_bytes() >= cc::node_arena::default_block_size_bytes);
+    }
+
+    SECTION("many nodes of different classes")
+    {
+        cc::vector<cc::node_allocation<u64>> small;
+        cc::vector<cc::node_allocation<big_node>> large;
+        for (auto i = 0; i < 1000; ++i)
+        {
+            small.push_back(cc::node_allocation<u64>::create_from(arena.allocator(), u64(i)));
+            if (i % 10 == 0)
+                large.push_back(cc::node_allocation<big_node>::create_from(arena.allocator()));
+        }
+
+        for (auto i = 0; i < 1000; ++i)
+            CHECK(*small[i] == u64(i));
+
+        auto const stats = cc::collect_stats(*arena.resource());
+        CHECK(stats.large_live_count == 100);
+        CHECK(stats.backing_count == arena.block_count());
+        CHECK(stats.backing_bytes == arena.allocated_bytes());
+    }
+
+    SECTION("resource returns the arena allocator")
+    {
+        auto& res = *arena.resource();
+        CHECK(&res.get_allocator(res.userdata) == &arena.allocator());
+    }
+
+    // all handles are freed here, reset is valid
+    arena.reset();
+    CHECK(arena.block_count() == 0);
+    CHECK(arena.allocated_bytes() == 0);
+}
+
+TEST("node_arena - emplace")
+{
+    int destroyed = 0;
+
+    {
+        cc::node_arena arena;
+
+        auto& a = arena.emplace<dtor_counter>(&destroyed, 1);
+        auto& b = arena.emplace<dtor_counter>(&destroyed, 2);
+        auto& x = arena.emplace<u64>(u64(7));
+        CHECK(a.value == 1);
+        CHECK(b.value == 2);
+        CHECK(x == 7);
+        CHECK(&a != &b);
+
+        arena.reset();
+        CHECK(destroyed == 2);
+
+        // arena is reusable after reset
+        auto& c = arena.emplace<dtor_counter>(&destroyed, 3);
+        CHECK(c.value == 3);
+        CHECK(arena.block_count() == 1);
+    }
+
+    // destructor resets the arena
+    CHECK(destroyed == 3);
+
+    SECTION("owned objects holding arena nodes")
+    {
+        cc::node_arena arena;
+
+        // the list frees its nodes in its destructor, which reset runs before checking for live nodes
+        auto& list = arena.emplace<cc::node_list<int>>(cc::node_list<int>::create_with_resource(arena.resource()));
+        for (auto i = 0; i < 100; ++i)
+            list.push_back(i);
+        CHECK(list.size() == 100);
+
+        arena.reset();
+        CHECK(arena.block_count() == 0);
+    }
+}
+
+TEST("node_arena - large nodes and alignment")
+{
+    cc::node_arena arena;
+
+    SECTION("over-aligned large nodes")
+    {
+        cc::vector<cc::node_allocation<over_aligned>> nodes;
+        for (auto i = 0; i < 50; ++i)
+        {
+            nodes.push_back(cc::node_allocation<over_aligned>::create_from(arena.allocator()));
+            CHECK(cc::is_aligned(&*nodes.back(), 128));
+            nodes.back()->data[0] = u64(i);
+        }
+
+        for (auto i = 0; i < 50; ++i)
+            CHECK(nodes[i]->data[0] == u64(i));
+    }
+
+    SECTION("oversized nodes get dedicated blocks")
+    {
+        struct huge
+        {
+            byte data[200'000];
+        };
+
+        auto const blocks_before = arena.block_count();
+        auto h0 = cc::node_allocation<huge>::create_from(arena.allocator());
+        auto h1 = cc::node_allocation<huge>::create_from(arena.allocator());
+        CHECK(arena.block_count() == blocks_before + 2);
+
+        h0->data[0] = byte(1);
+        h0->data[199'999] = byte(2);
+        h1->data[0] = byte(3);
+        CHECK(h0->data[0] == byte(1));
+        CHECK(h0->data[199'999] == byte(2));
+    }
+
+    SECTION("large frees update statistics")
+    {
+        auto n = cc::node_allocation<big_node>::create_from(arena.allocator());
+        CHECK(cc::collect_stats(*arena.resource()).large_live_count == 1);
+        n.reset();
+
+        auto const stats = cc::collect_stats(*arena.resource());
+        CHECK(stats.large_alloc_count == 1);
+        CHECK(stats.large_free_count == 1);
+        CHECK(stats.large_live_count == 0);
+        CHECK(stats.large_live_bytes == 0);
+    }
+}
+
+TEST("node_arena - custom block size")
+{
+    // rounded up to the 16 KiB chunk size
+    cc::node_arena arena(nullptr, 1000);
+
+    cc::vector<cc::node_allocation<u64>> nodes;
+    for (auto i = 0; i < 10'000; ++i)
+        nodes.push_back(cc::node_allocation<u64>::create_from(arena.allocator(), u64(i)));
+
+    // 10k u64 nodes need > 5 blocks of 16 KiB
+    CHECK(arena.block_count() > 5);
+
+    for (auto i = 0; i < 10'000; ++i)
+        CHECK(*nodes[i] == u64(i));
+
+    nodes.clear();
+    arena.reset();
+    CHECK(arena.block_count() == 0);
+}
+
+#if CC_ASSERT_ENABLED
+// without assertions, a reset with live nodes is undefined behavior
+TEST("node_arena - reset asserts on live nodes")
+{
+    cc::node_arena arena;
+    auto n = cc::node_allocation<int>::create_from(arena.allocator(), 1);
+
+    CHECK_ASSERTS(arena.reset());
+
+    // the failed reset left the arena untouched
+    CHECK(*n == 1);
+    n.reset();
+}
+#endif
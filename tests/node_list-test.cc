@@ -0,0 +1,399 @@
+#include <clean-core/node_arena.hh>
+#include <clean-core/node_list.hh>
+#include <clean-core/node_queue.hh>
+#include <clean-core/node_stack.hh>
+
+#include <nexus/test.hh>
+
+#include <initializer_list>
+
+using namespace cc::primitive_defines;
+
+namespace
+{
+struct tracked
+{
+    int* live = nullptr;
+    int value = 0;
+
+    tracked(int* l, int v) : live(l), value(v) { *live += 1; }
+    ~tracked() { *live -= 1; }
+
+    tracked(tracked const&) = delete;
+    tracked& operator=(tracked const&) = delete;
+};
+
+template <class ContainerT>
+bool elements_are(ContainerT const& c, std::initializer_list<int> expected)
+{
+    auto it = expected.begin();
+    for (auto const& v : c)
+    {
+        if (it == expected.end() || v != *it)
+            return false;
+        ++it;
+    }
+    return it == expected.end();
+}
+} // namespace
+
+// links come first, small values share a 24 byte slot
+static_assert(sizeof(cc::impl::list_node<int>) == 24);
+static_assert(cc::node_class_index_for<cc::impl::list_node<int>>() == cc::node_class_index_for<u64[3]>());
+static_assert(sizeof(cc::list_node_handle<int>) == sizeof(void*));
+
+TEST("node_list - basics")
+{
+    cc::node_list<int> l;
+    CHECK(l.empty());
+    CHECK(l.size() == 0);
+    CHECK(l.begin() == l.end());
+
+    l.push_back(2);
+    l.push_back(3);
+    l.push_front(1);
+    CHECK(l.size() == 3);
+    CHECK(l.front() == 1);
+    CHECK(l.back() == 3);
+    CHECK(elements_are(l, {1, 2, 3}));
+
+    // reverse traversal
+    auto it = l.last();
+    CHECK(*it == 3);
+    CHECK(*--it == 2);
+    CHECK(*--it == 1);
+    CHECK(--it == l.end());
+
+    SECTION("pop and remove")
+    {
+        CHECK(l.pop_front() == 1);
+        CHECK(l.pop_back() == 3);
+        CHECK(l.size() == 1);
+        l.remove_back();
+        CHECK(l.empty());
+        CHECK(l.begin() == l.end());
+    }
+
+    SECTION("insert and remove at")
+    {
+        auto it = l.begin();
+        ++it;
+        auto const inserted = l.insert_before(it, 10);
+        CHECK(*inserted == 10);
+        CHECK(elements_are(l, {1, 10, 2, 3}));
+
+        auto const next = l.remove_at(inserted);
+        CHECK(*next == 2);
+        CHECK(elements_are(l, {1, 2, 3}));
+
+        l.insert_before(l.end(), 4);
+        CHECK(l.back() == 4);
+    }
+
+    SECTION("remove_all_where")
+    {
+        l.push_back(4);
+        CHECK(l.remove_all_where([](int v) { return v % 2 == 0; }) == 2);
+        CHECK(elements_are(l, {1, 3}));
+        CHECK(l.size() == 2);
+
+        // optional index, positions before removal
+        CHECK(l.remove_all_where([](isize idx, int) { return idx == 1; }) == 1);
+        CHECK(elements_are(l, {1}));
+    }
+
+    SECTION("copy and move")
+    {
+        auto copy = l;
+        copy.push_back(4);
+        CHECK(elements_are(l, {1, 2, 3}));
+        CHECK(elements_are(copy, {1, 2, 3, 4}));
+
+        auto moved = cc::move(copy);
+        CHECK(copy.empty());
+        CHECK(moved.size() == 4);
+
+        moved = l;
+        CHECK(elements_are(moved, {1, 2, 3}));
+    }
+}
+
+TEST("node_list - stable addresses and destruction")
+{
+    int live = 0;
+    {
+        cc::node_list<tracked> l;
+        auto& a = l.emplace_back(&live, 1);
+        auto& b = l.emplace_front(&live, 0);
+        for (auto i = 2; i < 100; ++i)
+            l.emplace_back(&live, i);
+        CHECK(live == 100);
+
+        // nodes never move
+        CHECK(a.value == 1);
+        CHECK(b.value == 0);
+        CHECK(&l.front() == &b);
+
+        l.remove_front();
+        CHECK(live == 99);
+        CHECK(&l.front() == &a);
+    }
+    CHECK(live == 0);
+}
+
+TEST("node_list - splicing")
+{
+    cc::node_list<int> a = {1, 2, 3};
+    cc::node_list<int> b = {4, 5};
+
+    SECTION("whole lists")
+    {
+        auto const* first_b = &b.front();
+        a.splice_back(b);
+        CHECK(b.empty());
+        CHECK(a.size() == 5);
+        CHECK(elements_are(a, {1, 2, 3, 4, 5}));
+        CHECK(first_b == &*(++++++a.begin())); // same node, no reallocation
+
+        cc::node_list<int> c = {0};
+        a.splice_front(c);
+        CHECK(elements_are(a, {0, 1, 2, 3, 4, 5}));
+
+        // splicing into the middle
+        cc::node_list<int> d = {7, 8};
+        a.splice_before(++a.begin(), d);
+        CHECK(elements_are(a, {0, 7, 8, 1, 2, 3, 4, 5}));
+        CHECK(a.back() == 5);
+
+        // splicing into empty list
+        cc::node_list<int> e;
+        e.splice_back(a);
+        CHECK(a.empty());
+        CHECK(e.size() == 8);
+        CHECK(e.front() == 0);
+        CHECK(e.back() == 5);
+    }
+
+    SECTION("single nodes")
+    {
+        a.splice_before(a.begin(), b, b.last());
+        CHECK(elements_are(a, {5, 1, 2, 3}));
+        CHECK(elements_are(b, {4}));
+
+        // within the same list
+        a.splice_before(a.end(), a, a.begin());
+        CHECK(elements_are(a, {1, 2, 3, 5}));
+    }
+
+    SECTION("lru moves")
+    {
+        auto it = ++a.begin();
+        auto const* p = &*it;
+        a.move_to_front(it);
+        CHECK(elements_are(a, {2, 1, 3}));
+        CHECK(&a.front() == p);
+
+        a.move_to_back(a.begin());
+        CHECK(elements_are(a, {1, 3, 2}));
+        CHECK(&a.back() == p);
+
+        a.move_to_back(a.last()); // no-op
+        a.move_to_front(a.begin()); // no-op
+        CHECK(elements_are(a, {1, 3, 2}));
+    }
+}
+
+TEST("node_list - node handles")
+{
+    int live = 0;
+    {
+        cc::node_list<tracked> l;
+        l.emplace_back(&live, 1);
+        l.emplace_back(&live, 2);
+        l.emplace_back(&live, 3);
+
+        auto h = l.extract(++l.begin());
+        CHECK(h.is_valid());
+        CHECK(h->value == 2);
+        CHECK(l.size() == 2);
+        CHECK(live == 3); // extracted but still alive
+
+        auto const* p = &*h;
+        auto& reinserted = l.push_front(cc::move(h));
+        CHECK(!h.is_valid());
+        CHECK(&reinserted == p);
+        CHECK(l.front().value == 2);
+
+        // handles move between container kinds
+        cc::node_stack<tracked> s;
+        cc::node_queue<tracked> q;
+        s.push(l.extract_back());
+        q.push_back(s.extract_top());
+        CHECK(q.front().value == 3);
+        CHECK(s.empty());
+        CHECK(l.size() == 2);
+
+        // dropping a handle destroys the element
+        auto dropped = l.extract_front();
+        CHECK(live == 3);
+        dropped.reset();
+        CHECK(live == 2);
+
+        // pre-allocated nodes
+        auto pre = cc::list_node_handle<tracked>::create_from(cc::default_node_allocator(), &live, 10);
+        CHECK(live == 3);
+        l.push_back(cc::move(pre));
+        CHECK(l.back().value == 10);
+    }
+    CHECK(live == 0);
+}
+
+TEST("node_list - custom resource")
+{
+    cc::node_arena arena;
+    {
+        auto l = cc::node_list<int>::create_with_resource(arena.resource());
+        for (auto i = 0; i < 50; ++i)
+            l.push_back(i);
+        CHECK(arena.allocated_bytes() > 0);
+
+        // nodes from different resources can be mixed
+        cc::node_list<int> other = {100};
+        l.splice_back(other);
+        CHECK(l.size() == 51);
+
+        // reset asserts that all arena nodes were freed
+        l.clear();
+        arena.reset();
+    }
+
+    SECTION("copy assignment allocates from the target resource")
+    {
+        cc::node_list<int> plain = {1, 2, 3};
+        auto in_arena = cc::node_list<int>::create_with_resource(arena.resource());
+        auto stack = cc::node_stack<int>::create_with_resource(arena.resource());
+        auto queue = cc::node_queue<int>::create_with_resource(arena.resource());
+        CHECK(arena.allocated_bytes() == 0);
+
+        cc::node_stack<int> plain_stack;
+        plain_stack.push(1);
+        cc::node_queue<int> plain_queue;
+        plain_queue.push_back(1);
+
+        in_arena = plain;
+        stack = plain_stack;
+        queue = plain_queue;
+        CHECK(arena.allocated_bytes() > 0);
+        CHECK(elements_are(in_arena, {1, 2, 3}));
+
+        // copies out of the arena must not keep arena nodes alive
+        plain = in_arena;
+        plain_stack = stack;
+        plain_queue = queue;
+        in_arena.clear();
+        stack.clear();
+        queue.clear();
+        arena.reset();
+        CHECK(elements_are(plain, {1, 2, 3}));
+        CHECK(plain_stack.top() == 1);
+        CHECK(plain_queue.front() == 1);
+    }
+}
+
+TEST("node_stack - basics")
+{
+    cc::node_stack<int> s;
+    CHECK(s.empty());
+
+    s.push(1);
+    s.push(2);
+    s.emplace(3);
+    CHECK(s.size() == 3);
+    CHECK(s.top() == 3);
+    CHECK(elements_are(s, {3, 2, 1}));
+
+    auto copy = s;
+    CHECK(elements_are(copy, {3, 2, 1}));
+
+    CHECK(s.pop() == 3);
+    s.remove_top();
+    CHECK(s.top() == 1);
+
+    SECTION("splice")
+    {
+        s.splice_top(copy);
+        CHECK(copy.empty());
+        CHECK(elements_are(s, {3, 2, 1, 1}));
+
+        // bottom is tracked correctly after splicing into empty
+        cc::node_stack<int> e;
+        e.splice_top(s);
+        e.splice_top(copy);
+        cc::node_stack<int> f;
+        f.push(9);
+        e.splice_top(f);
+        CHECK(elements_are(e, {9, 3, 2, 1, 1}));
+    }
+
+    SECTION("free list")
+    {
+        // recycle nodes without touching the allocator
+        cc::node_stack<int> free_list;
+        free_list.push(s.extract_top());
+        CHECK(s.empty());
+        auto h = free_list.extract_top();
+        *h = 42;
+        s.push(cc::move(h));
+        CHECK(s.top() == 42);
+    }
+}
+
+TEST("node_queue - basics")
+{
+    cc::node_queue<int> q;
+    CHECK(q.empty());
+
+    for (auto i = 0; i < 5; ++i)
+        q.push_back(i);
+    CHECK(q.size() == 5);
+    CHECK(q.front() == 0);
+    CHECK(q.back() == 4);
+
+    CHECK(q.pop_front() == 0);
+    q.remove_front();
+    CHECK(elements_are(q, {2, 3, 4}));
+
+    cc::node_queue<int> other;
+    other.push_back(5);
+    q.splice_back(other);
+    CHECK(other.empty());
+    CHECK(q.back() == 5);
+    CHECK(elements_are(q, {2, 3, 4, 5}));
+
+    while (!q.empty())
+        q.remove_front();
+    CHECK(q.begin() == q.end());
+
+    // tail is reset correctly after draining
+    q.push_back(7);
+    CHECK(q.front() == 7);
+    CHECK(q.back() == 7);
+}
+
+#if CC_ASSERT_ENABLED
+TEST("node_list - asserts")
+{
+    cc::node_list<int> l;
+    CHECK_ASSERTS(l.front());
+    CHECK_ASSERTS(l.remove_back());
+    CHECK_ASSERTS(l.splice_back(l));
+
+    cc::list_node_handle<int> h;
+    CHECK_ASSERTS(l.push_back(cc::move(h)));
+
+    cc::node_stack<int> s;
+    CHECK_ASSERTS(s.top());
+    cc::node_queue<int> q;
+    CHECK_ASSERTS(q.extract_front());
+}
+#endif
@@ -0,0 +1,242 @@
+#include <clean-core/ringbuffer.hh>
+#include <clean-core/string.hh>
+#include <clean-core/to_string.hh>
+
+#include <nexus/test.hh>
+
+#include <deque>
+#include <memory>
+#include <random>
+
+using namespace cc::primitive_defines;
+
+namespace
+{
+template <class T>
+bool same_elements(cc::ringbuffer<T> const& rb, std::deque<T> const& ref)
+{
+    if (rb.size() != isize(ref.size()))
+        return false;
+    auto i = 0;
+    for (auto const& v : rb)
+        if (!(v == ref[i++]))
+            return false;
+    return true;
+}
+} // namespace
+
+TEST("ringbuffer - basics")
+{
+    cc::ringbuffer<int> rb;
+    CHECK(rb.empty());
+    CHECK(rb.capacity() == 0);
+    CHECK(rb.begin() == rb.end());
+    CHECK(rb.readable_regions().empty());
+
+    rb.push_back(1);
+    rb.push_back(2);
+    rb.push_front(0);
+    CHECK(rb.size() == 3);
+    CHECK(rb.front() == 0);
+    CHECK(rb.back() == 2);
+    CHECK(rb[1] == 1);
+    CHECK(cc::has_single_bit(u64(rb.capacity())));
+
+    CHECK(rb.pop_front() == 0);
+    CHECK(rb.pop_back() == 2);
+    CHECK(rb.size() == 1);
+    rb.remove_back();
+    CHECK(rb.empty());
+
+    // wraps around without growing
+    rb = cc::ringbuffer<int>::create_with_capacity(3);
+    CHECK(rb.capacity() == 4);
+    for (auto i = 0; i < 100; ++i)
+    {
+        rb.push_back(i);
+        rb.push_back(i + 1);
+        CHECK(rb.pop_front() == i);
+        rb.remove_front();
+    }
+    CHECK(rb.capacity() == 4);
+
+    rb = {1, 2, 3};
+    auto sum = 0;
+    for (auto v : rb)
+        sum += v;
+    CHECK(sum == 6);
+    rb.clear();
+    CHECK(rb.empty());
+}
+
+TEST("ringbuffer - randomized against std::deque")
+{
+    std::mt19937 rng(1);
+    cc::ringbuffer<cc::string> rb;
+    std::deque<cc::string> ref;
+    for (auto i = 0; i < 20000; ++i)
+    {
+        auto const op = rng() % 6;
+        auto const value = cc::to_string(i);
+        if (op == 0)
+        {
+            rb.push_back(value);
+            ref.push_back(value);
+        }
+        else if (op == 1)
+        {
+            rb.push_front(value);
+            ref.push_front(value);
+        }
+        else if (op == 2 && !ref.empty())
+        {
+            REQUIRE(rb.pop_front() == ref.front());
+            ref.pop_front();
+        }
+        else if (op == 3 && !ref.empty())
+        {
+            REQUIRE(rb.pop_back() == ref.back());
+            ref.pop_back();
+        }
+        else if (op == 4 && !ref.empty())
+        {
+            auto const idx = isize(rng() % ref.size());
+            REQUIRE(rb[idx] == ref[idx]);
+        }
+        else if (op == 5)
+        {
+            // self-aliasing push into a full buffer
+            if (!ref.empty())
+            {
+                rb.push_back(rb.front());
+                ref.push_back(ref.front());
+            }
+        }
+        if (i % 101 == 0)
+            REQUIRE(same_elements(rb, ref));
+    }
+    REQUIRE(same_elements(rb, ref));
+
+    auto copy = rb;
+    CHECK(same_elements(copy, ref));
+    auto moved = cc::move(copy);
+    CHECK(copy.empty());
+    CHECK(same_elements(moved, ref));
+}
+
+TEST("ringbuffer - regions")
+{
+    auto rb = cc::ringbuffer<int>::create_with_capacity(8);
+    CHECK(rb.capacity() == 8);
+
+    // move the head to the middle so the next writes wrap
+    for (auto i = 0; i < 6; ++i)
+        rb.push_back(-1);
+    rb.commit_read(6);
+    CHECK(rb.empty());
+
+    auto w = rb.writable_regions(5);
+    CHECK(w.size() == 5);
+    CHECK(w.first.size() == 2);
+    CHECK(w.second.size() == 3);
+    for (auto i = 0; i < w.first.size(); ++i)
+        w.first[i] = i;
+    for (auto i = 0; i < w.second.size(); ++i)
+        w.second[i] = i + 2;
+    rb.commit_write(5);
+    CHECK(rb.size() == 5);
+    for (auto i = 0; i < 5; ++i)
+        CHECK(rb[i] == i);
+
+    auto const r = rb.readable_regions();
+    CHECK(r.first.size() == 2);
+    CHECK(r.second.size() == 3);
+    CHECK(r.second[0] == 2);
+
+    int out[4] = {};
+    CHECK(rb.pop_front_to(out) == 4);
+    CHECK(out[3] == 3);
+    CHECK(rb.size() == 1);
+    CHECK(rb.front() == 4);
+
+    // bulk push that wraps and one that grows
+    int const values[] = {5, 6, 7, 8, 9, 10};
+    rb.push_back_range(values);
+    CHECK(rb.size() == 7);
+    CHECK(rb.capacity() == 8);
+    rb.push_back_range(values);
+    CHECK(rb.size() == 13);
+    CHECK(rb.capacity() == 16);
+    CHECK(rb[0] == 4);
+    CHECK(rb[12] == 10);
+
+    int big[20] = {};
+    CHECK(rb.pop_front_to(big) == 13);
+    CHECK(big[6] == 10);
+    CHECK(big[7] == 5);
+    CHECK(rb.empty());
+
+    // writable regions grow the storage
+    auto const w2 = rb.writable_regions(100);
+    CHECK(w2.size() == 100);
+    CHECK(rb.capacity() == 128);
+    rb.commit_write(0);
+    CHECK(rb.empty());
+}
+
+TEST("ringbuffer - non-trivial bulk operations")
+{
+    cc::ringbuffer<cc::string> rb;
+    cc::string const values[] = {"a", "b", "c"};
+    for (auto i = 0; i < 10; ++i)
+    {
+        rb.push_back_range(values);
+        rb.commit_read(2);
+    }
+    CHECK(rb.size() == 10);
+    CHECK(rb.front() == "c");
+
+    cc::string out[4];
+    CHECK(rb.pop_front_to(out) == 4);
+    CHECK(out[0] == "c");
+    CHECK(out[1] == "a");
+    CHECK(rb.size() == 6);
+}
+
+TEST("ringbuffer - subobject-safe move assignment")
+{
+    struct item
+    {
+        int id = 0;
+        std::unique_ptr<cc::ringbuffer<item>> inner;
+    };
+
+    cc::ringbuffer<item> rb;
+    rb.push_back(item{1, std::make_unique<cc::ringbuffer<item>>()});
+    rb.push_back(item{2, nullptr});
+    rb.front().inner->push_back(item{10, nullptr});
+    rb.front().inner->push_back(item{11, nullptr});
+    rb.front().inner->push_back(item{12, nullptr});
+
+    // rhs is owned by our first element
+    rb = cc::move(*rb.front().inner);
+    REQUIRE(rb.size() == 3);
+    CHECK(rb[0].id == 10);
+    CHECK(rb[1].id == 11);
+    CHECK(rb[2].id == 12);
+}
+
+#if CC_ASSERT_ENABLED
+TEST("ringbuffer - asserts")
+{
+    cc::ringbuffer<int> rb;
+    CHECK_ASSERTS((void)rb.front());
+    CHECK_ASSERTS((void)rb.pop_front());
+    CHECK_ASSERTS(rb.remove_back());
+    CHECK_ASSERTS(rb.commit_read(1));
+
+    rb.push_back(1);
+    CHECK_ASSERTS((void)rb[1]);
+    CHECK_ASSERTS(rb.commit_write(rb.capacity()));
+}
+#endif
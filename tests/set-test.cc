@@ -0,0 +1,206 @@
+#include <clean-core/set.hh>
+#include <clean-core/string.hh>
+
+#include <nexus/test.hh>
+
+#include <random>
+#include <unordered_set>
+
+using namespace cc::primitive_defines;
+
+namespace
+{
+template <class T>
+bool same_elements(cc::set<T> const& s, std::unordered_set<T> const& ref)
+{
+    isize count = 0;
+    for (auto const& e : s)
+    {
+        if (!ref.contains(e))
+            return false;
+        ++count;
+    }
+    return count == isize(ref.size()) && s.size() == count;
+}
+} // namespace
+
+TEST("set - basics")
+{
+    cc::set<int> s;
+    CHECK(s.empty());
+    CHECK(s.capacity() == 0);
+    CHECK(!s.contains(1));
+    CHECK(!s.remove(1));
+    CHECK(s.begin() == s.end());
+
+    CHECK(s.insert(1));
+    CHECK(s.insert(2));
+    CHECK(!s.insert(1));
+    CHECK(s.size() == 2);
+    CHECK(s.contains(1));
+    CHECK(s.contains(2));
+    CHECK(!s.contains(3));
+
+    auto sum = 0;
+    for (auto v : s)
+        sum += v;
+    CHECK(sum == 3);
+
+    CHECK(s.remove(1));
+    CHECK(!s.contains(1));
+    CHECK(s.size() == 1);
+
+    s = {5, 6, 7, 5};
+    CHECK(s.size() == 3);
+    CHECK(s.remove_all_where([](int v) { return v > 5; }) == 2);
+    CHECK(s.size() == 1);
+
+    s.clear();
+    CHECK(s.empty());
+    CHECK(s.capacity() >= 16);
+}
+
+TEST("set - strings and heterogeneous lookup")
+{
+    cc::set<cc::string> s = {"apple", "pear"};
+    CHECK(s.contains("apple"));
+    CHECK(s.contains(cc::string_view("pear")));
+    CHECK(!s.contains("plum"));
+    CHECK(s.insert(cc::string_view("plum")));
+    CHECK(!s.insert("plum"));
+    CHECK(s.remove("apple"));
+    CHECK(s.size() == 2);
+
+    auto copy = s;
+    copy.insert("cherry");
+    CHECK(s.size() == 2);
+    CHECK(copy.size() == 3);
+
+    SECTION("inserting views into own elements while growing")
+    {
+        cc::set<cc::string> prefixes;
+        prefixes.insert("a string that is long enough to live on the heap, so that use-after-free is caught");
+        for (auto i = 1; i < 60; ++i)
+        {
+            // a prefix of some element, not present yet
+            auto const& e = *prefixes.begin();
+            auto const prefix = cc::string_view(e).subview(0, 80 - i);
+            REQUIRE(!prefixes.contains(prefix));
+            REQUIRE(prefixes.insert(prefix));
+        }
+        CHECK(prefixes.size() == 60);
+    }
+}
+
+TEST("set - insert_range and batched contains")
+{
+    cc::vector<int> input;
+    for (auto i = 0; i < 1000; ++i)
+        input.push_back(i % 300); // lots of duplicates, also within one probe block
+
+    cc::set<int> s;
+    CHECK(s.insert_range(input) == 300);
+    CHECK(s.size() == 300);
+    CHECK(s.insert_range(input) == 0);
+    CHECK(s.insert_range({299, 300, 301, 300}) == 2);
+    CHECK(s.size() == 302);
+
+    cc::vector<int> keys;
+    for (auto i = -50; i < 350; ++i)
+        keys.push_back(i);
+
+    auto found = cc::vector<bool>::create_defaulted(keys.size());
+    s.contains_each(keys, found);
+    for (auto i = 0; i < keys.size(); ++i)
+        REQUIRE(found[i] == s.contains(keys[i]));
+
+    CHECK(s.count_contained(keys) == 302);
+    CHECK(s.count_contained({1, 1, 1, -1}) == 3);
+    CHECK(cc::set<int>().count_contained(keys) == 0);
+}
+
+TEST("set - set operations")
+{
+    std::mt19937 rng(42);
+    cc::set<u32> a;
+    cc::set<u32> b;
+    std::unordered_set<u32> ra;
+    std::unordered_set<u32> rb;
+    for (auto i = 0; i < 3000; ++i)
+    {
+        auto const x = u32(rng() % 4000);
+        auto const y = u32(rng() % 4000);
+        a.insert(x);
+        ra.insert(x);
+        b.insert(y);
+        rb.insert(y);
+    }
+    // leave some tombstones
+    for (auto v = 0u; v < 4000; v += 7)
+    {
+        a.remove(v);
+        ra.erase(v);
+    }
+
+    std::unordered_set<u32> r_union = ra;
+    r_union.insert(rb.begin(), rb.end());
+    std::unordered_set<u32> r_inter;
+    std::unordered_set<u32> r_diff;
+    for (auto v : ra)
+        (rb.contains(v) ? r_inter : r_diff).insert(v);
+
+    CHECK(same_elements(cc::set<u32>::create_union(a, b), r_union));
+    CHECK(same_elements(cc::set<u32>::create_intersection(a, b), r_inter));
+    CHECK(same_elements(cc::set<u32>::create_intersection(b, a), r_inter));
+    CHECK(same_elements(cc::set<u32>::create_difference(a, b), r_diff));
+
+    // with empty sets
+    cc::set<u32> empty;
+    CHECK(same_elements(cc::set<u32>::create_union(empty, a), ra));
+    CHECK(cc::set<u32>::create_intersection(a, empty).empty());
+    CHECK(same_elements(cc::set<u32>::create_difference(a, empty), ra));
+    CHECK(cc::set<u32>::create_difference(empty, a).empty());
+}
+
+TEST("set - extract_to_vector")
+{
+    cc::set<cc::string> s = {"a", "bb", "ccc"};
+    auto const cap = s.capacity();
+    auto v = s.extract_to_vector();
+    CHECK(s.empty());
+    CHECK(s.capacity() == cap);
+    CHECK(v.size() == 3);
+
+    isize total_len = 0;
+    for (auto const& str : v)
+        total_len += str.size();
+    CHECK(total_len == 6);
+
+    CHECK(cc::set<int>().extract_to_vector().empty());
+}
+
+TEST("set - randomized against std::unordered_set")
+{
+    std::mt19937 rng(7);
+    cc::set<u64> s;
+    std::unordered_set<u64> ref;
+
+    for (auto i = 0; i < 30000; ++i)
+    {
+        auto const key = u64(rng() % 1500);
+        if (rng() % 3 == 0)
+            REQUIRE(s.remove(key) == (ref.erase(key) > 0));
+        else
+            REQUIRE(s.insert(key) == ref.insert(key).second);
+    }
+    CHECK(same_elements(s, ref));
+}
+
+#if CC_ASSERT_ENABLED
+TEST("set - asserts")
+{
+    cc::set<int> s = {1, 2};
+    bool out[1];
+    CHECK_ASSERTS(s.contains_each({1, 2}, out));
+}
+#endif
@@ -0,0 +1,186 @@
+#include <clean-core/shared_node_allocation.hh>
+#include <clean-core/vector.hh>
+
+#include <nexus/test.hh>
+
+#include <atomic>
+#include <thread>
+
+using namespace cc::primitive_defines;
+
+namespace
+{
+struct tracked
+{
+    int* live = nullptr;
+    int value = 0;
+
+    tracked(int* l, int v) : live(l), value(v) { *live += 1; }
+    ~tracked() { *live -= 1; }
+
+    tracked(tracked const&) = delete;
+    tracked& operator=(tracked const&) = delete;
+};
+
+struct padded
+{
+    u32 a = 0;
+    u32 b = 0;
+    u32 c = 0;
+};
+} // namespace
+
+// counter is co-located with T, small types share padding with it
+static_assert(sizeof(cc::impl::shared_node<padded>) == 16);
+static_assert(cc::node_class_index_for<cc::impl::shared_node<padded>>() == cc::node_class_index_for<u64[2]>());
+static_assert(sizeof(cc::shared_node_allocation<int>) == sizeof(void*));
+
+TEST("shared_node_allocation - basics")
+{
+    auto& alloc = cc::default_node_allocator();
+
+    SECTION("empty handle")
+    {
+        cc::shared_node_allocation<int> s;
+        CHECK(!s.is_valid());
+        CHECK(!s);
+        CHECK(s.get() == nullptr);
+        CHECK(s.use_count() == 0);
+        s.reset();
+        CHECK(!s);
+    }
+
+    SECTION("create and access")
+    {
+        auto s = cc::shared_node_allocation<int>::create_from(alloc, 42);
+        CHECK(s.is_valid());
+        CHECK(*s == 42);
+        CHECK(s.use_count() == 1);
+        CHECK(s.is_unique());
+
+        *s = 7;
+        CHECK(*s.get() == 7);
+    }
+
+    SECTION("multi-arg construction")
+    {
+        int live = 0;
+        auto s = cc::local_shared_node_allocation<tracked>::create_from(alloc, &live, 3);
+        CHECK(live == 1);
+        CHECK(s->value == 3);
+        s.reset();
+        CHECK(live == 0);
+    }
+}
+
+TEST("shared_node_allocation - sharing semantics")
+{
+    auto& alloc = cc::default_node_allocator();
+    int live = 0;
+
+    SECTION("copies share the object")
+    {
+        auto a = cc::shared_node_allocation<tracked>::create_from(alloc, &live, 1);
+        auto b = a;
+        CHECK(a == b);
+        CHECK(a.get() == b.get());
+        CHECK(a.use_count() == 2);
+        CHECK(!a.is_unique());
+
+        a.reset();
+        CHECK(live == 1);
+        CHECK(b.use_count() == 1);
+        CHECK(b->value == 1);
+
+        b.reset();
+        CHECK(live == 0);
+    }
+
+    SECTION("moves transfer the reference")
+    {
+        auto a = cc::shared_node_allocation<tracked>::create_from(alloc, &live, 1);
+        auto b = cc::move(a);
+        CHECK(!a);
+        CHECK(b.use_count() == 1);
+
+        cc::shared_node_allocation<tracked> c;
+        c = cc::move(b);
+        CHECK(!b);
+        CHECK(c.use_count() == 1);
+        CHECK(live == 1);
+    }
+
+    SECTION("assignment releases the previous object")
+    {
+        auto a = cc::local_shared_node_allocation<tracked>::create_from(alloc, &live, 1);
+        auto b = cc::local_shared_node_allocation<tracked>::create_from(alloc, &live, 2);
+        CHECK(live == 2);
+
+        b = a;
+        CHECK(live == 1);
+        CHECK(a.use_count() == 2);
+        CHECK(b->value == 1);
+    }
+
+    SECTION("self-assignment")
+    {
+        auto a = cc::shared_node_allocation<tracked>::create_from(alloc, &live, 1);
+        auto const& a_ref = a;
+        a = a_ref;
+        CHECK(a.use_count() == 1);
+        CHECK(live == 1);
+    }
+
+    SECTION("many copies")
+    {
+        auto a = cc::local_shared_node_allocation<tracked>::create_from(alloc, &live, 5);
+
+        cc::vector<cc::local_shared_node_allocation<tracked>> copies;
+        for (auto i = 0; i < 100; ++i)
+            copies.push_back(a);
+
+        CHECK(a.use_count() == 101);
+        a.reset();
+        CHECK(copies[0].use_count() == 100);
+
+        copies.clear();
+        CHECK(live == 0);
+    }
+
+    CHECK(live == 0);
+}
+
+TEST("shared_node_allocation - concurrent copies")
+{
+    int live = 0;
+    auto root = cc::shared_node_allocation<tracked>::create_from(cc::default_node_allocator(), &live, 9);
+
+    auto constexpr thread_count = 4;
+    auto constexpr copies_per_thread = 10'000;
+
+    // CHECK is not used inside the threads, mismatches are collected instead
+    std::atomic<int> mismatches = 0;
+
+    cc::vector<std::thread> threads;
+    for (auto t = 0; t < thread_count; ++t)
+        threads.push_back(std::thread(
+            [&mismatches, copy = root]
+            {
+                for (auto i = 0; i < copies_per_thread; ++i)
+                {
+                    auto c = copy;
+                    if (c->value != 9)
+                        mismatches += 1;
+                }
+            }));
+
+    // the last reference may be dropped on any thread
+    root.reset();
+
+    for (auto& t : threads)
+        t.join();
+    threads.clear();
+
+    CHECK(mismatches == 0);
+    CHECK(live == 0);
+}
@@ -0,0 +1,282 @@
+#include <clean-core/small_vector.hh>
+
+#include <nexus/test.hh>
+
+#include <memory>
+#include <new>
+#include <string>
+
+using namespace cc::primitive_defines;
+
+// four pointers of bookkeeping, then the inline elements
+static_assert(sizeof(cc::small_vector<u32, 8>) == 4 * sizeof(void*) + 8 * sizeof(u32));
+static_assert(cc::small_vector<u32, 8>::inline_capacity() == 8);
+
+namespace
+{
+struct tracked
+{
+    static inline int alive = 0;
+    int value;
+
+    tracked(int v) : value(v) { ++alive; }
+    tracked(tracked const& rhs) : value(rhs.value) { ++alive; }
+    tracked(tracked&& rhs) noexcept : value(rhs.value) { ++alive; }
+    tracked& operator=(tracked const&) = default;
+    tracked& operator=(tracked&&) = default;
+    ~tracked() { --alive; }
+
+    bool operator==(int rhs) const { return value == rhs; }
+};
+
+struct counting_resource : cc::memory_resource
+{
+    int allocations = 0;
+    int deallocations = 0;
+
+    counting_resource()
+    {
+        allocate_bytes = [](cc::byte** out_ptr, isize min_bytes, isize, isize alignment, void* userdata) -> isize
+        {
+            auto* self = static_cast<counting_resource*>(userdata);
+            if (min_bytes == 0)
+            {
+                *out_ptr = nullptr;
+                return 0;
+            }
+            ++self->allocations;
+            *out_ptr = static_cast<cc::byte*>(::operator new(min_bytes, std::align_val_t(alignment)));
+            return min_bytes;
+        };
+        deallocate_bytes = [](cc::byte* p, isize, isize alignment, void* userdata)
+        {
+            if (p == nullptr)
+                return;
+            ++static_cast<counting_resource*>(userdata)->deallocations;
+            ::operator delete(p, std::align_val_t(alignment));
+        };
+        userdata = this;
+    }
+};
+
+template <class V>
+bool has_values(V const& v, std::initializer_list<int> values)
+{
+    if (v.size() != isize(values.size()))
+        return false;
+    isize i = 0;
+    for (auto x : values)
+        if (!(v[i++] == x))
+            return false;
+    return true;
+}
+} // namespace
+
+TEST("small_vector - inline storage does not allocate")
+{
+    counting_resource res;
+    auto v = cc::small_vector<int, 4>::create_with_resource(&res);
+    CHECK(v.is_inline());
+    CHECK(v.capacity() == 4);
+
+    v.push_back(1);
+    v.emplace_back(2);
+    v.push_back(3);
+    v.push_back(4);
+    CHECK(has_values(v, {1, 2, 3, 4}));
+    CHECK(v.is_inline());
+    CHECK(!v.has_capacity_back_for(1));
+
+    v.remove_at(1);
+    CHECK(v.pop_back() == 4);
+    v.resize_to_filled(4, 9);
+    CHECK(has_values(v, {1, 3, 9, 9}));
+
+    auto copy = v;
+    auto moved = cc::move(copy);
+    CHECK(copy.empty());
+    CHECK(copy.is_inline());
+    CHECK(has_values(moved, {1, 3, 9, 9}));
+    CHECK(moved.is_inline());
+    CHECK(res.allocations == 0);
+}
+
+TEST("small_vector - spilling to the heap")
+{
+    counting_resource res;
+    {
+        auto v = cc::small_vector<int, 4>::create_with_resource(&res);
+        for (auto i = 0; i < 100; ++i)
+            v.push_back(i);
+        CHECK(!v.is_inline());
+        CHECK(v.size() == 100);
+        CHECK(v.capacity() >= 100);
+        auto ok = true;
+        for (auto i = 0; i < 100; ++i)
+            ok &= v[i] == i;
+        CHECK(ok);
+
+        // exponential growth, no allocation per push
+        CHECK(res.allocations < 10);
+
+        // moves steal the heap buffer
+        auto const p = v.data();
+        auto moved = cc::move(v);
+        CHECK(moved.data() == p);
+        CHECK(v.empty());
+        CHECK(v.is_inline());
+
+        // shrinking moves back inline if possible
+        moved.resize_down_to(3);
+        moved.shrink_to_fit();
+        CHECK(moved.is_inline());
+        CHECK(has_values(moved, {0, 1, 2}));
+    }
+    CHECK(res.allocations == res.deallocations);
+
+    SECTION("aliasing arguments during growth")
+    {
+        cc::small_vector<std::string, 2> s = {"a string that is long enough to not use sso", "b"};
+        s.push_back(s[0]);
+        s.resize_to_filled(10, s[1]);
+        CHECK(s.size() == 10);
+        CHECK(s[2] == "a string that is long enough to not use sso");
+        CHECK(s[9] == "b");
+    }
+}
+
+TEST("small_vector - extract into cc::vector")
+{
+    counting_resource res;
+    {
+        SECTION("heap buffer is handed over")
+        {
+            auto v = cc::small_vector<int, 2>::create_with_resource(&res);
+            for (auto i = 0; i < 10; ++i)
+                v.push_back(i);
+            auto const p = v.data();
+            auto const allocations = res.allocations;
+
+            auto vec = v.extract_vector();
+            CHECK(vec.data() == p);
+            CHECK(vec.size() == 10);
+            CHECK(vec[9] == 9);
+            CHECK(res.allocations == allocations);
+            CHECK(v.empty());
+            CHECK(v.is_inline());
+
+            // the vector keeps growing in the same resource
+            vec.push_back(10);
+            vec.resize_to_defaulted(1000);
+        }
+        SECTION("inline elements are moved")
+        {
+            auto v = cc::small_vector<int, 8>::create_with_resource(&res);
+            v.push_back(1);
+            v.push_back(2);
+            auto vec = v.extract_vector();
+            CHECK(vec.size() == 2);
+            CHECK(vec[1] == 2);
+            CHECK(res.allocations == 1);
+            CHECK(v.empty());
+        }
+    }
+    CHECK(res.allocations == res.deallocations);
+}
+
+TEST("small_vector - non-trivial elements")
+{
+    tracked::alive = 0;
+    {
+        cc::small_vector<tracked, 3> v;
+        for (auto i = 0; i < 5; ++i)
+            v.emplace_back(i);
+        CHECK(tracked::alive == 5);
+
+        cc::small_vector<tracked, 3> small = {7, 8};
+        CHECK(tracked::alive == 7);
+
+        // heap into inline and back
+        small = v;
+        CHECK(has_values(small, {0, 1, 2, 3, 4}));
+        CHECK(tracked::alive == 10);
+        v = cc::move(small);
+        CHECK(tracked::alive == 5);
+        CHECK(small.empty());
+
+        CHECK(v.remove_all_where([](tracked const& t) { return t.value % 2 == 1; }) == 2);
+        CHECK(has_values(v, {0, 2, 4}));
+        v.remove_at_unordered(0);
+        CHECK(has_values(v, {4, 2}));
+        CHECK(v.remove_first_where([](tracked const& t) { return t.value == 2; }) == isize(1));
+        CHECK(tracked::alive == 1);
+
+        v.shrink_to_fit();
+        CHECK(v.is_inline());
+        CHECK(tracked::alive == 1);
+    }
+    CHECK(tracked::alive == 0);
+}
+
+TEST("small_vector - move assignment from a vector owned by an element")
+{
+    // rhs is reachable through one of our elements, which are inline or on the heap,
+    // and rhs's own elements live either inside rhs itself (inline) or in its heap buffer
+    struct node
+    {
+        tracked value;
+        std::unique_ptr<cc::small_vector<node, 3>> kids;
+    };
+    using node_vector = cc::small_vector<node, 3>;
+
+    for (auto const own_count : {2, 5})
+        for (auto const kid_count : {2, 6})
+        {
+            tracked::alive = 0;
+            counting_resource res;
+            {
+                node_vector v;
+                for (auto i = 0; i < own_count; ++i)
+                    v.push_back(node{tracked(i), nullptr});
+                v[0].kids = std::make_unique<node_vector>(node_vector::create_with_resource(&res));
+                for (auto i = 0; i < kid_count; ++i)
+                    v[0].kids->push_back(node{tracked(10 + i), nullptr});
+                REQUIRE(v.is_inline() == (own_count <= 3));
+                REQUIRE(v[0].kids->is_inline() == (kid_count <= 3));
+                auto const* const kid_data = v[0].kids->data();
+                auto const kid_allocations = res.allocations;
+
+                v = cc::move(*v[0].kids);
+                CHECK(tracked::alive == kid_count);
+                REQUIRE(v.size() == kid_count);
+                CHECK(v[0].value.value == 10);
+                CHECK(v[kid_count - 1].value.value == 10 + kid_count - 1);
+                if (kid_count > 3)
+                {
+                    // the heap buffer is adopted as is
+                    CHECK(v.data() == kid_data);
+                    CHECK(res.allocations == kid_allocations);
+                }
+                else
+                {
+                    CHECK(v.is_inline());
+                }
+            }
+            CHECK(tracked::alive == 0);
+            CHECK(res.allocations == res.deallocations);
+        }
+}
+
+#if CC_ASSERT_ENABLED
+TEST("small_vector - asserts")
+{
+    cc::small_vector<int, 2> v = {1, 2};
+    CHECK_ASSERTS((void)v[2]);
+    CHECK_ASSERTS(v.push_back_stable(3));
+    CHECK_ASSERTS(v.resize_down_to(3));
+
+    cc::small_vector<int, 2> e;
+    CHECK_ASSERTS(e.remove_back());
+    CHECK_ASSERTS((void)e.front());
+}
+#endif
@@ -0,0 +1,273 @@
+#include <clean-core/soa_vector.hh>
+
+#include <nexus/test.hh>
+
+#include <new>
+#include <string>
+
+using namespace cc::primitive_defines;
+
+static_assert(cc::soa_vector<int, float, char>::column_count() == 3);
+static_assert(cc::soa_vector<char>::column_alignment >= isize(std::hardware_destructive_interference_size));
+static_assert(std::is_same_v<cc::soa_vector<int, float>::column_t<1>, float>);
+
+namespace
+{
+struct tracked
+{
+    static inline int alive = 0;
+    int value;
+
+    tracked(int v) : value(v) { ++alive; }
+    tracked(tracked const& rhs) : value(rhs.value) { ++alive; }
+    tracked(tracked&& rhs) noexcept : value(rhs.value) { ++alive; }
+    tracked& operator=(tracked const&) = default;
+    tracked& operator=(tracked&&) = default;
+    ~tracked() { --alive; }
+};
+
+struct throws_on_negative
+{
+    int value;
+
+    throws_on_negative(int v) : value(v)
+    {
+        if (v < 0)
+            throw 0;
+    }
+};
+
+struct counting_resource : cc::memory_resource
+{
+    int allocations = 0;
+    int deallocations = 0;
+
+    counting_resource()
+    {
+        allocate_bytes = [](cc::byte** out_ptr, isize min_bytes, isize, isize alignment, void* userdata) -> isize
+        {
+            auto* self = static_cast<counting_resource*>(userdata);
+            if (min_bytes == 0)
+            {
+                *out_ptr = nullptr;
+                return 0;
+            }
+            ++self->allocations;
+            *out_ptr = static_cast<cc::byte*>(::operator new(min_bytes, std::align_val_t(alignment)));
+            return min_bytes;
+        };
+        deallocate_bytes = [](cc::byte* p, isize, isize alignment, void* userdata)
+        {
+            if (p == nullptr)
+                return;
+            ++static_cast<counting_resource*>(userdata)->deallocations;
+            ::operator delete(p, std::align_val_t(alignment));
+        };
+        userdata = this;
+    }
+};
+} // namespace
+
+TEST("soa_vector - columns and rows")
+{
+    counting_resource res;
+    {
+        auto v = cc::soa_vector<int, double, char>::create_with_resource(&res);
+        CHECK(v.empty());
+        CHECK(v.column<0>().empty());
+
+        for (auto i = 0; i < 100; ++i)
+            v.push_back(i, i * 0.5, char('a' + i % 26));
+        CHECK(v.size() == 100);
+        CHECK(v.capacity() >= 100);
+        CHECK(res.allocations < 10); // all columns grow together, exponentially
+
+        // every column is contiguous and aligned
+        auto ints = v.column<0>();
+        auto doubles = v.column<1>();
+        auto chars = v.column<2>();
+        CHECK(ints.size() == 100);
+        CHECK(isize(uintptr_t(ints.data())) % v.column_alignment == 0);
+        CHECK(isize(uintptr_t(doubles.data())) % v.column_alignment == 0);
+        CHECK(isize(uintptr_t(chars.data())) % v.column_alignment == 0);
+
+        auto ok = true;
+        for (auto i = 0; i < 100; ++i)
+            ok &= ints[i] == i && doubles[i] == i * 0.5 && chars[i] == 'a' + i % 26;
+        CHECK(ok);
+
+        // rows are references into the columns
+        auto [i, d, c] = v[42];
+        i = -1;
+        d = 2.5;
+        CHECK(v.column<0>()[42] == -1);
+        CHECK(v.column<1>()[42] == 2.5);
+        CHECK(c == 'q');
+        CHECK(v.back().get<0>() == 99);
+
+        // zipped iteration
+        for (auto [a, b, ch] : v)
+            b = a * 2.0;
+        auto const& cv = v;
+        auto sum = 0.0;
+        for (auto [a, b, ch] : cv)
+            sum += b;
+        CHECK(sum == 2.0 * (99 * 100 / 2 - 42 - 1));
+    }
+    CHECK(res.allocations == res.deallocations);
+}
+
+TEST("soa_vector - removal compacts all columns")
+{
+    cc::soa_vector<int, std::string> v;
+    for (auto i = 0; i < 10; ++i)
+        v.emplace_back(i, std::to_string(i));
+
+    SECTION("remove_all_where")
+    {
+        CHECK(v.remove_all_where([](int const& i, std::string const&) { return i % 3 == 0; }) == 4);
+        CHECK(v.size() == 6);
+        auto ok = true;
+        for (auto [i, s] : v)
+            ok &= s == std::to_string(i) && i % 3 != 0;
+        CHECK(ok);
+        CHECK(v[0].get<0>() == 1);
+        CHECK(v[5].get<0>() == 8);
+
+        // with index
+        CHECK(v.remove_all_where([](isize idx, int&, std::string&) { return idx >= 2; }) == 4);
+        CHECK(v.size() == 2);
+        CHECK(v[1].get<1>() == "2");
+    }
+    SECTION("remove_at_unordered")
+    {
+        v.remove_at_unordered(2);
+        CHECK(v.size() == 9);
+        CHECK(v[2].get<0>() == 9);
+        CHECK(v[2].get<1>() == "9");
+        v.remove_at_unordered(8);
+        CHECK(v.size() == 8);
+        CHECK(v.back().get<1>() == "7");
+    }
+    SECTION("remove_at")
+    {
+        v.remove_at(0);
+        v.remove_back();
+        CHECK(v.size() == 8);
+        CHECK(v[0].get<1>() == "1");
+        CHECK(v.back().get<0>() == 8);
+        v.resize_down_to(3);
+        CHECK(v.column<1>().back() == "3");
+        v.clear();
+        CHECK(v.empty());
+        CHECK(v.capacity() >= 10);
+    }
+}
+
+TEST("soa_vector - lifetimes and value semantics")
+{
+    tracked::alive = 0;
+    {
+        cc::soa_vector<tracked, int> v;
+        v.reserve(4);
+        CHECK(v.capacity() == 4);
+        for (auto i = 0; i < 20; ++i)
+            v.emplace_back(i, i);
+        CHECK(tracked::alive == 20);
+
+        // arguments may alias rows during growth
+        while (v.size() < v.capacity())
+            v.emplace_back(v[0].get<0>(), 0);
+        v.push_back(v[1].get<0>(), 1);
+        CHECK(v.back().get<0>().value == 1);
+
+        auto copy = v;
+        CHECK(tracked::alive == 2 * v.size());
+        CHECK(copy.capacity() == v.size());
+        CHECK(copy[19].get<0>().value == 19);
+
+        auto moved = cc::move(copy);
+        CHECK(copy.empty());
+        CHECK(copy.capacity() == 0);
+        CHECK(tracked::alive == 2 * v.size());
+
+        moved = v;
+        v = cc::move(moved);
+        CHECK(tracked::alive == v.size());
+
+        v.remove_all_where([](tracked const& t, int) { return t.value > 0; });
+        CHECK(tracked::alive == v.size());
+        v.resize_down_to(1);
+        CHECK(tracked::alive == 1);
+    }
+    CHECK(tracked::alive == 0);
+
+    SECTION("value-initialized rows")
+    {
+        cc::soa_vector<int, float> v;
+        v.resize_to_defaulted(50);
+        auto ok = true;
+        for (auto [i, f] : v)
+            ok &= i == 0 && f == 0.f;
+        CHECK(ok);
+    }
+
+    SECTION("throwing field constructors leave no partial row")
+    {
+        tracked::alive = 0;
+        cc::soa_vector<tracked, throws_on_negative> v;
+        v.emplace_back(1, 1);
+        auto threw = false;
+        try
+        {
+            v.emplace_back(2, -1);
+        }
+        catch (int)
+        {
+            threw = true;
+        }
+        CHECK(threw);
+        CHECK(v.size() == 1);
+        CHECK(tracked::alive == 1);
+    }
+}
+
+TEST("soa_vector - move assignment from a vector inside the column block")
+{
+    // raw bytes in a column, so that rhs itself can live in the block that the assignment frees
+    struct alignas(alignof(void*)) blob
+    {
+        cc::byte bytes[128];
+    };
+    using blob_vector = cc::soa_vector<int, blob>;
+    static_assert(sizeof(blob_vector) <= sizeof(blob) && alignof(blob_vector) <= alignof(blob));
+
+    blob_vector v;
+    v.emplace_back(1, blob{});
+    v.emplace_back(2, blob{});
+    auto* const rhs = new (cc::placement_new, v[1].get<1>().bytes) blob_vector();
+    for (auto i = 0; i < 3; ++i)
+        rhs->emplace_back(10 + i, blob{});
+
+    // rhs is empty afterwards, so it needs no destructor call
+    v = cc::move(*rhs);
+    REQUIRE(v.size() == 3);
+    CHECK(v[0].get<0>() == 10);
+    CHECK(v[2].get<0>() == 12);
+}
+
+#if CC_ASSERT_ENABLED
+TEST("soa_vector - asserts")
+{
+    cc::soa_vector<int, float> v;
+    v.push_back(1, 2.f);
+    CHECK_ASSERTS((void)v[1]);
+    CHECK_ASSERTS(v.remove_at_unordered(1));
+    CHECK_ASSERTS(v.resize_down_to(2));
+    CHECK_ASSERTS(v.resize_to_defaulted(0));
+
+    cc::soa_vector<int, float> e;
+    CHECK_ASSERTS(e.remove_back());
+    CHECK_ASSERTS((void)e.back());
+}
+#endif
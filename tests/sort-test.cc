@@ -0,0 +1,239 @@
+#include <clean-core/sort.hh>
+#include <clean-core/span.hh>
+#include <clean-core/vector.hh>
+
+#include <nexus/test.hh>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace cc::primitive_defines;
+
+namespace
+{
+struct counting_resource : cc::memory_resource
+{
+    int allocations = 0;
+    int deallocations = 0;
+
+    counting_resource()
+    {
+        allocate_bytes = [](cc::byte** out_ptr, isize min_bytes, isize, isize alignment, void* userdata) -> isize
+        {
+            auto* self = static_cast<counting_resource*>(userdata);
+            if (min_bytes == 0)
+            {
+                *out_ptr = nullptr;
+                return 0;
+            }
+            ++self->allocations;
+            *out_ptr = static_cast<cc::byte*>(::operator new(min_bytes, std::align_val_t(alignment)));
+            return min_bytes;
+        };
+        deallocate_bytes = [](cc::byte* p, isize, isize alignment, void* userdata)
+        {
+            if (p == nullptr)
+                return;
+            ++static_cast<counting_resource*>(userdata)->deallocations;
+            ::operator delete(p, std::align_val_t(alignment));
+        };
+        userdata = this;
+    }
+};
+
+// inputs that stress pivot selection and the partition schemes
+std::vector<std::vector<int>> make_patterns(isize n, std::mt19937& rng)
+{
+    std::vector<std::vector<int>> patterns;
+    auto add = [&](auto&& f)
+    {
+        std::vector<int> v(n);
+        for (isize i = 0; i < n; ++i)
+            v[i] = f(i);
+        patterns.push_back(cc::move(v));
+    };
+    add([&](isize) { return int(rng()); });                                        // random
+    add([&](isize) { return int(rng() % 4); });                                    // few unique
+    add([&](isize i) { return int(i); });                                          // sorted
+    add([&](isize i) { return int(n - i); });                                      // reversed
+    add([&](isize) { return 7; });                                                 // all equal
+    add([&](isize i) { return int(i < n / 2 ? i : n - i); });                      // organ pipe
+    add([&](isize i) { return int(i % 16); });                                     // sawtooth
+    add([&](isize i) { return i % 64 == 0 ? int(rng()) : int(i); });               // almost sorted
+    add([&](isize i) { return int(i ^ 0x55); });                                   // shuffled blocks
+    return patterns;
+}
+
+struct keyed
+{
+    u32 key;
+    u32 order;
+};
+} // namespace
+
+TEST("sort - sorting networks")
+{
+    // 0-1 principle: a network sorts all inputs iff it sorts all 0-1 inputs
+    for (isize n = 0; n <= 8; ++n)
+    {
+        auto ok = true;
+        for (u32 bits = 0; bits < (1u << n); ++bits)
+        {
+            int v[8];
+            for (isize i = 0; i < n; ++i)
+                v[i] = (bits >> i) & 1;
+            cc::sort(cc::span<int>(v, n));
+            ok &= cc::is_sorted(cc::span<int>(v, n));
+        }
+        CHECK(ok);
+    }
+
+    double d[] = {3.5, -1.0, 2.0, 0.0, 8.0};
+    cc::sort(cc::span<double>(d));
+    CHECK(d[0] == -1.0);
+    CHECK(d[4] == 8.0);
+}
+
+TEST("sort - unstable comparison sort")
+{
+    std::mt19937 rng(11);
+    for (isize n : {isize(9), isize(23), isize(24), isize(100), isize(129), isize(1000), isize(50'000)})
+    {
+        for (auto& pattern : make_patterns(n, rng))
+        {
+            auto expected = pattern;
+            std::sort(expected.begin(), expected.end());
+
+            cc::vector<int> v;
+            for (auto x : pattern)
+                v.push_back(x);
+            cc::sort(v);
+            CHECK(std::equal(v.begin(), v.end(), expected.begin(), expected.end()));
+
+            cc::sort(v, [](int a, int b) { return a > b; });
+            CHECK(std::equal(v.begin(), v.end(), expected.rbegin(), expected.rend()));
+        }
+    }
+
+    SECTION("non-trivial elements")
+    {
+        std::vector<std::string> v;
+        for (auto i = 0; i < 500; ++i)
+            v.push_back("a string that is long enough to allocate " + std::to_string(rng() % 100));
+        auto expected = v;
+        std::sort(expected.begin(), expected.end());
+        cc::sort(v);
+        CHECK(v == expected);
+    }
+
+    SECTION("sort_by_key")
+    {
+        std::vector<keyed> v;
+        for (u32 i = 0; i < 1000; ++i)
+            v.push_back({u32(rng() % 100), i});
+        cc::sort_by_key(v, [](keyed const& k) { return k.key; });
+        CHECK(cc::is_sorted(v, [](keyed const& a, keyed const& b) { return a.key < b.key; }));
+    }
+}
+
+TEST("sort - stable_sort")
+{
+    std::mt19937 rng(12);
+    counting_resource res;
+    for (isize n : {isize(0), isize(5), isize(16), isize(17), isize(1000), isize(20'000)})
+    {
+        std::vector<keyed> v;
+        for (u32 i = 0; i < u32(n); ++i)
+            v.push_back({u32(rng() % 50), i});
+        auto expected = v;
+        std::stable_sort(expected.begin(), expected.end(), [](keyed a, keyed b) { return a.key < b.key; });
+
+        auto const allocations = res.allocations;
+        cc::stable_sort(v, [](keyed const& a, keyed const& b) { return a.key < b.key; }, &res);
+        auto ok = true;
+        for (isize i = 0; i < n; ++i)
+            ok &= v[i].key == expected[i].key && v[i].order == expected[i].order;
+        CHECK(ok);
+        CHECK(res.allocations == allocations + (n > 16 ? 1 : 0));
+    }
+    CHECK(res.allocations == res.deallocations);
+
+    SECTION("non-trivial elements")
+    {
+        std::vector<std::string> v;
+        for (auto i = 0; i < 300; ++i)
+            v.push_back(std::to_string(rng() % 30) + " a string that is long enough to allocate " + std::to_string(i));
+        auto expected = v;
+        auto const by_prefix = [](std::string const& a, std::string const& b) { return a[0] < b[0]; };
+        std::stable_sort(expected.begin(), expected.end(), by_prefix);
+        cc::stable_sort(v, by_prefix);
+        CHECK(v == expected);
+
+        cc::stable_sort(v);
+        CHECK(cc::is_sorted(v));
+    }
+}
+
+TEST("sort - radix_sort")
+{
+    std::mt19937_64 rng(13);
+    auto const check_radix = [&]<class T>(T, auto&& gen)
+    {
+        for (isize n : {isize(0), isize(1), isize(50), isize(65), isize(1000), isize(100'000)})
+        {
+            std::vector<T> v(n);
+            for (auto& x : v)
+                x = gen();
+            auto expected = v;
+            std::sort(expected.begin(), expected.end());
+            cc::radix_sort(v);
+            CHECK(v == expected);
+        }
+    };
+    check_radix(u8(), [&] { return u8(rng()); });
+    check_radix(i16(), [&] { return i16(rng()); });
+    check_radix(i32(), [&] { return i32(rng()); });
+    check_radix(u32(), [&] { return u32(rng() % 1000); }); // upper digits are skipped
+    check_radix(i64(), [&] { return i64(rng()); });
+    check_radix(u64(), [&] { return u64(rng()); });
+    check_radix(f32(), [&] { return f32(i64(rng() % 2000) - 1000) * 0.37f; });
+    check_radix(f64(), [&] { return std::ldexp(f64(i64(rng() % 2000) - 1000), int(rng() % 40) - 20); });
+
+    SECTION("special floating point values")
+    {
+        auto const inf = std::numeric_limits<f32>::infinity();
+        f32 v[] = {1.f, -0.f, inf, -2.f, 0.f, -inf, 3.f, -1.f};
+        cc::radix_sort(cc::span<f32>(v));
+        CHECK(v[0] == -inf);
+        CHECK(v[1] == -2.f);
+        CHECK(std::signbit(v[3]));
+        CHECK(!std::signbit(v[4]));
+        CHECK(v[7] == inf);
+    }
+
+    SECTION("radix_sort_by_key is stable")
+    {
+        counting_resource res;
+        std::vector<keyed> v;
+        for (u32 i = 0; i < 10'000; ++i)
+            v.push_back({u32(rng() % 300), i});
+        cc::radix_sort_by_key(v, [](keyed const& k) { return k.key; }, &res);
+        auto ok = true;
+        for (isize i = 1; i < isize(v.size()); ++i)
+            ok &= v[i - 1].key < v[i].key || (v[i - 1].key == v[i].key && v[i - 1].order < v[i].order);
+        CHECK(ok);
+        CHECK(res.allocations == 1);
+        CHECK(res.deallocations == 1);
+
+        // signed and floating point keys
+        cc::radix_sort_by_key(v, [](keyed const& k) { return -i32(k.key); });
+        CHECK(v.front().key == 299);
+        cc::radix_sort_by_key(v, [](keyed const& k) { return f32(k.order) * -0.5f; });
+        CHECK(v.front().order == 9999);
+    }
+}
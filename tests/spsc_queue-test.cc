@@ -0,0 +1,168 @@
+#include <clean-core/spsc_queue.hh>
+#include <clean-core/string.hh>
+#include <clean-core/to_string.hh>
+#include <clean-core/vector.hh>
+
+#include <nexus/test.hh>
+
+#include <thread>
+
+using namespace cc::primitive_defines;
+
+TEST("spsc_queue - single thread")
+{
+    auto q = cc::spsc_queue<int>::create_with_capacity(5);
+    CHECK(q.capacity() == 8);
+    CHECK(q.empty());
+    CHECK(!q.try_pop().has_value());
+
+    for (auto i = 0; i < 8; ++i)
+        CHECK(q.try_push(i));
+    CHECK(!q.try_push(8));
+    CHECK(q.size() == 8);
+
+    CHECK(q.try_pop().value() == 0);
+    CHECK(q.pop() == 1);
+    CHECK(q.size() == 6);
+
+    // batch operations wrap around the end of the slots
+    int const values[] = {8, 9, 10};
+    CHECK(q.try_push_range(values) == 2);
+    int out[16] = {};
+    CHECK(q.try_pop_to(out) == 8);
+    for (auto i = 0; i < 8; ++i)
+        CHECK(out[i] == i + 2);
+    CHECK(q.try_pop_to(out) == 0);
+
+    q.push_range(values);
+    auto r = q.readable_regions();
+    CHECK(r.size() == 3);
+    CHECK(r.first[0] == 8);
+    q.commit_read(2);
+    CHECK(q.pop() == 10);
+
+    auto w = q.writable_regions();
+    CHECK(w.size() == 8);
+    w.first[0] = 42;
+    q.commit_write(1);
+    CHECK(q.pop() == 42);
+}
+
+TEST("spsc_queue - non-trivial elements")
+{
+    auto q = cc::spsc_queue<cc::string>::create_with_capacity(4);
+    q.push("a");
+    q.emplace("b");
+    cc::string const values[] = {"c", "d", "e"};
+    CHECK(q.try_push_range(values) == 2);
+    CHECK(q.pop() == "a");
+
+    cc::string out[2];
+    CHECK(q.pop_to(out) == 2);
+    CHECK(out[0] == "b");
+    CHECK(out[1] == "c");
+
+    // leftovers are destroyed with the queue
+    q.push("f");
+}
+
+TEST("spsc_queue - two threads")
+{
+    constexpr isize count = 200'000;
+
+    // a tiny queue forces both sides to wait and sleep
+    auto q = cc::spsc_queue<u64>::create_with_capacity(16);
+
+    std::thread producer(
+        [&]
+        {
+            u64 batch[7];
+            for (isize i = 0; i < count;)
+            {
+                if (i % 3 == 0 && i + 7 <= count)
+                {
+                    for (auto j = 0; j < 7; ++j)
+                        batch[j] = u64(i + j);
+                    q.push_range(batch);
+                    i += 7;
+                }
+                else if (i % 3 == 1)
+                {
+                    if (q.try_push(u64(i)))
+                        ++i;
+                }
+                else
+                {
+                    q.push(u64(i));
+                    ++i;
+                }
+            }
+        });
+
+    u64 expected = 0;
+    bool in_order = true;
+    u64 buffer[5];
+    while (expected < u64(count))
+    {
+        if (expected % 2 == 0)
+        {
+            auto const n = q.pop_to(buffer);
+            for (isize i = 0; i < n; ++i)
+                in_order &= buffer[i] == expected++;
+        }
+        else
+        {
+            in_order &= q.pop() == expected++;
+        }
+    }
+    producer.join();
+
+    CHECK(in_order);
+    CHECK(q.empty());
+}
+
+TEST("spsc_queue - regions across threads")
+{
+    constexpr u64 count = 100'000;
+    auto q = cc::spsc_queue<u64>::create_with_capacity(64);
+
+    std::thread producer(
+        [&]
+        {
+            u64 next = 0;
+            while (next < count)
+            {
+                auto const w = q.writable_regions();
+                auto n = cc::min(w.size(), isize(count - next));
+                for (isize i = 0; i < n; ++i)
+                    (i < w.first.size() ? w.first[i] : w.second[i - w.first.size()]) = next + u64(i);
+                q.commit_write(n);
+                next += u64(n);
+            }
+        });
+
+    u64 expected = 0;
+    bool in_order = true;
+    while (expected < count)
+    {
+        auto const r = q.readable_regions();
+        for (auto v : r.first)
+            in_order &= v == expected++;
+        for (auto v : r.second)
+            in_order &= v == expected++;
+        q.commit_read(r.size());
+    }
+    producer.join();
+
+    CHECK(in_order);
+}
+
+#if CC_ASSERT_ENABLED
+TEST("spsc_queue - asserts")
+{
+    CHECK_ASSERTS((void)cc::spsc_queue<int>::create_with_capacity(0));
+
+    auto q = cc::spsc_queue<int>::create_with_capacity(4);
+    CHECK_ASSERTS(q.commit_read(1));
+}
+#endif
@@ -709,6 +709,19 @@ TEST("string - comparisons")
         CHECK(s == cc::string_view{""});
     }
 
+    SECTION("ordering")
+    {
+        cc::string a = cc::string("apple");
+        cc::string b = cc::string("banana");
+        CHECK(a < b);
+        CHECK(!(b < a));
+        CHECK(!(a < a));
+        CHECK(a < cc::string_view{"apples"});
+        CHECK(cc::string_view{"app"} < a);
+        CHECK(a < "b");
+        CHECK(!("b" < a));
+    }
+
     SECTION("starts_with")
     {
         cc::string s = cc::string("hello world");
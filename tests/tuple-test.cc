@@ -0,0 +1,133 @@
+#include <clean-core/hash.hh>
+#include <clean-core/map.hh>
+#include <clean-core/string.hh>
+#include <clean-core/tuple.hh>
+
+#include <nexus/test.hh>
+
+#include <type_traits>
+
+using namespace cc::primitive_defines;
+
+namespace
+{
+struct empty_tag
+{
+    bool operator==(empty_tag const&) const = default;
+    auto operator<=>(empty_tag const&) const = default;
+};
+
+enum class color : u8
+{
+    red,
+    green
+};
+} // namespace
+
+// empty elements take no storage
+static_assert(sizeof(cc::tuple<int, empty_tag>) == sizeof(int));
+static_assert(sizeof(cc::tuple<empty_tag, int, empty_tag>) <= 2 * sizeof(int));
+static_assert(std::is_empty_v<cc::tuple<>>);
+
+// trivial whenever all elements are
+static_assert(std::is_trivially_copyable_v<cc::tuple<int, float, empty_tag>>);
+static_assert(std::is_trivially_destructible_v<cc::tuple<int, float, empty_tag>>);
+static_assert(std::is_trivially_default_constructible_v<cc::tuple<int, void*>>);
+static_assert(!std::is_trivially_copyable_v<cc::tuple<int, cc::string>>);
+
+// bytewise comparison only without padding and with bytewise-equal elements
+static_assert(cc::tuple<u32, u32>::is_bytewise_comparable);
+static_assert(cc::tuple<u64, int*, empty_tag>::is_bytewise_comparable);
+static_assert(cc::tuple<cc::tuple<u16, u16>, u32>::is_bytewise_comparable);
+static_assert(!cc::tuple<u8, u32>::is_bytewise_comparable);
+static_assert(!cc::tuple<float, float>::is_bytewise_comparable);
+static_assert(!cc::tuple<cc::string>::is_bytewise_comparable);
+
+static_assert(cc::tuple<int, char, float>::size() == 3);
+static_assert(std::tuple_size_v<cc::tuple<int, char>> == 2);
+static_assert(std::is_same_v<std::tuple_element_t<1, cc::tuple<int, char&, float>>, char&>);
+
+// usable in constant expressions
+static_assert(cc::tuple(1, 2) == cc::tuple(1, 2));
+static_assert(cc::tuple(1, 2) < cc::tuple(1, 3));
+
+TEST("tuple - construction and access")
+{
+    cc::tuple<int, float, cc::string> t = {1, 2.5f, "three"};
+    CHECK(t.get<0>() == 1);
+    CHECK(t.get<1>() == 2.5f);
+    CHECK(t.get<2>() == "three");
+
+    t.get<0>() = 42;
+    CHECK(t.get<0>() == 42);
+
+    auto [i, f, s] = t;
+    CHECK(i == 42);
+    CHECK(f == 2.5f);
+    CHECK(s == "three");
+
+    auto& [ri, rf, rs] = t;
+    rs = "four";
+    CHECK(t.get<2>() == "four");
+
+    auto moved = cc::move(t).get<2>();
+    CHECK(moved == "four");
+
+    auto deduced = cc::tuple(1, 'c', color::green);
+    static_assert(std::is_same_v<decltype(deduced), cc::tuple<int, char, color>>);
+    CHECK(deduced.get<2>() == color::green);
+
+    // reference elements
+    int x = 1;
+    cc::tuple<int&, empty_tag> r = {x, empty_tag{}};
+    r.get<0>() = 7;
+    CHECK(x == 7);
+
+    // nested tuples are not mistaken for copies
+    cc::tuple<cc::tuple<int>> nested = {cc::tuple<int>(3)};
+    auto nested_copy = nested;
+    CHECK(nested_copy.get<0>().get<0>() == 3);
+}
+
+TEST("tuple - comparison")
+{
+    using key = cc::tuple<u32, u32>;
+    CHECK(key(1, 2) == key(1, 2));
+    CHECK(key(1, 2) != key(2, 1));
+    CHECK(key(1, 2) < key(2, 1));
+    CHECK(key(1, 2) < key(1, 3));
+    CHECK(key(1, 3) >= key(1, 3));
+
+    // element-wise path
+    using mixed = cc::tuple<u8, float, cc::string>;
+    CHECK(mixed(1, 0.0f, "a") == mixed(1, -0.0f, "a"));
+    CHECK(mixed(1, 0.0f, "a") != mixed(1, 0.0f, "b"));
+    CHECK(mixed(1, 0.0f, "a") < mixed(1, 0.0f, "b"));
+    CHECK(mixed(0, 5.0f, "z") < mixed(1, 0.0f, "a"));
+
+    cc::tuple<> e0, e1;
+    CHECK(e0 == e1);
+    CHECK(!(e0 < e1));
+}
+
+TEST("tuple - hashing")
+{
+    using key = cc::tuple<u32, u32, empty_tag>;
+    CHECK(cc::make_hash(key(1, 2, empty_tag{})) == cc::make_hash(key(1, 2, empty_tag{})));
+    CHECK(cc::make_hash(key(1, 2, empty_tag{})) != cc::make_hash(key(2, 1, empty_tag{})));
+
+    // element-wise hashing follows the element rules
+    using mixed = cc::tuple<float, cc::string>;
+    CHECK(cc::make_hash(mixed(0.0f, "a")) == cc::make_hash(mixed(-0.0f, "a")));
+    CHECK(cc::make_hash(mixed(1.0f, "a")) != cc::make_hash(mixed(1.0f, "b")));
+
+    SECTION("as map key")
+    {
+        cc::map<cc::tuple<u32, u32>, int> edges;
+        for (u32 i = 0; i < 100; ++i)
+            edges[cc::tuple(i, i + 1)] = int(i);
+        CHECK(edges.size() == 100);
+        CHECK(edges.get(cc::tuple<u32, u32>(41, 42)) == 41);
+        CHECK(edges.get_ptr(cc::tuple<u32, u32>(42, 41)) == nullptr);
+    }
+}
@@ -0,0 +1,273 @@
+#include <clean-core/string.hh>
+#include <clean-core/variant.hh>
+
+#include <nexus/test.hh>
+
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+using namespace cc::primitive_defines;
+
+namespace
+{
+struct tracked
+{
+    static inline int alive = 0;
+    int value;
+
+    tracked(int v) : value(v) { ++alive; }
+    tracked(tracked const& rhs) : value(rhs.value) { ++alive; }
+    tracked(tracked&& rhs) noexcept : value(rhs.value) { ++alive; }
+    tracked& operator=(tracked const&) = default;
+    tracked& operator=(tracked&&) = default;
+    ~tracked() { --alive; }
+
+    bool operator==(tracked const&) const = default;
+};
+
+struct explicit_only
+{
+    int value;
+    explicit explicit_only(int v, int w) : value(v + w) {}
+};
+
+struct throwing_assign
+{
+    throwing_assign() = default;
+    throwing_assign(throwing_assign&&) noexcept = default;
+    throwing_assign& operator=(throwing_assign&&) { return *this; }
+};
+
+struct throws_on_negative
+{
+    static inline int alive = 0;
+    int value;
+
+    throws_on_negative(int v) : value(v)
+    {
+        if (v < 0)
+            throw v;
+        ++alive;
+    }
+    throws_on_negative(throws_on_negative&& rhs) noexcept : value(rhs.value) { ++alive; }
+    ~throws_on_negative() { --alive; }
+};
+
+// deep-copying tree node, the child is only reachable through the parent's alternative
+struct tree
+{
+    std::unique_ptr<cc::variant<int, tree>> child;
+
+    tree() = default;
+    explicit tree(cc::variant<int, tree> c) : child(std::make_unique<cc::variant<int, tree>>(cc::move(c))) {}
+    tree(tree const& rhs) : child(rhs.child ? std::make_unique<cc::variant<int, tree>>(*rhs.child) : nullptr) {}
+    tree(tree&&) noexcept = default;
+    tree& operator=(tree const& rhs) { return *this = tree(rhs); }
+    tree& operator=(tree&&) noexcept = default;
+};
+
+template <int I>
+struct tag
+{
+    int value = I;
+};
+
+template <int... Is>
+cc::variant<tag<Is>...> make_tag_variant(std::integer_sequence<int, Is...>); // declaration only
+} // namespace
+
+// smallest discriminant, stored after the value
+static_assert(sizeof(cc::variant<u32, float>) == 8);
+static_assert(sizeof(cc::variant<u8, i8>) == 2);
+static_assert(std::is_same_v<cc::variant<int, float>::index_t, u8>);
+
+// trivial whenever all alternatives are
+static_assert(std::is_trivially_copyable_v<cc::variant<int, float, void*>>);
+static_assert(std::is_trivially_destructible_v<cc::variant<int, float, void*>>);
+static_assert(!std::is_trivially_copyable_v<cc::variant<int, cc::string>>);
+static_assert(!std::is_trivially_destructible_v<cc::variant<int, cc::string>>);
+
+// converting construction selects the same type, otherwise the only constructible alternative
+static_assert(std::is_constructible_v<cc::variant<int, cc::string>, char const*>);
+static_assert(!std::is_constructible_v<cc::variant<int, float>, double>); // ambiguous
+static_assert(!std::is_constructible_v<cc::variant<int, float>, cc::string>);
+
+// move operations are only noexcept if all alternatives' are
+static_assert(std::is_nothrow_move_constructible_v<cc::variant<int, cc::string>>);
+static_assert(std::is_nothrow_move_assignable_v<cc::variant<int, cc::string>>);
+static_assert(std::is_nothrow_move_constructible_v<cc::variant<int, throwing_assign>>);
+static_assert(!std::is_nothrow_move_assignable_v<cc::variant<int, throwing_assign>>);
+
+static_assert(cc::variant<int, float, cc::string>::index_of<cc::string>() == 2);
+static_assert(std::is_same_v<cc::variant<int, float>::alternative_t<1>, float>);
+
+TEST("variant - basics")
+{
+    cc::variant<int, float, cc::string> v;
+    CHECK(v.index() == 0);
+    CHECK(v.is<int>());
+    CHECK(v.get<int>() == 0);
+
+    v = 2.5f;
+    CHECK(v.is<float>());
+    CHECK(v.get<1>() == 2.5f);
+    CHECK(v.get_ptr<int>() == nullptr);
+    CHECK(v.get_ptr<float>() != nullptr);
+
+    v = "a string that is long enough to not use sso";
+    CHECK(v.is<cc::string>());
+    CHECK(v.get<cc::string>() == "a string that is long enough to not use sso");
+
+    auto copy = v;
+    CHECK(copy == v);
+    auto moved = cc::move(copy);
+    CHECK(moved.get<cc::string>() == "a string that is long enough to not use sso");
+
+    v = 7;
+    CHECK(v != moved);
+    CHECK(v == cc::variant<int, float, cc::string>(7));
+    CHECK(v != cc::variant<int, float, cc::string>(8));
+
+    v.emplace<cc::string>("x");
+    CHECK(v.get<2>() == "x");
+    v.get<cc::string>() += "y";
+    CHECK(v.get<cc::string>() == "xy");
+    auto s = cc::move(v).get<cc::string>();
+    CHECK(s == "xy");
+
+    // duplicate alternatives via index
+    auto d = cc::variant<int, int>::create_emplaced<1>(5);
+    CHECK(d.index() == 1);
+    CHECK(d.get<1>() == 5);
+
+    auto e = cc::variant<int, explicit_only>::create_emplaced<explicit_only>(3, 4);
+    CHECK(e.get<explicit_only>().value == 7);
+}
+
+TEST("variant - visit")
+{
+    cc::variant<int, float, cc::string> v = 3;
+    auto const describe = [](auto const& x) -> cc::string
+    {
+        if constexpr (std::is_same_v<std::decay_t<decltype(x)>, cc::string>)
+            return "string";
+        else if constexpr (std::is_same_v<std::decay_t<decltype(x)>, int>)
+            return "int";
+        else
+            return "float";
+    };
+    CHECK(v.visit(describe) == "int");
+    v = 1.f;
+    CHECK(v.visit(describe) == "float");
+    v = cc::string("s");
+    CHECK(v.visit(describe) == "string");
+
+    // mutable visit
+    v.visit([](auto& x) { x = x + x; });
+    CHECK(v.get<cc::string>() == "ss");
+
+    // rvalue visit forwards the value category
+    auto taken = cc::move(v).visit([](auto&& x) { return std::is_rvalue_reference_v<decltype(x)>; });
+    CHECK(taken);
+
+    // more alternatives than a single dispatch switch covers
+    decltype(make_tag_variant(std::make_integer_sequence<int, 40>{})) many = tag<37>{};
+    auto const value = [](auto const& t) { return t.value; };
+    CHECK(many.visit(value) == 37);
+    many = tag<3>{};
+    CHECK(many.visit(value) == 3);
+    many = tag<32>{};
+    CHECK(many.visit(value) == 32);
+}
+
+TEST("variant - lifetimes")
+{
+    tracked::alive = 0;
+    {
+        cc::variant<int, tracked> v = tracked(1);
+        CHECK(tracked::alive == 1);
+
+        v = 5;
+        CHECK(tracked::alive == 0);
+
+        v = tracked(2);
+        auto copy = v;
+        CHECK(tracked::alive == 2);
+
+        copy = tracked(3); // same alternative: assigns
+        CHECK(tracked::alive == 2);
+        CHECK(copy.get<tracked>().value == 3);
+
+        v = copy;
+        CHECK(v.get<tracked>().value == 3);
+        CHECK(tracked::alive == 2);
+
+        copy = 4;
+        v = cc::move(copy);
+        CHECK(tracked::alive == 0);
+        CHECK(v.get<int>() == 4);
+
+        v.emplace<tracked>(6);
+        CHECK(tracked::alive == 1);
+    }
+    CHECK(tracked::alive == 0);
+}
+
+TEST("variant - throwing constructors keep the old value")
+{
+    tracked::alive = 0;
+    throws_on_negative::alive = 0;
+    {
+        cc::variant<tracked, throws_on_negative> v = tracked(1);
+        auto threw = false;
+        try
+        {
+            v.emplace<throws_on_negative>(-1);
+        }
+        catch (int)
+        {
+            threw = true;
+        }
+        CHECK(threw);
+        REQUIRE(v.is<tracked>());
+        CHECK(v.get<tracked>().value == 1);
+        CHECK(tracked::alive == 1);
+        CHECK(throws_on_negative::alive == 0);
+
+        v.emplace<throws_on_negative>(2);
+        CHECK(tracked::alive == 0);
+        CHECK(throws_on_negative::alive == 1);
+    }
+    CHECK(tracked::alive == 0);
+    CHECK(throws_on_negative::alive == 0);
+}
+
+TEST("variant - assigning from a value owned by the current alternative")
+{
+    // the current alternative (tree) is destroyed when switching to int, which frees rhs
+    cc::variant<int, tree> v = tree(cc::variant<int, tree>(7));
+
+    SECTION("move")
+    {
+        v = cc::move(*v.get<tree>().child);
+        REQUIRE(v.is<int>());
+        CHECK(v.get<int>() == 7);
+    }
+
+    SECTION("copy")
+    {
+        v = *v.get<tree>().child;
+        REQUIRE(v.is<int>());
+        CHECK(v.get<int>() == 7);
+    }
+}
+
+#if CC_ASSERT_ENABLED
+TEST("variant - asserts")
+{
+    cc::variant<int, float> v = 1;
+    CHECK_ASSERTS((void)v.get<float>());
+    CHECK_ASSERTS((void)v.get<1>());
+}
+#endif
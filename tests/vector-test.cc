@@ -721,6 +721,212 @@ TEST("vector - emplace_back_stable requires capacity")
     }
 }
 
+TEST("vector - push_back_range")
+{
+    SECTION("grows at most once")
+    {
+        CountingResource res;
+        auto v = cc::vector<int>::create_with_resource(&res);
+        v.push_back(-1);
+        res.reset();
+
+        std::vector<int> src(10'000);
+        for (int i = 0; i < 10'000; ++i)
+            src[i] = i;
+        v.push_back_range(cc::span<int const>(src.data(), cc::isize(src.size())));
+
+        CHECK(res.allocations == 1);
+        CHECK(v.size() == 10'001);
+        CHECK(v[0] == -1);
+        CHECK(v[1] == 0);
+        CHECK(v[10'000] == 9'999);
+    }
+
+    SECTION("appending itself")
+    {
+        cc::vector<int> v = {1, 2, 3};
+        v.push_back_range(cc::span<int const>(v.data(), v.size()));
+        v.push_back_range(cc::span<int const>(v.data(), v.size()));
+        CHECK(v.size() == 12);
+        CHECK(v[3] == 1);
+        CHECK(v[11] == 3);
+    }
+
+    SECTION("non-trivial elements are copy-constructed")
+    {
+        Tracked::reset_counters();
+        {
+            cc::vector<Tracked> v;
+            Tracked src[3] = {Tracked(1), Tracked(2), Tracked(3)};
+            v.push_back_range(cc::span<Tracked const>(src, 3));
+            CHECK(Tracked::copy_ctor_count == 3);
+            CHECK(v[2].value == 3);
+        }
+        CHECK(Tracked::dtor_count == Tracked::default_ctor_count + Tracked::copy_ctor_count + Tracked::move_ctor_count);
+    }
+
+    SECTION("empty range")
+    {
+        cc::vector<int> v;
+        v.push_back_range({});
+        CHECK(v.empty());
+    }
+}
+
+TEST("vector - append_uninitialized")
+{
+    cc::vector<uint32_t> v = {7};
+    auto dst = v.append_uninitialized(100);
+    CHECK(dst.size() == 100);
+    CHECK(v.size() == 101);
+    CHECK(dst.data() == v.data() + 1);
+    for (int i = 0; i < 100; ++i)
+        dst[i] = uint32_t(i);
+
+    CHECK(v[0] == 7);
+    CHECK(v[100] == 99);
+
+    auto const none = v.append_uninitialized(0);
+    CHECK(none.empty());
+    CHECK(v.size() == 101);
+}
+
+TEST("vector - insert_at and emplace_at")
+{
+    SECTION("positions")
+    {
+        cc::vector<int> v = {1, 3};
+        v.insert_at(1, 2);
+        v.insert_at(0, 0);
+        v.insert_at(v.size(), 4);
+        v.emplace_at(2, 9);
+        CHECK(v.size() == 6);
+        CHECK(v[0] == 0);
+        CHECK(v[1] == 1);
+        CHECK(v[2] == 9);
+        CHECK(v[3] == 2);
+        CHECK(v[4] == 3);
+        CHECK(v[5] == 4);
+    }
+
+    SECTION("against std::vector with growth and aliasing")
+    {
+        cc::vector<Tracked> v;
+        std::vector<int> ref;
+        Tracked::reset_counters();
+        for (int i = 0; i < 500; ++i)
+        {
+            auto const idx = cc::isize((i * 7919) % (ref.size() + 1));
+            if (i % 3 == 0 && !ref.empty())
+            {
+                // inserting an element of the container itself
+                auto const src = cc::isize((i * 31) % ref.size());
+                v.insert_at(idx, v[src]);
+                ref.insert(ref.begin() + idx, ref[src]);
+            }
+            else
+            {
+                v.emplace_at(idx, i);
+                ref.insert(ref.begin() + idx, i);
+            }
+        }
+
+        auto same = v.size() == cc::isize(ref.size());
+        for (cc::isize i = 0; same && i < v.size(); ++i)
+            same = v[i].value == ref[i];
+        CHECK(same);
+
+        v.clear();
+        CHECK(Tracked::dtor_count == Tracked::default_ctor_count + Tracked::copy_ctor_count + Tracked::move_ctor_count);
+    }
+
+    SECTION("move-only elements")
+    {
+        cc::vector<TrackedMove> v;
+        v.emplace_back(1);
+        v.emplace_back(3);
+        v.insert_at(1, TrackedMove(2));
+        v.emplace_at(0, 0);
+        CHECK(v.size() == 4);
+        CHECK(v[0].value == 0);
+        CHECK(v[1].value == 1);
+        CHECK(v[2].value == 2);
+        CHECK(v[3].value == 3);
+    }
+}
+
+TEST("vector - insert_range_at")
+{
+    SECTION("grows at most once")
+    {
+        CountingResource res;
+        auto v = cc::vector<int>::create_with_resource(&res);
+        for (int i = 0; i < 10; ++i)
+            v.push_back(i);
+        res.reset();
+
+        std::vector<int> src(1000, -1);
+        v.insert_range_at(5, cc::span<int const>(src.data(), cc::isize(src.size())));
+        CHECK(res.allocations <= 1);
+        CHECK(v.size() == 1010);
+        CHECK(v[4] == 4);
+        CHECK(v[5] == -1);
+        CHECK(v[1004] == -1);
+        CHECK(v[1005] == 5);
+        CHECK(v[1009] == 9);
+    }
+
+    SECTION("inserting itself")
+    {
+        cc::vector<int> v = {0, 1, 2, 3};
+        v.reserve(100);
+        v.insert_range_at(1, cc::span<int const>(v.data() + 2, 2));
+        CHECK(v.size() == 6);
+        CHECK(v[0] == 0);
+        CHECK(v[1] == 2);
+        CHECK(v[2] == 3);
+        CHECK(v[3] == 1);
+        CHECK(v[4] == 2);
+        CHECK(v[5] == 3);
+    }
+
+    SECTION("against std::vector with and without capacity")
+    {
+        cc::vector<Tracked> v;
+        std::vector<int> ref;
+        Tracked::reset_counters();
+        for (int i = 0; i < 200; ++i)
+        {
+            if (i % 4 == 0)
+                v.reserve(v.size() + 8);
+
+            auto const idx = cc::isize((i * 7919) % (ref.size() + 1));
+            auto const count = i % 5;
+            if (i % 3 == 0 && cc::isize(ref.size()) >= count)
+            {
+                // inserting a range of the container itself
+                v.insert_range_at(idx, cc::span<Tracked const>(v.data(), count));
+                ref.insert(ref.begin() + idx, ref.begin(), ref.begin() + count);
+            }
+            else
+            {
+                Tracked src[4] = {Tracked(i), Tracked(i + 1000), Tracked(i + 2000), Tracked(i + 3000)};
+                v.insert_range_at(idx, cc::span<Tracked const>(src, count));
+                for (int k = 0; k < count; ++k)
+                    ref.insert(ref.begin() + idx + k, i + 1000 * k);
+            }
+        }
+
+        auto same = v.size() == cc::isize(ref.size());
+        for (cc::isize i = 0; same && i < v.size(); ++i)
+            same = v[i].value == ref[i];
+        CHECK(same);
+
+        v.clear();
+        CHECK(Tracked::dtor_count == Tracked::default_ctor_count + Tracked::copy_ctor_count + Tracked::move_ctor_count);
+    }
+}
+
 TEST("vector - pop_back")
 {
     SECTION("int - single pop")